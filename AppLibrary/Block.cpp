@@ -1,31 +1,257 @@
-#include "Block.h"
-#include <fstream>
-#include "..\Core\StringUtils.h"
-
-
-void ProcessBlock(std::ifstream& streamObject)
-{
-	std::cout << "    ProcessBlock" << std::endl;
-
-	std::string line;
-	bool done = false;
-	while (!done)
-	{
-		getline(streamObject, line);
-		std::cout << line << '\n';
-
-		if (startsWith(line, EndFeatureToken))
-		{
-			done = true;
-		}
-		
-		//NIY 
-
-		//else if (startsWith(line, ""))
-		//{
-		//	std::string partFileName = line.substr(EndFeatureToken.size(), line.size() - EndFeatureToken.size());
-		//	cout << "    " << EndFeatureToken << " " << partFileName << endl;
-		//}
-
-	}
-}
\ No newline at end of file
+
+#include "Block.h"
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include "..\Core\FeatureContentStore.h"
+#include "..\Core\StringUtils.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\DataReader\DataObjectReader.h"
+#include "..\DataReader\DataReaderRegistrant.h"
+
+
+GuidObject* ReadBlockVersion10(std::ifstream& streamObject);
+GuidObject* ReadBlockVersion10View(PartFileTokenizer& tokenizer);
+static void WriteBlockVersion10(GuidObject* object, std::string& out);
+
+static DataReaderRegistrant block10registrant("Block10", ReadBlockVersion10, ReadBlockVersion10View, WriteBlockVersion10);
+
+
+// Every NaN means a field that was not given, they are made one bit pattern so such blocks share too
+static double CanonicalField(double value)
+{
+	return std::isnan(value) ? std::numeric_limits<double>::quiet_NaN() : value;
+}
+
+static const Application::BlockFields* InternBlockFields(const double origin[3], double length, double width, double height)
+{
+	static const FeatureContentKind blockKind = FeatureContentStore::GetInstance().GetKind("Block");
+
+	Application::BlockFields fields;
+	for (int i = 0; i < 3; i++)
+	{
+		fields.origin[i] = CanonicalField(origin[i]);
+	}
+	fields.length = CanonicalField(length);
+	fields.width = CanonicalField(width);
+	fields.height = CanonicalField(height);
+	return FeatureContentStore::GetInstance().Intern(blockKind, fields);
+}
+
+static const double ZeroOrigin[3] = { 0.0, 0.0, 0.0 };
+
+Application::Block::Block(int guid)
+	: IBlock(guid), m_fields(InternBlockFields(ZeroOrigin, 0.0, 0.0, 0.0))
+{
+
+}
+
+Application::Block::Block(const double origin[3], double length, double width, double height, int guid)
+	: IBlock(guid), m_fields(InternBlockFields(origin, length, width, height))
+{
+
+}
+
+Application::Block* Application::Block::FromText(std::string_view origin, std::string_view length, std::string_view width,
+	std::string_view height, int guid)
+{
+	double originValue[3];
+	parseDoubleListField(Block_OriginToken, origin, originValue, 3);
+	double lengthValue = parseDoubleField(Block_LengthToken, length);
+	double widthValue = parseDoubleField(Block_WidthToken, width);
+	double heightValue = parseDoubleField(Block_HeightToken, height);
+
+	return new Block(originValue, lengthValue, widthValue, heightValue, guid);
+}
+
+std::string Application::Block::GetVersion()
+{
+	return "10";
+}
+
+void Application::Block::WriteFeature(std::string& out)
+{
+	out.append(FeatureToken).append("Block\n");
+	out.append(Block_VersionToken).append(GetVersion()).append("\n");
+	appendDoubleList(out.append(Block_OriginToken), m_fields->origin, 3);
+	out.append("\n");
+	appendDouble(out.append(Block_LengthToken), m_fields->length);
+	out.append("\n");
+	appendDouble(out.append(Block_WidthToken), m_fields->width);
+	out.append("\n");
+	appendDouble(out.append(Block_HeightToken), m_fields->height);
+	out.append("\n");
+	out.append(Block_GuidToken).append(std::to_string(m_guid)).append("\n");
+	out.append(EndFeatureToken).append("\n");
+}
+
+bool Application::Block::CopyFieldsFrom(const Feature& other)
+{
+	const Block* block = dynamic_cast<const Block*>(&other);
+	if (block == nullptr)
+	{
+		return false;
+	}
+	// payloads live as long as the FeatureContentStore, the pointer is all there is to copy, and equal fields share one
+	if (m_fields != block->m_fields)
+	{
+		m_fields = block->m_fields;
+		MarkDirty();
+	}
+	return true;
+}
+
+void Application::Block::SetOrigin(const double origin[3])
+{
+	m_fields = InternBlockFields(origin, m_fields->length, m_fields->width, m_fields->height);
+	MarkDirty();
+}
+
+void Application::Block::SetLength(double length)
+{
+	m_fields = InternBlockFields(m_fields->origin, length, m_fields->width, m_fields->height);
+	MarkDirty();
+}
+
+void Application::Block::SetWidth(double width)
+{
+	m_fields = InternBlockFields(m_fields->origin, m_fields->length, width, m_fields->height);
+	MarkDirty();
+}
+
+void Application::Block::SetHeight(double height)
+{
+	m_fields = InternBlockFields(m_fields->origin, m_fields->length, m_fields->width, height);
+	MarkDirty();
+}
+
+void ReadInBlock(std::ifstream& streamObject)
+{
+	std::cout << "    ProcessBlock" << std::endl;
+	std::string line;
+	getline(streamObject, line);
+
+	std::string version = line.substr(Block_VersionToken.size(), line.size() - Block_VersionToken.size());
+	std::cout << "    " << Block_VersionToken << " " << version << std::endl;
+
+	dataReaderFunction readerFunc = DataObjectReader::GetInstance().GetReader("Block" + version);
+	if (readerFunc != nullptr)
+	{
+		// there is only one Block version, nothing to version up
+		delete readerFunc(streamObject);
+	}
+}
+
+GuidObject* ReadInBlock(PartFileTokenizer& tokenizer)
+{
+	std::string_view line;
+	tokenizer.NextLine(line);
+
+	std::string_view version = PartFileTokenizer::TokenValue(line, Block_VersionToken);
+
+	std::string BlockVersionToken("Block");
+	BlockVersionToken.append(version);
+
+	dataViewReaderFunction readerFunc = DataObjectReader::GetInstance().GetViewReader(BlockVersionToken);
+	if (readerFunc == nullptr)
+	{
+		return nullptr;
+	}
+	return readerFunc(tokenizer);
+}
+
+GuidObject* ReadBlockVersion10(std::ifstream& streamObject)
+{
+	std::string line;
+
+	std::string origin;
+	std::string length;
+	std::string width;
+	std::string height;
+	int guid = -1;
+
+	std::string_view value;
+	bool done = false;
+	while (!done && getline(streamObject, line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::EndFeature:
+			done = true;
+			break;
+		case PartFileKey::Block_Origin:
+			origin = value;
+			break;
+		case PartFileKey::Block_Length:
+			length = value;
+			break;
+		case PartFileKey::Block_Width:
+			width = value;
+			break;
+		case PartFileKey::Block_Height:
+			height = value;
+			break;
+		case PartFileKey::Block_Guid:
+			parseInt(value, guid);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return Application::Block::FromText(origin, length, width, height, guid);
+}
+
+GuidObject* ReadBlockVersion10View(PartFileTokenizer& tokenizer)
+{
+	std::string_view line;
+
+	std::string_view origin;
+	std::string_view length;
+	std::string_view width;
+	std::string_view height;
+	int guid = -1;
+
+	// the values stay views into the mapped part, from_chars reads them in place
+	std::string_view value;
+	bool done = false;
+	while (!done && tokenizer.NextLine(line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::EndFeature:
+			done = true;
+			break;
+		case PartFileKey::Block_Origin:
+			origin = value;
+			break;
+		case PartFileKey::Block_Length:
+			length = value;
+			break;
+		case PartFileKey::Block_Width:
+			width = value;
+			break;
+		case PartFileKey::Block_Height:
+			height = value;
+			break;
+		case PartFileKey::Block_Guid:
+			parseInt(value, guid);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return Application::Block::FromText(origin, length, width, height, guid);
+}
+
+static void WriteBlockVersion10(GuidObject* object, std::string& out)
+{
+	Application::Block* block = dynamic_cast<Application::Block*>(object);
+	if (block == nullptr)
+	{
+		throw std::exception("Block10 writer given a different feature");
+	}
+	block->WriteFeature(out);
+}
@@ -1,39 +1,98 @@
-#pragma once
-#include "AppFeaturesOpsExports.h"
-#include "Feature.h"
-
-#include <iostream>
-#include <fstream>
-#include "..\Core\GuidObject.h"
-
-void ProcessBlock(std::ifstream& streamObject);
-
-namespace Application
-{
-	class APPLIBRARY_API IBlock : public GuidObject
-	{
-	public:
-		virtual std::string GetVersion() = 0;
-		IBlock(int guid) : GuidObject(guid)
-		{
-
-		}
-		IBlock() = delete;
-	};
-
-
-	class APPLIBRARY_API Block : public Application::Feature, public IBlock
-	{
-		public:
-			Block() = delete;
-			Block(int guid) : IBlock(guid)
-			{
-
-			}
-			std::string GetVersion() override
-			{
-				return "1";
-			}
-	};
-}
-
+#pragma once
+#include "AppFeaturesOpsExports.h"
+#include "Feature.h"
+
+#include <iostream>
+#include <fstream>
+#include "..\Core\GuidObject.h"
+
+class PartFileTokenizer;
+
+void ReadInBlock(std::ifstream& streamObject);
+GuidObject* ReadInBlock(PartFileTokenizer& tokenizer);
+
+namespace Application
+{
+	class APPLIBRARY_API IBlock : public GuidObject
+	{
+	public:
+		virtual std::string GetVersion() = 0;
+		IBlock(int guid) : GuidObject(guid)
+		{
+
+		}
+		IBlock() = delete;
+	};
+
+
+	/// <summary>
+	/// The field values of a Block, one shared copy per distinct set in the FeatureContentStore.
+	/// </summary>
+	struct BlockFields
+	{
+		double origin[3];
+		double length;
+		double width;
+		double height;
+	};
+	static_assert(sizeof(BlockFields) == 6 * sizeof(double), "BlockFields is compared as bytes and must have no padding");
+
+	/// <summary>
+	/// Fields are held as doubles, read with from_chars straight from the line buffer.
+	/// A field that was never given is NaN and writes back empty.  Blocks with the same
+	/// fields share one BlockFields, each keeps only its guid and a pointer to it.
+	/// </summary>
+	class APPLIBRARY_API Block : public Application::Feature, public IBlock
+	{
+		public:
+			Block() = delete;
+			Block(int guid);
+			Block(const double origin[3], double length, double width, double height, int guid);
+
+			/// <summary>
+			/// Builds a block from the field text of a Feature:Block block.
+			/// </summary>
+			static Block* FromText(std::string_view origin, std::string_view length, std::string_view width,
+				std::string_view height, int guid);
+
+			std::string GetVersion() override;
+			void WriteFeature(std::string& out) override;
+			bool CopyFieldsFrom(const Feature& other) override;
+
+			const double* GetOrigin() const
+			{
+				return m_fields->origin;
+			};
+			double GetLength() const
+			{
+				return m_fields->length;
+			};
+			double GetWidth() const
+			{
+				return m_fields->width;
+			};
+			double GetHeight() const
+			{
+				return m_fields->height;
+			};
+
+			/// <summary>
+			/// The setters swap in the shared payload for the new values and mark the block dirty.
+			/// </summary>
+			void SetOrigin(const double origin[3]);
+			void SetLength(double length);
+			void SetWidth(double width);
+			void SetHeight(double height);
+
+			/// <summary>
+			/// The shared payload, equal for every block with the same fields.
+			/// </summary>
+			const BlockFields* GetFields() const
+			{
+				return m_fields;
+			};
+
+		private:
+			const BlockFields* m_fields;
+	};
+}
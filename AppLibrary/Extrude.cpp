@@ -1,189 +1,575 @@
-#include "Extrude.h"
-#include "ExtrudeVersions.h"
-#include <fstream>
-#include "..\Core\StringUtils.h"
-#include "..\DataReader\DataObjectReader.h"
-#include "..\DataReader\\DataReaderRegistrant.h"
-
-
-std::string Extrude_VersionToken = "Extrude_Version:";
-std::string Extrude_DistanceToken = "Extrude_Distance:";
-std::string Extrude_TargetFaceToken = "Extrude_TargetFace:";
-std::string Extrude_VectorToken = "Extrude_Vector:";
-std::string Extrude_BooleanToken = "Extrude_Boolean:";
-std::string Extrude_GuidToken = "Extrude_Guid:";
-
-
-GuidObject* ReadExtrudeVersion2(std::ifstream& streamObject);
-GuidObject* ReadExtrudeVersion3(std::ifstream& streamObject);
-
-Application::Extrude* VersionUpExtrudeVersion2(Application::Extrude2* oldFeature);
-
-static DataReaderRegistrant extrude2registrant("Extrude2", ReadExtrudeVersion2);
-static DataReaderRegistrant extrude3registrant("Extrude3", ReadExtrudeVersion3);
-
-
-
-Application::Extrude::Extrude(std::string distance, std::string targetFace, std::string vectorObject, std::string isAddition, std::string isSubtraction, int guid)
-	: Application::IExtrude(guid), m_distance(distance), m_targetFace(targetFace), m_vectorObject(vectorObject), m_isAddition(isAddition), m_isSubtraction(isSubtraction)
-{
-
-}
-std::string Application::Extrude::GetVersion()
-{
-	return "3";
-}
-
-void ReadInExtrude(std::ifstream& streamObject)
-{
-
-	std::cout << "    ProcessExtrude" << std::endl;
-	std::string line;
-	getline(streamObject, line);
-
-	void* extrudeReadIn = nullptr;
-
-	std::string version = line.substr(Extrude_VersionToken.size(), line.size() - Extrude_VersionToken.size());
-	std::cout << "    " << Extrude_VersionToken << " " << version << std::endl;
-
-	std::string ExtrudeVersionToken = "Extrude" + version;
-
-	dataReaderFunction readerFunc = nullptr;
-
-	readerFunc = DataObjectReader::GetInstance().GetReader(ExtrudeVersionToken);
-
-	if (readerFunc != nullptr)
-	{
-		extrudeReadIn = readerFunc(streamObject);
-	}
-	
-	Application::IExtrude* extrudeReadInterface = (Application::IExtrude*)extrudeReadIn;
-
-	Application::IExtrude* retVal2 = dynamic_cast<Application::IExtrude*>(extrudeReadInterface);
-
-	Application::Extrude* retVal = dynamic_cast<Application::Extrude*>(extrudeReadInterface);
-
-	Application::Extrude2* retVal3 = dynamic_cast<Application::Extrude2*>(retVal2);
-
-	if (retVal == nullptr)
-	{
-		if (version == "1")
-		{
-
-		}
-		else if (version == "2")
-		{
-			Application::Extrude2* extrudeVersion2 = dynamic_cast<Application::Extrude2*>(extrudeReadInterface);
-			retVal = VersionUpExtrudeVersion2(extrudeVersion2);
-		}
-		// need to upgrade to latest Version
-		
-	}
-	else
-	{
-		return; // We woudl probably like to return this retVal
-	}
-	// TODO I believe we are leaking the Extrude Object here :(
-}
-
-GuidObject * ReadExtrudeVersion2(std::ifstream& streamObject)
-{
-	std::string line;
-
-	std::string distance;
-	std::string targetFace;
-	std::string vectorObject;
-	std::string booleanType;
-	int guid = -1;
-
-	bool done = false;
-	while (!done)
-	{
-		getline(streamObject, line);
-		std::cout << line << '\n';
-
-
-
-		if (startsWith(line, EndFeatureToken))
-		{
-			done = true;
-		}
-
-		else if (startsWith(line, Extrude_DistanceToken))
-		{
-			distance = line.substr(Extrude_DistanceToken.size(), line.size() - Extrude_DistanceToken.size());
-			std::cout << "    " << Extrude_DistanceToken << " " << distance << std::endl;
-		}
-		else if (startsWith(line, Extrude_TargetFaceToken))
-		{
-			targetFace = line.substr(Extrude_TargetFaceToken.size(), line.size() - Extrude_TargetFaceToken.size());
-			std::cout << "    " << Extrude_TargetFaceToken << " " << targetFace << std::endl;
-		}
-		else if (startsWith(line, Extrude_VectorToken))
-		{
-			vectorObject = line.substr(Extrude_VectorToken.size(), line.size() - Extrude_VectorToken.size());
-			std::cout << "    " << Extrude_VectorToken << " " << vectorObject << std::endl;
-		}
-		else if (startsWith(line, Extrude_BooleanToken))
-		{
-			booleanType = line.substr(Extrude_BooleanToken.size(), line.size() - Extrude_BooleanToken.size());
-			std::cout << "    " << Extrude_BooleanToken << " " << booleanType << std::endl;
-		}
-		else if (startsWith(line, Extrude_GuidToken))
-		{
-			std::string temp = line.substr(Extrude_GuidToken.size(), line.size() - Extrude_GuidToken.size());
-			guid = std::stoi(temp);
-			std::cout << "    " << Extrude_GuidToken << " " << guid << std::endl;
-		}
-
-	}
-
-	// TODO no validation we read in all the right fields 
-
-	return new Application::Extrude2(distance, targetFace, vectorObject, booleanType, guid);
-
-}
-
-
-GuidObject* ReadExtrudeVersion3(std::ifstream& streamObject)
-{
-
-	throw std::exception("NIY");
-
-	return nullptr;
-
-}
-
-
-Application::Extrude* VersionUpExtrudeVersion2(Application::Extrude2 * oldFeature)
-{
-	Application::Extrude* retval = nullptr;
-
-	//Old Items
-	const std::string distance = oldFeature->GetDistance();
-	const std::string targetFace = oldFeature->GetTargetFace();
-	const std::string vectorObject = oldFeature->GetVectorObject();
-	const std::string booleanType = oldFeature->GetBooleanType();
-	int guid = oldFeature->GetGuid();
-
-	//New Items
-	std::string isAddition;
-	std::string isSubtraction;
-
-	std::cout << "    VersionUpExtrudeVersion2" << std::endl;
-
-	if (booleanType == "Intersect")
-	{
-		isAddition = "True";
-		isSubtraction = "False";
-	}
-	else
-	{
-		throw std::exception("NIY");
-	}
-
-	retval = new Application::Extrude(distance, targetFace, vectorObject, isAddition, isSubtraction, guid);
-
-	return retval;
-
-}
+#include "Extrude.h"
+#include "ExtrudeVersions.h"
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include "..\Core\FeatureContentStore.h"
+#include "..\Core\StringUtils.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\DataReader\DataObjectReader.h"
+#include "..\DataReader\\DataReaderRegistrant.h"
+
+
+GuidObject* ReadExtrudeVersion2(std::ifstream& streamObject);
+GuidObject* ReadExtrudeVersion3(std::ifstream& streamObject);
+GuidObject* ReadExtrudeVersion2View(PartFileTokenizer& tokenizer);
+GuidObject* ReadExtrudeVersion3View(PartFileTokenizer& tokenizer);
+GuidObject* ReadExtrudeVersion2AsLatestView(PartFileTokenizer& tokenizer);
+
+Application::Extrude* VersionUpExtrudeVersion2(Application::Extrude2* oldFeature);
+static void VersionUpExtrudeBooleanType(Application::ExtrudeBooleanType booleanType, bool& isAddition, bool& isSubtraction);
+static void RequireExtrudeVersion2Fields(std::string_view distance, std::string_view targetFace, std::string_view vectorObject,
+	std::string_view booleanType);
+static Application::Extrude* VersionUpToLatestExtrude(std::string_view version, GuidObject* extrudeReadIn);
+static GuidObject* VersionUpExtrude2(GuidObject* oldObject);
+static void WriteExtrudeVersion3(GuidObject* object, std::string& out);
+
+static DataReaderRegistrant extrude2registrant("Extrude2", ReadExtrudeVersion2, ReadExtrudeVersion2View, VersionUpExtrude2,
+	ReadExtrudeVersion2AsLatestView);
+static DataReaderRegistrant extrude3registrant("Extrude3", ReadExtrudeVersion3, ReadExtrudeVersion3View, WriteExtrudeVersion3);
+
+
+
+static const Application::ExtrudeFields* InternExtrudeFields(double distance, InternedStringId targetFace, InternedStringId vectorObject,
+	bool isAddition, bool isSubtraction)
+{
+	static const FeatureContentKind extrudeKind = FeatureContentStore::GetInstance().GetKind("Extrude");
+
+	Application::ExtrudeFields fields = {};
+	// every NaN means a distance that was not given, one bit pattern lets such extrudes share
+	fields.distance = std::isnan(distance) ? std::numeric_limits<double>::quiet_NaN() : distance;
+	fields.targetFace = targetFace;
+	fields.vectorObject = vectorObject;
+	fields.isAddition = isAddition;
+	fields.isSubtraction = isSubtraction;
+	return FeatureContentStore::GetInstance().Intern(extrudeKind, fields);
+}
+
+Application::Extrude::Extrude(double distance, InternedStringId targetFace, InternedStringId vectorObject, bool isAddition, bool isSubtraction, int guid)
+	: Application::IExtrude(guid), m_fields(InternExtrudeFields(distance, targetFace, vectorObject, isAddition, isSubtraction))
+{
+
+}
+
+Application::Extrude* Application::Extrude::FromText(std::string_view distance, std::string_view targetFace, std::string_view vectorObject,
+	std::string_view isAddition, std::string_view isSubtraction, int guid)
+{
+	double distanceValue = parseDoubleField(Extrude_DistanceToken, distance);
+	bool isAdditionValue = parseBoolField(Extrude_IsAdditionToken, isAddition);
+	bool isSubtractionValue = parseBoolField(Extrude_IsSubtractionToken, isSubtraction);
+
+	StringInterner& interner = StringInterner::GetInstance();
+	return new Extrude(distanceValue, interner.Intern(targetFace), interner.Intern(vectorObject), isAdditionValue, isSubtractionValue, guid);
+}
+
+std::string Application::Extrude::GetVersion()
+{
+	return "3";
+}
+
+std::string_view Application::Extrude::GetTargetFaceName() const
+{
+	return StringInterner::GetInstance().GetString(m_fields->targetFace);
+}
+
+std::string_view Application::Extrude::GetVectorObjectName() const
+{
+	return StringInterner::GetInstance().GetString(m_fields->vectorObject);
+}
+
+void Application::Extrude::WriteFeature(std::string& out)
+{
+	out.append(FeatureToken).append("Extrude\n");
+	out.append(Extrude_VersionToken).append(GetVersion()).append("\n");
+	appendDouble(out.append(Extrude_DistanceToken), m_fields->distance);
+	out.append("\n");
+	out.append(Extrude_TargetFaceToken).append(GetTargetFaceName()).append("\n");
+	out.append(Extrude_VectorToken).append(GetVectorObjectName()).append("\n");
+	out.append(Extrude_IsAdditionToken).append(boolToString(m_fields->isAddition)).append("\n");
+	out.append(Extrude_IsSubtractionToken).append(boolToString(m_fields->isSubtraction)).append("\n");
+	out.append(Extrude_GuidToken).append(std::to_string(m_guid)).append("\n");
+	out.append(EndFeatureToken).append("\n");
+}
+
+bool Application::Extrude::CopyFieldsFrom(const Feature& other)
+{
+	const Extrude* extrude = dynamic_cast<const Extrude*>(&other);
+	if (extrude == nullptr)
+	{
+		return false;
+	}
+	if (m_fields != extrude->m_fields)
+	{
+		m_fields = extrude->m_fields;
+		MarkDirty();
+	}
+	return true;
+}
+
+void Application::Extrude::SetDistance(double distance)
+{
+	m_fields = InternExtrudeFields(distance, m_fields->targetFace, m_fields->vectorObject, m_fields->isAddition, m_fields->isSubtraction);
+	MarkDirty();
+}
+
+void Application::Extrude::SetTargetFace(std::string_view targetFace)
+{
+	InternedStringId targetFaceId = StringInterner::GetInstance().Intern(targetFace);
+	m_fields = InternExtrudeFields(m_fields->distance, targetFaceId, m_fields->vectorObject, m_fields->isAddition, m_fields->isSubtraction);
+	MarkDirty();
+}
+
+void Application::Extrude::SetVectorObject(std::string_view vectorObject)
+{
+	InternedStringId vectorObjectId = StringInterner::GetInstance().Intern(vectorObject);
+	m_fields = InternExtrudeFields(m_fields->distance, m_fields->targetFace, vectorObjectId, m_fields->isAddition, m_fields->isSubtraction);
+	MarkDirty();
+}
+
+void Application::Extrude::SetIsAddition(bool isAddition)
+{
+	m_fields = InternExtrudeFields(m_fields->distance, m_fields->targetFace, m_fields->vectorObject, isAddition, m_fields->isSubtraction);
+	MarkDirty();
+}
+
+void Application::Extrude::SetIsSubtraction(bool isSubtraction)
+{
+	m_fields = InternExtrudeFields(m_fields->distance, m_fields->targetFace, m_fields->vectorObject, m_fields->isAddition, isSubtraction);
+	MarkDirty();
+}
+
+bool Application::ParseExtrudeBooleanType(std::string_view text, ExtrudeBooleanType& booleanType)
+{
+	if (text == "Intersect")
+	{
+		booleanType = ExtrudeBooleanType::Intersect;
+	}
+	else if (text == "Unite")
+	{
+		booleanType = ExtrudeBooleanType::Unite;
+	}
+	else if (text == "Subtract")
+	{
+		booleanType = ExtrudeBooleanType::Subtract;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+Application::ExtrudeBooleanType Application::ParseExtrudeBooleanTypeField(std::string_view text)
+{
+	ExtrudeBooleanType booleanType = ExtrudeBooleanType::Unspecified;
+	if (!text.empty() && !ParseExtrudeBooleanType(text, booleanType))
+	{
+		std::string msg = std::string(Extrude_BooleanToken) + std::string(text) + " is not Intersect, Unite or Subtract";
+		throw std::exception(msg.c_str());
+	}
+	return booleanType;
+}
+
+std::string_view Application::ExtrudeBooleanTypeToString(ExtrudeBooleanType booleanType)
+{
+	switch (booleanType)
+	{
+	case ExtrudeBooleanType::Intersect:
+		return "Intersect";
+	case ExtrudeBooleanType::Unite:
+		return "Unite";
+	case ExtrudeBooleanType::Subtract:
+		return "Subtract";
+	default:
+		return std::string_view();
+	}
+}
+
+void ReadInExtrude(std::ifstream& streamObject)
+{
+
+	std::cout << "    ProcessExtrude" << std::endl;
+	std::string line;
+	getline(streamObject, line);
+
+	GuidObject* extrudeReadIn = nullptr;
+
+	std::string version = line.substr(Extrude_VersionToken.size(), line.size() - Extrude_VersionToken.size());
+	std::cout << "    " << Extrude_VersionToken << " " << version << std::endl;
+
+	std::string ExtrudeVersionToken = "Extrude" + version;
+
+	dataReaderFunction readerFunc = nullptr;
+
+	readerFunc = DataObjectReader::GetInstance().GetReader(ExtrudeVersionToken);
+
+	if (readerFunc != nullptr)
+	{
+		extrudeReadIn = readerFunc(streamObject);
+	}
+
+	// the stream readers only trace the part, nothing keeps the feature
+	delete VersionUpToLatestExtrude(version, extrudeReadIn);
+}
+
+GuidObject* ReadInExtrude(PartFileTokenizer& tokenizer)
+{
+	std::string_view line;
+	tokenizer.NextLine(line);
+
+	GuidObject* extrudeReadIn = nullptr;
+
+	std::string_view version = PartFileTokenizer::TokenValue(line, Extrude_VersionToken);
+
+	// "Extrude" plus the version stays inside the small string buffer, no heap allocation
+	std::string ExtrudeVersionToken("Extrude");
+	ExtrudeVersionToken.append(version);
+
+	// older versions read straight into the latest Extrude when they can, one allocation and no Extrude2
+	DataObjectReader& dataReader = DataObjectReader::GetInstance();
+	dataViewReaderFunction latestReaderFunc = dataReader.GetLatestViewReader(ExtrudeVersionToken);
+	if (latestReaderFunc != nullptr)
+	{
+		return dynamic_cast<Application::Extrude*>(latestReaderFunc(tokenizer));
+	}
+
+	dataViewReaderFunction readerFunc = dataReader.GetViewReader(ExtrudeVersionToken);
+
+	if (readerFunc != nullptr)
+	{
+		extrudeReadIn = readerFunc(tokenizer);
+	}
+
+	return VersionUpToLatestExtrude(version, extrudeReadIn);
+}
+
+static Application::Extrude* VersionUpToLatestExtrude(std::string_view version, GuidObject* extrudeReadIn)
+{
+	// whatever was read is owned here, only the latest version leaves
+	std::unique_ptr<GuidObject> readIn(extrudeReadIn);
+
+	Application::Extrude* latest = dynamic_cast<Application::Extrude*>(extrudeReadIn);
+	if (latest != nullptr)
+	{
+		readIn.release();
+		return latest;
+	}
+
+	if (version == "2")
+	{
+		Application::Extrude2* extrudeVersion2 = dynamic_cast<Application::Extrude2*>(extrudeReadIn);
+		if (extrudeVersion2 != nullptr)
+		{
+			return VersionUpExtrudeVersion2(extrudeVersion2);
+		}
+	}
+	return nullptr;
+}
+
+GuidObject * ReadExtrudeVersion2(std::ifstream& streamObject)
+{
+	std::string line;
+
+	std::string distance;
+	std::string targetFace;
+	std::string vectorObject;
+	std::string booleanType;
+	int guid = -1;
+
+	bool done = false;
+	while (!done)
+	{
+		getline(streamObject, line);
+		std::cout << line << '\n';
+
+
+
+		if (startsWith(line, EndFeatureToken))
+		{
+			done = true;
+		}
+
+		else if (startsWith(line, Extrude_DistanceToken))
+		{
+			distance = line.substr(Extrude_DistanceToken.size(), line.size() - Extrude_DistanceToken.size());
+			std::cout << "    " << Extrude_DistanceToken << " " << distance << std::endl;
+		}
+		else if (startsWith(line, Extrude_TargetFaceToken))
+		{
+			targetFace = line.substr(Extrude_TargetFaceToken.size(), line.size() - Extrude_TargetFaceToken.size());
+			std::cout << "    " << Extrude_TargetFaceToken << " " << targetFace << std::endl;
+		}
+		else if (startsWith(line, Extrude_VectorToken))
+		{
+			vectorObject = line.substr(Extrude_VectorToken.size(), line.size() - Extrude_VectorToken.size());
+			std::cout << "    " << Extrude_VectorToken << " " << vectorObject << std::endl;
+		}
+		else if (startsWith(line, Extrude_BooleanToken))
+		{
+			booleanType = line.substr(Extrude_BooleanToken.size(), line.size() - Extrude_BooleanToken.size());
+			std::cout << "    " << Extrude_BooleanToken << " " << booleanType << std::endl;
+		}
+		else if (startsWith(line, Extrude_GuidToken))
+		{
+			parseInt(std::string_view(line).substr(Extrude_GuidToken.size()), guid);
+			std::cout << "    " << Extrude_GuidToken << " " << guid << std::endl;
+		}
+
+	}
+
+	RequireExtrudeVersion2Fields(distance, targetFace, vectorObject, booleanType);
+
+	return Application::Extrude2::FromText(distance, targetFace, vectorObject, booleanType, guid);
+
+}
+
+
+GuidObject* ReadExtrudeVersion3(std::ifstream& streamObject)
+{
+	std::string line;
+
+	std::string distance;
+	std::string targetFace;
+	std::string vectorObject;
+	std::string isAddition;
+	std::string isSubtraction;
+	int guid = -1;
+
+	bool done = false;
+	while (!done && getline(streamObject, line))
+	{
+		std::cout << line << '\n';
+
+		if (startsWith(line, EndFeatureToken))
+		{
+			done = true;
+		}
+		else if (startsWith(line, Extrude_DistanceToken))
+		{
+			distance = line.substr(Extrude_DistanceToken.size(), line.size() - Extrude_DistanceToken.size());
+		}
+		else if (startsWith(line, Extrude_TargetFaceToken))
+		{
+			targetFace = line.substr(Extrude_TargetFaceToken.size(), line.size() - Extrude_TargetFaceToken.size());
+		}
+		else if (startsWith(line, Extrude_VectorToken))
+		{
+			vectorObject = line.substr(Extrude_VectorToken.size(), line.size() - Extrude_VectorToken.size());
+		}
+		else if (startsWith(line, Extrude_IsAdditionToken))
+		{
+			isAddition = line.substr(Extrude_IsAdditionToken.size(), line.size() - Extrude_IsAdditionToken.size());
+		}
+		else if (startsWith(line, Extrude_IsSubtractionToken))
+		{
+			isSubtraction = line.substr(Extrude_IsSubtractionToken.size(), line.size() - Extrude_IsSubtractionToken.size());
+		}
+		else if (startsWith(line, Extrude_GuidToken))
+		{
+			parseInt(std::string_view(line).substr(Extrude_GuidToken.size()), guid);
+		}
+	}
+
+	return Application::Extrude::FromText(distance, targetFace, vectorObject, isAddition, isSubtraction, guid);
+}
+
+namespace
+{
+	// Field text of a version 2 Feature:Extrude block, views into the part
+	struct ExtrudeVersion2Fields
+	{
+		std::string_view distance;
+		std::string_view targetFace;
+		std::string_view vectorObject;
+		std::string_view booleanType;
+		int guid = -1;
+	};
+}
+
+static void ReadExtrudeVersion2Fields(PartFileTokenizer& tokenizer, ExtrudeVersion2Fields& fields)
+{
+	std::string_view line;
+	std::string_view value;
+	bool done = false;
+	while (!done && tokenizer.NextLine(line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::EndFeature:
+			done = true;
+			break;
+		case PartFileKey::Extrude_Distance:
+			fields.distance = value;
+			break;
+		case PartFileKey::Extrude_TargetFace:
+			fields.targetFace = value;
+			break;
+		case PartFileKey::Extrude_Vector:
+			fields.vectorObject = value;
+			break;
+		case PartFileKey::Extrude_Boolean:
+			fields.booleanType = value;
+			break;
+		case PartFileKey::Extrude_Guid:
+			parseInt(value, fields.guid);
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+// The version 2 writer always wrote these, a block missing one was cut short or edited by hand.  The guid may be missing
+static void RequireExtrudeVersion2Fields(std::string_view distance, std::string_view targetFace, std::string_view vectorObject,
+	std::string_view booleanType)
+{
+	const std::pair<std::string_view, std::string_view> requiredFields[] =
+	{
+		{ Extrude_DistanceToken, distance },
+		{ Extrude_TargetFaceToken, targetFace },
+		{ Extrude_VectorToken, vectorObject },
+		{ Extrude_BooleanToken, booleanType },
+	};
+	for (const std::pair<std::string_view, std::string_view>& field : requiredFields)
+	{
+		if (field.second.empty())
+		{
+			std::string msg = "Feature:Extrude version 2 has no " + std::string(field.first);
+			throw std::exception(msg.c_str());
+		}
+	}
+}
+
+GuidObject* ReadExtrudeVersion2View(PartFileTokenizer& tokenizer)
+{
+	ExtrudeVersion2Fields fields;
+	ReadExtrudeVersion2Fields(tokenizer, fields);
+	RequireExtrudeVersion2Fields(fields.distance, fields.targetFace, fields.vectorObject, fields.booleanType);
+
+	return Application::Extrude2::FromText(fields.distance, fields.targetFace, fields.vectorObject, fields.booleanType, fields.guid);
+}
+
+// Version 2 text straight into a version 3 Extrude, the same rules as VersionUpExtrudeVersion2
+// applied to each field as it is parsed
+GuidObject* ReadExtrudeVersion2AsLatestView(PartFileTokenizer& tokenizer)
+{
+	ExtrudeVersion2Fields fields;
+	ReadExtrudeVersion2Fields(tokenizer, fields);
+	RequireExtrudeVersion2Fields(fields.distance, fields.targetFace, fields.vectorObject, fields.booleanType);
+
+	double distance = parseDoubleField(Extrude_DistanceToken, fields.distance);
+	Application::ExtrudeBooleanType booleanType = Application::ParseExtrudeBooleanTypeField(fields.booleanType);
+
+	bool isAddition = false;
+	bool isSubtraction = false;
+	VersionUpExtrudeBooleanType(booleanType, isAddition, isSubtraction);
+
+	StringInterner& interner = StringInterner::GetInstance();
+	return new Application::Extrude(distance, interner.Intern(fields.targetFace), interner.Intern(fields.vectorObject),
+		isAddition, isSubtraction, fields.guid);
+}
+
+GuidObject* ReadExtrudeVersion3View(PartFileTokenizer& tokenizer)
+{
+	std::string_view line;
+
+	std::string_view distance;
+	std::string_view targetFace;
+	std::string_view vectorObject;
+	std::string_view isAddition;
+	std::string_view isSubtraction;
+	int guid = -1;
+
+	std::string_view value;
+	bool done = false;
+	while (!done && tokenizer.NextLine(line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::EndFeature:
+			done = true;
+			break;
+		case PartFileKey::Extrude_Distance:
+			distance = value;
+			break;
+		case PartFileKey::Extrude_TargetFace:
+			targetFace = value;
+			break;
+		case PartFileKey::Extrude_Vector:
+			vectorObject = value;
+			break;
+		case PartFileKey::Extrude_IsAddition:
+			isAddition = value;
+			break;
+		case PartFileKey::Extrude_IsSubtraction:
+			isSubtraction = value;
+			break;
+		case PartFileKey::Extrude_Guid:
+			parseInt(value, guid);
+			break;
+		default:
+			break;
+		}
+	}
+
+	return Application::Extrude::FromText(distance, targetFace, vectorObject, isAddition, isSubtraction, guid);
+}
+
+
+Application::Extrude* VersionUpExtrudeVersion2(Application::Extrude2 * oldFeature)
+{
+	Application::Extrude* retval = nullptr;
+
+	//Old Items
+	const double distance = oldFeature->GetDistance();
+	const InternedStringId targetFace = oldFeature->GetTargetFace();
+	const InternedStringId vectorObject = oldFeature->GetVectorObject();
+	const Application::ExtrudeBooleanType booleanType = oldFeature->GetBooleanType();
+	int guid = oldFeature->GetGuid();
+
+	//New Items
+	bool isAddition = false;
+	bool isSubtraction = false;
+	VersionUpExtrudeBooleanType(booleanType, isAddition, isSubtraction);
+
+	retval = new Application::Extrude(distance, targetFace, vectorObject, isAddition, isSubtraction, guid);
+
+	return retval;
+
+}
+
+// Extrude_Boolean of version 2 became Extrude_IsAddition and Extrude_IsSubtraction in version 3
+static void VersionUpExtrudeBooleanType(Application::ExtrudeBooleanType booleanType, bool& isAddition, bool& isSubtraction)
+{
+	if (booleanType == Application::ExtrudeBooleanType::Intersect)
+	{
+		isAddition = true;
+		isSubtraction = false;
+	}
+	else
+	{
+		throw std::exception("NIY");
+	}
+}
+
+static GuidObject* VersionUpExtrude2(GuidObject* oldObject)
+{
+	Application::Extrude2* extrudeVersion2 = dynamic_cast<Application::Extrude2*>(oldObject);
+	if (extrudeVersion2 == nullptr)
+	{
+		throw std::exception("Extrude2 version up given a different feature");
+	}
+	return VersionUpExtrudeVersion2(extrudeVersion2);
+}
+
+static void WriteExtrudeVersion3(GuidObject* object, std::string& out)
+{
+	Application::Extrude* extrude = dynamic_cast<Application::Extrude*>(object);
+	if (extrude == nullptr)
+	{
+		throw std::exception("Extrude3 writer given a different feature");
+	}
+	extrude->WriteFeature(out);
+}
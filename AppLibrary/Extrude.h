@@ -1,67 +1,133 @@
-#pragma once
-#include "AppFeaturesOpsExports.h"
-#include "Feature.h"
-#include <iostream>
-#include <fstream>
-#include "..\Core\GuidObject.h"
-
-void ReadInExtrude(std::ifstream& streamObject);
-
-namespace Application
-{
-	class APPLIBRARY_API IExtrude : public GuidObject
-	{
-	public:
-		virtual std::string GetVersion() = 0;
-		IExtrude(int guid) : GuidObject(guid)
-		{
-
-		}
-	};
-
-
-	class APPLIBRARY_API Extrude : public Application::Feature, public IExtrude
-	{
-	public:
-		Extrude() = delete;
-		Extrude(std::string distance, std::string targetFace, std::string vectorObject, std::string isAddition, std::string isSubtraction, int m_guid);
-		std::string GetVersion() override;
-		virtual ~Extrude()
-		{
-
-		}
-
-		const std::string& GetDistance()
-		{
-			return m_distance;
-		};
-		const std::string& GetTargetFace()
-		{
-			return m_targetFace;
-		};
-		const std::string& GetVectorObject()
-		{
-			return m_vectorObject;
-		};
-		const std::string& GetIsAddition()
-		{
-			return m_isAddition;
-		};
-		const std::string& GetIsSubtraction()
-		{
-			return m_isSubtraction;
-		};
-
-	private:
-		std::string m_distance;
-		std::string m_targetFace;
-		std::string m_vectorObject;
-		std::string m_isAddition;
-		std::string m_isSubtraction;
-	};
-}
-
-
-
-
-
+#pragma once
+#include "AppFeaturesOpsExports.h"
+#include "Feature.h"
+#include <iostream>
+#include <fstream>
+#include <cstdint>
+#include <string_view>
+#include "..\Core\GuidObject.h"
+#include "..\Core\StringInterner.h"
+
+class PartFileTokenizer;
+
+void ReadInExtrude(std::ifstream& streamObject);
+GuidObject* ReadInExtrude(PartFileTokenizer& tokenizer);
+
+namespace Application
+{
+	class APPLIBRARY_API IExtrude : public GuidObject
+	{
+	public:
+		virtual std::string GetVersion() = 0;
+		IExtrude(int guid) : GuidObject(guid)
+		{
+
+		}
+	};
+
+
+	/// <summary>
+	/// The Extrude_Boolean values of version 2 extrudes.
+	/// </summary>
+	enum class ExtrudeBooleanType : uint8_t
+	{
+		Unspecified,
+		Intersect,
+		Unite,
+		Subtract,
+	};
+
+	APPLIBRARY_API bool ParseExtrudeBooleanType(std::string_view text, ExtrudeBooleanType& booleanType);
+	// Empty text is Unspecified, other text that does not parse throws std::exception
+	APPLIBRARY_API ExtrudeBooleanType ParseExtrudeBooleanTypeField(std::string_view text);
+	APPLIBRARY_API std::string_view ExtrudeBooleanTypeToString(ExtrudeBooleanType booleanType);
+
+	/// <summary>
+	/// The field values of a latest version Extrude, one shared copy per distinct set in the FeatureContentStore.
+	/// </summary>
+	struct ExtrudeFields
+	{
+		double distance;
+		InternedStringId targetFace;
+		InternedStringId vectorObject;
+		bool isAddition;
+		bool isSubtraction;
+		uint8_t reserved[6]; /** Always zero, spelled out so the payload has no padding bytes. */
+	};
+	static_assert(sizeof(ExtrudeFields) == 24, "ExtrudeFields is compared as bytes and must have no padding");
+
+	/// <summary>
+	/// Fields are held typed, the text form is only made by WriteFeature and the other
+	/// serialization edges.  A distance that was never given is NaN and writes back empty.
+	/// Extrudes with the same fields share one ExtrudeFields, each keeps only its guid and a pointer to it.
+	/// </summary>
+	class APPLIBRARY_API Extrude : public Application::Feature, public IExtrude
+	{
+	public:
+		Extrude() = delete;
+		Extrude(double distance, InternedStringId targetFace, InternedStringId vectorObject, bool isAddition, bool isSubtraction, int m_guid);
+
+		/// <summary>
+		/// Builds an extrude from the field text of a version 3 Feature:Extrude block.
+		/// </summary>
+		static Extrude* FromText(std::string_view distance, std::string_view targetFace, std::string_view vectorObject,
+			std::string_view isAddition, std::string_view isSubtraction, int guid);
+
+		std::string GetVersion() override;
+		void WriteFeature(std::string& out) override;
+		bool CopyFieldsFrom(const Feature& other) override;
+		virtual ~Extrude()
+		{
+
+		}
+
+		double GetDistance() const
+		{
+			return m_fields->distance;
+		};
+		InternedStringId GetTargetFace() const
+		{
+			return m_fields->targetFace;
+		};
+		InternedStringId GetVectorObject() const
+		{
+			return m_fields->vectorObject;
+		};
+		bool GetIsAddition() const
+		{
+			return m_fields->isAddition;
+		};
+		bool GetIsSubtraction() const
+		{
+			return m_fields->isSubtraction;
+		};
+
+		/// <summary>
+		/// The setters swap in the shared payload for the new values and mark the extrude dirty.
+		/// </summary>
+		void SetDistance(double distance);
+		void SetTargetFace(std::string_view targetFace);
+		void SetVectorObject(std::string_view vectorObject);
+		void SetIsAddition(bool isAddition);
+		void SetIsSubtraction(bool isSubtraction);
+
+		/// <summary>
+		/// The shared payload, equal for every extrude with the same fields.
+		/// </summary>
+		const ExtrudeFields* GetFields() const
+		{
+			return m_fields;
+		};
+
+		std::string_view GetTargetFaceName() const;
+		std::string_view GetVectorObjectName() const;
+
+	private:
+		const ExtrudeFields* m_fields;
+	};
+}
+
+
+
+
+
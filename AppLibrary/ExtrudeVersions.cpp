@@ -1,13 +1,37 @@
-#include "ExtrudeVersions.h"
-
-
-Application::Extrude2::Extrude2(std::string distance, std::string targetFace, std::string vectorObject, std::string booleanType, int guid)
-	: Application::IExtrude(guid) ,m_distance(distance), m_targetFace(targetFace), m_vectorObject(vectorObject), m_booleanType(booleanType)
-{
-
-}
-
-std::string Application::Extrude2::GetVersion()
-{
-	return "2";
+#include "ExtrudeVersions.h"
+#include "..\Core\StringUtils.h"
+
+
+Application::Extrude2::Extrude2(double distance, InternedStringId targetFace, InternedStringId vectorObject, ExtrudeBooleanType booleanType, int guid)
+	: Application::IExtrude(guid) ,m_distance(distance), m_targetFace(targetFace), m_vectorObject(vectorObject), m_booleanType(booleanType)
+{
+
+}
+
+Application::Extrude2* Application::Extrude2::FromText(std::string_view distance, std::string_view targetFace, std::string_view vectorObject,
+	std::string_view booleanType, int guid)
+{
+	double distanceValue = parseDoubleField(Extrude_DistanceToken, distance);
+	ExtrudeBooleanType booleanTypeValue = ParseExtrudeBooleanTypeField(booleanType);
+
+	StringInterner& interner = StringInterner::GetInstance();
+	return new Extrude2(distanceValue, interner.Intern(targetFace), interner.Intern(vectorObject), booleanTypeValue, guid);
+}
+
+std::string Application::Extrude2::GetVersion()
+{
+	return "2";
+}
+
+void Application::Extrude2::WriteFeature(std::string& out)
+{
+	out.append(FeatureToken).append("Extrude\n");
+	out.append(Extrude_VersionToken).append(GetVersion()).append("\n");
+	appendDouble(out.append(Extrude_DistanceToken), m_distance);
+	out.append("\n");
+	out.append(Extrude_TargetFaceToken).append(StringInterner::GetInstance().GetString(m_targetFace)).append("\n");
+	out.append(Extrude_VectorToken).append(StringInterner::GetInstance().GetString(m_vectorObject)).append("\n");
+	out.append(Extrude_BooleanToken).append(ExtrudeBooleanTypeToString(m_booleanType)).append("\n");
+	out.append(Extrude_GuidToken).append(std::to_string(m_guid)).append("\n");
+	out.append(EndFeatureToken).append("\n");
 }
\ No newline at end of file
@@ -1,46 +1,56 @@
-#pragma once
-
-#include "Extrude.h"
-#include <string>
-namespace Application
-{
-	class Extrude2 : public Feature, public IExtrude
-	{
-	public:
-		Extrude2(std::string distance, std::string targetFace, std::string vectorObject, std::string booleanType, int m_guid);
-		std::string GetVersion() override;
-
-		virtual ~Extrude2()
-		{
-
-		}
-		Extrude2() = delete;
-
-		const std::string& GetDistance()
-		{
-			return m_distance;
-		};
-		const std::string& GetTargetFace()
-		{
-			return m_targetFace;
-		};
-		const std::string& GetVectorObject()
-		{
-			return m_vectorObject;
-		};
-		const std::string& GetBooleanType()
-		{
-			return m_booleanType;
-		};
-
-
-	private:
-		std::string m_distance;
-		std::string m_targetFace;
-		std::string m_vectorObject;
-		std::string m_booleanType;
-
-	};
-}
-
-
+#pragma once
+
+#include "Extrude.h"
+#include <string>
+namespace Application
+{
+	class Extrude2 : public Feature, public IExtrude
+	{
+	public:
+		Extrude2(double distance, InternedStringId targetFace, InternedStringId vectorObject, ExtrudeBooleanType booleanType, int m_guid);
+
+		/// <summary>
+		/// Builds an extrude from the field text of a version 2 Feature:Extrude block.
+		/// </summary>
+		static Extrude2* FromText(std::string_view distance, std::string_view targetFace, std::string_view vectorObject,
+			std::string_view booleanType, int guid);
+
+		std::string GetVersion() override;
+
+		/// <summary>
+		/// Appends the extrude as version 2 text, which reads back into the latest version.
+		/// </summary>
+		void WriteFeature(std::string& out) override;
+
+		virtual ~Extrude2()
+		{
+
+		}
+		Extrude2() = delete;
+
+		double GetDistance() const
+		{
+			return m_distance;
+		};
+		InternedStringId GetTargetFace() const
+		{
+			return m_targetFace;
+		};
+		InternedStringId GetVectorObject() const
+		{
+			return m_vectorObject;
+		};
+		ExtrudeBooleanType GetBooleanType() const
+		{
+			return m_booleanType;
+		};
+
+
+	private:
+		double m_distance;
+		InternedStringId m_targetFace;
+		InternedStringId m_vectorObject;
+		ExtrudeBooleanType m_booleanType;
+
+	};
+}
@@ -1,18 +1,82 @@
-#include "Feature.h"
-#include "Block.h"
-#include "Extrude.h"
-
-
-void ProcessFeature(std::string featureType, std::ifstream& streamObject)
-{
-
-	if (featureType == "Extrude")
-	{
-		ReadInExtrude(streamObject);
-	}
-	else if (featureType == "Block")
-	{
-		ProcessBlock(streamObject);
-	}
-
-}
+#include "Feature.h"
+#include "Block.h"
+#include "Extrude.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PerfectHash.h"
+#include <mutex>
+#include <unordered_set>
+
+
+namespace
+{
+	struct FeatureReaders
+	{
+		void (*streamReader)(std::ifstream& streamObject);
+		GuidObject* (*viewReader)(PartFileTokenizer& tokenizer);
+	};
+}
+
+// One probe per feature whatever the number of types, add new feature types here
+static constexpr PerfectHashEntry<FeatureReaders> FeatureReaderEntries[] =
+{
+	{ "Extrude", { ReadInExtrude, ReadInExtrude } },
+	{ "Block", { ReadInBlock, ReadInBlock } },
+};
+
+static constexpr auto FeatureReaderMap = MakePerfectHashMap(FeatureReaderEntries);
+static_assert(FeatureReaderMap.IsPerfect(), "no perfect hash seed for the feature types");
+
+
+void ProcessFeature(std::string featureType, std::ifstream& streamObject)
+{
+	const FeatureReaders* readers = FeatureReaderMap.Find(featureType);
+	if (readers != nullptr)
+	{
+		readers->streamReader(streamObject);
+	}
+}
+
+GuidObject* ProcessFeature(std::string_view featureType, PartFileTokenizer& tokenizer)
+{
+	const FeatureReaders* readers = FeatureReaderMap.Find(featureType);
+	if (readers == nullptr)
+	{
+		return nullptr;
+	}
+	return readers->viewReader(tokenizer);
+}
+
+// The features edited since their last save, by address.  Readers build features on the ThreadPool, edits may come from any thread
+static std::mutex dirtyFeaturesMutex;
+static std::unordered_set<Application::Feature*> dirtyFeatures;
+
+Application::Feature::~Feature()
+{
+	MarkClean();
+}
+
+void Application::Feature::MarkDirty()
+{
+	std::lock_guard<std::mutex> lock(dirtyFeaturesMutex);
+	if (!m_dirty)
+	{
+		m_dirty = true;
+		dirtyFeatures.insert(this);
+	}
+}
+
+void Application::Feature::MarkClean()
+{
+	std::lock_guard<std::mutex> lock(dirtyFeaturesMutex);
+	if (m_dirty)
+	{
+		m_dirty = false;
+		dirtyFeatures.erase(this);
+	}
+}
+
+std::vector<Application::Feature*> Application::Feature::GetDirtyFeatures()
+{
+	std::lock_guard<std::mutex> lock(dirtyFeaturesMutex);
+	return std::vector<Feature*>(dirtyFeatures.begin(), dirtyFeatures.end());
+}
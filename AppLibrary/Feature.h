@@ -1,23 +1,72 @@
-#pragma once
-
-#include "AppFeaturesOpsExports.h"
-
-#include <iostream>
-#include <fstream>
-
-static std::string FeatureToken = "Feature:";
-static std::string EndFeatureToken = "EndFeature";
-
-
-APPLIBRARY_API void ProcessFeature(std::string featureType, std::ifstream& streamObject);
-
-namespace Application
-{
-	class APPLIBRARY_API Feature 
-	{
-		public:
-
-
-	};
-}
-
+#pragma once
+
+#include "AppFeaturesOpsExports.h"
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\PartFileWritable.h"
+
+
+class PartFileTokenizer;
+class GuidObject;
+
+APPLIBRARY_API void ProcessFeature(std::string featureType, std::ifstream& streamObject);
+// Returns the feature upgraded to the latest version, nullptr for types that have no object yet.
+// Only touches the tokenizer it is given, so spans of one file can be read on separate threads.
+APPLIBRARY_API GuidObject* ProcessFeature(std::string_view featureType, PartFileTokenizer& tokenizer);
+
+namespace Application
+{
+	class APPLIBRARY_API Feature : public IPartFileWritable
+	{
+		public:
+			virtual ~Feature();
+
+			/// <summary>
+			/// Appends the feature to out, Feature: line through EndFeature.  Every feature
+			/// type writes itself, SavePart has no fallback for one that cannot.
+			/// </summary>
+			void WriteFeature(std::string& out) override = 0;
+
+			/// <summary>
+			/// Takes other's field values, keeping this object and its guid, so pointers to it
+			/// stay valid.  Marks the feature dirty when a value changed.  False when other is
+			/// of another type, nothing is copied then.
+			/// </summary>
+			virtual bool CopyFieldsFrom(const Feature& other)
+			{
+				return false;
+			}
+
+			/// <summary>
+			/// Whether the feature changed since it was read or last saved.  The field setters
+			/// and CopyFieldsFrom set it, PartFile::SavePart writes the dirty features of its
+			/// part and clears it.  A feature as a reader builds it is clean.
+			/// </summary>
+			bool IsDirty() const
+			{
+				return m_dirty;
+			}
+			void MarkDirty();
+			void MarkClean();
+
+			/// <summary>
+			/// The dirty features of every part, SavePart picks out its own so a save costs
+			/// the size of the edit rather than the part.
+			/// </summary>
+			static std::vector<Feature*> GetDirtyFeatures();
+
+		protected:
+			Feature() : m_dirty(false)
+			{
+
+			}
+
+		private:
+			bool m_dirty;
+	};
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <cstdint>
+
+// On disk layout of the binary part file (.prtb).  Everything is little
+// endian and naturally aligned so a mapped file is used in place, there is
+// no parse step on open:
+//
+//   Header
+//   TocEntry[featureCount]          one per feature, in file order
+//   ExtrudeRecord[extrudeCount]     fixed layout records, grouped by type
+//   BlockRecord[blockCount]
+//   WireRecord[wireCount]
+//   string table                    field text referenced through StringRef
+//
+// Each section starts on an 8 byte boundary.  Records keep the field text
+// exactly as the text format holds it (including the feature version), so
+// converting between the two formats is lossless.
+//
+// From format version 2 the content is deduplicated: features with the same
+// field text share one record and equal strings share one string table entry.
+// A feature's guid is the one in its TocEntry, the guid in a shared record is
+// only the first feature's.
+
+namespace Application
+{
+	namespace BinaryPart
+	{
+		constexpr char Magic[4] = { 'P', 'R', 'T', 'B' };
+		constexpr uint32_t FormatVersion = 2;
+		constexpr uint32_t OldestFormatVersion = 1; /** Version 1 has a record per feature, it reads the same. */
+		constexpr uint32_t SectionAlignment = 8;
+
+		enum class FeatureType : uint16_t
+		{
+			Extrude = 1,
+			Block = 2,
+			Wire = 3
+		};
+
+		/// Offset is relative to the start of the string table.
+		struct StringRef
+		{
+			uint32_t offset;
+			uint32_t length;
+		};
+
+		/// Offset used for a field the feature did not have.
+		constexpr uint32_t NoStringOffset = 0xFFFFFFFF;
+		constexpr int32_t NoGuid = -1;
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t formatVersion;
+			uint32_t headerSize;
+			int32_t schemaVersion;
+			StringRef partFileName;
+			uint32_t featureCount;
+			uint32_t extrudeCount;
+			uint32_t blockCount;
+			uint32_t wireCount;
+			uint64_t tocOffset;
+			uint64_t extrudeOffset;
+			uint64_t blockOffset;
+			uint64_t wireOffset;
+			uint64_t stringTableOffset;
+			uint64_t stringTableSize;
+			uint64_t fileSize;
+		};
+		static_assert(sizeof(Header) == 96, "BinaryPart::Header layout changed");
+
+		struct TocEntry
+		{
+			uint16_t featureType;
+			uint16_t version;
+			int32_t guid;
+			uint32_t recordIndex; /** Index into the section of featureType, features may share a record. */
+		};
+		static_assert(sizeof(TocEntry) == 12, "BinaryPart::TocEntry layout changed");
+
+		struct ExtrudeRecord
+		{
+			int32_t guid;
+			StringRef distance;
+			StringRef targetFace;
+			StringRef vectorObject;
+			StringRef booleanType; /** Version 2 only. */
+			StringRef isAddition; /** Version 3 on. */
+			StringRef isSubtraction; /** Version 3 on. */
+		};
+		static_assert(sizeof(ExtrudeRecord) == 52, "BinaryPart::ExtrudeRecord layout changed");
+
+		struct BlockRecord
+		{
+			int32_t guid;
+			StringRef origin;
+			StringRef length;
+			StringRef width;
+			StringRef height;
+		};
+		static_assert(sizeof(BlockRecord) == 36, "BinaryPart::BlockRecord layout changed");
+
+		struct WireRecord
+		{
+			int32_t guid;
+			StringRef distance;
+		};
+		static_assert(sizeof(WireRecord) == 12, "BinaryPart::WireRecord layout changed");
+	}
+}
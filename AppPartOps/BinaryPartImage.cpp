@@ -0,0 +1,219 @@
+#include "BinaryPartImage.h"
+#include "PartFileConverter.h"
+#include <fstream>
+#include <cstring>
+#include "..\AppLibrary\Feature.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\StringUtils.h"
+
+using namespace Application;
+
+
+BinaryPartImage::BinaryPartImage(const std::string& partFilePath)
+	: m_mappedFile(new MappedFile(partFilePath)), m_data(nullptr), m_size(0), m_header(nullptr), m_toc(nullptr),
+	m_extrudes(nullptr), m_blocks(nullptr), m_wires(nullptr), m_stringTable(nullptr)
+{
+	try
+	{
+		if (!m_mappedFile->IsOpen())
+		{
+			throw std::exception("Unable to map binary part file");
+		}
+		m_data = m_mappedFile->Data();
+		m_size = m_mappedFile->Size();
+		Validate();
+	}
+	catch (...)
+	{
+		delete m_mappedFile;
+		throw;
+	}
+}
+
+BinaryPartImage::BinaryPartImage(const char* data, size_t size, std::shared_ptr<const void> owner)
+	: m_mappedFile(nullptr), m_owner(std::move(owner)), m_data(data), m_size(size), m_header(nullptr), m_toc(nullptr),
+	m_extrudes(nullptr), m_blocks(nullptr), m_wires(nullptr), m_stringTable(nullptr)
+{
+	Validate();
+}
+
+BinaryPartImage::~BinaryPartImage()
+{
+	delete m_mappedFile;
+}
+
+bool BinaryPartImage::IsBinaryPartFile(const std::string& partFilePath)
+{
+	char magic[sizeof(BinaryPart::Magic)] = { 0 };
+	std::ifstream partFile(partFilePath, std::ios::binary);
+	if (!partFile.read(magic, sizeof(magic)))
+	{
+		return false;
+	}
+	return memcmp(magic, BinaryPart::Magic, sizeof(magic)) == 0;
+}
+
+// A section is valid if it sits inside the file, starts aligned and holds count records
+static bool SectionFits(uint64_t offset, uint64_t count, uint64_t recordSize, uint64_t fileSize)
+{
+	if (offset % BinaryPart::SectionAlignment != 0 || offset > fileSize)
+	{
+		return false;
+	}
+	return count <= (fileSize - offset) / recordSize;
+}
+
+void BinaryPartImage::Validate()
+{
+	size_t fileSize = m_size;
+	const char* data = m_data;
+	if (fileSize < sizeof(BinaryPart::Header))
+	{
+		throw std::exception("Binary part file is truncated");
+	}
+
+	m_header = (const BinaryPart::Header*)data;
+	if (memcmp(m_header->magic, BinaryPart::Magic, sizeof(BinaryPart::Magic)) != 0)
+	{
+		throw std::exception("Not a binary part file");
+	}
+	if (m_header->formatVersion < BinaryPart::OldestFormatVersion || m_header->formatVersion > BinaryPart::FormatVersion
+		|| m_header->headerSize != sizeof(BinaryPart::Header))
+	{
+		throw std::exception("Unsupported binary part file version");
+	}
+	if (m_header->fileSize != fileSize)
+	{
+		throw std::exception("Binary part file is truncated");
+	}
+
+	if (!SectionFits(m_header->tocOffset, m_header->featureCount, sizeof(BinaryPart::TocEntry), fileSize) ||
+		!SectionFits(m_header->extrudeOffset, m_header->extrudeCount, sizeof(BinaryPart::ExtrudeRecord), fileSize) ||
+		!SectionFits(m_header->blockOffset, m_header->blockCount, sizeof(BinaryPart::BlockRecord), fileSize) ||
+		!SectionFits(m_header->wireOffset, m_header->wireCount, sizeof(BinaryPart::WireRecord), fileSize) ||
+		!SectionFits(m_header->stringTableOffset, m_header->stringTableSize, 1, fileSize))
+	{
+		throw std::exception("Binary part file section out of bounds");
+	}
+	// shared records leave fewer records than features
+	if ((uint64_t)m_header->extrudeCount + m_header->blockCount + m_header->wireCount > m_header->featureCount)
+	{
+		throw std::exception("Binary part file feature counts do not add up");
+	}
+
+	m_toc = (const BinaryPart::TocEntry*)(data + m_header->tocOffset);
+	m_extrudes = (const BinaryPart::ExtrudeRecord*)(data + m_header->extrudeOffset);
+	m_blocks = (const BinaryPart::BlockRecord*)(data + m_header->blockOffset);
+	m_wires = (const BinaryPart::WireRecord*)(data + m_header->wireOffset);
+	m_stringTable = data + m_header->stringTableOffset;
+}
+
+// Everything below is bounds checked on access rather than up front, keeping open O(1)
+
+const BinaryPart::TocEntry& BinaryPartImage::GetTocEntry(uint32_t index) const
+{
+	if (index >= m_header->featureCount)
+	{
+		throw std::exception("Binary part feature index out of range");
+	}
+	return m_toc[index];
+}
+
+const BinaryPart::ExtrudeRecord& BinaryPartImage::GetExtrude(uint32_t recordIndex) const
+{
+	if (recordIndex >= m_header->extrudeCount)
+	{
+		throw std::exception("Binary part Extrude record out of range");
+	}
+	return m_extrudes[recordIndex];
+}
+
+const BinaryPart::BlockRecord& BinaryPartImage::GetBlock(uint32_t recordIndex) const
+{
+	if (recordIndex >= m_header->blockCount)
+	{
+		throw std::exception("Binary part Block record out of range");
+	}
+	return m_blocks[recordIndex];
+}
+
+const BinaryPart::WireRecord& BinaryPartImage::GetWire(uint32_t recordIndex) const
+{
+	if (recordIndex >= m_header->wireCount)
+	{
+		throw std::exception("Binary part Wire record out of range");
+	}
+	return m_wires[recordIndex];
+}
+
+std::string_view BinaryPartImage::GetString(BinaryPart::StringRef ref) const
+{
+	if (!HasString(ref))
+	{
+		return std::string_view();
+	}
+	if ((uint64_t)ref.offset + ref.length > m_header->stringTableSize)
+	{
+		throw std::exception("Binary part string out of range");
+	}
+	return std::string_view(m_stringTable + ref.offset, ref.length);
+}
+
+void BinaryPartImage::IndexGuids() const
+{
+	std::call_once(m_guidsIndexed, [this]()
+	{
+		m_materialized.resize(m_header->featureCount, false);
+		m_guidToFeature.reserve(m_header->featureCount);
+		for (uint32_t i = 0; i < m_header->featureCount; i++)
+		{
+			const BinaryPart::TocEntry& tocEntry = m_toc[i];
+			if (tocEntry.guid != BinaryPart::NoGuid && (BinaryPart::FeatureType)tocEntry.featureType != BinaryPart::FeatureType::Wire)
+			{
+				m_guidToFeature[tocEntry.guid] = i;
+			}
+		}
+	});
+}
+
+uint32_t BinaryPartImage::FindFeatureIndex(int guid) const
+{
+	IndexGuids();
+	std::unordered_map<int, uint32_t>::const_iterator found = m_guidToFeature.find(guid);
+	return (found != m_guidToFeature.end()) ? found->second : NoFeature;
+}
+
+bool BinaryPartImage::IsMaterialized(int guid) const
+{
+	uint32_t index = FindFeatureIndex(guid);
+	return index != NoFeature && m_materialized[index];
+}
+
+GuidObject* BinaryPartImage::ReadFeature(uint32_t index) const
+{
+	// the record goes back through its text form so the readers and version ups of the text format apply unchanged
+	std::string text;
+	AppendBinaryFeatureAsText(text, *this, index);
+
+	PartFileTokenizer tokenizer(text.data(), text.size());
+	std::string_view line;
+	tokenizer.NextLine(line);
+	std::string_view featureToken = startsWith(line, RoutingFeatureToken) ? RoutingFeatureToken : FeatureToken;
+	return ProcessFeature(PartFileTokenizer::TokenValue(line, featureToken), tokenizer);
+}
+
+GuidObject* BinaryPartImage::MaterializeObject(int guid)
+{
+	uint32_t index = FindFeatureIndex(guid);
+	if (index == NoFeature || m_materialized[index])
+	{
+		return nullptr;
+	}
+
+	// only marked once read, a feature that failed to read is tried again on the next lookup
+	GuidObject* object = ReadFeature(index);
+	m_materialized[index] = true;
+	return object;
+}
@@ -0,0 +1,121 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include "BinaryPartFormat.h"
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "..\Core\GuidObject.h"
+
+class MappedFile;
+
+namespace Application
+{
+	/// <summary>
+	/// A binary part file (.prtb) mapped into memory.  The constructor only
+	/// checks the header and section bounds, records are read in place.
+	/// Throws std::exception if the file is not a valid binary part.
+	/// Registered with the GuidObjectManager it reads a feature through the
+	/// DataObjectReader readers the first time its guid is looked up, the same
+	/// as a LazyFeatureIndex does for a text part.
+	/// </summary>
+	class APPPARTOPS_API BinaryPartImage : public ILazyObjectSource
+	{
+	public:
+		BinaryPartImage(const std::string& partFilePath);
+
+		/// <summary>
+		/// An image already in memory, read in place.  owner keeps the bytes alive
+		/// for as long as the image, such as a SharedPartCache entry's lease.
+		/// </summary>
+		BinaryPartImage(const char* data, size_t size, std::shared_ptr<const void> owner);
+		virtual ~BinaryPartImage();
+
+		BinaryPartImage() = delete;
+		BinaryPartImage(const BinaryPartImage&) = delete;
+		BinaryPartImage& operator=(const BinaryPartImage&) = delete;
+
+		/// <summary>
+		/// Sniffs the magic number, false for text part files and missing files.
+		/// </summary>
+		static bool IsBinaryPartFile(const std::string& partFilePath);
+
+		/// <summary>
+		/// True for an image given in memory rather than mapped from a binary part file.
+		/// </summary>
+		bool IsInMemory() const
+		{
+			return m_mappedFile == nullptr;
+		}
+
+		const BinaryPart::Header& GetHeader() const
+		{
+			return *m_header;
+		}
+		std::string_view GetPartFileName() const
+		{
+			return GetString(m_header->partFileName);
+		}
+		int GetSchemaVersion() const
+		{
+			return m_header->schemaVersion;
+		}
+		uint32_t GetFeatureCount() const
+		{
+			return m_header->featureCount;
+		}
+
+		const BinaryPart::TocEntry& GetTocEntry(uint32_t index) const;
+		const BinaryPart::ExtrudeRecord& GetExtrude(uint32_t recordIndex) const;
+		const BinaryPart::BlockRecord& GetBlock(uint32_t recordIndex) const;
+		const BinaryPart::WireRecord& GetWire(uint32_t recordIndex) const;
+
+		bool HasString(BinaryPart::StringRef ref) const
+		{
+			return ref.offset != BinaryPart::NoStringOffset;
+		}
+		std::string_view GetString(BinaryPart::StringRef ref) const;
+
+		static const uint32_t NoFeature = (uint32_t)-1;
+
+		/// <summary>
+		/// Index of the last feature in the file with this guid, NoFeature if there is none.
+		/// Routing features are not indexed by guid.
+		/// </summary>
+		uint32_t FindFeatureIndex(int guid) const;
+
+		/// <summary>
+		/// Reads the feature at index up to its latest version into a new object the caller
+		/// owns, without handing it to the GuidObjectManager or counting it as materialized.
+		/// nullptr when there is no reader for it.
+		/// </summary>
+		GuidObject* ReadFeature(uint32_t index) const;
+
+		/// <summary>
+		/// True once the feature has been handed to the GuidObjectManager.
+		/// </summary>
+		bool IsMaterialized(int guid) const;
+
+		GuidObject* MaterializeObject(int guid) override;
+
+	private:
+		void Validate();
+		void IndexGuids() const;
+
+		MappedFile* m_mappedFile; /** nullptr for an image given in memory. */
+		std::shared_ptr<const void> m_owner;
+		const char* m_data;
+		size_t m_size;
+		const BinaryPart::Header* m_header;
+		const BinaryPart::TocEntry* m_toc;
+		const BinaryPart::ExtrudeRecord* m_extrudes;
+		const BinaryPart::BlockRecord* m_blocks;
+		const BinaryPart::WireRecord* m_wires;
+		const char* m_stringTable;
+		mutable std::once_flag m_guidsIndexed; /** The guids are indexed on the first lookup, opening stays O(1). */
+		mutable std::unordered_map<int, uint32_t> m_guidToFeature;
+		mutable std::vector<bool> m_materialized;
+	};
+}
@@ -0,0 +1,129 @@
+#include "BinaryPartWriter.h"
+#include "PartOpsInternal.h"
+#include <cstddef>
+#include <cstring>
+#include "..\Core\ContentHash.h"
+
+using namespace Application;
+
+static uint64_t AlignSection(uint64_t offset)
+{
+	return (offset + BinaryPart::SectionAlignment - 1) / BinaryPart::SectionAlignment * BinaryPart::SectionAlignment;
+}
+
+// The record bytes after the guid, which all a record holds besides its guid
+template <typename Record>
+static std::string_view RecordContent(const Record& record)
+{
+	static_assert(offsetof(Record, guid) == 0, "Binary part records start with their guid");
+	return std::string_view(reinterpret_cast<const char*>(&record) + sizeof(record.guid), sizeof(Record) - sizeof(record.guid));
+}
+
+template <typename Record>
+static void AddRecord(std::vector<BinaryPart::TocEntry>& toc, std::vector<Record>& section,
+	std::unordered_multimap<uint64_t, uint32_t>& recordsByContent, BinaryPart::FeatureType featureType, uint16_t version, const Record& record)
+{
+	// strings are shared already, so features with the same field text have byte equal records
+	std::string_view content = RecordContent(record);
+	uint64_t hash = HashContent(content.data(), content.size());
+	auto range = recordsByContent.equal_range(hash);
+	for (auto iterator = range.first; iterator != range.second; ++iterator)
+	{
+		if (RecordContent(section[iterator->second]) == content)
+		{
+			toc.push_back({ (uint16_t)featureType, version, record.guid, iterator->second });
+			return;
+		}
+	}
+
+	BinaryPart::TocEntry tocEntry = { (uint16_t)featureType, version, record.guid, (uint32_t)section.size() };
+	recordsByContent.emplace(hash, tocEntry.recordIndex);
+	toc.push_back(tocEntry);
+	section.push_back(record);
+}
+
+Application::BinaryPartWriter::BinaryPartWriter() : m_schemaVersion(-1)
+{
+	m_partFileName = { BinaryPart::NoStringOffset, 0 };
+}
+
+BinaryPart::StringRef Application::BinaryPartWriter::AddString(std::string_view text)
+{
+	uint64_t hash = HashContent(text.data(), text.size());
+	auto range = m_stringsByContent.equal_range(hash);
+	for (auto iterator = range.first; iterator != range.second; ++iterator)
+	{
+		BinaryPart::StringRef ref = iterator->second;
+		if (std::string_view(m_strings).substr(ref.offset, ref.length) == text)
+		{
+			return ref;
+		}
+	}
+
+	BinaryPart::StringRef ref = { (uint32_t)m_strings.size(), (uint32_t)text.size() };
+	m_strings.append(text);
+	m_stringsByContent.emplace(hash, ref);
+	return ref;
+}
+
+void Application::BinaryPartWriter::SetPartFileName(std::string_view partFileName)
+{
+	m_partFileName = AddString(partFileName);
+}
+
+void Application::BinaryPartWriter::SetSchemaVersion(int32_t schemaVersion)
+{
+	m_schemaVersion = schemaVersion;
+}
+
+void Application::BinaryPartWriter::AddFeature(uint16_t version, const BinaryPart::ExtrudeRecord& record)
+{
+	AddRecord(m_toc, m_extrudes, m_extrudesByContent, BinaryPart::FeatureType::Extrude, version, record);
+}
+
+void Application::BinaryPartWriter::AddFeature(uint16_t version, const BinaryPart::BlockRecord& record)
+{
+	AddRecord(m_toc, m_blocks, m_blocksByContent, BinaryPart::FeatureType::Block, version, record);
+}
+
+void Application::BinaryPartWriter::AddFeature(uint16_t version, const BinaryPart::WireRecord& record)
+{
+	AddRecord(m_toc, m_wires, m_wiresByContent, BinaryPart::FeatureType::Wire, version, record);
+}
+
+std::vector<char> Application::BinaryPartWriter::GetImage() const
+{
+	BinaryPart::Header header = {};
+	memcpy(header.magic, BinaryPart::Magic, sizeof(header.magic));
+	header.formatVersion = BinaryPart::FormatVersion;
+	header.headerSize = sizeof(BinaryPart::Header);
+	header.schemaVersion = m_schemaVersion;
+	header.partFileName = m_partFileName;
+	header.featureCount = (uint32_t)m_toc.size();
+	header.extrudeCount = (uint32_t)m_extrudes.size();
+	header.blockCount = (uint32_t)m_blocks.size();
+	header.wireCount = (uint32_t)m_wires.size();
+
+	header.tocOffset = AlignSection(sizeof(BinaryPart::Header));
+	header.extrudeOffset = AlignSection(header.tocOffset + m_toc.size() * sizeof(BinaryPart::TocEntry));
+	header.blockOffset = AlignSection(header.extrudeOffset + m_extrudes.size() * sizeof(BinaryPart::ExtrudeRecord));
+	header.wireOffset = AlignSection(header.blockOffset + m_blocks.size() * sizeof(BinaryPart::BlockRecord));
+	header.stringTableOffset = AlignSection(header.wireOffset + m_wires.size() * sizeof(BinaryPart::WireRecord));
+	header.stringTableSize = m_strings.size();
+	header.fileSize = header.stringTableOffset + header.stringTableSize;
+
+	std::vector<char> image((size_t)header.fileSize, '\0');
+	memcpy(image.data(), &header, sizeof(header));
+	memcpy(image.data() + header.tocOffset, m_toc.data(), m_toc.size() * sizeof(BinaryPart::TocEntry));
+	memcpy(image.data() + header.extrudeOffset, m_extrudes.data(), m_extrudes.size() * sizeof(BinaryPart::ExtrudeRecord));
+	memcpy(image.data() + header.blockOffset, m_blocks.data(), m_blocks.size() * sizeof(BinaryPart::BlockRecord));
+	memcpy(image.data() + header.wireOffset, m_wires.data(), m_wires.size() * sizeof(BinaryPart::WireRecord));
+	memcpy(image.data() + header.stringTableOffset, m_strings.data(), m_strings.size());
+	return image;
+}
+
+void Application::BinaryPartWriter::Write(const std::string& binaryPartPath) const
+{
+	std::vector<char> image = GetImage();
+	WriteFileAtomically(binaryPartPath, std::string_view(image.data(), image.size()));
+}
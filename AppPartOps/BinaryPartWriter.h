@@ -0,0 +1,55 @@
+#pragma once
+#include "BinaryPartFormat.h"
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Application
+{
+	/// <summary>
+	/// Collects the features of a binary part file (.prtb) in memory, in the
+	/// order they are added, and lays the sections out on Write.  Equal strings
+	/// and features with equal field text are stored once.
+	/// </summary>
+	class BinaryPartWriter
+	{
+	public:
+		BinaryPartWriter();
+
+		BinaryPart::StringRef AddString(std::string_view text);
+
+		void SetPartFileName(std::string_view partFileName);
+		void SetSchemaVersion(int32_t schemaVersion);
+
+		void AddFeature(uint16_t version, const BinaryPart::ExtrudeRecord& record);
+		void AddFeature(uint16_t version, const BinaryPart::BlockRecord& record);
+		void AddFeature(uint16_t version, const BinaryPart::WireRecord& record);
+
+		/// <summary>
+		/// The whole image laid out in memory, byte for byte what Write puts on disk.
+		/// </summary>
+		std::vector<char> GetImage() const;
+
+		/// <summary>
+		/// Writes the whole image to binaryPartPath through a temp file renamed over it, so a
+		/// reader sees the old file or the new one.  Throws std::exception if that fails.
+		/// </summary>
+		void Write(const std::string& binaryPartPath) const;
+
+	private:
+		BinaryPart::StringRef m_partFileName;
+		int32_t m_schemaVersion;
+		std::vector<BinaryPart::TocEntry> m_toc;
+		std::vector<BinaryPart::ExtrudeRecord> m_extrudes;
+		std::vector<BinaryPart::BlockRecord> m_blocks;
+		std::vector<BinaryPart::WireRecord> m_wires;
+		std::string m_strings;
+
+		// HashContent of the string or record content to where it is stored
+		std::unordered_multimap<uint64_t, BinaryPart::StringRef> m_stringsByContent;
+		std::unordered_multimap<uint64_t, uint32_t> m_extrudesByContent;
+		std::unordered_multimap<uint64_t, uint32_t> m_blocksByContent;
+		std::unordered_multimap<uint64_t, uint32_t> m_wiresByContent;
+	};
+}
@@ -1,7 +1,23 @@
-#pragma once
-
-struct PartOpsNotifierData
-{
-	std::string partName;
-	int guid;
-};
+#pragma once
+#include <string>
+#include <vector>
+
+struct PartOpsNotifierData
+{
+	std::string partName;
+	int guid;
+};
+
+// Sent with Observer::ReloadPart, observers that only know PartOpsNotifierData still read the part name and guid
+struct PartReloadNotifierData : PartOpsNotifierData
+{
+	std::vector<int> changedGuids; /** Patched in place, the objects observers hold stay valid. */
+	std::vector<int> addedGuids;
+	std::vector<int> removedGuids; /** No longer registered, the objects are not freed. */
+};
+
+// Sent with Observer::SavePart once the save is on disk, by SavePart itself or by the PartSaveQueue
+struct PartSaveNotifierData : PartOpsNotifierData
+{
+	size_t coalescedSaves; /** SavePart calls written out as the one delta log batch. */
+};
@@ -1,41 +1,58 @@
-#include "Journaling_Part.h"
-#include "..\Journaling\Journaling.h"
-#include "..\Journaling\JournalHelpers.h"
-
-void Journaling_Part_Save(Application::PartFile* partFile)
-{
-
-
-	//If Journaling write the thing things
-	if (IsJournaling())
-	{
-		JournalStartCall("Save", partFile);
-	}
-	partFile->SavePart();
-
-	if (IsJournaling())
-	{
-		JournalEndCall();
-	}
-
-}
-
-void Journaling_Part_MakeWidgetFeature(Application::PartFile* partFile, bool option1, int values)
-{
-
-	//If Journaling write the thing things
-	if (IsJournaling())
-	{
-		JournalStartCall("MakeWidgetFeature", partFile);
-		JournalBoolInParam(option1, "option1");
-		JournalIntInParam(values, "values");
-	}
-	partFile->MakeWidgetFeature(option1, values);
-
-	if (IsJournaling())
-	{
-		JournalEndCall();
-	}
-
-}
-
+#include "Journaling_Part.h"
+#include "..\Journaling\Journaling.h"
+#include "..\Journaling\JournalHelpers.h"
+
+void Journaling_Part_Save(Application::PartFile* partFile)
+{
+
+
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("Save", partFile);
+	}
+	partFile->SavePart();
+
+	if (IsJournaling())
+	{
+		JournalEndCall();
+	}
+
+}
+
+void Journaling_Part_Flush(Application::PartFile* partFile)
+{
+
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("Flush", partFile);
+	}
+	partFile->FlushSaves();
+
+	if (IsJournaling())
+	{
+		JournalEndCall();
+	}
+
+}
+
+void Journaling_Part_MakeWidgetFeature(Application::PartFile* partFile, bool option1, int values)
+{
+
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("MakeWidgetFeature", partFile);
+		JournalBoolInParam(option1, "option1");
+		JournalIntInParam(values, "values");
+	}
+	partFile->MakeWidgetFeature(option1, values);
+
+	if (IsJournaling())
+	{
+		JournalEndCall();
+	}
+
+}
+
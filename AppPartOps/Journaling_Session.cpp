@@ -1,45 +1,116 @@
-#include "Journaling_Session.h"
-#include "..\Journaling\Journaling.h"
-#include "..\Journaling\JournalHelpers.h"
-
-Application::PartFile* Journaling_Session_OpenPart(std::string partFilePath)
-{
-	//If Journaling write the thing things
-	if (IsJournaling())
-	{
-		JournalStartCall("OpenPart", CannedGlobals::SESSION);
-		JournalStringInParam(partFilePath, "partFilePath");
-	}
-	Application::PartFile* retVal = nullptr;
-	retVal = Application::PartFile::OpenPartFile(partFilePath);
-
-	if (IsJournaling())
-	{
-		JournalReturnClass(retVal, "AutomationAPI::Part", "Part");
-		JournalEndCall();
-	}
-
-	return retVal;
-
-}
-
-Application::PartFile* Journaling_Session_MakePart(std::string partFilePath)
-{
-	//If Journaling write the thing things
-	if (IsJournaling())
-	{
-		JournalStartCall("MakePart", CannedGlobals::SESSION);
-		JournalStringInParam(partFilePath, "partFilePath");
-	}
-	Application::PartFile* retVal = nullptr;
-	retVal = Application::PartFile::CreatePartFile(partFilePath);
-
-	if (IsJournaling())
-	{
-		JournalReturnClass(retVal, "AutomationAPI::Part", "Part");
-		JournalEndCall();
-	}
-
-	return retVal;
-
-}
+#include "Journaling_Session.h"
+#include "PartSaveQueue.h"
+#include "..\Core\PartFileWatcher.h"
+#include "..\Journaling\Journaling.h"
+#include "..\Journaling\JournalHelpers.h"
+
+Application::PartFile* Journaling_Session_OpenPart(std::string partFilePath)
+{
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("OpenPart", CannedGlobals::SESSION);
+		JournalStringInParam(partFilePath, "partFilePath");
+	}
+	Application::PartFile* retVal = nullptr;
+	retVal = Application::PartFile::OpenPartFile(partFilePath);
+
+	if (IsJournaling())
+	{
+		JournalReturnClass(retVal, "AutomationAPI::Part", "Part");
+		JournalEndCall();
+	}
+
+	return retVal;
+
+}
+
+Application::PartFile* Journaling_Session_MakePart(std::string partFilePath)
+{
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("MakePart", CannedGlobals::SESSION);
+		JournalStringInParam(partFilePath, "partFilePath");
+	}
+	Application::PartFile* retVal = nullptr;
+	retVal = Application::PartFile::CreatePartFile(partFilePath);
+
+	if (IsJournaling())
+	{
+		JournalReturnClass(retVal, "AutomationAPI::Part", "Part");
+		JournalEndCall();
+	}
+
+	return retVal;
+
+}
+
+void Journaling_Session_SetWriteBehindSaves(bool enabled)
+{
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("SetWriteBehindSaves", CannedGlobals::SESSION);
+		JournalBoolInParam(enabled, "enabled");
+	}
+	Application::PartSaveQueue::GetInstance().SetEnabled(enabled);
+
+	if (IsJournaling())
+	{
+		JournalEndCall();
+	}
+
+}
+
+void Journaling_Session_SaveBarrier()
+{
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("SaveBarrier", CannedGlobals::SESSION);
+	}
+	Application::PartSaveQueue::GetInstance().Barrier();
+
+	if (IsJournaling())
+	{
+		JournalEndCall();
+	}
+
+}
+
+void Journaling_Session_SetWatchForChanges(bool watchForChanges)
+{
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("SetWatchForChanges", CannedGlobals::SESSION);
+		JournalBoolInParam(watchForChanges, "watchForChanges");
+	}
+	Application::PartFile::SetWatchForChanges(watchForChanges);
+
+	if (IsJournaling())
+	{
+		JournalEndCall();
+	}
+
+}
+
+int Journaling_Session_DispatchChanges()
+{
+	//If Journaling write the thing things
+	if (IsJournaling())
+	{
+		JournalStartCall("DispatchChanges", CannedGlobals::SESSION);
+	}
+	int retVal = (int)PartFileWatcher::GetInstance().DispatchChanges();
+
+	if (IsJournaling())
+	{
+		JournalReturnInt(retVal, "changes");
+		JournalEndCall();
+	}
+
+	return retVal;
+
+}
@@ -1,9 +1,16 @@
-#pragma once
-#include "AppPartOpsExports.h"
-#include <string>
-#include "PartOps.h"
-
-extern APPPARTOPS_API Application::PartFile* Journaling_Session_MakePart(std::string);
-
-extern APPPARTOPS_API Application::PartFile* Journaling_Session_OpenPart(std::string);
-
+#pragma once
+#include "AppPartOpsExports.h"
+#include <string>
+#include "PartOps.h"
+
+extern APPPARTOPS_API Application::PartFile* Journaling_Session_MakePart(std::string);
+
+extern APPPARTOPS_API Application::PartFile* Journaling_Session_OpenPart(std::string);
+
+extern APPPARTOPS_API void Journaling_Session_SetWriteBehindSaves(bool enabled);
+
+extern APPPARTOPS_API void Journaling_Session_SaveBarrier();
+
+extern APPPARTOPS_API void Journaling_Session_SetWatchForChanges(bool watchForChanges);
+
+extern APPPARTOPS_API int Journaling_Session_DispatchChanges();
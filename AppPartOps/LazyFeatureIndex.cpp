@@ -0,0 +1,123 @@
+#include "LazyFeatureIndex.h"
+#include "PartArchive.h"
+#include "..\AppLibrary\Feature.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileIntegrity.h"
+#include "..\Core\PartFileTokenizer.h"
+
+Application::LazyFeatureIndex::LazyFeatureIndex(const std::string& partFilePath, bool verifyIntegrity)
+	: m_mappedFile(nullptr), m_data(nullptr), m_size(0), m_verifyIntegrity(verifyIntegrity)
+{
+	// a part in an archive is a slice of the archive's mapping, anything else gets its own
+	std::string archivePath;
+	std::string partName;
+	if (PartArchive::SplitArchivedPartPath(partFilePath, archivePath, partName))
+	{
+		m_archive = PartArchive::GetArchive(archivePath);
+		std::string_view part = m_archive->GetPart(partName);
+		m_data = part.data();
+		m_size = part.size();
+	}
+	else
+	{
+		m_mappedFile = new MappedFile(partFilePath);
+
+		// an unreadable part gives an empty index, the same as the eager readers which just read nothing
+		if (!m_mappedFile->IsOpen())
+		{
+			return;
+		}
+		m_data = m_mappedFile->Data();
+		m_size = m_mappedFile->Size();
+	}
+
+	m_layout = ScanPartFileLayout(m_data, m_size);
+	if (m_verifyIntegrity)
+	{
+		try
+		{
+			VerifyPartFileComplete(m_layout, m_size);
+		}
+		catch (...)
+		{
+			delete m_mappedFile;
+			throw;
+		}
+	}
+
+	m_materialized.resize(m_layout.features.size(), false);
+	m_guidToFeature.reserve(m_layout.features.size());
+	for (size_t i = 0; i < m_layout.features.size(); i++)
+	{
+		const FeatureSpan& span = m_layout.features[i];
+		if (span.guid != -1 && !span.isRoutingFeature)
+		{
+			m_guidToFeature[span.guid] = i;
+		}
+	}
+}
+
+Application::LazyFeatureIndex::~LazyFeatureIndex()
+{
+	delete m_mappedFile;
+}
+
+const FeatureSpan* Application::LazyFeatureIndex::FindFeature(int guid) const
+{
+	size_t index = FindFeatureIndex(guid);
+	return (index != NoFeature) ? &m_layout.features[index] : nullptr;
+}
+
+size_t Application::LazyFeatureIndex::FindFeatureIndex(int guid) const
+{
+	std::unordered_map<int, size_t>::const_iterator found = m_guidToFeature.find(guid);
+	return (found != m_guidToFeature.end()) ? found->second : NoFeature;
+}
+
+std::string_view Application::LazyFeatureIndex::GetFeatureText(size_t index) const
+{
+	const FeatureSpan& span = m_layout.features[index];
+	size_t end = span.hasChecksum ? span.checksumBegin : span.end;
+	return std::string_view(m_data + span.begin, end - span.begin);
+}
+
+bool Application::LazyFeatureIndex::IsMaterialized(int guid) const
+{
+	std::unordered_map<int, size_t>::const_iterator found = m_guidToFeature.find(guid);
+	return found != m_guidToFeature.end() && m_materialized[found->second];
+}
+
+GuidObject* Application::LazyFeatureIndex::ReadFeature(size_t index) const
+{
+	const FeatureSpan& span = m_layout.features[index];
+	if (m_verifyIntegrity)
+	{
+		VerifyFeatureChecksum(m_data, span);
+	}
+	return ReadSpan(span);
+}
+
+GuidObject* Application::LazyFeatureIndex::ReadSpan(const FeatureSpan& span) const
+{
+	PartFileTokenizer tokenizer(m_data + span.bodyBegin, span.end - span.bodyBegin);
+	return ProcessFeature(span.featureType, tokenizer);
+}
+
+GuidObject* Application::LazyFeatureIndex::MaterializeObject(int guid)
+{
+	std::unordered_map<int, size_t>::iterator found = m_guidToFeature.find(guid);
+	if (found == m_guidToFeature.end() || m_materialized[found->second])
+	{
+		return nullptr;
+	}
+
+	const FeatureSpan& span = m_layout.features[found->second];
+	if (m_verifyIntegrity)
+	{
+		VerifyFeatureChecksum(m_data, span);
+	}
+	// only marked once read, a feature that failed to read is tried again on the next lookup
+	GuidObject* object = ReadSpan(span);
+	m_materialized[found->second] = true;
+	return object;
+}
@@ -0,0 +1,98 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "..\Core\GuidObject.h"
+#include "..\Core\PartFileLayout.h"
+
+class MappedFile;
+
+namespace Application
+{
+	class PartArchive;
+
+	/// <summary>
+	/// Type, version, guid and byte span of every feature in a text part file,
+	/// built from the framing lines alone.  Registered with the GuidObjectManager
+	/// it reads a feature through the DataObjectReader readers the first time its
+	/// guid is looked up.  Keeps the part file mapped for as long as it lives.
+	/// partFilePath may address a part in an archive, <archive>.prtpak#<part name>.
+	/// With verifyIntegrity a part cut short throws at construction and a feature is
+	/// checked against its FeatureChecksum: line when it is read, the rest of the part
+	/// is never checksummed so opening stays as cheap as the index.
+	/// </summary>
+	class APPPARTOPS_API LazyFeatureIndex : public ILazyObjectSource
+	{
+	public:
+		LazyFeatureIndex(const std::string& partFilePath, bool verifyIntegrity = true);
+		virtual ~LazyFeatureIndex();
+
+		LazyFeatureIndex() = delete;
+		LazyFeatureIndex(const LazyFeatureIndex&) = delete;
+		LazyFeatureIndex& operator=(const LazyFeatureIndex&) = delete;
+
+		std::string_view GetPartFileName() const
+		{
+			return m_layout.partFileName;
+		}
+		std::string_view GetSchemaVersion() const
+		{
+			return m_layout.schemaVersion;
+		}
+		size_t GetFeatureCount() const
+		{
+			return m_layout.features.size();
+		}
+		const FeatureSpan& GetFeature(size_t index) const
+		{
+			return m_layout.features[index];
+		}
+
+		static const size_t NoFeature = (size_t)-1;
+
+		/// <summary>
+		/// The last feature in the file with this guid, nullptr if there is none.
+		/// </summary>
+		const FeatureSpan* FindFeature(int guid) const;
+
+		/// <summary>
+		/// Index of the last feature in the file with this guid, NoFeature if there is none.
+		/// Routing features are not indexed by guid.
+		/// </summary>
+		size_t FindFeatureIndex(int guid) const;
+
+		/// <summary>
+		/// The feature's bytes from its Feature: line up to its FeatureChecksum: line, or
+		/// through its End line when it has none, a view into the mapped part.
+		/// </summary>
+		std::string_view GetFeatureText(size_t index) const;
+
+		/// <summary>
+		/// Reads the feature at index up to its latest version into a new object the caller
+		/// owns, without handing it to the GuidObjectManager or counting it as materialized.
+		/// nullptr when there is no reader for it.  Safe to call from several threads at once.
+		/// </summary>
+		GuidObject* ReadFeature(size_t index) const;
+
+		/// <summary>
+		/// True once the feature has been handed to the GuidObjectManager.
+		/// </summary>
+		bool IsMaterialized(int guid) const;
+
+		GuidObject* MaterializeObject(int guid) override;
+
+	private:
+		GuidObject* ReadSpan(const FeatureSpan& span) const;
+
+		MappedFile* m_mappedFile; /** nullptr for a part read from an archive. */
+		std::shared_ptr<PartArchive> m_archive; /** Keeps the archive mapped for a part read from one. */
+		const char* m_data;
+		size_t m_size;
+		PartFileLayout m_layout;
+		std::unordered_map<int, size_t> m_guidToFeature;
+		std::vector<bool> m_materialized;
+		bool m_verifyIntegrity;
+	};
+}
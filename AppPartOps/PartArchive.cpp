@@ -0,0 +1,284 @@
+#include "PartArchive.h"
+#include "BinaryPartImage.h"
+#include "PartDeltaLog.h"
+#include "PartOpsInternal.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include "..\Core\MappedFile.h"
+
+using namespace Application;
+
+static std::mutex openArchivesMutex;
+static std::map<std::string, std::shared_ptr<PartArchive>> openArchives;
+
+static uint64_t AlignSection(uint64_t offset)
+{
+	return (offset + PartArchiveFormat::SectionAlignment - 1) / PartArchiveFormat::SectionAlignment * PartArchiveFormat::SectionAlignment;
+}
+
+// A section is valid if it sits inside the file, starts aligned and holds count entries
+static bool SectionFits(uint64_t offset, uint64_t count, uint64_t entrySize, uint64_t fileSize)
+{
+	if (offset % PartArchiveFormat::SectionAlignment != 0 || offset > fileSize)
+	{
+		return false;
+	}
+	return count <= (fileSize - offset) / entrySize;
+}
+
+
+PartArchive::PartArchive(const std::string& archivePath)
+	: m_mappedFile(new MappedFile(archivePath)), m_header(nullptr), m_toc(nullptr), m_names(nullptr), m_archivePath(archivePath)
+{
+	try
+	{
+		Validate();
+	}
+	catch (...)
+	{
+		delete m_mappedFile;
+		throw;
+	}
+}
+
+PartArchive::~PartArchive()
+{
+	delete m_mappedFile;
+}
+
+void PartArchive::Validate()
+{
+	if (!m_mappedFile->IsOpen())
+	{
+		std::string msg = "Unable to open part archive " + m_archivePath;
+		throw std::exception(msg.c_str());
+	}
+
+	const char* data = m_mappedFile->Data();
+	uint64_t fileSize = m_mappedFile->Size();
+	if (fileSize < sizeof(PartArchiveFormat::Header))
+	{
+		throw std::exception("Part archive is truncated");
+	}
+
+	m_header = (const PartArchiveFormat::Header*)data;
+	if (memcmp(m_header->magic, PartArchiveFormat::Magic, sizeof(PartArchiveFormat::Magic)) != 0)
+	{
+		throw std::exception("Not a part archive");
+	}
+	if (m_header->formatVersion != PartArchiveFormat::FormatVersion || m_header->headerSize != sizeof(PartArchiveFormat::Header))
+	{
+		throw std::exception("Unsupported part archive version");
+	}
+	if (m_header->fileSize != fileSize)
+	{
+		throw std::exception("Part archive is truncated");
+	}
+	if (!SectionFits(m_header->tocOffset, m_header->partCount, sizeof(PartArchiveFormat::TocEntry), fileSize) ||
+		!SectionFits(m_header->namesOffset, m_header->namesSize, 1, fileSize))
+	{
+		throw std::exception("Part archive section out of bounds");
+	}
+
+	m_toc = (const PartArchiveFormat::TocEntry*)(data + m_header->tocOffset);
+	m_names = data + m_header->namesOffset;
+}
+
+// Everything below is bounds checked on access rather than up front, keeping open O(1)
+
+std::string_view PartArchive::GetPartName(uint32_t index) const
+{
+	if (index >= m_header->partCount)
+	{
+		throw std::exception("Part archive part index out of range");
+	}
+	const PartArchiveFormat::TocEntry& entry = m_toc[index];
+	if ((uint64_t)entry.nameOffset + entry.nameLength > m_header->namesSize)
+	{
+		throw std::exception("Part archive name out of range");
+	}
+	return std::string_view(m_names + entry.nameOffset, entry.nameLength);
+}
+
+std::string_view PartArchive::GetPart(uint32_t index) const
+{
+	if (index >= m_header->partCount)
+	{
+		throw std::exception("Part archive part index out of range");
+	}
+	const PartArchiveFormat::TocEntry& entry = m_toc[index];
+	if (entry.offset > m_header->fileSize || entry.size > m_header->fileSize - entry.offset)
+	{
+		throw std::exception("Part archive part out of range");
+	}
+	return std::string_view(m_mappedFile->Data() + entry.offset, (size_t)entry.size);
+}
+
+std::string_view PartArchive::GetPart(std::string_view partName) const
+{
+	uint32_t low = 0;
+	uint32_t high = m_header->partCount;
+	while (low < high)
+	{
+		uint32_t middle = low + (high - low) / 2;
+		int order = GetPartName(middle).compare(partName);
+		if (order == 0)
+		{
+			return GetPart(middle);
+		}
+		if (order < 0)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+
+	std::string msg = "Part archive " + m_archivePath + " has no part " + std::string(partName);
+	throw std::exception(msg.c_str());
+}
+
+std::shared_ptr<PartArchive> PartArchive::GetArchive(const std::string& archivePath)
+{
+	std::lock_guard<std::mutex> lock(openArchivesMutex);
+	std::shared_ptr<PartArchive>& archive = openArchives[archivePath];
+	if (archive == nullptr)
+	{
+		try
+		{
+			archive = std::make_shared<PartArchive>(archivePath);
+		}
+		catch (...)
+		{
+			openArchives.erase(archivePath);
+			throw;
+		}
+	}
+	return archive;
+}
+
+void PartArchive::CloseArchives()
+{
+	std::lock_guard<std::mutex> lock(openArchivesMutex);
+	openArchives.clear();
+}
+
+bool PartArchive::SplitArchivedPartPath(const std::string& partFilePath, std::string& archivePath, std::string& partName)
+{
+	size_t separator = partFilePath.rfind(PartArchiveFormat::PartSeparator);
+	if (separator == std::string::npos || std::filesystem::path(partFilePath.substr(0, separator)).extension() != ".prtpak")
+	{
+		return false;
+	}
+	archivePath = partFilePath.substr(0, separator);
+	partName = partFilePath.substr(separator + 1);
+	return true;
+}
+
+bool PartArchive::IsArchivedPartPath(const std::string& partFilePath)
+{
+	std::string archivePath;
+	std::string partName;
+	return SplitArchivedPartPath(partFilePath, archivePath, partName);
+}
+
+void PartArchive::Pack(const std::vector<std::string>& partFilePaths, const std::string& archivePath)
+{
+	struct PackedPart
+	{
+		std::string name;
+		std::unique_ptr<MappedFile> mappedFile;
+	};
+
+	std::vector<PackedPart> parts;
+	parts.reserve(partFilePaths.size());
+	for (const std::string& partFilePath : partFilePaths)
+	{
+		if (BinaryPartImage::IsBinaryPartFile(partFilePath))
+		{
+			std::string msg = "Binary part " + partFilePath + " cannot be packed, convert it to text first";
+			throw std::exception(msg.c_str());
+		}
+		if (PartDeltaLog::HasPendingDeltas(partFilePath))
+		{
+			PartDeltaLog(partFilePath).Compact();
+		}
+
+		PackedPart part = { std::filesystem::path(partFilePath).stem().string(), std::make_unique<MappedFile>(partFilePath) };
+		if (!part.mappedFile->IsOpen())
+		{
+			std::string msg = "Unable to open part file " + partFilePath;
+			throw std::exception(msg.c_str());
+		}
+		parts.push_back(std::move(part));
+	}
+
+	std::sort(parts.begin(), parts.end(), [](const PackedPart& left, const PackedPart& right) { return left.name < right.name; });
+	for (size_t i = 1; i < parts.size(); i++)
+	{
+		if (parts[i].name == parts[i - 1].name)
+		{
+			std::string msg = "Two parts named " + parts[i].name + " cannot go in one part archive";
+			throw std::exception(msg.c_str());
+		}
+	}
+
+	PartArchiveFormat::Header header = {};
+	memcpy(header.magic, PartArchiveFormat::Magic, sizeof(header.magic));
+	header.formatVersion = PartArchiveFormat::FormatVersion;
+	header.headerSize = sizeof(PartArchiveFormat::Header);
+	header.partCount = (uint32_t)parts.size();
+
+	std::string names;
+	std::vector<PartArchiveFormat::TocEntry> toc(parts.size());
+	for (size_t i = 0; i < parts.size(); i++)
+	{
+		toc[i].nameOffset = (uint32_t)names.size();
+		toc[i].nameLength = (uint32_t)parts[i].name.size();
+		names.append(parts[i].name);
+	}
+
+	header.tocOffset = AlignSection(sizeof(PartArchiveFormat::Header));
+	header.namesOffset = AlignSection(header.tocOffset + toc.size() * sizeof(PartArchiveFormat::TocEntry));
+	header.namesSize = names.size();
+	uint64_t offset = AlignSection(header.namesOffset + header.namesSize);
+	for (size_t i = 0; i < parts.size(); i++)
+	{
+		toc[i].offset = offset;
+		toc[i].size = parts[i].mappedFile->Size();
+		offset = AlignSection(offset + toc[i].size);
+	}
+	header.fileSize = offset;
+
+	// header, table of contents and names go out as one piece, each part straight from its mapping
+	std::string head((size_t)(parts.empty() ? header.fileSize : toc[0].offset), '\0');
+	memcpy(&head[0], &header, sizeof(header));
+	memcpy(&head[(size_t)header.tocOffset], toc.data(), toc.size() * sizeof(PartArchiveFormat::TocEntry));
+	memcpy(&head[(size_t)header.namesOffset], names.data(), names.size());
+
+	static const char padding[PartArchiveFormat::SectionAlignment] = {};
+	std::vector<std::string_view> segments;
+	segments.reserve(1 + 2 * parts.size());
+	segments.push_back(head);
+	for (size_t i = 0; i < parts.size(); i++)
+	{
+		segments.push_back(std::string_view(parts[i].mappedFile->Data(), (size_t)toc[i].size));
+		size_t paddingSize = (size_t)(AlignSection(toc[i].size) - toc[i].size);
+		if (paddingSize != 0)
+		{
+			segments.push_back(std::string_view(padding, paddingSize));
+		}
+	}
+
+	// a mapping of the old archive would keep it from being replaced
+	{
+		std::lock_guard<std::mutex> lock(openArchivesMutex);
+		openArchives.erase(archivePath);
+	}
+	WriteFileAtomically(archivePath, segments);
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include "PartArchiveFormat.h"
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class MappedFile;
+
+namespace Application
+{
+	/// <summary>
+	/// A part archive (.prtpak) mapped into memory.  The constructor only checks the
+	/// header and section bounds, a part is found by binary search of the table of
+	/// contents and read in place, so only the pages of the parts opened are touched.
+	/// Throws std::exception if the file is not a valid part archive.
+	/// </summary>
+	class APPPARTOPS_API PartArchive
+	{
+	public:
+		PartArchive(const std::string& archivePath);
+		virtual ~PartArchive();
+
+		PartArchive() = delete;
+		PartArchive(const PartArchive&) = delete;
+		PartArchive& operator=(const PartArchive&) = delete;
+
+		/// <summary>
+		/// The archive at archivePath, mapped on first use and kept mapped, so opening
+		/// parts one after another maps it once.  Safe to call from several threads.
+		/// </summary>
+		static std::shared_ptr<PartArchive> GetArchive(const std::string& archivePath);
+
+		/// <summary>
+		/// Lets go of the archives GetArchive kept, each is unmapped once the parts
+		/// read from it are released.  Needed before an archive is packed again.
+		/// </summary>
+		static void CloseArchives();
+
+		/// <summary>
+		/// Splits <archive>.prtpak#<part name>, false for a path that does not address a part in an archive.
+		/// </summary>
+		static bool SplitArchivedPartPath(const std::string& partFilePath, std::string& archivePath, std::string& partName);
+		static bool IsArchivedPartPath(const std::string& partFilePath);
+
+		/// <summary>
+		/// Packs the text part files at partFilePaths into a new archive at archivePath,
+		/// written atomically.  Each part is named by its file name without the .prt
+		/// extension.  Throws std::exception for two parts of the same name, for binary
+		/// parts (.prtb) and for parts that cannot be read.  Saves waiting in a part's
+		/// delta log are folded into it first, as OpenPartFile would.
+		/// </summary>
+		static void Pack(const std::vector<std::string>& partFilePaths, const std::string& archivePath);
+
+		uint32_t GetPartCount() const
+		{
+			return m_header->partCount;
+		}
+		std::string_view GetPartName(uint32_t index) const;
+
+		/// <summary>
+		/// The bytes of the part at index, a view into the mapping.
+		/// </summary>
+		std::string_view GetPart(uint32_t index) const;
+
+		/// <summary>
+		/// The bytes of the part named partName, throws std::exception if the archive has none.
+		/// </summary>
+		std::string_view GetPart(std::string_view partName) const;
+
+	private:
+		void Validate();
+
+		MappedFile* m_mappedFile;
+		const PartArchiveFormat::Header* m_header;
+		const PartArchiveFormat::TocEntry* m_toc;
+		const char* m_names;
+		std::string m_archivePath;
+	};
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+// On disk layout of a part archive (.prtpak), many text part files packed in
+// to one so opening a part costs no file open or directory lookup of its own.
+// Little endian, mapped and read in place:
+//
+//   Header
+//   TocEntry[partCount]      sorted by name, a part is found by binary search
+//   name table               the part names TocEntry refers to
+//   part data                each part's bytes exactly as its .prt held them
+//
+// Each section and each part starts on an 8 byte boundary.  A part inside an
+// archive is addressed as <archive>.prtpak#<part name>.
+
+namespace Application
+{
+	namespace PartArchiveFormat
+	{
+		constexpr char Magic[4] = { 'P', 'R', 'T', 'K' };
+		constexpr uint32_t FormatVersion = 1;
+		constexpr uint32_t SectionAlignment = 8;
+		constexpr char PartSeparator = '#';
+
+		struct Header
+		{
+			char magic[4];
+			uint32_t formatVersion;
+			uint32_t headerSize;
+			uint32_t partCount;
+			uint64_t tocOffset;
+			uint64_t namesOffset;
+			uint64_t namesSize;
+			uint64_t fileSize;
+		};
+		static_assert(sizeof(Header) == 48, "PartArchiveFormat::Header layout changed");
+
+		struct TocEntry
+		{
+			uint32_t nameOffset; /** Relative to the start of the name table. */
+			uint32_t nameLength;
+			uint64_t offset; /** Of the part's bytes, from the start of the archive. */
+			uint64_t size;
+		};
+		static_assert(sizeof(TocEntry) == 24, "PartArchiveFormat::TocEntry layout changed");
+	}
+}
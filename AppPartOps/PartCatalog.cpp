@@ -0,0 +1,435 @@
+#include "framework.h"
+#include "PartCatalog.h"
+#include "PartDeltaLog.h"
+#include "PartFileProbe.h"
+#include "PartOpsInternal.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include "..\Core\MappedFile.h"
+#include "..\Core\StringUtils.h"
+#include "..\Core\ThreadPool.h"
+
+using namespace Application;
+
+// Index layout, all little endian and unaligned:
+//   uint32 magic, uint32 IndexVersion, uint32 featureTypeCount, uint32 entryCount
+//   featureTypeCount x (uint16 length, name)
+//   entryCount x (uint64 fileSize, int64 lastWriteTime, uint64 deltaLogSize, int64 deltaLogWriteTime, int32 schemaVersion, uint32 featureCount,
+//                 uint32 routingFeatureCount, uint8 flags, uint16 versionCount, uint16 pathLength,
+//                 uint16 nameLength, path, name, versionCount x (uint16 featureType, int32 version, uint32 count))
+static const uint32_t IndexMagic = 0x54414350; // "PCAT"
+static const uint8_t BinaryFlag = 1;
+static const uint8_t PendingDeltasFlag = 2;
+
+template <typename Value>
+static void AppendValue(std::string& out, Value value)
+{
+	out.append(reinterpret_cast<const char*>(&value), sizeof(Value));
+}
+
+static void AppendShortString(std::string& out, std::string_view text)
+{
+	if (text.size() > UINT16_MAX)
+	{
+		throw std::exception("Part catalog string too long");
+	}
+	AppendValue<uint16_t>(out, (uint16_t)text.size());
+	out.append(text);
+}
+
+// Bounds checked reads over the mapped index, any overrun marks the index unusable
+class IndexCursor
+{
+public:
+	IndexCursor(const char* data, size_t size)
+		: m_data(data), m_size(size), m_offset(0), m_failed(false)
+	{
+	}
+
+	template <typename Value>
+	Value Read()
+	{
+		Value value = Value();
+		if (m_failed || m_size - m_offset < sizeof(Value))
+		{
+			m_failed = true;
+			return value;
+		}
+		memcpy(&value, m_data + m_offset, sizeof(Value));
+		m_offset += sizeof(Value);
+		return value;
+	}
+
+	std::string_view ReadBytes(size_t length)
+	{
+		if (m_failed || m_size - m_offset < length)
+		{
+			m_failed = true;
+			return std::string_view();
+		}
+		std::string_view bytes(m_data + m_offset, length);
+		m_offset += length;
+		return bytes;
+	}
+
+	bool Failed() const
+	{
+		return m_failed;
+	}
+
+private:
+	const char* m_data;
+	size_t m_size;
+	size_t m_offset;
+	bool m_failed;
+};
+
+static bool IsPartFilePath(const std::filesystem::path& path)
+{
+	std::filesystem::path extension = path.extension();
+	return extension == ".prt" || extension == ".prtb";
+}
+
+PartCatalog::PartCatalog(const std::string& rootDirectory, const std::string& indexPath)
+	: m_rootDirectory(rootDirectory), m_indexPath(indexPath)
+{
+	if (!Load())
+	{
+		m_entries.clear();
+		m_featureTypeNames.clear();
+		m_featureTypeIds.clear();
+	}
+	RebuildLookups();
+}
+
+bool PartCatalog::Load()
+{
+	MappedFile mappedFile(m_indexPath);
+	if (!mappedFile.IsOpen())
+	{
+		return false;
+	}
+
+	IndexCursor cursor(mappedFile.Data(), mappedFile.Size());
+	if (cursor.Read<uint32_t>() != IndexMagic || cursor.Read<uint32_t>() != IndexVersion)
+	{
+		return false;
+	}
+
+	uint32_t featureTypeCount = cursor.Read<uint32_t>();
+	uint32_t entryCount = cursor.Read<uint32_t>();
+	if (cursor.Failed() || featureTypeCount > UINT16_MAX + 1u)
+	{
+		return false;
+	}
+
+	for (uint32_t typeIndex = 0; typeIndex < featureTypeCount && !cursor.Failed(); ++typeIndex)
+	{
+		InternFeatureType(cursor.ReadBytes(cursor.Read<uint16_t>()));
+	}
+
+	m_entries.reserve(std::min<size_t>(entryCount, mappedFile.Size() / 56));
+	for (uint32_t entryIndex = 0; entryIndex < entryCount && !cursor.Failed(); ++entryIndex)
+	{
+		PartCatalogEntry entry;
+		entry.fileSize = cursor.Read<uint64_t>();
+		entry.lastWriteTime = cursor.Read<int64_t>();
+		entry.deltaLogSize = cursor.Read<uint64_t>();
+		entry.deltaLogWriteTime = cursor.Read<int64_t>();
+		entry.schemaVersion = cursor.Read<int32_t>();
+		entry.featureCount = cursor.Read<uint32_t>();
+		entry.routingFeatureCount = cursor.Read<uint32_t>();
+		uint8_t flags = cursor.Read<uint8_t>();
+		entry.isBinary = (flags & BinaryFlag) != 0;
+		entry.hasPendingDeltas = (flags & PendingDeltasFlag) != 0;
+		uint16_t versionCount = cursor.Read<uint16_t>();
+		uint16_t pathLength = cursor.Read<uint16_t>();
+		uint16_t nameLength = cursor.Read<uint16_t>();
+		entry.relativePath = cursor.ReadBytes(pathLength);
+		entry.partFileName = cursor.ReadBytes(nameLength);
+
+		entry.featureVersions.resize(versionCount);
+		for (PartCatalogFeatureVersion& featureVersion : entry.featureVersions)
+		{
+			featureVersion.featureType = cursor.Read<uint16_t>();
+			featureVersion.version = cursor.Read<int32_t>();
+			featureVersion.count = cursor.Read<uint32_t>();
+			if (featureVersion.featureType >= m_featureTypeNames.size())
+			{
+				return false;
+			}
+		}
+		m_entries.push_back(std::move(entry));
+	}
+
+	return !cursor.Failed();
+}
+
+void PartCatalog::Save() const
+{
+	std::string index;
+	index.reserve(16 + m_entries.size() * 96);
+
+	AppendValue<uint32_t>(index, IndexMagic);
+	AppendValue<uint32_t>(index, IndexVersion);
+	AppendValue<uint32_t>(index, (uint32_t)m_featureTypeNames.size());
+	AppendValue<uint32_t>(index, (uint32_t)m_entries.size());
+
+	for (const std::string& featureTypeName : m_featureTypeNames)
+	{
+		AppendShortString(index, featureTypeName);
+	}
+
+	for (const PartCatalogEntry& entry : m_entries)
+	{
+		if (entry.relativePath.size() > UINT16_MAX || entry.partFileName.size() > UINT16_MAX
+			|| entry.featureVersions.size() > UINT16_MAX)
+		{
+			throw std::exception("Part catalog entry too large to index");
+		}
+
+		AppendValue<uint64_t>(index, entry.fileSize);
+		AppendValue<int64_t>(index, entry.lastWriteTime);
+		AppendValue<uint64_t>(index, entry.deltaLogSize);
+		AppendValue<int64_t>(index, entry.deltaLogWriteTime);
+		AppendValue<int32_t>(index, entry.schemaVersion);
+		AppendValue<uint32_t>(index, entry.featureCount);
+		AppendValue<uint32_t>(index, entry.routingFeatureCount);
+		AppendValue<uint8_t>(index, (entry.isBinary ? BinaryFlag : 0) | (entry.hasPendingDeltas ? PendingDeltasFlag : 0));
+		AppendValue<uint16_t>(index, (uint16_t)entry.featureVersions.size());
+		AppendValue<uint16_t>(index, (uint16_t)entry.relativePath.size());
+		AppendValue<uint16_t>(index, (uint16_t)entry.partFileName.size());
+		index.append(entry.relativePath);
+		index.append(entry.partFileName);
+
+		for (const PartCatalogFeatureVersion& featureVersion : entry.featureVersions)
+		{
+			AppendValue<uint16_t>(index, featureVersion.featureType);
+			AppendValue<int32_t>(index, featureVersion.version);
+			AppendValue<uint32_t>(index, featureVersion.count);
+		}
+	}
+
+	WriteFileAtomically(m_indexPath, index);
+}
+
+PartCatalogRefreshResult PartCatalog::Refresh(size_t threadCount)
+{
+	PartCatalogRefreshResult result;
+	auto start = std::chrono::steady_clock::now();
+
+	std::filesystem::path root(m_rootDirectory);
+	std::vector<PartCatalogEntry> entries;
+	std::vector<PartCatalogEntry> changed;
+	size_t keptCount = 0;
+
+	// the walk only looks at sizes and write times, the directory listing already has them
+	for (const auto& directoryEntry : std::filesystem::recursive_directory_iterator(root,
+		std::filesystem::directory_options::skip_permission_denied))
+	{
+		if (!directoryEntry.is_regular_file() || !IsPartFilePath(directoryEntry.path()))
+		{
+			continue;
+		}
+
+		PartCatalogEntry stamp;
+		stamp.relativePath = directoryEntry.path().lexically_relative(root).generic_string();
+		stamp.fileSize = directoryEntry.file_size();
+		stamp.lastWriteTime = (int64_t)directoryEntry.last_write_time().time_since_epoch().count();
+
+		// saves append to the delta log and leave the part alone, so it is part of the stamp too
+		std::error_code deltaLogError;
+		std::filesystem::path deltaLogPath(PartDeltaLog::GetDeltaLogPath(directoryEntry.path().string()));
+		if (std::filesystem::is_regular_file(deltaLogPath, deltaLogError))
+		{
+			stamp.deltaLogSize = std::filesystem::file_size(deltaLogPath, deltaLogError);
+			stamp.deltaLogWriteTime = (int64_t)std::filesystem::last_write_time(deltaLogPath, deltaLogError).time_since_epoch().count();
+			if (deltaLogError)
+			{
+				// gone between the two calls, a compaction, so the next refresh sees the folded part
+				stamp.deltaLogSize = 0;
+				stamp.deltaLogWriteTime = 0;
+			}
+		}
+
+		auto found = m_entryByPath.find(stamp.relativePath);
+		if (found != m_entryByPath.end())
+		{
+			PartCatalogEntry& known = m_entries[found->second];
+			++keptCount;
+			if (known.fileSize == stamp.fileSize && known.lastWriteTime == stamp.lastWriteTime
+				&& known.deltaLogSize == stamp.deltaLogSize && known.deltaLogWriteTime == stamp.deltaLogWriteTime)
+			{
+				entries.push_back(std::move(known));
+				continue;
+			}
+		}
+		changed.push_back(std::move(stamp));
+	}
+
+	std::vector<std::unique_ptr<PartFileProbe>> probes(changed.size());
+	auto probeChanged = [&](size_t begin, size_t end)
+	{
+		for (size_t changedIndex = begin; changedIndex < end; ++changedIndex)
+		{
+			try
+			{
+				std::filesystem::path partPath = root / std::filesystem::path(changed[changedIndex].relativePath);
+				probes[changedIndex] = std::make_unique<PartFileProbe>(ProbePartFile(partPath.string()));
+			}
+			catch (std::exception&)
+			{
+				// left out of the index, so the next refresh tries it again
+			}
+		}
+	};
+
+	if (threadCount == 0)
+	{
+		ThreadPool::GetInstance().ParallelFor(changed.size(), probeChanged);
+	}
+	else
+	{
+		ThreadPool threadPool(threadCount);
+		threadPool.ParallelFor(changed.size(), probeChanged);
+	}
+
+	// feature type ids are handed out here on one thread, in the order the parts were found
+	for (size_t changedIndex = 0; changedIndex < changed.size(); ++changedIndex)
+	{
+		const PartFileProbe* probe = probes[changedIndex].get();
+		if (probe == nullptr)
+		{
+			++result.failedCount;
+			continue;
+		}
+
+		PartCatalogEntry& entry = changed[changedIndex];
+		entry.partFileName = probe->partFileName;
+		if (!parseInt(probe->schemaVersion, entry.schemaVersion))
+		{
+			entry.schemaVersion = -1;
+		}
+		entry.isBinary = probe->isBinary;
+		entry.hasPendingDeltas = probe->hasPendingDeltas;
+		entry.featureCount = (uint32_t)probe->featureCount;
+		entry.routingFeatureCount = (uint32_t)probe->routingFeatureCount;
+		for (const auto& featureType : probe->featureVersions)
+		{
+			uint16_t featureTypeId = InternFeatureType(featureType.first);
+			for (const auto& version : featureType.second)
+			{
+				entry.featureVersions.push_back({ featureTypeId, version.first, (uint32_t)version.second });
+			}
+		}
+		entries.push_back(std::move(entry));
+		++result.probedCount;
+	}
+
+	result.removedCount = m_entries.size() - keptCount;
+	result.partCount = entries.size();
+
+	std::sort(entries.begin(), entries.end(), [](const PartCatalogEntry& left, const PartCatalogEntry& right)
+		{
+			return left.relativePath < right.relativePath;
+		});
+	m_entries = std::move(entries);
+	RebuildLookups();
+	Save();
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+const std::string& PartCatalog::GetFeatureTypeName(uint16_t featureType) const
+{
+	if (featureType >= m_featureTypeNames.size())
+	{
+		throw std::exception("Unknown part catalog feature type");
+	}
+	return m_featureTypeNames[featureType];
+}
+
+std::vector<const PartCatalogEntry*> PartCatalog::FindPartsWithFeatureVersion(std::string_view featureType, int version) const
+{
+	std::vector<const PartCatalogEntry*> parts;
+
+	auto featureTypeId = m_featureTypeIds.find(std::string(featureType));
+	if (featureTypeId == m_featureTypeIds.end())
+	{
+		return parts;
+	}
+
+	auto found = m_entriesByFeatureVersion.find(((uint64_t)featureTypeId->second << 32) | (uint32_t)version);
+	if (found != m_entriesByFeatureVersion.end())
+	{
+		parts.reserve(found->second.size());
+		for (uint32_t entryIndex : found->second)
+		{
+			parts.push_back(&m_entries[entryIndex]);
+		}
+	}
+	return parts;
+}
+
+std::vector<const PartCatalogEntry*> PartCatalog::FindPartsWithSchemaBelow(int schemaVersion) const
+{
+	return FindParts([schemaVersion](const PartCatalogEntry& entry)
+		{
+			return entry.schemaVersion >= 0 && entry.schemaVersion < schemaVersion;
+		});
+}
+
+std::vector<const PartCatalogEntry*> PartCatalog::FindParts(const std::function<bool(const PartCatalogEntry&)>& predicate) const
+{
+	std::vector<const PartCatalogEntry*> parts;
+	for (const PartCatalogEntry& entry : m_entries)
+	{
+		if (predicate(entry))
+		{
+			parts.push_back(&entry);
+		}
+	}
+	return parts;
+}
+
+uint16_t PartCatalog::InternFeatureType(std::string_view featureType)
+{
+	std::string name(featureType);
+	auto found = m_featureTypeIds.find(name);
+	if (found != m_featureTypeIds.end())
+	{
+		return found->second;
+	}
+
+	if (m_featureTypeNames.size() > UINT16_MAX)
+	{
+		throw std::exception("Too many feature types for the part catalog");
+	}
+
+	uint16_t featureTypeId = (uint16_t)m_featureTypeNames.size();
+	m_featureTypeNames.push_back(name);
+	m_featureTypeIds.emplace(std::move(name), featureTypeId);
+	return featureTypeId;
+}
+
+void PartCatalog::RebuildLookups()
+{
+	m_entryByPath.clear();
+	m_entriesByFeatureVersion.clear();
+	m_entryByPath.reserve(m_entries.size());
+
+	for (size_t entryIndex = 0; entryIndex < m_entries.size(); ++entryIndex)
+	{
+		const PartCatalogEntry& entry = m_entries[entryIndex];
+		m_entryByPath.emplace(entry.relativePath, entryIndex);
+		for (const PartCatalogFeatureVersion& featureVersion : entry.featureVersions)
+		{
+			uint64_t key = ((uint64_t)featureVersion.featureType << 32) | (uint32_t)featureVersion.version;
+			m_entriesByFeatureVersion[key].push_back((uint32_t)entryIndex);
+		}
+	}
+}
@@ -0,0 +1,115 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Application
+{
+	struct PartCatalogFeatureVersion
+	{
+		uint16_t featureType; /** Index into PartCatalog::GetFeatureTypeName. */
+		int32_t version; /** -1 for none. */
+		uint32_t count;
+	};
+
+	/// <summary>
+	/// What the catalog knows about one part, the probe of the file when it last changed.
+	/// </summary>
+	struct PartCatalogEntry
+	{
+		std::string relativePath; /** From the catalog root, with / separators. */
+		uint64_t fileSize = 0;
+		int64_t lastWriteTime = 0;
+		uint64_t deltaLogSize = 0; /** 0 when the part has no delta log. */
+		int64_t deltaLogWriteTime = 0; /** 0 when the part has no delta log. */
+		std::string partFileName;
+		int32_t schemaVersion = -1; /** -1 when the header has none or it is not a number. */
+		bool isBinary = false;
+		bool hasPendingDeltas = false;
+		uint32_t featureCount = 0;
+		uint32_t routingFeatureCount = 0;
+		std::vector<PartCatalogFeatureVersion> featureVersions;
+	};
+
+	struct PartCatalogRefreshResult
+	{
+		size_t partCount = 0; /** Parts under the root after the refresh. */
+		size_t probedCount = 0; /** New or changed since the last refresh. */
+		size_t removedCount = 0;
+		size_t failedCount = 0; /** Could not be probed, left out and tried again next refresh. */
+		double seconds = 0;
+	};
+
+	/// <summary>
+	/// Index of the header and feature versions of every part (.prt and .prtb) under a
+	/// root directory, kept in one compact binary file.  Refresh only probes parts whose
+	/// size or last write time, or those of their delta log, changed since the index was saved, on the ThreadPool, so
+	/// keeping a large tree indexed costs one directory walk.  Queries run on the loaded
+	/// index and never touch the parts.  The probing is ProbePartFile, the same tokens
+	/// ReadInPartFile reads.
+	/// </summary>
+	class APPPARTOPS_API PartCatalog
+	{
+	public:
+		/// <summary>
+		/// Bump when the index layout changes, an index of another version is rebuilt.
+		/// </summary>
+		static const uint32_t IndexVersion = 2;
+
+		/// <summary>
+		/// Loads indexPath if it exists and was built for this version, otherwise starts empty.
+		/// </summary>
+		PartCatalog(const std::string& rootDirectory, const std::string& indexPath);
+
+		PartCatalog(const PartCatalog&) = delete;
+		PartCatalog& operator=(const PartCatalog&) = delete;
+
+		/// <summary>
+		/// Brings the index up to date with the tree and saves it.  threadCount of 0
+		/// probes on the shared ThreadPool.
+		/// </summary>
+		PartCatalogRefreshResult Refresh(size_t threadCount = 0);
+
+		/// <summary>
+		/// Writes the index to indexPath, replacing the old one atomically.
+		/// </summary>
+		void Save() const;
+
+		const std::vector<PartCatalogEntry>& GetEntries() const
+		{
+			return m_entries;
+		}
+		const std::string& GetFeatureTypeName(uint16_t featureType) const;
+
+		/// <summary>
+		/// Parts with at least one featureType feature at version.
+		/// </summary>
+		std::vector<const PartCatalogEntry*> FindPartsWithFeatureVersion(std::string_view featureType, int version) const;
+
+		/// <summary>
+		/// Parts whose SchemaVersion is known and below schemaVersion.
+		/// </summary>
+		std::vector<const PartCatalogEntry*> FindPartsWithSchemaBelow(int schemaVersion) const;
+
+		std::vector<const PartCatalogEntry*> FindParts(const std::function<bool(const PartCatalogEntry&)>& predicate) const;
+
+	private:
+		bool Load();
+		uint16_t InternFeatureType(std::string_view featureType);
+		void RebuildLookups();
+
+		std::string m_rootDirectory;
+		std::string m_indexPath;
+		std::vector<PartCatalogEntry> m_entries;
+		std::vector<std::string> m_featureTypeNames;
+		std::unordered_map<std::string, uint16_t> m_featureTypeIds;
+		std::unordered_map<std::string, size_t> m_entryByPath;
+
+		// featureType << 32 | version to the entries with it, for FindPartsWithFeatureVersion
+		std::unordered_map<uint64_t, std::vector<uint32_t>> m_entriesByFeatureVersion;
+	};
+}
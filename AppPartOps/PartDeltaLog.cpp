@@ -0,0 +1,485 @@
+#include "framework.h"
+#include "PartDeltaLog.h"
+#include "PartFileWriter.h"
+#include <algorithm>
+#include <fstream>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include "..\Core\ContentHash.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileIntegrity.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\StringUtils.h"
+#include "..\Core\ThreadPool.h"
+
+static const double DefaultCompactionRatio = 0.5;
+
+static uint64_t FileSizeInBytes(const std::string& filePath)
+{
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (!GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &attributes))
+	{
+		return 0;
+	}
+	return ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+}
+
+// Last write time and size, a part replaced by another process changes one or the other
+struct FileStamp
+{
+	uint64_t writeTime = 0;
+	uint64_t size = 0;
+
+	bool operator==(const FileStamp& other) const
+	{
+		return writeTime == other.writeTime && size == other.size;
+	}
+};
+
+static FileStamp GetFileStamp(const std::string& filePath)
+{
+	FileStamp stamp;
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (GetFileAttributesExA(filePath.c_str(), GetFileExInfoStandard, &attributes))
+	{
+		stamp.writeTime = ((uint64_t)attributes.ftLastWriteTime.dwHighDateTime << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+		stamp.size = ((uint64_t)attributes.nFileSizeHigh << 32) | attributes.nFileSizeLow;
+	}
+	return stamp;
+}
+
+// Every process saving the part opens the same mutex, mutex names cannot hold a path so it is named by the path's hash
+static HANDLE CreateDeltaLogMutex(const std::string& deltaLogPath)
+{
+	std::string normalizedPath = std::filesystem::absolute(deltaLogPath).lexically_normal().string();
+	std::transform(normalizedPath.begin(), normalizedPath.end(), normalizedPath.begin(), [](unsigned char c) { return (char)tolower(c); });
+	std::string mutexName = "Local\\PartDeltaLog." + ContentHashToString(HashContent(normalizedPath.data(), normalizedPath.size()));
+
+	HANDLE mutex = CreateMutexA(nullptr, FALSE, mutexName.c_str());
+	if (mutex == nullptr)
+	{
+		std::string msg = "Unable to create the mutex of part delta log " + deltaLogPath;
+		throw std::exception(msg.c_str());
+	}
+	return mutex;
+}
+
+// Held across processes while the log is appended to, read for compaction or swapped out.  A holder that died
+// leaves WAIT_ABANDONED, at worst a batch cut short that replay ignores, so the next one carries on
+class DeltaLogProcessLock
+{
+public:
+	explicit DeltaLogProcessLock(HANDLE mutex) : m_mutex(mutex)
+	{
+		DWORD waited = WaitForSingleObject(m_mutex, INFINITE);
+		if (waited != WAIT_OBJECT_0 && waited != WAIT_ABANDONED)
+		{
+			throw std::exception("Unable to lock the part delta log");
+		}
+	}
+
+	~DeltaLogProcessLock()
+	{
+		ReleaseMutex(m_mutex);
+	}
+
+	DeltaLogProcessLock(const DeltaLogProcessLock&) = delete;
+	DeltaLogProcessLock& operator=(const DeltaLogProcessLock&) = delete;
+
+private:
+	HANDLE m_mutex;
+};
+
+static bool ReadWholeFile(const std::string& filePath, std::string& content)
+{
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file.is_open())
+	{
+		return false;
+	}
+	content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	return true;
+}
+
+// One WriteFile per segment and one flush, the PartFileWriter chunks go out without being joined first
+static void WriteFileDurably(const std::string& filePath, const std::vector<std::string_view>& segments, DWORD desiredAccess, DWORD creationDisposition)
+{
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), desiredAccess, FILE_SHARE_READ, nullptr, creationDisposition, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw std::exception("Unable to open part delta log or compacted part for writing");
+	}
+
+	bool ok = true;
+	for (std::string_view segment : segments)
+	{
+		DWORD written = 0;
+		ok = ok && WriteFile(fileHandle, segment.data(), (DWORD)segment.size(), &written, nullptr) && written == segment.size();
+	}
+	ok = ok && FlushFileBuffers(fileHandle);
+	CloseHandle(fileHandle);
+
+	if (!ok)
+	{
+		throw std::exception("Unable to write part delta log or compacted part");
+	}
+}
+
+static void WriteFileDurably(const std::string& filePath, const std::string& content, DWORD desiredAccess, DWORD creationDisposition)
+{
+	WriteFileDurably(filePath, std::vector<std::string_view>{ content }, desiredAccess, creationDisposition);
+}
+
+namespace
+{
+	struct FeatureOverride
+	{
+		std::string_view text; /** Feature: line through EndFeature, empty for a tombstone. */
+		bool isTombstone;
+	};
+
+	/// The last word on every guid the log touches, plus the order new guids first showed up in.
+	struct DeltaReplay
+	{
+		std::unordered_map<int, FeatureOverride> overrides;
+		std::vector<int> firstSeenOrder;
+		std::vector<std::string_view> featuresWithoutGuid;
+
+		void Apply(int guid, FeatureOverride featureOverride)
+		{
+			if (overrides.find(guid) == overrides.end())
+			{
+				firstSeenOrder.push_back(guid);
+			}
+			overrides[guid] = featureOverride;
+		}
+	};
+
+	// Batches apply in file order, a batch cut short by a crash ends the replay
+	DeltaReplay ReplayDeltaLog(std::string_view deltaLog)
+	{
+		DeltaReplay replay;
+		PartFileTokenizer tokenizer(deltaLog.data(), deltaLog.size());
+		std::string_view line;
+
+		while (tokenizer.NextLine(line))
+		{
+			if (!startsWith(line, DeltaSaveToken))
+			{
+				continue;
+			}
+
+			size_t batchBegin = tokenizer.Offset();
+			size_t batchEnd = batchBegin;
+			bool complete = false;
+			while (!complete)
+			{
+				batchEnd = tokenizer.Offset();
+				if (!tokenizer.NextLine(line))
+				{
+					break;
+				}
+				complete = startsWith(line, EndDeltaSaveToken);
+			}
+			if (!complete)
+			{
+				break;
+			}
+
+			std::string_view batch = deltaLog.substr(batchBegin, batchEnd - batchBegin);
+			PartFileLayout layout = ScanPartFileLayout(batch.data(), batch.size());
+			for (const FeatureSpan& span : layout.features)
+			{
+				// records go into the compacted part as they are, under a fresh footer, so a damaged one stops here
+				try
+				{
+					VerifyFeatureChecksum(batch.data(), span);
+				}
+				catch (std::exception& e)
+				{
+					std::string msg = std::string(e.what()) + ", in the delta log batch at byte " + std::to_string(batchBegin);
+					throw std::exception(msg.c_str());
+				}
+
+				std::string_view text = batch.substr(span.begin, span.end - span.begin);
+				if (span.guid == -1)
+				{
+					replay.featuresWithoutGuid.push_back(text);
+				}
+				else
+				{
+					replay.Apply(span.guid, { text, false });
+				}
+			}
+
+			PartFileTokenizer batchTokenizer(batch.data(), batch.size());
+			while (batchTokenizer.NextLine(line))
+			{
+				int guid = -1;
+				if (startsWith(line, TombstoneToken) && parseInt(PartFileTokenizer::TokenValue(line, TombstoneToken), guid))
+				{
+					replay.Apply(guid, { std::string_view(), true });
+				}
+			}
+		}
+
+		return replay;
+	}
+
+	// Base features keep their place and bytes unless the log replaced or deleted them, new ones follow in log order.
+	// The result is never bigger than base plus log, so one buffer of that size holds it and goes out in one write.
+	Application::PartFileWriter FoldDeltaLog(const std::string& partFilePath, std::string_view deltaLog)
+	{
+		DeltaReplay replay = ReplayDeltaLog(deltaLog);
+
+		MappedFile basePart(partFilePath);
+		std::string partFileName = basePart.IsOpen() ? std::string() : std::filesystem::path(partFilePath).stem().string();
+		Application::PartFileWriter compacted(basePart.Size() + deltaLog.size() + PartFileNameToken.size() + partFileName.size() + 2);
+
+		std::unordered_set<int> written;
+		if (basePart.IsOpen())
+		{
+			PartFileLayout layout = ScanPartFileLayout(basePart.Data(), basePart.Size());
+
+			// the merged part gets a fresh checksum, so damage has to be caught before it would cover it
+			PartFileChecksumCheck integrity(basePart.Data(), basePart.Size(), layout);
+			integrity.CheckFeatures(0, layout.features.size());
+			integrity.Verify();
+
+			size_t headerEnd = layout.features.empty() ? layout.footerBegin : layout.features.front().begin;
+			compacted.AddText(std::string_view(basePart.Data(), headerEnd));
+			if (layout.integrity.empty())
+			{
+				if (headerEnd > 0 && basePart.Data()[headerEnd - 1] != '\n')
+				{
+					compacted.AddText("\n");
+				}
+				compacted.AddIntegrityHeader();
+			}
+
+			for (const FeatureSpan& span : layout.features)
+			{
+				std::unordered_map<int, FeatureOverride>::const_iterator found = replay.overrides.find(span.guid);
+				if (span.guid == -1 || found == replay.overrides.end())
+				{
+					compacted.AddText(std::string_view(basePart.Data() + span.begin, span.end - span.begin));
+				}
+				else if (!found->second.isTombstone && written.insert(span.guid).second)
+				{
+					compacted.AddText(found->second.text);
+				}
+			}
+
+			// the base may end without a newline, features appended after it need their own line
+			if (basePart.Size() > 0 && basePart.Data()[basePart.Size() - 1] != '\n')
+			{
+				compacted.AddText("\n");
+			}
+		}
+		else
+		{
+			compacted.AddText(PartFileNameToken);
+			compacted.AddText(partFileName);
+			compacted.AddText("\n");
+			compacted.AddIntegrityHeader();
+		}
+
+		for (int guid : replay.firstSeenOrder)
+		{
+			const FeatureOverride& featureOverride = replay.overrides[guid];
+			if (!featureOverride.isTombstone && written.insert(guid).second)
+			{
+				compacted.AddText(featureOverride.text);
+			}
+		}
+		for (std::string_view text : replay.featuresWithoutGuid)
+		{
+			compacted.AddText(text);
+		}
+
+		// the old footer was left behind with the base, this one covers the merged part
+		compacted.AddChecksumFooter();
+		return compacted;
+	}
+}
+
+
+Application::PartDeltaLog::PartDeltaLog(const std::string& partFilePath)
+	: m_partFilePath(partFilePath), m_deltaLogPath(GetDeltaLogPath(partFilePath)), m_sequence(0), m_compactionRatio(DefaultCompactionRatio),
+	m_processMutex(CreateDeltaLogMutex(m_deltaLogPath))
+{
+
+}
+
+Application::PartDeltaLog::~PartDeltaLog()
+{
+	try
+	{
+		WaitForCompaction();
+	}
+	catch (...)
+	{
+		// the log is still on disk, the next open folds it in
+	}
+	CloseHandle(m_processMutex);
+}
+
+std::string Application::PartDeltaLog::GetDeltaLogPath(const std::string& partFilePath)
+{
+	return partFilePath + ".delta";
+}
+
+bool Application::PartDeltaLog::HasPendingDeltas(const std::string& partFilePath)
+{
+	return FileSizeInBytes(GetDeltaLogPath(partFilePath)) > 0;
+}
+
+bool Application::PartDeltaLog::ReadFolded(const std::string& partFilePath, std::string& foldedPart)
+{
+	std::string deltaLogPath = GetDeltaLogPath(partFilePath);
+	HANDLE processMutex = CreateDeltaLogMutex(deltaLogPath);
+	bool folded = false;
+	try
+	{
+		// the part and log are read together, a compaction elsewhere cannot swap one out between them
+		DeltaLogProcessLock processLock(processMutex);
+		std::string deltaLog;
+		folded = ReadWholeFile(deltaLogPath, deltaLog) && !deltaLog.empty();
+		if (folded)
+		{
+			foldedPart = FoldDeltaLog(partFilePath, deltaLog).GetText();
+		}
+	}
+	catch (...)
+	{
+		CloseHandle(processMutex);
+		throw;
+	}
+	CloseHandle(processMutex);
+	return folded;
+}
+
+void Application::PartDeltaLog::AppendSave(const std::string& featureRecords, const std::vector<int>& deletedGuids)
+{
+	AppendSave(std::vector<std::string_view>{ featureRecords }, deletedGuids);
+}
+
+void Application::PartDeltaLog::AppendSave(const std::vector<std::string_view>& featureRecords, const std::vector<int>& deletedGuids)
+{
+	std::lock_guard<std::mutex> lock(m_logMutex);
+	DeltaLogProcessLock processLock(m_processMutex);
+
+	// the sequence only numbers this session's saves for people reading the log, replay goes by file order
+	std::string batchBegin;
+	batchBegin.append(DeltaSaveToken).append(std::to_string(++m_sequence)).append("\n");
+	std::string batchEnd;
+	for (int guid : deletedGuids)
+	{
+		batchEnd.append(TombstoneToken).append(std::to_string(guid)).append("\n");
+	}
+	batchEnd.append(EndDeltaSaveToken).append("\n");
+
+	// a batch cut short between segments has no EndDeltaSave line, replay ignores it
+	std::vector<std::string_view> batch;
+	batch.reserve(featureRecords.size() + 2);
+	batch.push_back(batchBegin);
+	batch.insert(batch.end(), featureRecords.begin(), featureRecords.end());
+	batch.push_back(batchEnd);
+	WriteFileDurably(m_deltaLogPath, batch, FILE_APPEND_DATA, OPEN_ALWAYS);
+}
+
+bool Application::PartDeltaLog::NeedsCompaction()
+{
+	uint64_t logSize = FileSizeInBytes(m_deltaLogPath);
+	return logSize > 0 && logSize > m_compactionRatio * FileSizeInBytes(m_partFilePath);
+}
+
+void Application::PartDeltaLog::Compact()
+{
+	WaitForCompaction();
+	CompactLog();
+}
+
+void Application::PartDeltaLog::StartBackgroundCompaction()
+{
+	if (m_compaction.valid())
+	{
+		if (m_compaction.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		{
+			return;
+		}
+		m_compaction.get();
+	}
+
+	m_compaction = ThreadPool::GetInstance().Submit([this]() { CompactLog(); });
+}
+
+void Application::PartDeltaLog::WaitForCompaction()
+{
+	if (m_compaction.valid())
+	{
+		m_compaction.get();
+	}
+}
+
+void Application::PartDeltaLog::Clear()
+{
+	WaitForCompaction();
+	std::lock_guard<std::mutex> lock(m_logMutex);
+	DeltaLogProcessLock processLock(m_processMutex);
+	DeleteFileA(m_deltaLogPath.c_str());
+}
+
+void Application::PartDeltaLog::CompactLog()
+{
+	std::string deltaLog;
+	FileStamp partStamp;
+	{
+		std::lock_guard<std::mutex> lock(m_logMutex);
+		DeltaLogProcessLock processLock(m_processMutex);
+		if (!ReadWholeFile(m_deltaLogPath, deltaLog) || deltaLog.empty())
+		{
+			return;
+		}
+		partStamp = GetFileStamp(m_partFilePath);
+	}
+
+	// The merge runs unlocked, saves from this process and others keep appending behind the snapshot we took.
+	// Flushed before the rename below, so the rename never exposes a half written file.  Named for this process,
+	// another one may be merging the same part
+	std::string compactedPath = m_partFilePath + ".compact" + std::to_string(GetCurrentProcessId());
+	WriteFileDurably(compactedPath, FoldDeltaLog(m_partFilePath, deltaLog).GetSegments(), GENERIC_WRITE, CREATE_ALWAYS);
+
+	std::lock_guard<std::mutex> lock(m_logMutex);
+	DeltaLogProcessLock processLock(m_processMutex);
+	std::string currentLog;
+	ReadWholeFile(m_deltaLogPath, currentLog);
+	if (!(GetFileStamp(m_partFilePath) == partStamp) || currentLog.compare(0, deltaLog.size(), deltaLog) != 0)
+	{
+		// another process compacted or rewrote the part meanwhile, what is left in the log is newer than our image
+		DeleteFileA(compactedPath.c_str());
+		return;
+	}
+	std::string tail = currentLog.substr(deltaLog.size());
+
+	if (!MoveFileExA(compactedPath.c_str(), m_partFilePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+	{
+		DeleteFileA(compactedPath.c_str());
+		throw std::exception("Unable to replace part file with its compacted image");
+	}
+
+	// A crash before the log is cut back only means the folded batches replay again, which changes nothing
+	if (tail.empty())
+	{
+		DeleteFileA(m_deltaLogPath.c_str());
+	}
+	else
+	{
+		std::string tailPath = m_deltaLogPath + ".compact";
+		WriteFileDurably(tailPath, tail, GENERIC_WRITE, CREATE_ALWAYS);
+		MoveFileExA(tailPath.c_str(), m_deltaLogPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH);
+	}
+}
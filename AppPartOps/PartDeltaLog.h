@@ -0,0 +1,106 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <mutex>
+#include <future>
+#include <cstdint>
+
+namespace Application
+{
+	/// <summary>
+	/// Append only log of part saves kept next to the part as <part>.delta.
+	/// Each save is one batch in the text part format:
+	///
+	///   DeltaSave:<sequence>
+	///   Feature:Extrude ... EndFeature    a changed or added feature, latest version
+	///   Tombstone:<guid>                  a deleted feature
+	///   EndDeltaSave
+	///
+	/// A batch missing its EndDeltaSave line was cut short and is ignored.
+	/// Compaction folds the log into the part file by guid and truncates it.
+	/// Appends, compaction and Clear lock a named mutex, so processes saving the
+	/// same part take turns.  A compaction that finds the part replaced by another
+	/// process meanwhile leaves the log as it is.
+	/// </summary>
+	class APPPARTOPS_API PartDeltaLog
+	{
+	public:
+		PartDeltaLog(const std::string& partFilePath);
+		virtual ~PartDeltaLog();
+
+		PartDeltaLog() = delete;
+		PartDeltaLog(const PartDeltaLog&) = delete;
+		PartDeltaLog& operator=(const PartDeltaLog&) = delete;
+
+		static std::string GetDeltaLogPath(const std::string& partFilePath);
+
+		/// <summary>
+		/// True when saves are waiting in a log next to partFilePath.
+		/// </summary>
+		static bool HasPendingDeltas(const std::string& partFilePath);
+
+		/// <summary>
+		/// The part file with its log folded in, read without writing either, for opens
+		/// that leave the part as it is.  False, and foldedPart untouched, when there is
+		/// no log.  Throws std::exception if the part fails its integrity checks.
+		/// </summary>
+		static bool ReadFolded(const std::string& partFilePath, std::string& foldedPart);
+
+		/// <summary>
+		/// Writes one batch and flushes it to disk, the cost follows the size of
+		/// featureRecords not the part.  Throws std::exception if the write fails.
+		/// </summary>
+		void AppendSave(const std::string& featureRecords, const std::vector<int>& deletedGuids);
+
+		/// <summary>
+		/// AppendSave with the records in pieces, as PartFileWriter::GetSegments gives
+		/// them, written one after the other without joining them first.
+		/// </summary>
+		void AppendSave(const std::vector<std::string_view>& featureRecords, const std::vector<int>& deletedGuids);
+
+		/// <summary>
+		/// True once the log has grown past the compaction ratio of the part file size.
+		/// </summary>
+		bool NeedsCompaction();
+
+		/// <summary>
+		/// Folds the log into the part file on the calling thread, waits for a background compaction first.
+		/// </summary>
+		void Compact();
+
+		/// <summary>
+		/// Runs Compact on the ThreadPool unless one is already running.  Saves made
+		/// meanwhile stay in the log.  A failure is rethrown by the next
+		/// StartBackgroundCompaction, Compact or WaitForCompaction.
+		/// </summary>
+		void StartBackgroundCompaction();
+		void WaitForCompaction();
+
+		/// <summary>
+		/// Deletes the log, for a part just written whole with everything saved to it.
+		/// Waits for a background compaction first.
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Log size over part file size that triggers compaction, 0.5 by default.
+		/// </summary>
+		void SetCompactionRatio(double compactionRatio)
+		{
+			m_compactionRatio = compactionRatio;
+		}
+
+	private:
+		void CompactLog();
+
+		std::string m_partFilePath;
+		std::string m_deltaLogPath;
+		uint64_t m_sequence;
+		double m_compactionRatio;
+		std::mutex m_logMutex; /** Held around appends and while the compacted files are swapped in. */
+		void* m_processMutex; /** Named Win32 mutex shared with other processes saving the part, taken inside m_logMutex. */
+		std::future<void> m_compaction;
+	};
+}
@@ -0,0 +1,146 @@
+#include "PartDiff.h"
+#include "LazyFeatureIndex.h"
+#include "PartArchive.h"
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include "..\Core\ContentHash.h"
+#include "..\Core\PartFileWritable.h"
+#include "..\Core\ThreadPool.h"
+
+using namespace Application;
+
+static std::vector<uint64_t> HashFeatureTexts(const LazyFeatureIndex& index)
+{
+	std::vector<uint64_t> hashes(index.GetFeatureCount(), 0);
+	ThreadPool::GetInstance().ParallelFor(hashes.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			std::string_view text = index.GetFeatureText(i);
+			hashes[i] = HashContent(text.data(), text.size());
+		}
+	});
+	return hashes;
+}
+
+// The feature read up to its latest version and written back out, empty when it has no reader or writer
+static std::string ReadCanonicalText(const LazyFeatureIndex& index, size_t featureIndex)
+{
+	std::unique_ptr<GuidObject> feature(index.ReadFeature(featureIndex));
+	IPartFileWritable* writable = dynamic_cast<IPartFileWritable*>(feature.get());
+	std::string text;
+	if (writable != nullptr)
+	{
+		writable->WriteFeature(text);
+	}
+	return text;
+}
+
+// Only the last feature of a repeated guid counts, the one the index hands out
+static bool IsComparedFeature(const LazyFeatureIndex& index, size_t featureIndex)
+{
+	const FeatureSpan& span = index.GetFeature(featureIndex);
+	return span.guid != -1 && !span.isRoutingFeature && index.FindFeatureIndex(span.guid) == featureIndex;
+}
+
+PartDiffResult DiffPartFiles(const LazyFeatureIndex& oldIndex, const LazyFeatureIndex& newIndex)
+{
+	auto start = std::chrono::steady_clock::now();
+	PartDiffResult result;
+
+	std::vector<uint64_t> oldHashes = HashFeatureTexts(oldIndex);
+	std::vector<uint64_t> newHashes = HashFeatureTexts(newIndex);
+
+	// Features in both parts whose text differs, only these are read
+	std::vector<size_t> oldCandidates;
+	std::vector<size_t> newCandidates;
+	for (size_t oldFeature = 0; oldFeature < oldIndex.GetFeatureCount(); oldFeature++)
+	{
+		if (!IsComparedFeature(oldIndex, oldFeature))
+		{
+			continue;
+		}
+		size_t newFeature = newIndex.FindFeatureIndex(oldIndex.GetFeature(oldFeature).guid);
+		if (newFeature == LazyFeatureIndex::NoFeature)
+		{
+			continue;
+		}
+		if (oldHashes[oldFeature] == newHashes[newFeature])
+		{
+			result.unchangedCount++;
+			continue;
+		}
+		oldCandidates.push_back(oldFeature);
+		newCandidates.push_back(newFeature);
+	}
+
+	std::vector<char> changed(oldCandidates.size(), 0);
+	ThreadPool::GetInstance().ParallelFor(oldCandidates.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			std::string oldText = ReadCanonicalText(oldIndex, oldCandidates[i]);
+			std::string newText = ReadCanonicalText(newIndex, newCandidates[i]);
+			changed[i] = oldText.empty() || oldText != newText;
+		}
+	});
+	result.readFeatureCount = 2 * oldCandidates.size();
+
+	size_t candidate = 0;
+	for (size_t oldFeature = 0; oldFeature < oldIndex.GetFeatureCount(); oldFeature++)
+	{
+		if (!IsComparedFeature(oldIndex, oldFeature))
+		{
+			continue;
+		}
+		const FeatureSpan& oldSpan = oldIndex.GetFeature(oldFeature);
+		if (newIndex.FindFeatureIndex(oldSpan.guid) == LazyFeatureIndex::NoFeature)
+		{
+			result.differences.push_back({ oldSpan.guid, PartFeatureChange::Removed, std::string(oldSpan.featureType) });
+		}
+		else if (candidate < oldCandidates.size() && oldCandidates[candidate] == oldFeature)
+		{
+			if (changed[candidate])
+			{
+				const FeatureSpan& newSpan = newIndex.GetFeature(newCandidates[candidate]);
+				result.differences.push_back({ oldSpan.guid, PartFeatureChange::Changed, std::string(newSpan.featureType) });
+			}
+			else
+			{
+				result.unchangedCount++;
+				result.rewrittenCount++;
+			}
+			candidate++;
+		}
+	}
+
+	for (size_t newFeature = 0; newFeature < newIndex.GetFeatureCount(); newFeature++)
+	{
+		const FeatureSpan& newSpan = newIndex.GetFeature(newFeature);
+		if (IsComparedFeature(newIndex, newFeature) && oldIndex.FindFeatureIndex(newSpan.guid) == LazyFeatureIndex::NoFeature)
+		{
+			result.differences.push_back({ newSpan.guid, PartFeatureChange::Added, std::string(newSpan.featureType) });
+		}
+	}
+
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+PartDiffResult DiffPartFiles(const std::string& oldPartFilePath, const std::string& newPartFilePath)
+{
+	// the lazy index reads a missing part as an empty one, which would diff as everything added or removed
+	for (const std::string& partFilePath : { oldPartFilePath, newPartFilePath })
+	{
+		if (!PartArchive::IsArchivedPartPath(partFilePath) && !std::filesystem::is_regular_file(partFilePath))
+		{
+			std::string msg = "Unable to open part file " + partFilePath;
+			throw std::exception(msg.c_str());
+		}
+	}
+
+	LazyFeatureIndex oldIndex(oldPartFilePath);
+	LazyFeatureIndex newIndex(newPartFilePath);
+	return DiffPartFiles(oldIndex, newIndex);
+}
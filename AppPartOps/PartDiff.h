@@ -0,0 +1,52 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <string>
+#include <vector>
+
+namespace Application
+{
+	class LazyFeatureIndex;
+}
+
+enum class PartFeatureChange
+{
+	Added, /** Only the new part has the guid. */
+	Removed, /** Only the old part has the guid. */
+	Changed /** Both have it and its fields differ once read up to the latest version. */
+};
+
+struct PartFeatureDifference
+{
+	int guid;
+	PartFeatureChange change;
+	std::string featureType; /** From the new part, from the old part for Removed. */
+};
+
+/// <summary>
+/// What DiffPartFiles found.
+/// </summary>
+struct PartDiffResult
+{
+	/// <summary>
+	/// Removed and Changed in the old part's feature order, then Added in the new part's.
+	/// </summary>
+	std::vector<PartFeatureDifference> differences;
+	size_t unchangedCount = 0;
+	size_t rewrittenCount = 0; /** Unchanged features whose text differed, such as one only version upped. */
+	size_t readFeatureCount = 0; /** Features read from either part, every other one was only hashed. */
+	double seconds = 0;
+};
+
+/// <summary>
+/// Compares two text part files feature by feature, matched by guid.  The features'
+/// text is hashed on the ThreadPool and only those whose text differs between the
+/// two parts are read, both sides up to their latest version and written back out
+/// canonically, so a version up or reordered fields do not count as a change.  Runs
+/// on the LazyFeatureIndex of each part, nothing is registered with the
+/// GuidObjectManager.  Features without a guid and routing features are left out,
+/// as the lazy index leaves them out, and a guid repeated in one part is compared
+/// by its last feature.  Throws std::exception if a part cannot be opened or fails
+/// its integrity checks.
+/// </summary>
+APPPARTOPS_API PartDiffResult DiffPartFiles(const std::string& oldPartFilePath, const std::string& newPartFilePath);
+APPPARTOPS_API PartDiffResult DiffPartFiles(const Application::LazyFeatureIndex& oldIndex, const Application::LazyFeatureIndex& newIndex);
@@ -0,0 +1,259 @@
+#include "PartFileConverter.h"
+#include "BinaryPartFormat.h"
+#include "BinaryPartImage.h"
+#include "BinaryPartWriter.h"
+#include "PartOpsInternal.h"
+#include <iterator>
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\StringUtils.h"
+
+using namespace Application;
+
+namespace
+{
+	// Which text key fills which record field, the same table drives both directions
+	template <typename Record>
+	struct FieldBinding
+	{
+		std::string_view token;
+		BinaryPart::StringRef Record::* field;
+	};
+
+	template <typename Record>
+	struct FeatureLayout
+	{
+		std::string_view typeName;
+		bool isRoutingFeature;
+		std::string_view versionToken;
+		std::string_view guidToken; /** Empty when the text format carries no guid. */
+		const FieldBinding<Record>* fields;
+		size_t fieldCount;
+	};
+
+	const FieldBinding<BinaryPart::ExtrudeRecord> ExtrudeFields[] =
+	{
+		{ Extrude_DistanceToken, &BinaryPart::ExtrudeRecord::distance },
+		{ Extrude_TargetFaceToken, &BinaryPart::ExtrudeRecord::targetFace },
+		{ Extrude_VectorToken, &BinaryPart::ExtrudeRecord::vectorObject },
+		{ Extrude_BooleanToken, &BinaryPart::ExtrudeRecord::booleanType },
+		{ Extrude_IsAdditionToken, &BinaryPart::ExtrudeRecord::isAddition },
+		{ Extrude_IsSubtractionToken, &BinaryPart::ExtrudeRecord::isSubtraction },
+	};
+
+	const FieldBinding<BinaryPart::BlockRecord> BlockFields[] =
+	{
+		{ Block_OriginToken, &BinaryPart::BlockRecord::origin },
+		{ Block_LengthToken, &BinaryPart::BlockRecord::length },
+		{ Block_WidthToken, &BinaryPart::BlockRecord::width },
+		{ Block_HeightToken, &BinaryPart::BlockRecord::height },
+	};
+
+	const FieldBinding<BinaryPart::WireRecord> WireFields[] =
+	{
+		{ Wire_DistanceToken, &BinaryPart::WireRecord::distance },
+	};
+
+	const FeatureLayout<BinaryPart::ExtrudeRecord> ExtrudeLayout =
+	{
+		"Extrude", false, Extrude_VersionToken, Extrude_GuidToken, ExtrudeFields, std::size(ExtrudeFields)
+	};
+
+	const FeatureLayout<BinaryPart::BlockRecord> BlockLayout =
+	{
+		"Block", false, Block_VersionToken, Block_GuidToken, BlockFields, std::size(BlockFields)
+	};
+
+	const FeatureLayout<BinaryPart::WireRecord> WireLayout =
+	{
+		"Wire", true, Wire_VersionToken, "", WireFields, std::size(WireFields)
+	};
+
+	// Reads the body of one feature, the Feature: line has been consumed already
+	template <typename Record>
+	void ReadTextFeature(PartFileTokenizer& tokenizer, const FeatureLayout<Record>& layout, BinaryPartWriter& writer)
+	{
+		Record record = {};
+		record.guid = BinaryPart::NoGuid;
+		for (size_t i = 0; i < layout.fieldCount; i++)
+		{
+			record.*(layout.fields[i].field) = { BinaryPart::NoStringOffset, 0 };
+		}
+
+		int version = 0;
+		std::string_view endToken = layout.isRoutingFeature ? EndRoutingFeatureToken : EndFeatureToken;
+		std::string_view line;
+		while (tokenizer.NextLine(line))
+		{
+			if (startsWith(line, endToken))
+			{
+				break;
+			}
+			else if (startsWith(line, layout.versionToken))
+			{
+				if (!parseInt(PartFileTokenizer::TokenValue(line, layout.versionToken), version))
+				{
+					throw std::exception("Malformed feature version in part file");
+				}
+			}
+			else if (!layout.guidToken.empty() && startsWith(line, layout.guidToken))
+			{
+				int guid = BinaryPart::NoGuid;
+				if (!parseInt(PartFileTokenizer::TokenValue(line, layout.guidToken), guid))
+				{
+					throw std::exception("Malformed feature guid in part file");
+				}
+				record.guid = guid;
+			}
+			else
+			{
+				for (size_t i = 0; i < layout.fieldCount; i++)
+				{
+					if (startsWith(line, layout.fields[i].token))
+					{
+						record.*(layout.fields[i].field) = writer.AddString(PartFileTokenizer::TokenValue(line, layout.fields[i].token));
+						break;
+					}
+				}
+			}
+		}
+
+		writer.AddFeature((uint16_t)version, record);
+	}
+
+	template <typename Record>
+	void AppendTextFeature(std::string& text, const BinaryPartImage& image, const FeatureLayout<Record>& layout,
+		const BinaryPart::TocEntry& tocEntry, const Record& record)
+	{
+		text.append(layout.isRoutingFeature ? RoutingFeatureToken : FeatureToken).append(layout.typeName).append(1, '\n');
+		text.append(layout.versionToken).append(std::to_string(tocEntry.version)).append(1, '\n');
+		for (size_t i = 0; i < layout.fieldCount; i++)
+		{
+			BinaryPart::StringRef ref = record.*(layout.fields[i].field);
+			if (image.HasString(ref))
+			{
+				text.append(layout.fields[i].token).append(image.GetString(ref)).append(1, '\n');
+			}
+		}
+		if (!layout.guidToken.empty() && tocEntry.guid != BinaryPart::NoGuid)
+		{
+			text.append(layout.guidToken).append(std::to_string(tocEntry.guid)).append(1, '\n');
+		}
+		text.append(layout.isRoutingFeature ? EndRoutingFeatureToken : EndFeatureToken).append(1, '\n');
+	}
+}
+
+void AppendBinaryFeatureAsText(std::string& text, const BinaryPartImage& image, uint32_t featureIndex)
+{
+	const BinaryPart::TocEntry& tocEntry = image.GetTocEntry(featureIndex);
+	switch ((BinaryPart::FeatureType)tocEntry.featureType)
+	{
+	case BinaryPart::FeatureType::Extrude:
+		AppendTextFeature(text, image, ExtrudeLayout, tocEntry, image.GetExtrude(tocEntry.recordIndex));
+		break;
+	case BinaryPart::FeatureType::Block:
+		AppendTextFeature(text, image, BlockLayout, tocEntry, image.GetBlock(tocEntry.recordIndex));
+		break;
+	case BinaryPart::FeatureType::Wire:
+		AppendTextFeature(text, image, WireLayout, tocEntry, image.GetWire(tocEntry.recordIndex));
+		break;
+	default:
+		throw std::exception("Unknown feature type in binary part file");
+	}
+}
+
+
+void ConvertTextPartToBinary(const std::string& textPartPath, const std::string& binaryPartPath)
+{
+	MappedFile mappedFile(textPartPath);
+	if (!mappedFile.IsOpen())
+	{
+		throw std::exception("Unable to open text part file");
+	}
+
+	BinaryPartWriter writer;
+	PartFileTokenizer tokenizer(mappedFile.Data(), mappedFile.Size());
+	std::string_view line;
+	while (tokenizer.NextLine(line))
+	{
+		if (startsWith(line, PartFileNameToken))
+		{
+			writer.SetPartFileName(PartFileTokenizer::TokenValue(line, PartFileNameToken));
+		}
+		else if (startsWith(line, SchemaVersionToken))
+		{
+			int schemaVersion = -1;
+			if (!parseInt(PartFileTokenizer::TokenValue(line, SchemaVersionToken), schemaVersion))
+			{
+				throw std::exception("Malformed SchemaVersion in part file");
+			}
+			writer.SetSchemaVersion(schemaVersion);
+		}
+		else if (startsWith(line, FeatureToken))
+		{
+			std::string_view featureType = PartFileTokenizer::TokenValue(line, FeatureToken);
+			if (featureType == ExtrudeLayout.typeName)
+			{
+				ReadTextFeature(tokenizer, ExtrudeLayout, writer);
+			}
+			else if (featureType == BlockLayout.typeName)
+			{
+				ReadTextFeature(tokenizer, BlockLayout, writer);
+			}
+			else
+			{
+				throw std::exception(("No binary record for feature type " + std::string(featureType)).c_str());
+			}
+		}
+		else if (startsWith(line, RoutingFeatureToken))
+		{
+			std::string_view featureType = PartFileTokenizer::TokenValue(line, RoutingFeatureToken);
+			if (featureType == WireLayout.typeName)
+			{
+				ReadTextFeature(tokenizer, WireLayout, writer);
+			}
+			else
+			{
+				throw std::exception(("No binary record for routing feature type " + std::string(featureType)).c_str());
+			}
+		}
+	}
+
+	writer.Write(binaryPartPath);
+}
+
+void ConvertBinaryPartToText(const std::string& binaryPartPath, const std::string& textPartPath)
+{
+	BinaryPartImage image(binaryPartPath);
+
+	std::string textPart;
+	if (image.HasString(image.GetHeader().partFileName))
+	{
+		textPart.append(PartFileNameToken).append(image.GetPartFileName()).append(1, '\n');
+	}
+	if (image.GetSchemaVersion() != -1)
+	{
+		textPart.append(SchemaVersionToken).append(std::to_string(image.GetSchemaVersion())).append(1, '\n');
+	}
+
+	for (uint32_t i = 0; i < image.GetFeatureCount(); i++)
+	{
+		AppendBinaryFeatureAsText(textPart, image, i);
+	}
+
+	// the target may be a part someone has open, it is replaced whole or not at all
+	WriteFileAtomically(textPartPath, textPart);
+}
+
+void ConvertPartFile(const std::string& sourcePath, const std::string& targetPath)
+{
+	if (BinaryPartImage::IsBinaryPartFile(sourcePath))
+	{
+		ConvertBinaryPartToText(sourcePath, targetPath);
+	}
+	else
+	{
+		ConvertTextPartToBinary(sourcePath, targetPath);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <cstdint>
+#include <string>
+
+namespace Application
+{
+	class BinaryPartImage;
+}
+
+/// <summary>
+/// Writes the text part file at textPartPath out as a binary part file (.prtb).
+/// Throws std::exception on malformed input or feature types the binary format has no record for.
+/// </summary>
+APPPARTOPS_API void ConvertTextPartToBinary(const std::string& textPartPath, const std::string& binaryPartPath);
+
+/// <summary>
+/// Writes the binary part file at binaryPartPath back out in the text format.
+/// </summary>
+APPPARTOPS_API void ConvertBinaryPartToText(const std::string& binaryPartPath, const std::string& textPartPath);
+
+/// <summary>
+/// Appends the feature at featureIndex of image as the text format holds it, from its
+/// Feature: or RoutingFeature: line through its End line.
+/// </summary>
+APPPARTOPS_API void AppendBinaryFeatureAsText(std::string& text, const Application::BinaryPartImage& image, uint32_t featureIndex);
+
+/// <summary>
+/// Converts sourcePath into the other format, whichever one it is not in already.
+/// </summary>
+APPPARTOPS_API void ConvertPartFile(const std::string& sourcePath, const std::string& targetPath);
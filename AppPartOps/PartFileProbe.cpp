@@ -0,0 +1,108 @@
+#include "framework.h"
+#include "PartFileProbe.h"
+#include "BinaryPartImage.h"
+#include "PartDeltaLog.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\PartFileLineScanner.h"
+
+static const char* BinaryFeatureTypeName(uint16_t featureType)
+{
+	switch ((Application::BinaryPart::FeatureType)featureType)
+	{
+	case Application::BinaryPart::FeatureType::Extrude:
+		return "Extrude";
+	case Application::BinaryPart::FeatureType::Block:
+		return "Block";
+	case Application::BinaryPart::FeatureType::Wire:
+		return "Wire";
+	default:
+		return "Unknown";
+	}
+}
+
+static void ProbeBinaryPartFile(const std::string& partFilePath, PartFileProbe& probe)
+{
+	Application::BinaryPartImage image(partFilePath);
+
+	probe.isBinary = true;
+	probe.partFileName = image.GetPartFileName();
+	probe.schemaVersion = std::to_string(image.GetSchemaVersion());
+
+	for (uint32_t featureIndex = 0; featureIndex < image.GetFeatureCount(); ++featureIndex)
+	{
+		const Application::BinaryPart::TocEntry& tocEntry = image.GetTocEntry(featureIndex);
+		if ((Application::BinaryPart::FeatureType)tocEntry.featureType == Application::BinaryPart::FeatureType::Wire)
+		{
+			++probe.routingFeatureCount;
+		}
+		else
+		{
+			++probe.featureCount;
+		}
+		++probe.featureVersions[BinaryFeatureTypeName(tocEntry.featureType)][tocEntry.version];
+	}
+}
+
+static void ProbeTextPartFile(const MappedFile& mappedFile, PartFileProbe& probe)
+{
+	PartFileLineScanner scanner(mappedFile.Data(), mappedFile.Size());
+	PartFileLine scannedLine;
+
+	while (scanner.Next(scannedLine))
+	{
+		std::string_view line = scanner.GetLine(scannedLine);
+		std::string_view value;
+		PartFileKey key = LookupPartFileKey(line, scannedLine.keyLength, value);
+
+		if (key == PartFileKey::PartFileName)
+		{
+			probe.partFileName = value;
+		}
+		else if (key == PartFileKey::SchemaVersion)
+		{
+			probe.schemaVersion = value;
+		}
+		else if (key == PartFileKey::Feature || key == PartFileKey::RoutingFeature)
+		{
+			bool isRoutingFeature = (key == PartFileKey::RoutingFeature);
+			std::string_view featureType = value;
+			int version = -1;
+			SkipFeatureBody(scanner, featureType, isRoutingFeature, version);
+
+			if (isRoutingFeature)
+			{
+				++probe.routingFeatureCount;
+			}
+			else
+			{
+				++probe.featureCount;
+			}
+			++probe.featureVersions[std::string(featureType)][version];
+		}
+	}
+}
+
+PartFileProbe ProbePartFile(const std::string& partFilePath)
+{
+	PartFileProbe probe;
+
+	if (Application::BinaryPartImage::IsBinaryPartFile(partFilePath))
+	{
+		ProbeBinaryPartFile(partFilePath, probe);
+	}
+	else
+	{
+		MappedFile mappedFile(partFilePath);
+		if (!mappedFile.IsOpen())
+		{
+			std::string msg = "Unable to open part file " + partFilePath;
+			throw std::exception(msg.c_str());
+		}
+		ProbeTextPartFile(mappedFile, probe);
+	}
+
+	probe.hasPendingDeltas = Application::PartDeltaLog::HasPendingDeltas(partFilePath);
+	return probe;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <map>
+#include <string>
+
+/// <summary>
+/// What ProbePartFile finds out about a part file without opening it.
+/// </summary>
+struct PartFileProbe
+{
+	std::string partFileName;
+	std::string schemaVersion;
+	bool isBinary = false;
+	bool hasPendingDeltas = false; /** Saves are waiting in the delta log, the counts below are for the part file alone. */
+	size_t featureCount = 0; /** Feature: blocks. */
+	size_t routingFeatureCount = 0; /** RoutingFeature: blocks. */
+
+	/// <summary>
+	/// Feature type to the version in the file (-1 for none) to how many features have it.
+	/// </summary>
+	std::map<std::string, std::map<int, size_t>> featureVersions;
+};
+
+/// <summary>
+/// Reads the header of the part file at partFilePath and counts its features by type and
+/// version, reading no other fields.  Text parts are scanned once with the
+/// PartFileLineScanner, binary parts only have their table of contents read.  Nothing is
+/// created, registered or cached and no CoreSession observers fire, so it is safe to call
+/// from tools and from any thread.  Throws std::exception if the file cannot be opened.
+/// </summary>
+APPPARTOPS_API PartFileProbe ProbePartFile(const std::string& partFilePath);
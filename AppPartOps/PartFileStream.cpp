@@ -0,0 +1,162 @@
+#include "framework.h"
+#include "PartFileStream.h"
+#include "PartOpsInternal.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <vector>
+#include "..\Core\GuidObject.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\PartFileLineScanner.h"
+#include "..\Core\PartFileTokenizer.h"
+
+static const size_t InitialStreamBufferBytes = 1024 * 1024;
+static const size_t MinimumStreamMemoryBudget = 4096;
+
+static void VisitFeature(const char* data, size_t blockBegin, size_t bodyBegin, size_t blockEnd, std::string_view featureType,
+	bool isRoutingFeature, int fileVersion, const StreamedFeatureVisitor& visitor, PartStreamResult& result)
+{
+	PartFileTokenizer tokenizer(data + bodyBegin, blockEnd - bodyBegin);
+	int version = fileVersion;
+	std::unique_ptr<GuidObject> feature(ReadFeatureToLatestVersion(featureType, version, tokenizer));
+
+	++result.featureCount;
+	if (feature == nullptr)
+	{
+		++result.unreadFeatureCount;
+	}
+
+	StreamedFeature streamedFeature = { featureType, isRoutingFeature, fileVersion, version, feature.get(),
+		std::string_view(data + blockBegin, blockEnd - blockBegin) };
+	if (!visitor(streamedFeature))
+	{
+		result.stoppedByVisitor = true;
+	}
+}
+
+/// <summary>
+/// Visits every complete feature block in data and returns how many bytes were used up, the
+/// rest (a partial line or feature block) waits for more input unless atEnd.
+/// </summary>
+static size_t ConsumeBuffered(const char* data, size_t size, bool atEnd, const StreamedFeatureVisitor& visitor, PartStreamResult& result)
+{
+	PartFileLineScanner scanner(data, size);
+	PartFileLine scannedLine;
+	size_t consumed = 0;
+
+	// the last line has only partly arrived when the buffer does not end in \n, the lines before it are whole
+	size_t completeEnd = size;
+	if (!atEnd && size > 0 && data[size - 1] != '\n')
+	{
+		completeEnd = std::string_view(data, size).rfind('\n') + 1;
+	}
+
+	while (scanner.Next(scannedLine))
+	{
+		if (scanner.Offset() > completeEnd)
+		{
+			return consumed;
+		}
+
+		std::string_view line = scanner.GetLine(scannedLine);
+		std::string_view value;
+		PartFileKey key = LookupPartFileKey(line, scannedLine.keyLength, value);
+
+		if (key == PartFileKey::PartFileName)
+		{
+			result.partFileName = value;
+		}
+		else if (key == PartFileKey::SchemaVersion)
+		{
+			result.schemaVersion = value;
+		}
+		else if (key == PartFileKey::Feature || key == PartFileKey::RoutingFeature)
+		{
+			bool isRoutingFeature = (key == PartFileKey::RoutingFeature);
+			std::string_view featureType = value;
+			size_t blockBegin = scannedLine.begin;
+			size_t bodyBegin = scanner.Offset();
+			int fileVersion = -1;
+			bool complete = SkipFeatureBody(scanner, featureType, isRoutingFeature, fileVersion, completeEnd);
+
+			if (!complete && !atEnd)
+			{
+				return consumed;
+			}
+
+			// a block cut short at the end of the input is still handed over, like ScanPartFileLayout does
+			size_t blockEnd = complete ? scanner.Offset() : size;
+			VisitFeature(data, blockBegin, bodyBegin, blockEnd, featureType, isRoutingFeature, fileVersion, visitor, result);
+			if (result.stoppedByVisitor)
+			{
+				return blockEnd;
+			}
+		}
+
+		consumed = scanner.Offset();
+	}
+
+	return atEnd ? size : consumed;
+}
+
+PartStreamResult StreamPartFile(std::istream& input, const StreamedFeatureVisitor& visitor, size_t memoryBudgetBytes)
+{
+	if (memoryBudgetBytes < MinimumStreamMemoryBudget)
+	{
+		throw std::exception("Streaming memory budget is too small");
+	}
+
+	PartStreamResult result;
+
+	// grows towards the budget only when a feature block needs it
+	std::vector<char> buffer(std::min(InitialStreamBufferBytes, memoryBudgetBytes));
+	size_t filled = 0;
+	bool atEnd = false;
+
+	while (!atEnd)
+	{
+		if (filled == buffer.size())
+		{
+			if (buffer.size() == memoryBudgetBytes)
+			{
+				throw std::exception("A feature block in the part file is larger than the streaming memory budget");
+			}
+			buffer.resize(std::min(buffer.size() * 2, memoryBudgetBytes));
+		}
+
+		input.read(buffer.data() + filled, buffer.size() - filled);
+		if (input.bad())
+		{
+			throw std::exception("Unable to read part file stream");
+		}
+		size_t readCount = (size_t)input.gcount();
+		filled += readCount;
+		result.bytesRead += readCount;
+		result.peakBufferBytes = std::max(result.peakBufferBytes, buffer.size());
+		atEnd = input.eof();
+
+		size_t consumed = ConsumeBuffered(buffer.data(), filled, atEnd, visitor, result);
+		if (result.stoppedByVisitor)
+		{
+			break;
+		}
+
+		memmove(buffer.data(), buffer.data() + consumed, filled - consumed);
+		filled -= consumed;
+	}
+
+	return result;
+}
+
+PartStreamResult StreamPartFile(const std::string& partFilePath, const StreamedFeatureVisitor& visitor, size_t memoryBudgetBytes)
+{
+	std::ifstream partFile(partFilePath, std::ios::binary);
+	if (!partFile.is_open())
+	{
+		std::string msg = "Unable to open part file " + partFilePath;
+		throw std::exception(msg.c_str());
+	}
+	return StreamPartFile(partFile, visitor, memoryBudgetBytes);
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <functional>
+#include <istream>
+#include <string>
+#include <string_view>
+
+class GuidObject;
+
+/// <summary>
+/// One feature as StreamPartFile hands it to the visitor.  Everything here, the feature
+/// object included, is released as soon as the visitor returns.
+/// </summary>
+struct StreamedFeature
+{
+	std::string_view featureType;
+	bool isRoutingFeature;
+	int fileVersion; /** The version in the part file, -1 if it has none. */
+	int version; /** The version feature was brought up to. */
+	GuidObject* feature; /** nullptr when no reader is registered for the type and version. */
+	std::string_view text; /** The Feature: line through EndFeature as it is in the part file. */
+};
+
+/// <summary>
+/// Return false to stop the stream after this feature.
+/// </summary>
+typedef std::function<bool(const StreamedFeature& streamedFeature)> StreamedFeatureVisitor;
+
+struct PartStreamResult
+{
+	std::string partFileName;
+	std::string schemaVersion;
+	size_t featureCount = 0;
+	size_t unreadFeatureCount = 0; /** Features with no registered reader, visited with a nullptr feature. */
+	size_t bytesRead = 0;
+	size_t peakBufferBytes = 0;
+	bool stoppedByVisitor = false;
+};
+
+static const size_t DefaultStreamMemoryBudget = 16 * 1024 * 1024;
+
+/// <summary>
+/// Reads a text part file from input in one pass and hands each feature to visitor as soon as
+/// its block is complete, brought up to the latest version through the readers and version
+/// ups registered with the DataObjectReader.  Nothing is registered with the
+/// GuidObjectManager or the CoreSession and nothing is printed.  Input is buffered in at most
+/// memoryBudgetBytes, plus the one feature being visited, so any size of part streams from a
+/// file, a pipe or stdin.  Throws std::exception when a single feature block does not fit in
+/// the budget or input fails.
+/// </summary>
+APPPARTOPS_API PartStreamResult StreamPartFile(std::istream& input, const StreamedFeatureVisitor& visitor,
+	size_t memoryBudgetBytes = DefaultStreamMemoryBudget);
+
+/// <summary>
+/// StreamPartFile over the part file at partFilePath.
+/// </summary>
+APPPARTOPS_API PartStreamResult StreamPartFile(const std::string& partFilePath, const StreamedFeatureVisitor& visitor,
+	size_t memoryBudgetBytes = DefaultStreamMemoryBudget);
@@ -0,0 +1,160 @@
+#include "framework.h"
+#include "PartFileWriter.h"
+#include "PartOpsInternal.h"
+#include "..\Core\FeatureSerializer.h"
+#include "..\Core\Crc32C.h"
+#include "..\Core\GuidObject.h"
+#include "..\Core\PartFileIntegrity.h"
+#include "..\Core\PartFileIO.h"
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\PartFileWritable.h"
+
+Application::PartFileWriter::PartFileWriter(size_t expectedBytes) : m_segments(1), m_growCount(0), m_checksums(true)
+{
+	m_segments.back().reserve(expectedBytes);
+}
+
+void Application::PartFileWriter::NoteCapacity(size_t capacityBefore)
+{
+	if (m_segments.back().capacity() != capacityBefore)
+	{
+		++m_growCount;
+	}
+}
+
+void Application::PartFileWriter::AddHeader(std::string_view partFileName, std::string_view schemaVersion)
+{
+	std::string& buffer = m_segments.back();
+	size_t capacityBefore = buffer.capacity();
+	buffer.append(PartFileNameToken).append(partFileName).append("\n");
+	buffer.append(SchemaVersionToken).append(schemaVersion).append("\n");
+	NoteCapacity(capacityBefore);
+	AddIntegrityHeader();
+}
+
+void Application::PartFileWriter::AddIntegrityHeader()
+{
+	if (m_checksums)
+	{
+		size_t capacityBefore = m_segments.back().capacity();
+		m_segments.back().append(IntegrityToken).append(IntegrityCrc32CValue).append("\n");
+		NoteCapacity(capacityBefore);
+	}
+}
+
+void Application::PartFileWriter::AddFeature(GuidObject* feature)
+{
+	IPartFileWritable* writable = dynamic_cast<IPartFileWritable*>(feature);
+	if (writable == nullptr)
+	{
+		throw std::exception("Feature has no writer, it cannot be saved");
+	}
+
+	std::string& buffer = m_segments.back();
+	size_t capacityBefore = buffer.capacity();
+	size_t featureBegin = buffer.size();
+	writable->WriteFeature(buffer);
+	if (m_checksums)
+	{
+		AppendFeatureChecksum(buffer, featureBegin);
+	}
+	NoteCapacity(capacityBefore);
+}
+
+void Application::PartFileWriter::AddFeatures(const std::vector<GuidObject*>& features)
+{
+	if (features.size() <= SerializeFeaturesPerChunk)
+	{
+		for (GuidObject* feature : features)
+		{
+			AddFeature(feature);
+		}
+		return;
+	}
+
+	// the chunks become segments of their own, whatever is added next starts a new one after them
+	SerializeFeaturesInParallel(features, TypicalFeatureBytes, m_segments, m_checksums);
+	m_segments.emplace_back();
+}
+
+void Application::PartFileWriter::AddText(std::string_view text)
+{
+	size_t capacityBefore = m_segments.back().capacity();
+	m_segments.back().append(text);
+	NoteCapacity(capacityBefore);
+}
+
+void Application::PartFileWriter::AddChecksumFooter()
+{
+	if (!m_checksums)
+	{
+		return;
+	}
+
+	// chained over the segments, a parallel AddFeatures is not joined for it
+	uint32_t checksum = 0;
+	for (const std::string& segment : m_segments)
+	{
+		checksum = Crc32C(segment.data(), segment.size(), checksum);
+	}
+
+	size_t capacityBefore = m_segments.back().capacity();
+	AppendPartFileChecksum(m_segments.back(), checksum);
+	NoteCapacity(capacityBefore);
+}
+
+std::vector<std::string_view> Application::PartFileWriter::GetSegments() const
+{
+	std::vector<std::string_view> segments;
+	segments.reserve(m_segments.size());
+	for (const std::string& segment : m_segments)
+	{
+		if (!segment.empty())
+		{
+			segments.push_back(segment);
+		}
+	}
+	return segments;
+}
+
+size_t Application::PartFileWriter::GetSize() const
+{
+	size_t size = 0;
+	for (const std::string& segment : m_segments)
+	{
+		size += segment.size();
+	}
+	return size;
+}
+
+const std::string& Application::PartFileWriter::GetText()
+{
+	if (m_segments.size() > 1)
+	{
+		std::string text;
+		text.reserve(GetSize());
+		for (const std::string& segment : m_segments)
+		{
+			text.append(segment);
+		}
+		m_segments.assign(1, std::move(text));
+	}
+	return m_segments.back();
+}
+
+void Application::PartFileWriter::Write(const std::string& partFilePath) const
+{
+	WriteFileAtomically(partFilePath, GetSegments());
+}
+
+std::vector<std::string> Application::PartFileWriter::TakeSegments()
+{
+	std::vector<std::string> segments(1);
+	segments.swap(m_segments);
+	return segments;
+}
+
+std::future<void> Application::PartFileWriter::WriteAsync(const std::string& partFilePath)
+{
+	return PartFileIO::GetBackend().WriteFileAsync(partFilePath, TakeSegments());
+}
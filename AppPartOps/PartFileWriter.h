@@ -0,0 +1,125 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class GuidObject;
+
+namespace Application
+{
+	/// <summary>
+	/// Serializes a part into one buffer, sized up front so a save is a single
+	/// allocation, and writes it with one WriteFile to a temp file that is flushed
+	/// and renamed over the part.  A crash leaves the old part or the new one.
+	/// Features go in at their latest version through IPartFileWritable, so
+	/// Extrude, Block and Wire (and anything after them) all save the same way.
+	/// AddFeatures serializes large lists on the ThreadPool into chunk buffers that
+	/// Write gathers in order, the bytes are the same as adding them one by one.
+	/// Features get CRC32C checksums unless SetChecksums(false), see PartFileIntegrity.h.
+	/// </summary>
+	class APPPARTOPS_API PartFileWriter
+	{
+	public:
+		/// <summary>
+		/// Rough size of one feature in the text format, for sizing the buffer from a feature count.
+		/// </summary>
+		static const size_t TypicalFeatureBytes = 192;
+
+		/// <summary>
+		/// expectedBytes is reserved up front, the size of the part last time it was saved is a good guess.
+		/// </summary>
+		explicit PartFileWriter(size_t expectedBytes = 0);
+
+		PartFileWriter(const PartFileWriter&) = delete;
+		PartFileWriter& operator=(const PartFileWriter&) = delete;
+		PartFileWriter(PartFileWriter&&) = default;
+
+		/// <summary>
+		/// Whether features get a FeatureChecksum: line, the header an Integrity: line and
+		/// AddChecksumFooter a footer.  On by default, change it before adding anything.
+		/// </summary>
+		void SetChecksums(bool checksums)
+		{
+			m_checksums = checksums;
+		}
+		bool GetChecksums() const
+		{
+			return m_checksums;
+		}
+
+		void AddHeader(std::string_view partFileName, std::string_view schemaVersion);
+
+		/// <summary>
+		/// Appends the Integrity: header line, for a header added with AddText.
+		/// </summary>
+		void AddIntegrityHeader();
+
+		/// <summary>
+		/// Appends the feature at its latest version.  Throws std::exception for objects
+		/// that are not IPartFileWritable.
+		/// </summary>
+		void AddFeature(GuidObject* feature);
+
+		/// <summary>
+		/// Appends the features in list order, on the ThreadPool once there are more
+		/// than SerializeFeaturesPerChunk of them.  Not from inside a ThreadPool task.
+		/// </summary>
+		void AddFeatures(const std::vector<GuidObject*>& features);
+
+		/// <summary>
+		/// Appends text as it is, for features carried over from a part or log unchanged.
+		/// </summary>
+		void AddText(std::string_view text);
+
+		/// <summary>
+		/// Appends the PartFileChecksum: line over everything added so far, the last thing
+		/// a whole part gets.  Nothing when checksums are off.
+		/// </summary>
+		void AddChecksumFooter();
+
+		/// <summary>
+		/// Replaces partFilePath with the buffers, atomically, one WriteFile per buffer.
+		/// </summary>
+		void Write(const std::string& partFilePath) const;
+
+		/// <summary>
+		/// Write, queued on the PartFileIO writer thread so the caller goes on at once.
+		/// The buffers are handed over, the writer is left empty.  The future rethrows
+		/// the write's failure.
+		/// </summary>
+		std::future<void> WriteAsync(const std::string& partFilePath);
+
+		/// <summary>
+		/// Everything added so far.  After a parallel AddFeatures this joins the chunk
+		/// buffers into one, Write and the delta log take GetSegments and do not need to.
+		/// </summary>
+		const std::string& GetText();
+
+		std::vector<std::string_view> GetSegments() const;
+
+		/// <summary>
+		/// Hands the buffers over in order and leaves the writer empty, for text that
+		/// outlives the writer.
+		/// </summary>
+		std::vector<std::string> TakeSegments();
+		size_t GetSize() const;
+
+		/// <summary>
+		/// How often the buffer outgrew its reservation, 0 when expectedBytes was enough.
+		/// </summary>
+		size_t GetGrowCount() const
+		{
+			return m_growCount;
+		}
+
+	private:
+		void NoteCapacity(size_t capacityBefore);
+
+		// added text in order, appends go to the last one
+		std::vector<std::string> m_segments;
+		size_t m_growCount;
+		bool m_checksums;
+	};
+}
@@ -1,139 +1,1091 @@
-#include "PartOps.h"
-#include "PartOpsInternal.h"
-#include "DelMeBadPattern.h"
-#include <iostream>
-#include "..\Journaling\Journaling.h"
-#include "..\Journaling\JournalHelpers.h"
-#include "..\Core\GuidObject.h"
-#include "..\AppLibrary\Feature.h"
-#include "..\Core\StringUtils.h"
-#include "..\Core\CoreSession.h"
-#include "..\Core\Observer.h"
-
-using namespace std;
-
-
-Application::PartFile::PartFile(std::string partFilePath, int guid) : GuidObject(guid),  m_partFilePath(partFilePath)
-{
-	cout << "    PartFile::PartFile called with " << partFilePath << " " << guid << endl;
-}
-
-void Application::PartFile::ClosePart()
-{
-	cout << "    PartFile::ClosePart called" << endl;
-
-	PartOpsNotifierData partOpsNotifierData;
-	partOpsNotifierData.guid = this->GetGuid();
-	partOpsNotifierData.partName = this->m_partFilePath;
-	PartOpsNotifierData* ptr = &partOpsNotifierData;
-
-	CoreSession::GetInstance().CreateMessage(Observer::ClosePart, (void*)ptr);
-}
-
-void Application::PartFile::SavePart()
-{
-	cout << "    PartFile::SavePart called" << endl;
-
-	PartOpsNotifierData partOpsNotifierData;
-	partOpsNotifierData.guid = this->GetGuid();
-	partOpsNotifierData.partName = this->m_partFilePath;
-	PartOpsNotifierData* ptr = &partOpsNotifierData;
-
-	CoreSession::GetInstance().CreateMessage(Observer::SavePart, (void*)ptr);
-}
-
-void Application::PartFile::MakeWidgetFeature(bool option1, int values)
-{
-	cout << "    MakeWidgetFeature called with " << option1 << " " << values << endl;
-}
-
-Application::PartFile* Application::PartFile::CreatePartFile(std::string partFilePath)
-{
-	int guid = 123424; 
-
-	Application::PartFile* partFile = new Application::PartFile( partFilePath, guid);
-	GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(guid, partFile);
-
-	PartOpsNotifierData partOpsNotifierData;
-	partOpsNotifierData.guid = guid;
-	partOpsNotifierData.partName = partFilePath;
-	PartOpsNotifierData* ptr = &partOpsNotifierData;
-
-	CoreSession::GetInstance().CreateMessage(Observer::CreatePart, (void*)ptr);
-	return partFile;
-}
-
-Application::PartFile* Application::PartFile::OpenPartFile(std::string partFilePath)
-{
-	int guid = -1;
-	
-	ReadInPartFile(guid, partFilePath);
-
-
-	PartFile* partFile = new PartFile(partFilePath, guid);
-	GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(guid, partFile);
-	
-	PartOpsNotifierData partOpsNotifierData;
-	partOpsNotifierData.guid = guid;
-	partOpsNotifierData.partName = partFilePath;
-	PartOpsNotifierData* ptr = &partOpsNotifierData;
-
-	CoreSession::GetInstance().CreateMessage(Observer::OpenPart, (void*)ptr);
-
-	return partFile;
-}
-
-
-
-std::string PartFileNameToken = "PartFileName:";
-std::string SchemaVersionToken = "SchemaVersion:";
-
-
-
-void ReadInPartFile(int & guid, std::string partFilePath)
-{
-	guid = 54321;
-	string line;
-	ifstream localPartFile(partFilePath);
-	if (localPartFile.is_open())
-	{
-		while (getline(localPartFile, line))
-		{
-			cout << line << '\n';
-
-			if (startsWith(line, PartFileNameToken))
-			{
-				std::string partFileName = line.substr(PartFileNameToken.size(), line.size() - PartFileNameToken.size());
-				cout << "    "<< PartFileNameToken << " " << partFileName << endl;
-			}
-			else if (startsWith(line, SchemaVersionToken))
-			{
-				std::string partFileName = line.substr(SchemaVersionToken.size(), line.size() - SchemaVersionToken.size());
-				cout << "    "<< SchemaVersionToken <<" " << partFileName << endl;
-			}
-			else if(startsWith(line, FeatureToken))
-			{
-				std::string featureType = line.substr(FeatureToken.size(), line.size() - FeatureToken.size());
-				ProcessFeature(featureType, localPartFile);
-			}
-
-
-		}
-		localPartFile.close();
-	}
-
-
-}
-
-
-
-
-
-
-
-
-
-
-
-
-
+#include "PartOps.h"
+#include "PartOpsInternal.h"
+#include "BinaryPartImage.h"
+#include "LazyFeatureIndex.h"
+#include "PartArchive.h"
+#include "PartDeltaLog.h"
+#include "PartFileWriter.h"
+#include "PartParseCache.h"
+#include "PartSaveQueue.h"
+#include "SharedPartCache.h"
+#include "DelMeBadPattern.h"
+#include <iostream>
+#include "..\Journaling\Journaling.h"
+#include "..\Journaling\JournalHelpers.h"
+#include "..\Core\GuidObject.h"
+#include "..\AppLibrary\Feature.h"
+#include "..\Core\StringUtils.h"
+#include "..\Core\CoreSession.h"
+#include "..\Core\Observer.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\PartFileIntegrity.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\ThreadPool.h"
+#include "..\Core\ContentHash.h"
+#include "..\Core\PartFileWatcher.h"
+#include "..\Core\PartFileIO.h"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+static bool verifyPartIntegrity = true;
+static bool watchPartFilesForChanges = false;
+
+// What a part written whole says it is, the features in it are at their latest versions
+static const std::string_view SavedSchemaVersion = "12";
+
+// Parts OpenPartFiles reads ahead, their buffers are held until each part is read
+static const size_t OpenBatchSize = 64;
+
+static std::vector<int> ReadInMappedPartFile(std::string partFilePath);
+static std::vector<int> ReadInParallelPartFile(std::string partFilePath);
+static std::vector<int> ReadInMappedPart(const char* data, size_t size);
+static std::vector<int> ReadInParallelPart(const char* data, size_t size);
+static std::vector<GuidObject*> ReadParallelFeatures(const char* data, size_t size);
+
+
+Application::PartFile::PartFile(std::string partFilePath, int guid) : GuidObject(guid),  m_partFilePath(partFilePath), m_binaryImage(nullptr), m_lazyIndex(nullptr), m_deltaLog(nullptr), m_hasBaseFile(true), m_holdsAllFeatures(false), m_watchId(PartFileWatcher::NoWatch)
+{
+	cout << "    PartFile::PartFile called with " << partFilePath << " " << guid << endl;
+}
+
+Application::PartFile::~PartFile()
+{
+	StopWatching();
+	if (m_deltaLog != nullptr)
+	{
+		try
+		{
+			PartSaveQueue::GetInstance().Flush(m_partFilePath);
+		}
+		catch (std::exception&)
+		{
+			// the saves stay queued with the log they share, the next Barrier or Flush of the part writes them or throws.
+			// PartSaveQueueStatistics::lastFailure has why meanwhile
+		}
+	}
+	ReleaseLazyIndex();
+	if (m_binaryImage != nullptr)
+	{
+		GuidObjectManager::GetGuidObjectManager().RemoveLazyObjectSource(m_binaryImage);
+		delete m_binaryImage;
+	}
+}
+
+void Application::PartFile::ReleaseLazyIndex()
+{
+	if (m_lazyIndex != nullptr)
+	{
+		GuidObjectManager::GetGuidObjectManager().RemoveLazyObjectSource(m_lazyIndex);
+		delete m_lazyIndex;
+		m_lazyIndex = nullptr;
+	}
+}
+
+const Application::BinaryPartImage* Application::PartFile::GetBinaryImage() const
+{
+	return m_binaryImage;
+}
+
+const Application::LazyFeatureIndex* Application::PartFile::GetLazyIndex() const
+{
+	return m_lazyIndex;
+}
+
+void Application::PartFile::ClosePart()
+{
+	cout << "    PartFile::ClosePart called" << endl;
+
+	// features nobody looked up are never read, drop the index and its mapping
+	ReleaseLazyIndex();
+	StopWatching();
+	FlushSaves();
+
+	PartOpsNotifierData partOpsNotifierData;
+	partOpsNotifierData.guid = this->GetGuid();
+	partOpsNotifierData.partName = this->m_partFilePath;
+	PartOpsNotifierData* ptr = &partOpsNotifierData;
+
+	CoreSession::GetInstance().CreateMessage(Observer::ClosePart, (void*)ptr);
+}
+
+void Application::PartFile::SavePart(PartSaveMode saveMode)
+{
+	cout << "    PartFile::SavePart called" << endl;
+
+	std::vector<GuidObject*> modifiedFeatures = GetModifiedFeatures();
+	bool hasChanges = !modifiedFeatures.empty() || !m_deletedFeatures.empty();
+	if (m_binaryImage != nullptr && m_binaryImage->IsInMemory() && (hasChanges || saveMode == PartSaveMode::Full))
+	{
+		throw std::exception("Parts opened from the shared part cache are read only, open the part Mapped or Parallel to save edits");
+	}
+	if (m_binaryImage != nullptr && (hasChanges || saveMode == PartSaveMode::Full))
+	{
+		throw std::exception("Binary part files are read only, convert the part to text to save edits");
+	}
+	if (PartArchive::IsArchivedPartPath(m_partFilePath) && (hasChanges || saveMode == PartSaveMode::Full))
+	{
+		throw std::exception("Parts in a part archive are read only, save edits to a loose part file and pack the archive again");
+	}
+
+	PartSaveQueue& saveQueue = PartSaveQueue::GetInstance();
+	if (m_holdsAllFeatures && (!m_hasBaseFile || saveMode == PartSaveMode::Full))
+	{
+		WriteWholePart();
+		for (GuidObject* modified : modifiedFeatures)
+		{
+			dynamic_cast<Feature*>(modified)->MarkClean();
+		}
+		m_deletedFeatures.clear();
+	}
+	else if (hasChanges)
+	{
+		std::vector<int> modifiedGuids;
+		modifiedGuids.reserve(modifiedFeatures.size());
+		for (GuidObject* modified : modifiedFeatures)
+		{
+			modifiedGuids.push_back(modified->GetGuid());
+		}
+
+		// large saves serialize on the ThreadPool, in guid order all the same
+		PartFileWriter featureRecords(modifiedFeatures.size() * PartFileWriter::TypicalFeatureBytes);
+		featureRecords.AddFeatures(modifiedFeatures);
+		std::vector<int> deletedGuids(m_deletedFeatures.begin(), m_deletedFeatures.end());
+
+		// the records are taken now, the features may be edited again before the queue writes them
+		if (saveQueue.IsEnabled())
+		{
+			GetDeltaLog();
+			saveQueue.QueueSave(m_partFilePath, GetGuid(), m_deltaLog, featureRecords.TakeSegments(), modifiedGuids, deletedGuids);
+		}
+		else
+		{
+			GetDeltaLog().AppendSave(featureRecords.GetSegments(), deletedGuids);
+		}
+		for (GuidObject* modified : modifiedFeatures)
+		{
+			dynamic_cast<Feature*>(modified)->MarkClean();
+		}
+		m_deletedFeatures.clear();
+	}
+
+	if (saveMode == PartSaveMode::Full && !m_holdsAllFeatures)
+	{
+		// queued saves go into the log before it is folded into the part
+		saveQueue.Flush(m_partFilePath);
+		// the lazy index maps the part file, let go of it while the file is replaced and index the result
+		bool wasLazy = (m_lazyIndex != nullptr);
+		ReleaseLazyIndex();
+		GetDeltaLog().Compact();
+		if (wasLazy)
+		{
+			m_lazyIndex = new LazyFeatureIndex(m_partFilePath, verifyPartIntegrity);
+			GuidObjectManager::GetGuidObjectManager().AddLazyObjectSource(m_lazyIndex);
+		}
+	}
+	else if (m_lazyIndex == nullptr && GetDeltaLog().NeedsCompaction())
+	{
+		// lazy parts only compact on a full save, the index would race the swap
+		GetDeltaLog().StartBackgroundCompaction();
+	}
+
+	// the queue sends SavePart once the saves it holds are on disk
+	if (saveQueue.HasQueuedSaves(m_partFilePath))
+	{
+		return;
+	}
+
+	PartSaveNotifierData partSaveNotifierData;
+	partSaveNotifierData.guid = this->GetGuid();
+	partSaveNotifierData.partName = this->m_partFilePath;
+	partSaveNotifierData.coalescedSaves = 1;
+	PartOpsNotifierData* ptr = &partSaveNotifierData;
+
+	CoreSession::GetInstance().CreateMessage(Observer::SavePart, (void*)ptr);
+}
+
+// Every feature the part holds in guid order, atomically replacing the part file, and the log they were saved to goes
+void Application::PartFile::WriteWholePart()
+{
+	// queued saves and a running compaction write the log, both are done with it before the part replaces it
+	PartSaveQueue::GetInstance().Flush(m_partFilePath);
+	GetDeltaLog().WaitForCompaction();
+
+	std::set<int> featureGuids(m_featureGuids.begin(), m_featureGuids.end());
+	std::vector<GuidObject*> features;
+	features.reserve(featureGuids.size());
+	GuidObjectManager& guidObjectManager = GuidObjectManager::GetGuidObjectManager();
+	for (int guid : featureGuids)
+	{
+		GuidObject* feature = guidObjectManager.GetObjectFromGUID(guid);
+		if (feature != nullptr)
+		{
+			features.push_back(feature);
+		}
+	}
+
+	std::string partFileName = std::filesystem::path(m_partFilePath).stem().string();
+	PartFileWriter part(features.size() * PartFileWriter::TypicalFeatureBytes + PartFileNameToken.size() + partFileName.size() + 64);
+	part.AddHeader(partFileName, SavedSchemaVersion);
+	part.AddFeatures(features);
+	part.AddChecksumFooter();
+	part.Write(m_partFilePath);
+
+	// a crash before the log goes only replays saves the part already has
+	GetDeltaLog().Clear();
+	m_hasBaseFile = true;
+}
+
+void Application::PartFile::FlushSaves()
+{
+	PartSaveQueue::GetInstance().Flush(m_partFilePath);
+}
+
+void Application::PartFile::AddFeature(GuidObject* feature)
+{
+	Feature* partFeature = dynamic_cast<Feature*>(feature);
+	if (partFeature == nullptr)
+	{
+		throw std::exception("Only an Application::Feature can be added to a part");
+	}
+
+	int guid = feature->GetGuid();
+	m_deletedFeatures.erase(guid);
+	m_featureGuids.insert(guid);
+	GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(guid, feature);
+	partFeature->MarkDirty();
+}
+
+void Application::PartFile::DeleteFeature(int guid)
+{
+	// a dirty feature left behind would otherwise be written again by the next save
+	Feature* feature = dynamic_cast<Feature*>(GuidObjectManager::GetGuidObjectManager().GetObjectFromGUID(guid));
+	if (feature != nullptr)
+	{
+		feature->MarkClean();
+	}
+
+	m_featureGuids.erase(guid);
+	GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(guid, nullptr);
+	m_deletedFeatures.insert(guid);
+}
+
+bool Application::PartFile::HasUnsavedChanges() const
+{
+	return !m_deletedFeatures.empty() || !GetModifiedFeatures().empty();
+}
+
+bool Application::PartFile::HasFeature(int guid) const
+{
+	if (m_featureGuids.find(guid) != m_featureGuids.end())
+	{
+		return true;
+	}
+	if (m_binaryImage != nullptr)
+	{
+		return m_binaryImage->FindFeatureIndex(guid) != BinaryPartImage::NoFeature;
+	}
+	return m_lazyIndex != nullptr && m_lazyIndex->FindFeatureIndex(guid) != LazyFeatureIndex::NoFeature;
+}
+
+// The dirty features of this part in guid order, so a save writes the same bytes every time.  Only what was edited is looked at
+std::vector<GuidObject*> Application::PartFile::GetModifiedFeatures() const
+{
+	std::map<int, GuidObject*> modified;
+	for (Feature* feature : Feature::GetDirtyFeatures())
+	{
+		GuidObject* object = dynamic_cast<GuidObject*>(feature);
+		if (object != nullptr && HasFeature(object->GetGuid()))
+		{
+			modified[object->GetGuid()] = object;
+		}
+	}
+
+	std::vector<GuidObject*> features;
+	features.reserve(modified.size());
+	for (const std::pair<const int, GuidObject*>& feature : modified)
+	{
+		features.push_back(feature.second);
+	}
+	return features;
+}
+
+void Application::PartFile::SetCompactionRatio(double compactionRatio)
+{
+	GetDeltaLog().SetCompactionRatio(compactionRatio);
+}
+
+void Application::PartFile::WaitForCompaction()
+{
+	if (m_deltaLog != nullptr)
+	{
+		m_deltaLog->WaitForCompaction();
+	}
+}
+
+Application::PartDeltaLog& Application::PartFile::GetDeltaLog()
+{
+	if (m_deltaLog == nullptr)
+	{
+		m_deltaLog = std::make_shared<PartDeltaLog>(m_partFilePath);
+	}
+	return *m_deltaLog;
+}
+
+void Application::PartFile::MakeWidgetFeature(bool option1, int values)
+{
+	cout << "    MakeWidgetFeature called with " << option1 << " " << values << endl;
+}
+
+Application::PartFile* Application::PartFile::CreatePartFile(std::string partFilePath)
+{
+	int guid = 123424; 
+
+	Application::PartFile* partFile = new Application::PartFile( partFilePath, guid);
+	partFile->m_hasBaseFile = false;
+	partFile->m_holdsAllFeatures = true;
+	GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(guid, partFile);
+
+	PartOpsNotifierData partOpsNotifierData;
+	partOpsNotifierData.guid = guid;
+	partOpsNotifierData.partName = partFilePath;
+	PartOpsNotifierData* ptr = &partOpsNotifierData;
+
+	CoreSession::GetInstance().CreateMessage(Observer::CreatePart, (void*)ptr);
+	return partFile;
+}
+
+void Application::PartFile::SetVerifyIntegrity(bool verifyIntegrity)
+{
+	verifyPartIntegrity = verifyIntegrity;
+}
+
+bool Application::PartFile::GetVerifyIntegrity()
+{
+	return verifyPartIntegrity;
+}
+
+void Application::PartFile::SetWatchForChanges(bool watchForChanges)
+{
+	watchPartFilesForChanges = watchForChanges;
+}
+
+bool Application::PartFile::GetWatchForChanges()
+{
+	return watchPartFilesForChanges;
+}
+
+// The feature's bytes up to its FeatureChecksum: line, which only restates them
+static std::string_view FeatureText(const char* data, const FeatureSpan& span)
+{
+	size_t end = span.hasChecksum ? span.checksumBegin : span.end;
+	return std::string_view(data + span.begin, end - span.begin);
+}
+
+// Hash of each feature's text by guid, for a repeated guid the last one, as the GuidObjectManager holds it
+static std::unordered_map<int, uint64_t> HashFeaturesByGuid(const char* data, const PartFileLayout& layout)
+{
+	std::vector<uint64_t> hashes(layout.features.size(), 0);
+	ThreadPool::GetInstance().ParallelFor(hashes.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			std::string_view text = FeatureText(data, layout.features[i]);
+			hashes[i] = HashContent(text.data(), text.size());
+		}
+	});
+
+	std::unordered_map<int, uint64_t> hashesByGuid;
+	hashesByGuid.reserve(hashes.size());
+	for (size_t i = 0; i < hashes.size(); i++)
+	{
+		const FeatureSpan& span = layout.features[i];
+		if (span.guid != -1 && !span.isRoutingFeature)
+		{
+			hashesByGuid[span.guid] = hashes[i];
+		}
+	}
+	return hashesByGuid;
+}
+
+// Whether the object is a feature edited since it was read or saved, a reload keeps such edits
+static bool IsDirtyFeature(GuidObject* object)
+{
+	Application::Feature* feature = dynamic_cast<Application::Feature*>(object);
+	return feature != nullptr && feature->IsDirty();
+}
+
+// Whether the feature held in memory already writes out as the one just read
+static bool WritesTheSame(GuidObject* held, GuidObject* read)
+{
+	IPartFileWritable* heldWritable = dynamic_cast<IPartFileWritable*>(held);
+	IPartFileWritable* readWritable = dynamic_cast<IPartFileWritable*>(read);
+	if (heldWritable == nullptr || readWritable == nullptr)
+	{
+		return false;
+	}
+	std::string heldText;
+	std::string readText;
+	heldWritable->WriteFeature(heldText);
+	readWritable->WriteFeature(readText);
+	return heldText == readText;
+}
+
+void Application::PartFile::StartWatching()
+{
+	MappedFile mappedFile(m_partFilePath);
+	if (mappedFile.IsOpen())
+	{
+		m_featureHashes = HashFeaturesByGuid(mappedFile.Data(), ScanPartFileLayout(mappedFile.Data(), mappedFile.Size()));
+	}
+	m_watchId = PartFileWatcher::GetInstance().Watch(m_partFilePath, [this](const std::string&) { return OnPartFileChanged(); });
+}
+
+void Application::PartFile::StopWatching()
+{
+	if (m_watchId != PartFileWatcher::NoWatch)
+	{
+		PartFileWatcher::GetInstance().Unwatch(m_watchId);
+		m_watchId = PartFileWatcher::NoWatch;
+		m_featureHashes.clear();
+	}
+}
+
+bool Application::PartFile::OnPartFileChanged()
+{
+	try
+	{
+		// a part that is there but will not open is still being written, try again once it settles
+		return ReloadChangedFeatures().reloaded || !std::filesystem::exists(m_partFilePath);
+	}
+	catch (std::exception& e)
+	{
+		// most likely written in pieces, the write that finishes it is another change
+		cout << "    PartFile reload of " << m_partFilePath << " failed: " << e.what() << endl;
+		return true;
+	}
+}
+
+Application::PartReloadResult Application::PartFile::ReloadChangedFeatures()
+{
+	auto start = std::chrono::steady_clock::now();
+	PartReloadResult result;
+
+	MappedFile mappedFile(m_partFilePath);
+	if (!mappedFile.IsOpen())
+	{
+		return result;
+	}
+	const char* data = mappedFile.Data();
+	size_t size = mappedFile.Size();
+	if (verifyPartIntegrity)
+	{
+		VerifyPartFileIntegrity(data, size);
+	}
+
+	PartFileLayout layout = ScanPartFileLayout(data, size);
+	std::unordered_map<int, uint64_t> featureHashes = HashFeaturesByGuid(data, layout);
+
+	// Only the last feature of a guid counts, and only those whose text hashes differently are read
+	std::unordered_map<int, size_t> lastFeature;
+	for (size_t i = 0; i < layout.features.size(); i++)
+	{
+		const FeatureSpan& span = layout.features[i];
+		if (span.guid != -1 && !span.isRoutingFeature)
+		{
+			lastFeature[span.guid] = i;
+		}
+	}
+	std::vector<size_t> candidates;
+	for (size_t i = 0; i < layout.features.size(); i++)
+	{
+		const FeatureSpan& span = layout.features[i];
+		if (span.guid == -1 || span.isRoutingFeature || lastFeature[span.guid] != i)
+		{
+			continue;
+		}
+		std::unordered_map<int, uint64_t>::const_iterator known = m_featureHashes.find(span.guid);
+		if (known != m_featureHashes.end() && known->second == featureHashes[span.guid])
+		{
+			result.unchangedCount++;
+			continue;
+		}
+		candidates.push_back(i);
+	}
+
+	std::vector<GuidObject*> features(candidates.size(), nullptr);
+	try
+	{
+		ThreadPool::GetInstance().ParallelFor(candidates.size(), [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; i++)
+			{
+				const FeatureSpan& span = layout.features[candidates[i]];
+				PartFileTokenizer tokenizer(data + span.bodyBegin, span.end - span.bodyBegin);
+				features[i] = ProcessFeature(span.featureType, tokenizer);
+			}
+		});
+	}
+	catch (...)
+	{
+		// every range has finished by now, drop what was read so a bad feature leaves the held features as they were
+		for (GuidObject* feature : features)
+		{
+			delete feature;
+		}
+		throw;
+	}
+	result.readFeatureCount = candidates.size();
+
+	// Applied here on the session's thread, nothing else touches the features meanwhile
+	GuidObjectManager& guidObjectManager = GuidObjectManager::GetGuidObjectManager();
+	for (size_t i = 0; i < candidates.size(); i++)
+	{
+		int guid = layout.features[candidates[i]].guid;
+		GuidObject* read = features[i];
+		GuidObject* held = guidObjectManager.GetObjectFromGUID(guid);
+		if (IsDirtyFeature(held) || m_deletedFeatures.count(guid) != 0)
+		{
+			result.keptEditedGuids.push_back(guid);
+			delete read;
+			continue;
+		}
+
+		if (held == nullptr)
+		{
+			if (read != nullptr)
+			{
+				guidObjectManager.SetObjectFromGUID(guid, read);
+				m_featureGuids.insert(guid);
+				result.addedGuids.push_back(guid);
+			}
+			continue;
+		}
+		if (read == nullptr || WritesTheSame(held, read))
+		{
+			// rewritten but not changed, such as saved by this session or version upped
+			result.unchangedCount++;
+			delete read;
+			continue;
+		}
+
+		Feature* heldFeature = dynamic_cast<Feature*>(held);
+		Feature* readFeature = dynamic_cast<Feature*>(read);
+		if (heldFeature != nullptr && readFeature != nullptr && heldFeature->CopyFieldsFrom(*readFeature))
+		{
+			// patched to what is on disk, there is nothing of it to save
+			heldFeature->MarkClean();
+			delete read;
+		}
+		else
+		{
+			// a feature that changed type cannot be patched, the new object takes its guid
+			guidObjectManager.SetObjectFromGUID(guid, read);
+		}
+		result.changedGuids.push_back(guid);
+	}
+
+	for (const std::pair<const int, uint64_t>& known : m_featureHashes)
+	{
+		if (featureHashes.count(known.first) != 0)
+		{
+			continue;
+		}
+		if (IsDirtyFeature(guidObjectManager.GetObjectFromGUID(known.first)))
+		{
+			result.keptEditedGuids.push_back(known.first);
+			continue;
+		}
+		guidObjectManager.SetObjectFromGUID(known.first, nullptr);
+		m_featureGuids.erase(known.first);
+		result.removedGuids.push_back(known.first);
+	}
+
+	m_featureHashes = std::move(featureHashes);
+	result.reloaded = true;
+	result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	if (!result.changedGuids.empty() || !result.addedGuids.empty() || !result.removedGuids.empty())
+	{
+		PartReloadNotifierData partReloadNotifierData;
+		partReloadNotifierData.guid = this->GetGuid();
+		partReloadNotifierData.partName = m_partFilePath;
+		partReloadNotifierData.changedGuids = result.changedGuids;
+		partReloadNotifierData.addedGuids = result.addedGuids;
+		partReloadNotifierData.removedGuids = result.removedGuids;
+		PartOpsNotifierData* ptr = &partReloadNotifierData;
+
+		CoreSession::GetInstance().CreateMessage(Observer::ReloadPart, (void*)ptr);
+	}
+	return result;
+}
+
+Application::PartFile* Application::PartFile::OpenPartFile(std::string partFilePath, PartFileReadMode readMode)
+{
+	int guid = -1;
+	BinaryPartImage* binaryImage = nullptr;
+	LazyFeatureIndex* lazyIndex = nullptr;
+	std::vector<int> featureGuids;
+
+	bool isArchivedPart = PartArchive::IsArchivedPartPath(partFilePath);
+	bool isBinaryPart = !isArchivedPart && BinaryPartImage::IsBinaryPartFile(partFilePath);
+	if (!isBinaryPart && !isArchivedPart && readMode != PartFileReadMode::Shared && PartDeltaLog::HasPendingDeltas(partFilePath))
+	{
+		// saves from an earlier session are still in the delta log, fold them in so every reader sees them.
+		// Shared parts are read only, ReadInSharedPartFile folds the log in memory and leaves the files alone
+		PartDeltaLog(partFilePath).Compact();
+	}
+
+	if (isBinaryPart)
+	{
+		// Header and section bounds are checked up front, features are read in place on demand
+		binaryImage = new BinaryPartImage(partFilePath);
+		guid = 54321;
+	}
+	else if (readMode == PartFileReadMode::Lazy)
+	{
+		// Only the framing lines are scanned, GetObjectFromGUID reads a feature the first time it is asked for
+		lazyIndex = new LazyFeatureIndex(partFilePath, verifyPartIntegrity);
+		GuidObjectManager::GetGuidObjectManager().AddLazyObjectSource(lazyIndex);
+		guid = 54321;
+	}
+	else if (readMode == PartFileReadMode::Shared)
+	{
+		// A hit parses nothing, the features are read in place from the shared entry
+		binaryImage = ReadInSharedPartFile(partFilePath, featureGuids);
+		guid = 54321;
+	}
+	else
+	{
+		ReadInPartFile(guid, partFilePath, readMode, featureGuids);
+	}
+
+	// Stream readers keep nothing, Lazy and binary parts read features on demand
+	bool holdsAllFeatures = !isBinaryPart && !isArchivedPart && binaryImage == nullptr && lazyIndex == nullptr && readMode != PartFileReadMode::Stream;
+	return FinishOpening(partFilePath, guid, binaryImage, lazyIndex, featureGuids, holdsAllFeatures);
+}
+
+std::vector<Application::PartFile*> Application::PartFile::OpenPartFiles(const std::vector<std::string>& partFilePaths, PartFileReadMode readMode)
+{
+	std::vector<PartFile*> partFiles;
+	partFiles.reserve(partFilePaths.size());
+	if (readMode == PartFileReadMode::Lazy || readMode == PartFileReadMode::Shared)
+	{
+		// neither reads the whole file up front, there is nothing to batch
+		for (const std::string& partFilePath : partFilePaths)
+		{
+			partFiles.push_back(OpenPartFile(partFilePath, readMode));
+		}
+		return partFiles;
+	}
+
+	for (size_t batchBegin = 0; batchBegin < partFilePaths.size(); batchBegin += OpenBatchSize)
+	{
+		size_t batchEnd = std::min(partFilePaths.size(), batchBegin + OpenBatchSize);
+
+		// binary and archived parts are mapped as OpenPartFile maps them, only loose text parts are read
+		std::vector<bool> isRead(batchEnd - batchBegin, false);
+		std::vector<PartFileRead> reads;
+		for (size_t i = batchBegin; i < batchEnd; i++)
+		{
+			const std::string& partFilePath = partFilePaths[i];
+			if (PartArchive::IsArchivedPartPath(partFilePath) || BinaryPartImage::IsBinaryPartFile(partFilePath))
+			{
+				continue;
+			}
+			if (PartDeltaLog::HasPendingDeltas(partFilePath))
+			{
+				PartDeltaLog(partFilePath).Compact();
+			}
+			isRead[i - batchBegin] = true;
+			reads.emplace_back();
+			reads.back().filePath = partFilePath;
+		}
+		PartFileIO::GetBackend().ReadFiles(reads);
+
+		size_t nextRead = 0;
+		for (size_t i = batchBegin; i < batchEnd; i++)
+		{
+			if (!isRead[i - batchBegin])
+			{
+				partFiles.push_back(OpenPartFile(partFilePaths[i], readMode));
+				continue;
+			}
+
+			// the tokenizers read the buffer the backend read into, as they would a mapped file
+			PartFileRead& read = reads[nextRead++];
+			std::vector<int> featureGuids;
+			if (read.error.empty() && readMode == PartFileReadMode::Parallel)
+			{
+				featureGuids = ReadInParallelPart(read.data.get(), read.size);
+			}
+			else if (read.error.empty())
+			{
+				featureGuids = ReadInMappedPart(read.data.get(), read.size);
+			}
+			read.data.reset();
+			partFiles.push_back(FinishOpening(read.filePath, 54321, nullptr, nullptr, featureGuids, read.error.empty()));
+		}
+	}
+	return partFiles;
+}
+
+Application::PartFile* Application::PartFile::FinishOpening(const std::string& partFilePath, int guid, BinaryPartImage* binaryImage, LazyFeatureIndex* lazyIndex,
+	const std::vector<int>& featureGuids, bool holdsAllFeatures)
+{
+	PartFile* partFile = new PartFile(partFilePath, guid);
+	partFile->m_binaryImage = binaryImage;
+	partFile->m_lazyIndex = lazyIndex;
+	if (binaryImage != nullptr)
+	{
+		// binary parts and shared cache entries read a record the first time its guid is looked up
+		GuidObjectManager::GetGuidObjectManager().AddLazyObjectSource(binaryImage);
+	}
+	partFile->m_featureGuids.insert(featureGuids.begin(), featureGuids.end());
+	partFile->m_holdsAllFeatures = holdsAllFeatures;
+	if (watchPartFilesForChanges && binaryImage == nullptr && lazyIndex == nullptr && !PartArchive::IsArchivedPartPath(partFilePath))
+	{
+		partFile->StartWatching();
+	}
+	GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(guid, partFile);
+	
+	PartOpsNotifierData partOpsNotifierData;
+	partOpsNotifierData.guid = guid;
+	partOpsNotifierData.partName = partFilePath;
+	PartOpsNotifierData* ptr = &partOpsNotifierData;
+
+	CoreSession::GetInstance().CreateMessage(Observer::OpenPart, (void*)ptr);
+
+	return partFile;
+}
+
+
+
+void ReadInPartFile(int & guid, std::string partFilePath, Application::PartFileReadMode readMode, std::vector<int>& featureGuids)
+{
+	guid = 54321;
+
+	std::string archivePath;
+	std::string partName;
+	if (Application::PartArchive::SplitArchivedPartPath(partFilePath, archivePath, partName))
+	{
+		// the archive stays mapped, only the part's slice of it is read.  There is no file to getline, Stream reads it mapped
+		std::shared_ptr<Application::PartArchive> archive = Application::PartArchive::GetArchive(archivePath);
+		std::string_view part = archive->GetPart(partName);
+		if (readMode == Application::PartFileReadMode::Parallel)
+		{
+			featureGuids = ReadInParallelPart(part.data(), part.size());
+		}
+		else
+		{
+			featureGuids = ReadInMappedPart(part.data(), part.size());
+		}
+		return;
+	}
+
+	if (readMode == Application::PartFileReadMode::Mapped)
+	{
+		featureGuids = ReadInMappedPartFile(partFilePath);
+		return;
+	}
+	else if (readMode == Application::PartFileReadMode::Parallel)
+	{
+		featureGuids = ReadInParallelPartFile(partFilePath);
+		return;
+	}
+
+	if (verifyPartIntegrity)
+	{
+		// getline drops the bytes the checksums cover, check the file as it is on disk first
+		MappedFile mappedFile(partFilePath);
+		if (mappedFile.IsOpen())
+		{
+			VerifyPartFileIntegrity(mappedFile.Data(), mappedFile.Size());
+		}
+	}
+
+	string line;
+	ifstream localPartFile(partFilePath);
+	if (localPartFile.is_open())
+	{
+		while (getline(localPartFile, line))
+		{
+			cout << line << '\n';
+
+			if (startsWith(line, PartFileNameToken))
+			{
+				std::string partFileName = line.substr(PartFileNameToken.size(), line.size() - PartFileNameToken.size());
+				cout << "    "<< PartFileNameToken << " " << partFileName << endl;
+			}
+			else if (startsWith(line, SchemaVersionToken))
+			{
+				std::string partFileName = line.substr(SchemaVersionToken.size(), line.size() - SchemaVersionToken.size());
+				cout << "    "<< SchemaVersionToken <<" " << partFileName << endl;
+			}
+			else if(startsWith(line, FeatureToken))
+			{
+				std::string featureType = line.substr(FeatureToken.size(), line.size() - FeatureToken.size());
+				ProcessFeature(featureType, localPartFile);
+			}
+
+
+		}
+		localPartFile.close();
+	}
+
+
+}
+
+// Features go in to the GuidObjectManager in file order, so a repeated guid resolves the same way whichever reader was used.
+// Returns their guids, the part's features
+static std::vector<int> RegisterFeatures(const std::vector<GuidObject*>& features)
+{
+	std::vector<int> featureGuids;
+	featureGuids.reserve(features.size());
+	for (GuidObject* feature : features)
+	{
+		if (feature != nullptr)
+		{
+			GuidObjectManager::GetGuidObjectManager().SetObjectFromGUID(feature->GetGuid(), feature);
+			featureGuids.push_back(feature->GetGuid());
+		}
+	}
+	return featureGuids;
+}
+
+static std::vector<int> ReadInMappedPartFile(std::string partFilePath)
+{
+	MappedFile mappedFile(partFilePath);
+	if (!mappedFile.IsOpen())
+	{
+		return std::vector<int>();
+	}
+	return ReadInMappedPart(mappedFile.Data(), mappedFile.Size());
+}
+
+static std::vector<int> ReadInMappedPart(const char* data, size_t size)
+{
+	if (verifyPartIntegrity)
+	{
+		VerifyPartFileIntegrity(data, size);
+	}
+
+	std::vector<GuidObject*> features;
+	if (Application::PartParseCache::GetInstance().TryLoad(data, size, features))
+	{
+		return RegisterFeatures(features);
+	}
+
+	PartFileTokenizer tokenizer(data, size);
+	std::string_view line;
+	std::string_view partFileName;
+	std::string_view schemaVersion;
+
+	std::string_view value;
+
+	while (tokenizer.NextLine(line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::PartFileName:
+			partFileName = value;
+			break;
+		case PartFileKey::SchemaVersion:
+			schemaVersion = value;
+			break;
+		case PartFileKey::Feature:
+			features.push_back(ProcessFeature(value, tokenizer));
+			break;
+		default:
+			break;
+		}
+	}
+
+	Application::PartParseCache::GetInstance().Store(data, size, features);
+	return RegisterFeatures(features);
+}
+
+static std::vector<int> ReadInParallelPartFile(std::string partFilePath)
+{
+	MappedFile mappedFile(partFilePath);
+	if (!mappedFile.IsOpen())
+	{
+		return std::vector<int>();
+	}
+	return ReadInParallelPart(mappedFile.Data(), mappedFile.Size());
+}
+
+static std::vector<int> ReadInParallelPart(const char* data, size_t size)
+{
+	return RegisterFeatures(ReadParallelFeatures(data, size));
+}
+
+// Verified and read up to the latest version, but not registered
+static std::vector<GuidObject*> ReadParallelFeatures(const char* data, size_t size)
+{
+	std::vector<GuidObject*> cachedFeatures;
+	if (Application::PartParseCache::GetInstance().TryLoad(data, size, cachedFeatures))
+	{
+		try
+		{
+			if (verifyPartIntegrity)
+			{
+				VerifyPartFileIntegrity(data, size);
+			}
+		}
+		catch (...)
+		{
+			for (GuidObject* feature : cachedFeatures)
+			{
+				delete feature;
+			}
+			throw;
+		}
+		return cachedFeatures;
+	}
+
+	// Phase one, find where every feature starts and ends
+	PartFileLayout layout = ScanPartFileLayout(data, size);
+
+	// Each range is checksummed by the task that reads it, while its bytes are in that core's cache
+	std::unique_ptr<PartFileChecksumCheck> integrity;
+	if (verifyPartIntegrity)
+	{
+		integrity = std::make_unique<PartFileChecksumCheck>(data, size, layout);
+	}
+
+	// Phase two, each span gets its own tokenizer and the results land in their file order slot
+	std::vector<GuidObject*> features(layout.features.size(), nullptr);
+	try
+	{
+		ThreadPool::GetInstance().ParallelFor(layout.features.size(), [&](size_t begin, size_t end)
+		{
+			if (integrity != nullptr)
+			{
+				integrity->CheckFeatures(begin, end);
+			}
+
+			for (size_t i = begin; i < end; i++)
+			{
+				const FeatureSpan& span = layout.features[i];
+				if (span.isRoutingFeature)
+				{
+					continue; // routing features belong to the demand loaded library, same as the sequential readers
+				}
+
+				PartFileTokenizer tokenizer(data + span.bodyBegin, span.end - span.bodyBegin);
+				features[i] = ProcessFeature(span.featureType, tokenizer);
+			}
+		});
+
+		if (integrity != nullptr)
+		{
+			integrity->Verify();
+		}
+	}
+	catch (...)
+	{
+		// every range has finished by now, drop what was read so a bad feature does not leave half a part behind
+		for (GuidObject* feature : features)
+		{
+			delete feature;
+		}
+
+		// a reader that tripped over damaged bytes is reported as the damage
+		if (integrity != nullptr)
+		{
+			integrity->Verify();
+		}
+		throw;
+	}
+
+	Application::PartParseCache::GetInstance().Store(data, size, features);
+	return features;
+}
+
+Application::BinaryPartImage* ReadInSharedPartFile(const std::string& partFilePath, std::vector<int>& featureGuids)
+{
+	Application::SharedPartCache& cache = Application::SharedPartCache::GetInstance();
+	if (!cache.IsEnabled())
+	{
+		throw std::exception("PartFileReadMode::Shared needs the shared part cache, call SharedPartCache::Open first");
+	}
+
+	std::shared_ptr<Application::PartArchive> archive;
+	std::unique_ptr<MappedFile> mappedFile;
+	std::string foldedPart;
+	std::string_view part;
+	std::string archivePath;
+	std::string partName;
+	if (Application::PartArchive::SplitArchivedPartPath(partFilePath, archivePath, partName))
+	{
+		archive = Application::PartArchive::GetArchive(archivePath);
+		part = archive->GetPart(partName);
+	}
+	else if (Application::PartDeltaLog::ReadFolded(partFilePath, foldedPart))
+	{
+		// entries are found by their bytes, the folded part has its own
+		part = foldedPart;
+	}
+	else
+	{
+		mappedFile = std::make_unique<MappedFile>(partFilePath);
+		if (!mappedFile->IsOpen())
+		{
+			return nullptr;
+		}
+		part = std::string_view(mappedFile->Data(), mappedFile->Size());
+	}
+
+	// The entry was published from the same bytes after they passed the integrity check, a hit skips it
+	Application::BinaryPartImage* image = cache.Find(partFilePath, part.data(), part.size());
+	if (image != nullptr)
+	{
+		return image;
+	}
+
+	std::vector<GuidObject*> features = ReadParallelFeatures(part.data(), part.size());
+	try
+	{
+		image = cache.Publish(partFilePath, part.data(), part.size(), features);
+	}
+	catch (...)
+	{
+		for (GuidObject* feature : features)
+		{
+			delete feature;
+		}
+		throw;
+	}
+
+	if (image == nullptr)
+	{
+		featureGuids = RegisterFeatures(features);
+		return nullptr;
+	}
+	for (GuidObject* feature : features)
+	{
+		delete feature;
+	}
+	return image;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
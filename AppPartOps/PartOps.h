@@ -1,27 +1,193 @@
-#pragma once
-#include "AppPartOpsExports.h"
-#include <string>
-#include "..\Core\GuidObject.h"
-
-
-namespace Application
-{
-	class APPPARTOPS_API PartFile : public GuidObject
-	{
-	public:
-		static PartFile* CreatePartFile(std::string partFilePath);
-		static PartFile* OpenPartFile(std::string partFilePath);
-		void SavePart();
-		void ClosePart();
-		void MakeWidgetFeature(bool option1, int values);
-
-	private:
-		PartFile(std::string partFilePath, int guid);
-		std::string m_partFilePath;
-	};
-}
-
-
-
-
-
+#pragma once
+#include "AppPartOpsExports.h"
+#include <string>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "..\Core\GuidObject.h"
+
+
+namespace Application
+{
+	class BinaryPartImage;
+	class LazyFeatureIndex;
+	class PartDeltaLog;
+
+	/// <summary>
+	/// How OpenPartFile pulls the part file off disk.
+	/// </summary>
+	enum class PartFileReadMode
+	{
+		Stream, /** getline through std::ifstream, every line is echoed to the console. Never uses the PartParseCache. */
+		Mapped, /** Memory mapped, readers get std::string_view tokens with no per line allocation. Uses the PartParseCache when it is on. */
+		Parallel, /** Memory mapped, a boundary scan finds the features and they are read on the ThreadPool. Uses the PartParseCache when it is on. */
+		Lazy, /** Memory mapped, only the feature index is built, a feature is read when its guid is first looked up. */
+		Shared /** Opened as a read only view over the part's SharedPartCache entry, read as Parallel and published on a miss. Features are read from the entry in place the first time their guid is looked up, as Lazy does.  A delta log is folded in memory, the part file is never rewritten. */
+	};
+	// Binary part files (.prtb) are detected by their magic number and always mapped, a feature is read when its guid is
+	// first looked up.  The read mode only applies to text parts.
+	// A part in a part archive is opened as <archive>.prtpak#<part name>, its slice of the mapped archive is read and
+	// Stream reads it as Mapped does.  Such parts are read only, see PartArchive.
+	// Shared needs SharedPartCache::Open first.  A part with a feature type the cache has no record for, or one too
+	// big for the segment, is left as read by Parallel, features registered and no binary image.
+
+	/// <summary>
+	/// What SavePart writes.
+	/// </summary>
+	enum class PartSaveMode
+	{
+		Delta, /** Appends the modified and deleted features to the delta log, compaction runs in the background past the ratio. */
+		Full /** Writes the whole part from the features held in memory and drops the delta log.  Stream and Lazy parts hold only what was looked up, they append like Delta and fold the log into the part file. */
+	};
+	// The first save of a part made with CreatePartFile writes it whole whichever the mode, there is no part file to append to.
+
+	/// <summary>
+	/// What PartFile::ReloadChangedFeatures did.
+	/// </summary>
+	struct PartReloadResult
+	{
+		bool reloaded = false; /** False when the part file could not be opened, nothing was touched. */
+		std::vector<int> changedGuids; /** Patched in place with the fields read from the file. */
+		std::vector<int> addedGuids;
+		std::vector<int> removedGuids;
+		std::vector<int> keptEditedGuids; /** Changed on disk while queued for SavePart, the edit is kept. */
+		size_t unchangedCount = 0;
+		size_t readFeatureCount = 0; /** Features read from the file, every other one was only hashed. */
+		double seconds = 0;
+	};
+
+	class APPPARTOPS_API PartFile : public GuidObject
+	{
+	public:
+		static PartFile* CreatePartFile(std::string partFilePath);
+		static PartFile* OpenPartFile(std::string partFilePath, PartFileReadMode readMode = PartFileReadMode::Stream);
+
+		/// <summary>
+		/// Opens every part as OpenPartFile would, in path order.  Loose text parts are
+		/// read through PartFileIO::GetBackend a batch at a time, with the batch's reads
+		/// in flight together, and each is tokenized straight out of the buffer it was
+		/// read into.  Stream is read as Mapped, nothing is echoed.  Binary, archived,
+		/// Lazy and Shared parts are opened one by one.  A part that cannot be read opens
+		/// with no features, as with Mapped.  Throws std::exception at the first part that
+		/// fails its integrity checks, the parts before it stay open.
+		/// </summary>
+		static std::vector<PartFile*> OpenPartFiles(const std::vector<std::string>& partFilePaths, PartFileReadMode readMode = PartFileReadMode::Parallel);
+
+		/// <summary>
+		/// Whether OpenPartFile checks a text part against its CRC32C checksums, on by default.
+		/// A damaged or half written part then throws std::exception before any feature is
+		/// registered.  Parts saved without checksums open unchecked either way.
+		/// </summary>
+		static void SetVerifyIntegrity(bool verifyIntegrity);
+		static bool GetVerifyIntegrity();
+
+		/// <summary>
+		/// Whether OpenPartFile watches the part file for changes by other processes, off
+		/// by default.  A change is picked up when the session calls PartFileWatcher's
+		/// DispatchChanges, and is applied as ReloadChangedFeatures.  Only loose text parts
+		/// read in full are watched, Lazy parts keep the file mapped and other tools cannot
+		/// write it.  Saves another process leaves in the delta log are seen once compacted.
+		/// </summary>
+		static void SetWatchForChanges(bool watchForChanges);
+		static bool GetWatchForChanges();
+
+		/// <summary>
+		/// Re-reads the features whose bytes changed since the part was opened or last
+		/// reloaded, found by hashing every feature's text.  Changed features are patched
+		/// in place, so the objects the GuidObjectManager hands out stay valid, added ones
+		/// are registered and removed ones are unregistered but not freed.  A feature that
+		/// reads back the same as it is held, such as one this session saved, counts as
+		/// unchanged.  Sends Observer::ReloadPart with PartReloadNotifierData when anything
+		/// changed.  Throws std::exception if the part fails its integrity checks, nothing
+		/// is touched then.
+		/// </summary>
+		PartReloadResult ReloadChangedFeatures();
+
+		/// <summary>
+		/// Writes the part's dirty features, see Feature::IsDirty, and the features deleted
+		/// with DeleteFeature.  With the PartSaveQueue on, a Delta save queues them and
+		/// returns, and Observer::SavePart is sent once they are on disk.  A Full save always
+		/// returns with them on disk.  See PartSaveMode for when the whole part is written.
+		/// </summary>
+		void SavePart(PartSaveMode saveMode = PartSaveMode::Delta);
+
+		/// <summary>
+		/// Returns once every save of this part queued in the PartSaveQueue is on disk.
+		/// Throws std::exception if they could not be written.  ClosePart does this too.
+		/// </summary>
+		void FlushSaves();
+
+		void ClosePart();
+		void MakeWidgetFeature(bool option1, int values);
+		virtual ~PartFile();
+
+		/// <summary>
+		/// The mapped image when the part was opened from a binary part file, or the
+		/// shared entry's image when it was opened with PartFileReadMode::Shared, else nullptr.
+		/// </summary>
+		const BinaryPartImage* GetBinaryImage() const;
+
+		/// <summary>
+		/// The feature index when the part was opened with PartFileReadMode::Lazy, else nullptr.
+		/// </summary>
+		const LazyFeatureIndex* GetLazyIndex() const;
+
+		/// <summary>
+		/// Adds a new feature to the part, or replaces the one with its guid, and registers
+		/// it with the GuidObjectManager.  It is marked dirty, so the next SavePart writes it.
+		/// The part does not own it.  Throws std::exception for objects that are not an
+		/// Application::Feature.
+		/// </summary>
+		void AddFeature(GuidObject* feature);
+
+		/// <summary>
+		/// Takes the feature out of the part and the GuidObjectManager, the next SavePart
+		/// writes a tombstone for it.  The object is not freed.
+		/// </summary>
+		void DeleteFeature(int guid);
+
+		bool HasUnsavedChanges() const;
+
+		/// <summary>
+		/// Delta log size over part file size that starts a background compaction, 0.5 by default.
+		/// </summary>
+		void SetCompactionRatio(double compactionRatio);
+
+		/// <summary>
+		/// Blocks until a background compaction has finished, rethrowing its failure.
+		/// </summary>
+		void WaitForCompaction();
+
+	private:
+		PartFile(std::string partFilePath, int guid);
+		static PartFile* FinishOpening(const std::string& partFilePath, int guid, BinaryPartImage* binaryImage, LazyFeatureIndex* lazyIndex,
+			const std::vector<int>& featureGuids, bool holdsAllFeatures);
+		void ReleaseLazyIndex();
+		void StartWatching();
+		void StopWatching();
+		bool OnPartFileChanged();
+		PartDeltaLog& GetDeltaLog();
+		bool HasFeature(int guid) const;
+		std::vector<GuidObject*> GetModifiedFeatures() const;
+		void WriteWholePart();
+		std::string m_partFilePath;
+		BinaryPartImage* m_binaryImage;
+		LazyFeatureIndex* m_lazyIndex;
+		std::shared_ptr<PartDeltaLog> m_deltaLog; /** Shared with the PartSaveQueue, saves it could not write yet outlive the part. */
+		std::unordered_set<int> m_featureGuids; /** Of the features read from the part or added to it.  A lazy part's are in its index. */
+		std::set<int> m_deletedFeatures;
+		bool m_hasBaseFile; /** False for a part made with CreatePartFile until its first save writes it. */
+		bool m_holdsAllFeatures; /** Every feature of the part is registered, so it can be written from memory.  False for Stream, Lazy, binary and archived parts. */
+		uint64_t m_watchId;
+		std::unordered_map<int, uint64_t> m_featureHashes; /** Of each feature's text by guid, as last read, while watched. */
+	};
+}
+
+
+
+
+
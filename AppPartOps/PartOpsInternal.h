@@ -1,7 +1,39 @@
-#pragma once
-
-#include <string>
-
-
-void ReadInPartFile(int& guid, std::string partFilePath);
-
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include "PartOps.h"
+
+class PartFileTokenizer;
+
+namespace Application
+{
+	class BinaryPartImage;
+	class BinaryPartWriter;
+}
+
+
+// featureGuids comes back with the guids of the features read and registered
+void ReadInPartFile(int& guid, std::string partFilePath, Application::PartFileReadMode readMode, std::vector<int>& featureGuids);
+
+// PartFileReadMode::Shared, the view over the part's SharedPartCache entry.  nullptr when the part could
+// not be published, its features are then registered as ReadInPartFile would with PartFileReadMode::Parallel
+// and their guids come back in featureGuids.
+Application::BinaryPartImage* ReadInSharedPartFile(const std::string& partFilePath, std::vector<int>& featureGuids);
+
+// Reads a feature body with the view reader registered for featureType and version, then steps
+// it up through the registered version ups, or in one go with its latest view reader when it
+// has one.  version comes back as the version it ended at.
+// nullptr when there is no reader for that version, for example a library not loaded yet.
+GuidObject* ReadFeatureToLatestVersion(std::string_view featureType, int& version, PartFileTokenizer& tokenizer);
+
+// Writes content to a temp file next to filePath, flushes it to disk and renames it over
+// filePath, so readers see the old file or the new one and never a partial write.  Goes through PartFileIO::GetBackend.
+void WriteFileAtomically(const std::string& filePath, std::string_view content);
+// The same with content given in pieces, each goes out with its own write and none are joined first.
+void WriteFileAtomically(const std::string& filePath, const std::vector<std::string_view>& segments);
+
+// Adds feature to writer as a binary part record holding its field text, false for a feature type
+// with no record.  How the PartParseCache and the SharedPartCache lay their entries out.
+bool AddCacheRecord(Application::BinaryPartWriter& writer, GuidObject* feature);
@@ -0,0 +1,283 @@
+#include "framework.h"
+#include "PartParseCache.h"
+#include "BinaryPartImage.h"
+#include "BinaryPartWriter.h"
+#include "PartOpsInternal.h"
+#include <filesystem>
+#include <algorithm>
+#include "..\AppLibrary\Block.h"
+#include "..\AppLibrary\Extrude.h"
+#include "..\Core\ContentHash.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\StringUtils.h"
+
+using namespace Application;
+
+static const uint64_t DefaultMaxCacheBytes = 256ull * 1024 * 1024;
+
+// Only the header lines are looked at, the first feature ends the search
+static std::string_view FindSchemaVersion(const char* partData, size_t partSize)
+{
+	PartFileTokenizer tokenizer(partData, partSize);
+	std::string_view line;
+	while (tokenizer.NextLine(line))
+	{
+		if (startsWith(line, SchemaVersionToken))
+		{
+			return PartFileTokenizer::TokenValue(line, SchemaVersionToken);
+		}
+		if (startsWith(line, FeatureToken) || startsWith(line, RoutingFeatureToken))
+		{
+			break;
+		}
+	}
+	return std::string_view();
+}
+
+bool AddCacheRecord(BinaryPartWriter& writer, GuidObject* feature)
+{
+	Extrude* extrude = dynamic_cast<Extrude*>(feature);
+	if (extrude != nullptr)
+	{
+		BinaryPart::ExtrudeRecord record = {};
+		record.guid = extrude->GetGuid();
+		// entries hold field text like the binary part format, typed fields only become text here
+		std::string distance;
+		appendDouble(distance, extrude->GetDistance());
+
+		record.distance = writer.AddString(distance);
+		record.targetFace = writer.AddString(extrude->GetTargetFaceName());
+		record.vectorObject = writer.AddString(extrude->GetVectorObjectName());
+		record.booleanType = { BinaryPart::NoStringOffset, 0 };
+		record.isAddition = writer.AddString(boolToString(extrude->GetIsAddition()));
+		record.isSubtraction = writer.AddString(boolToString(extrude->GetIsSubtraction()));
+		writer.AddFeature((uint16_t)std::stoi(extrude->GetVersion()), record);
+		return true;
+	}
+
+	Block* block = dynamic_cast<Block*>(feature);
+	if (block != nullptr)
+	{
+		BinaryPart::BlockRecord record = {};
+		record.guid = block->GetGuid();
+
+		std::string field;
+		appendDoubleList(field, block->GetOrigin(), 3);
+		record.origin = writer.AddString(field);
+		field.clear();
+		appendDouble(field, block->GetLength());
+		record.length = writer.AddString(field);
+		field.clear();
+		appendDouble(field, block->GetWidth());
+		record.width = writer.AddString(field);
+		field.clear();
+		appendDouble(field, block->GetHeight());
+		record.height = writer.AddString(field);
+		writer.AddFeature((uint16_t)std::stoi(block->GetVersion()), record);
+		return true;
+	}
+	return false;
+}
+
+static GuidObject* LoadCacheRecord(const BinaryPartImage& image, const BinaryPart::TocEntry& tocEntry)
+{
+	if ((BinaryPart::FeatureType)tocEntry.featureType == BinaryPart::FeatureType::Extrude)
+	{
+		const BinaryPart::ExtrudeRecord& record = image.GetExtrude(tocEntry.recordIndex);
+		return Extrude::FromText(image.GetString(record.distance), image.GetString(record.targetFace),
+			image.GetString(record.vectorObject), image.GetString(record.isAddition),
+			image.GetString(record.isSubtraction), tocEntry.guid);
+	}
+	if ((BinaryPart::FeatureType)tocEntry.featureType == BinaryPart::FeatureType::Block)
+	{
+		const BinaryPart::BlockRecord& record = image.GetBlock(tocEntry.recordIndex);
+		return Block::FromText(image.GetString(record.origin), image.GetString(record.length),
+			image.GetString(record.width), image.GetString(record.height), tocEntry.guid);
+	}
+	throw std::exception("Unexpected feature type in parse cache entry");
+}
+
+
+PartParseCache& Application::PartParseCache::GetInstance()
+{
+	static PartParseCache instance;
+	return instance;
+}
+
+Application::PartParseCache::PartParseCache() : m_maxCacheBytes(DefaultMaxCacheBytes), m_hits(0), m_misses(0), m_stores(0), m_evictions(0)
+{
+
+}
+
+void Application::PartParseCache::SetCacheDirectory(const std::string& cacheDirectory)
+{
+	m_cacheDirectory = cacheDirectory;
+	if (!m_cacheDirectory.empty())
+	{
+		std::error_code error;
+		std::filesystem::create_directories(m_cacheDirectory, error);
+	}
+}
+
+std::string Application::PartParseCache::GetEntryPath(const char* partData, size_t partSize) const
+{
+	std::string_view schemaVersion = FindSchemaVersion(partData, partSize);
+	int schemaVersionValue = -1;
+	parseInt(schemaVersion, schemaVersionValue);
+
+	std::string entryName = ContentHashToString(HashContent(partData, partSize));
+	entryName.append("-s").append(std::to_string(schemaVersionValue));
+	entryName.append("-r").append(std::to_string(ReaderVersion));
+	entryName.append(".prtb");
+	return (std::filesystem::path(m_cacheDirectory) / entryName).string();
+}
+
+bool Application::PartParseCache::TryLoad(const char* partData, size_t partSize, std::vector<GuidObject*>& features)
+{
+	if (!IsEnabled())
+	{
+		return false;
+	}
+
+	std::string entryPath = GetEntryPath(partData, partSize);
+	if (!BinaryPartImage::IsBinaryPartFile(entryPath))
+	{
+		m_misses++;
+		return false;
+	}
+
+	std::vector<GuidObject*> loaded;
+	try
+	{
+		BinaryPartImage image(entryPath);
+		loaded.reserve(image.GetFeatureCount());
+		for (uint32_t i = 0; i < image.GetFeatureCount(); i++)
+		{
+			loaded.push_back(LoadCacheRecord(image, image.GetTocEntry(i)));
+		}
+	}
+	catch (std::exception&)
+	{
+		// a damaged entry is dropped and the part is parsed as if it was never cached
+		for (GuidObject* feature : loaded)
+		{
+			delete feature;
+		}
+		std::error_code error;
+		std::filesystem::remove(entryPath, error);
+		m_misses++;
+		return false;
+	}
+
+	// the write time doubles as the last use for eviction
+	std::error_code error;
+	std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+
+	features.insert(features.end(), loaded.begin(), loaded.end());
+	m_hits++;
+	return true;
+}
+
+void Application::PartParseCache::Store(const char* partData, size_t partSize, const std::vector<GuidObject*>& features)
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	BinaryPartWriter writer;
+	for (GuidObject* feature : features)
+	{
+		if (feature != nullptr && !AddCacheRecord(writer, feature))
+		{
+			return;
+		}
+	}
+
+	// other processes may be filling the same entry, each writes its own file and the rename settles it
+	std::string entryPath = GetEntryPath(partData, partSize);
+	std::string temporaryPath = entryPath + "." + std::to_string(GetCurrentProcessId()) + ".tmp";
+	writer.Write(temporaryPath);
+	if (!MoveFileExA(temporaryPath.c_str(), entryPath.c_str(), MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFileA(temporaryPath.c_str());
+		return;
+	}
+	m_stores++;
+
+	EvictToLimit();
+}
+
+void Application::PartParseCache::EvictToLimit()
+{
+	struct CacheEntry
+	{
+		std::filesystem::path path;
+		uint64_t size;
+		std::filesystem::file_time_type lastUsed;
+	};
+
+	std::vector<CacheEntry> entries;
+	uint64_t totalBytes = 0;
+	std::error_code error;
+	for (const std::filesystem::directory_entry& directoryEntry : std::filesystem::directory_iterator(m_cacheDirectory, error))
+	{
+		if (directoryEntry.path().extension() == ".prtb")
+		{
+			CacheEntry entry = { directoryEntry.path(), directoryEntry.file_size(error), directoryEntry.last_write_time(error) };
+			totalBytes += entry.size;
+			entries.push_back(entry);
+		}
+	}
+
+	if (totalBytes <= m_maxCacheBytes)
+	{
+		return;
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const CacheEntry& a, const CacheEntry& b) { return a.lastUsed < b.lastUsed; });
+	for (const CacheEntry& entry : entries)
+	{
+		if (totalBytes <= m_maxCacheBytes)
+		{
+			break;
+		}
+		if (std::filesystem::remove(entry.path, error))
+		{
+			totalBytes -= entry.size;
+			m_evictions++;
+		}
+	}
+}
+
+void Application::PartParseCache::Clear()
+{
+	if (!IsEnabled())
+	{
+		return;
+	}
+
+	std::error_code error;
+	for (const std::filesystem::directory_entry& directoryEntry : std::filesystem::directory_iterator(m_cacheDirectory, error))
+	{
+		if (directoryEntry.path().extension() == ".prtb")
+		{
+			std::filesystem::remove(directoryEntry.path(), error);
+		}
+	}
+}
+
+PartParseCacheStatistics Application::PartParseCache::GetStatistics() const
+{
+	PartParseCacheStatistics statistics = { m_hits, m_misses, m_stores, m_evictions };
+	return statistics;
+}
+
+void Application::PartParseCache::ResetStatistics()
+{
+	m_hits = 0;
+	m_misses = 0;
+	m_stores = 0;
+	m_evictions = 0;
+}
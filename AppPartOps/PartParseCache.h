@@ -0,0 +1,92 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <string>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+class GuidObject;
+
+namespace Application
+{
+	struct PartParseCacheStatistics
+	{
+		uint64_t hits;
+		uint64_t misses;
+		uint64_t stores;
+		uint64_t evictions;
+	};
+
+	/// <summary>
+	/// On disk cache of parsed, already version upped feature sets, one binary
+	/// part file (.prtb) per entry.  Entries are keyed by the part's content hash,
+	/// its SchemaVersion and ReaderVersion, so an edited part or a changed reader
+	/// simply misses.  Least recently used entries are evicted past the size limit.
+	/// Off until SetCacheDirectory is given a directory.
+	/// </summary>
+	class APPPARTOPS_API PartParseCache
+	{
+	public:
+		static PartParseCache& GetInstance();
+
+		PartParseCache(const PartParseCache&) = delete;
+		PartParseCache& operator=(const PartParseCache&) = delete;
+
+		/// <summary>
+		/// Bump when a reader or version up changes what a part reads as, old entries then stop matching.
+		/// </summary>
+		static const uint32_t ReaderVersion = 2;
+
+		/// <summary>
+		/// Where entries live, created if missing.  An empty path turns the cache off.
+		/// </summary>
+		void SetCacheDirectory(const std::string& cacheDirectory);
+		const std::string& GetCacheDirectory() const
+		{
+			return m_cacheDirectory;
+		}
+		bool IsEnabled() const
+		{
+			return !m_cacheDirectory.empty();
+		}
+
+		/// <summary>
+		/// Total size the entries may take up, 256 MB by default.
+		/// </summary>
+		void SetMaxCacheBytes(uint64_t maxCacheBytes)
+		{
+			m_maxCacheBytes = maxCacheBytes;
+		}
+
+		/// <summary>
+		/// Fills features from the entry for this part content, false on a miss.
+		/// </summary>
+		bool TryLoad(const char* partData, size_t partSize, std::vector<GuidObject*>& features);
+
+		/// <summary>
+		/// Writes the entry for this part content.  Nothing is stored if a feature
+		/// has no cache record, a partial entry would lose it on the next open.
+		/// </summary>
+		void Store(const char* partData, size_t partSize, const std::vector<GuidObject*>& features);
+
+		/// <summary>
+		/// Deletes every entry in the cache directory.
+		/// </summary>
+		void Clear();
+
+		PartParseCacheStatistics GetStatistics() const;
+		void ResetStatistics();
+
+	private:
+		PartParseCache();
+		std::string GetEntryPath(const char* partData, size_t partSize) const;
+		void EvictToLimit();
+
+		std::string m_cacheDirectory;
+		uint64_t m_maxCacheBytes;
+		std::atomic<uint64_t> m_hits;
+		std::atomic<uint64_t> m_misses;
+		std::atomic<uint64_t> m_stores;
+		std::atomic<uint64_t> m_evictions;
+	};
+}
@@ -0,0 +1,383 @@
+#include "PartSaveQueue.h"
+#include "PartDeltaLog.h"
+#include "DelMeBadPattern.h"
+#include <algorithm>
+#include <functional>
+#include "..\Core\CoreSession.h"
+#include "..\Core\Observer.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\ThreadPool.h"
+
+using namespace Application;
+
+PartSaveQueue& Application::PartSaveQueue::GetInstance()
+{
+	static PartSaveQueue instance;
+	return instance;
+}
+
+Application::PartSaveQueue::PartSaveQueue() : m_stopping(false), m_enabled(false), m_coalesceTime(100), m_statistics()
+{
+
+}
+
+Application::PartSaveQueue::~PartSaveQueue()
+{
+	Shutdown();
+}
+
+void Application::PartSaveQueue::SetEnabled(bool enabled)
+{
+	// saves already queued land before SavePart goes back to writing them itself
+	if (!enabled)
+	{
+		Barrier();
+	}
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_enabled = enabled;
+}
+
+bool Application::PartSaveQueue::IsEnabled() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_enabled;
+}
+
+void Application::PartSaveQueue::SetCoalesceMilliseconds(uint32_t coalesceMilliseconds)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_coalesceTime = std::chrono::milliseconds(coalesceMilliseconds);
+}
+
+void Application::PartSaveQueue::QueueSave(const std::string& partFilePath, int partGuid, std::shared_ptr<PartDeltaLog> deltaLog, std::vector<std::string> featureRecords,
+	const std::vector<int>& modifiedGuids, const std::vector<int>& deletedGuids)
+{
+	// split back into one record per guid, so a later save of the guid can replace it.  The writer
+	// never splits a feature across buffers, so each is scanned on its own
+	std::list<std::string> buffers;
+	std::vector<std::string_view> records;
+	records.reserve(modifiedGuids.size());
+	for (std::string& segment : featureRecords)
+	{
+		if (segment.empty())
+		{
+			continue;
+		}
+
+		buffers.push_back(std::move(segment));
+		const std::string& buffer = buffers.back();
+		PartFileLayout layout = ScanPartFileLayout(buffer.data(), buffer.size());
+		for (const FeatureSpan& span : layout.features)
+		{
+			records.push_back(std::string_view(buffer).substr(span.begin, span.end - span.begin));
+		}
+	}
+	if (records.size() != modifiedGuids.size())
+	{
+		throw std::exception("Saved feature records do not match the features saved");
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::map<std::string, QueuedPart>::iterator parked = m_queued.find(partFilePath);
+		if (parked != m_queued.end() && parked->second.failedWrites >= MaxFlusherAttempts)
+		{
+			// the caller's edits stay unsaved rather than pile up behind saves that cannot be written
+			std::string msg = "Unable to write queued saves of " + parked->second.failure + ", flush the part's saves before saving it again";
+			throw std::exception(msg.c_str());
+		}
+
+		std::pair<std::map<std::string, QueuedPart>::iterator, bool> queued = m_queued.try_emplace(partFilePath);
+		QueuedPart& part = queued.first->second;
+		if (queued.second)
+		{
+			part.partFilePath = partFilePath;
+			part.partGuid = partGuid;
+			part.deltaLog = std::move(deltaLog);
+			part.saveCount = 0;
+			part.failedWrites = 0;
+			part.dueAt = std::chrono::steady_clock::now() + m_coalesceTime;
+		}
+
+		// a record replaced by a later save keeps its buffer until the batch is written
+		part.buffers.splice(part.buffers.end(), buffers);
+		for (size_t i = 0; i < modifiedGuids.size(); i++)
+		{
+			part.features[modifiedGuids[i]] = records[i];
+			part.deletedGuids.erase(modifiedGuids[i]);
+		}
+		for (int guid : deletedGuids)
+		{
+			part.features.erase(guid);
+			part.deletedGuids.insert(guid);
+		}
+		part.saveCount++;
+		m_statistics.queuedSaves++;
+
+		if (!m_flusher.joinable())
+		{
+			m_stopping = false;
+			m_flusher = std::thread(&PartSaveQueue::FlusherLoop, this);
+		}
+	}
+	m_changed.notify_all();
+}
+
+bool Application::PartSaveQueue::HasQueuedSaves(const std::string& partFilePath)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_queued.find(partFilePath) != m_queued.end() || m_writing.find(partFilePath) != m_writing.end();
+}
+
+// A batch that failed goes back under the saves queued while it was being written
+void Application::PartSaveQueue::MergeOlder(QueuedPart& newer, QueuedPart& older)
+{
+	for (const std::pair<const int, std::string_view>& feature : older.features)
+	{
+		if (newer.features.find(feature.first) == newer.features.end() && newer.deletedGuids.find(feature.first) == newer.deletedGuids.end())
+		{
+			newer.features.insert(feature);
+		}
+	}
+	newer.buffers.splice(newer.buffers.end(), older.buffers);
+	for (int guid : older.deletedGuids)
+	{
+		if (newer.features.find(guid) == newer.features.end())
+		{
+			newer.deletedGuids.insert(guid);
+		}
+	}
+	newer.saveCount += older.saveCount;
+	newer.failedWrites = older.failedWrites;
+	newer.failure = older.failure;
+	newer.dueAt = std::min(newer.dueAt, older.dueAt);
+}
+
+// m_mutex is held.  Parts another thread is writing are left, their saves would land out of order
+std::vector<PartSaveQueue::QueuedPart> Application::PartSaveQueue::TakeParts(bool dueOnly, const std::string* partFilePath)
+{
+	std::vector<QueuedPart> parts;
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::map<std::string, QueuedPart>::iterator queued = m_queued.begin();
+	while (queued != m_queued.end())
+	{
+		bool take = m_writing.find(queued->first) == m_writing.end() && (partFilePath == nullptr || queued->first == *partFilePath)
+			&& (!dueOnly || queued->second.dueAt <= now);
+		if (!take)
+		{
+			++queued;
+			continue;
+		}
+
+		m_writing.insert(queued->first);
+		parts.push_back(std::move(queued->second));
+		queued = m_queued.erase(queued);
+	}
+	return parts;
+}
+
+// Appends each part's batch and sends Observer::SavePart for the ones on disk.  Returns the first failure, empty when there was none
+std::string Application::PartSaveQueue::WriteParts(std::vector<QueuedPart>& parts)
+{
+	std::vector<std::string> failures(parts.size());
+	std::function<void(size_t, size_t)> writeRange = [&parts, &failures](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			QueuedPart& part = parts[i];
+			std::vector<std::string_view> featureRecords;
+			featureRecords.reserve(part.features.size());
+			for (const std::pair<const int, std::string_view>& feature : part.features)
+			{
+				featureRecords.push_back(feature.second);
+			}
+
+			try
+			{
+				part.deltaLog->AppendSave(featureRecords, std::vector<int>(part.deletedGuids.begin(), part.deletedGuids.end()));
+			}
+			catch (std::exception& e)
+			{
+				failures[i] = part.partFilePath + ", " + e.what();
+			}
+		}
+	};
+
+	// every append flushes its own log, side by side on the ThreadPool the flushes of a round overlap
+	if (parts.size() == 1)
+	{
+		writeRange(0, 1);
+	}
+	else
+	{
+		ThreadPool::GetInstance().ParallelFor(parts.size(), writeRange);
+	}
+
+	std::string firstFailure;
+	std::vector<PartSaveNotifierData> written;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_statistics.writeRounds++;
+		for (size_t i = 0; i < parts.size(); i++)
+		{
+			QueuedPart& part = parts[i];
+			m_writing.erase(part.partFilePath);
+			if (failures[i].empty())
+			{
+				m_statistics.writtenBatches++;
+				PartSaveNotifierData partSaveNotifierData;
+				partSaveNotifierData.guid = part.partGuid;
+				partSaveNotifierData.partName = part.partFilePath;
+				partSaveNotifierData.coalescedSaves = part.saveCount;
+				written.push_back(partSaveNotifierData);
+				continue;
+			}
+
+			m_statistics.failedBatches++;
+			m_statistics.lastFailure = failures[i];
+			if (firstFailure.empty())
+			{
+				firstFailure = failures[i];
+			}
+			part.failedWrites++;
+			part.failure = failures[i];
+			part.dueAt = std::chrono::steady_clock::now() + m_coalesceTime;
+			if (part.failedWrites == MaxFlusherAttempts)
+			{
+				// parked, the flusher would only fail again.  A Flush, Barrier or ClosePart still writes it and throws the failure
+				m_statistics.parkedParts++;
+			}
+			if (part.failedWrites >= MaxFlusherAttempts)
+			{
+				part.dueAt = std::chrono::steady_clock::time_point::max();
+			}
+			std::pair<std::map<std::string, QueuedPart>::iterator, bool> queued = m_queued.try_emplace(part.partFilePath);
+			if (queued.second)
+			{
+				queued.first->second = std::move(part);
+			}
+			else
+			{
+				MergeOlder(queued.first->second, part);
+			}
+		}
+	}
+	m_changed.notify_all();
+
+	for (PartSaveNotifierData& partSaveNotifierData : written)
+	{
+		PartOpsNotifierData* ptr = &partSaveNotifierData;
+		CoreSession::GetInstance().CreateMessage(Observer::SavePart, (void*)ptr);
+	}
+	return firstFailure;
+}
+
+void Application::PartSaveQueue::FlusherLoop()
+{
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (!m_stopping)
+	{
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		std::chrono::steady_clock::time_point wakeAt = now + std::chrono::hours(1);
+		bool due = false;
+		for (const std::pair<const std::string, QueuedPart>& queued : m_queued)
+		{
+			if (m_writing.find(queued.first) == m_writing.end())
+			{
+				due = due || queued.second.dueAt <= now;
+				wakeAt = std::min(wakeAt, queued.second.dueAt);
+			}
+		}
+		if (!due)
+		{
+			m_changed.wait_until(lock, wakeAt);
+			continue;
+		}
+
+		std::vector<QueuedPart> parts = TakeParts(true, nullptr);
+		lock.unlock();
+		// a failed batch is queued again and tried a window later, up to MaxFlusherAttempts times.  Flush and Barrier throw it
+		WriteParts(parts);
+		lock.lock();
+	}
+}
+
+void Application::PartSaveQueue::Flush(const std::string& partFilePath)
+{
+	std::vector<QueuedPart> parts;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_changed.wait(lock, [&]() { return m_writing.find(partFilePath) == m_writing.end(); });
+		parts = TakeParts(false, &partFilePath);
+	}
+	if (parts.empty())
+	{
+		return;
+	}
+
+	std::string failure = WriteParts(parts);
+	if (!failure.empty())
+	{
+		std::string msg = "Unable to write queued saves of " + failure;
+		throw std::exception(msg.c_str());
+	}
+}
+
+void Application::PartSaveQueue::Barrier()
+{
+	std::vector<QueuedPart> parts;
+	{
+		// what the flusher is writing was queued before the call too
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_changed.wait(lock, [this]() { return m_writing.empty(); });
+		parts = TakeParts(false, nullptr);
+	}
+	if (parts.empty())
+	{
+		return;
+	}
+
+	std::string failure = WriteParts(parts);
+	if (!failure.empty())
+	{
+		std::string msg = "Unable to write queued saves of " + failure;
+		throw std::exception(msg.c_str());
+	}
+}
+
+void Application::PartSaveQueue::Shutdown()
+{
+	try
+	{
+		Barrier();
+	}
+	catch (std::exception&)
+	{
+		// WriteParts kept it in the statistics, the saves are still queued
+	}
+
+	std::thread flusher;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+		flusher = std::move(m_flusher);
+	}
+	m_changed.notify_all();
+	if (flusher.joinable())
+	{
+		flusher.join();
+	}
+}
+
+PartSaveQueueStatistics Application::PartSaveQueue::GetStatistics() const
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_statistics;
+}
+
+void Application::PartSaveQueue::ResetStatistics()
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_statistics = PartSaveQueueStatistics();
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace Application
+{
+	class PartDeltaLog;
+
+	struct PartSaveQueueStatistics
+	{
+		uint64_t queuedSaves; /** SavePart calls that queued records. */
+		uint64_t writtenBatches; /** Delta log batches written, one per part per round however many saves it held. */
+		uint64_t failedBatches;
+		uint64_t parkedParts; /** Parts the flusher stopped retrying, their saves wait for Flush or Barrier. */
+		uint64_t writeRounds; /** Times the flusher, Flush or Barrier wrote, the parts of a round are flushed together. */
+		std::string lastFailure; /** Part and reason of the last batch that could not be written, empty until one fails. */
+	};
+
+	/// <summary>
+	/// Write-behind for PartFile::SavePart.  When it is on, a Delta save turns the
+	/// part's edits into delta log records and queues them, and SavePart returns
+	/// without touching the disk.  A flusher thread writes a part's queued saves
+	/// once the coalesce window since the first of them has gone by, as a single
+	/// delta log batch in which the last save of a guid wins.  A script saving
+	/// after every edit then costs one append and one flush per window.  Parts
+	/// that come due together are appended on the ThreadPool, so their flushes
+	/// overlap rather than queue up.  Observer::SavePart, with PartSaveNotifierData,
+	/// is sent once a batch is on disk, from the thread that wrote it.  A batch that
+	/// fails stays queued under any later saves and is tried again a window later.
+	/// After MaxFlusherAttempts failures in a row the flusher leaves the part be, its
+	/// saves stay queued for Flush, Barrier or ClosePart to write or report, and the
+	/// part's next SavePart throws.  Failures the flusher meets are kept in
+	/// PartSaveQueueStatistics::lastFailure.
+	/// Off by default, SavePart then writes before it returns.
+	/// </summary>
+	class APPPARTOPS_API PartSaveQueue
+	{
+	public:
+		static PartSaveQueue& GetInstance();
+
+		/// <summary>
+		/// Writes of a part the flusher tries before it gives up on the part.
+		/// </summary>
+		static const size_t MaxFlusherAttempts = 5;
+
+		PartSaveQueue(const PartSaveQueue&) = delete;
+		PartSaveQueue& operator=(const PartSaveQueue&) = delete;
+
+		/// <summary>
+		/// Turning it off is a Barrier first, and throws as Barrier does.
+		/// </summary>
+		void SetEnabled(bool enabled);
+		bool IsEnabled() const;
+
+		/// <summary>
+		/// How long a part's first queued save waits for more before they are written, 100 ms by default.
+		/// </summary>
+		void SetCoalesceMilliseconds(uint32_t coalesceMilliseconds);
+
+		/// <summary>
+		/// Queues one save of the part, what SavePart does when the queue is on.
+		/// featureRecords are the buffers of a PartFileWriter, from TakeSegments, with
+		/// one feature per guid of modifiedGuids, in that order.  They are kept as they
+		/// are and the batch is written from them, through deltaLog, which the queue
+		/// holds on to until they are.  Throws std::exception, queueing nothing, when
+		/// the flusher gave up on the part's earlier saves.  Flush them first.
+		/// </summary>
+		void QueueSave(const std::string& partFilePath, int partGuid, std::shared_ptr<PartDeltaLog> deltaLog, std::vector<std::string> featureRecords,
+			const std::vector<int>& modifiedGuids, const std::vector<int>& deletedGuids);
+
+		bool HasQueuedSaves(const std::string& partFilePath);
+
+		/// <summary>
+		/// Writes the part's queued saves on the calling thread, waiting for the
+		/// flusher first if it has them.  Returns once they are on disk.  Throws
+		/// std::exception if they could not be written, they stay queued.
+		/// </summary>
+		void Flush(const std::string& partFilePath);
+
+		/// <summary>
+		/// Flush for every part, the saves queued before the call are on disk when it
+		/// returns.  Throws std::exception for the first part that failed, the others
+		/// are written regardless.  Not from inside a ThreadPool task.
+		/// </summary>
+		void Barrier();
+
+		/// <summary>
+		/// Barrier, leaving a failure in PartSaveQueueStatistics::lastFailure rather than
+		/// throwing it, and joins the flusher.  Saves that failed stay queued.  Call before
+		/// shutdownProduct, AutomationAPI::Session does.  A later save starts it again.
+		/// </summary>
+		void Shutdown();
+
+		PartSaveQueueStatistics GetStatistics() const;
+		void ResetStatistics();
+
+	private:
+		PartSaveQueue();
+		~PartSaveQueue();
+
+		struct QueuedPart
+		{
+			std::string partFilePath;
+			int partGuid;
+			std::shared_ptr<PartDeltaLog> deltaLog;
+			std::list<std::string> buffers; /** The writer buffers of the saves, a list so the records keep pointing into them as parts move. */
+			std::map<int, std::string_view> features; /** The last record saved for each guid, in guid order as SavePart writes them. */
+			std::set<int> deletedGuids;
+			size_t saveCount;
+			size_t failedWrites; /** Writes that failed in a row. */
+			std::string failure; /** Why the last of them failed. */
+			std::chrono::steady_clock::time_point dueAt;
+		};
+
+		static void MergeOlder(QueuedPart& newer, QueuedPart& older);
+		std::vector<QueuedPart> TakeParts(bool dueOnly, const std::string* partFilePath);
+		std::string WriteParts(std::vector<QueuedPart>& parts);
+		void FlusherLoop();
+
+		mutable std::mutex m_mutex;
+		std::condition_variable m_changed; /** A save was queued or a write finished, the flusher and Flush both wait on it. */
+		std::map<std::string, QueuedPart> m_queued; /** By part file path. */
+		std::set<std::string> m_writing; /** Parts taken for writing, a part is written by one thread at a time. */
+		std::thread m_flusher;
+		bool m_stopping;
+		bool m_enabled;
+		std::chrono::milliseconds m_coalesceTime;
+		PartSaveQueueStatistics m_statistics;
+	};
+}
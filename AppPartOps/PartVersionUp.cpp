@@ -0,0 +1,165 @@
+#include "framework.h"
+#include "PartVersionUp.h"
+#include "PartOpsInternal.h"
+#include <memory>
+#include "..\Core\Crc32C.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileIntegrity.h"
+#include "..\Core\PartFileIO.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\DataReader\DataObjectReader.h"
+
+void WriteFileAtomically(const std::string& filePath, const std::vector<std::string_view>& segments)
+{
+	PartFileIO::GetBackend().WriteFileNow(filePath, segments);
+}
+
+void WriteFileAtomically(const std::string& filePath, std::string_view content)
+{
+	WriteFileAtomically(filePath, std::vector<std::string_view>{ content });
+}
+
+GuidObject* ReadFeatureToLatestVersion(std::string_view featureType, int& version, PartFileTokenizer& tokenizer)
+{
+	DataObjectReader& dataReader = DataObjectReader::GetInstance();
+
+	if (version < 0)
+	{
+		return nullptr;
+	}
+
+	std::string typeName(featureType);
+
+	// a fused reader makes the latest version in one go, only the version number still has to step up
+	dataViewReaderFunction latestReaderFunc = dataReader.GetLatestViewReader(typeName + std::to_string(version));
+	if (latestReaderFunc != nullptr)
+	{
+		GuidObject* feature = latestReaderFunc(tokenizer);
+		while (dataReader.GetVersionUp(typeName + std::to_string(version)) != nullptr)
+		{
+			++version;
+		}
+		return feature;
+	}
+
+	dataViewReaderFunction readerFunc = dataReader.GetViewReader(typeName + std::to_string(version));
+	if (readerFunc == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<GuidObject> feature(readerFunc(tokenizer));
+	while (dataVersionUpFunction versionUpFunc = dataReader.GetVersionUp(typeName + std::to_string(version)))
+	{
+		feature.reset(versionUpFunc(feature.get()));
+		++version;
+	}
+	return feature.release();
+}
+
+/// <summary>
+/// Reads one feature at its own version and steps it up to the latest, appending it to out.
+/// Returns false, appending nothing, when the feature is already at its latest version.
+/// </summary>
+static bool VersionUpFeature(const char* data, const FeatureSpan& span, std::string& out, PartVersionUpResult& result)
+{
+	DataObjectReader& dataReader = DataObjectReader::GetInstance();
+
+	std::string typeName(span.featureType);
+	int version = span.version;
+
+	if (version < 0 || dataReader.GetVersionUp(typeName + std::to_string(version)) == nullptr)
+	{
+		return false;
+	}
+
+	PartFileTokenizer tokenizer(data + span.bodyBegin, span.end - span.bodyBegin);
+	std::unique_ptr<GuidObject> feature(ReadFeatureToLatestVersion(span.featureType, version, tokenizer));
+	if (feature == nullptr)
+	{
+		std::string msg = "No reader registered for " + typeName + std::to_string(span.version);
+		throw std::exception(msg.c_str());
+	}
+
+	std::string writerName = typeName + std::to_string(version);
+	dataWriterFunction writerFunc = dataReader.GetWriter(writerName);
+	if (writerFunc == nullptr)
+	{
+		std::string msg = "No writer registered for " + writerName;
+		throw std::exception(msg.c_str());
+	}
+	writerFunc(feature.get(), out);
+
+	std::string path = typeName + " " + std::to_string(span.version);
+	for (int step = span.version + 1; step <= version; ++step)
+	{
+		path.append("->").append(std::to_string(step));
+	}
+	++result.upgradePaths[path];
+	return true;
+}
+
+PartVersionUpResult VersionUpPartFile(const std::string& partFilePath)
+{
+	PartVersionUpResult result;
+	std::string upgraded;
+
+	{
+		MappedFile mappedFile(partFilePath);
+		if (!mappedFile.IsOpen())
+		{
+			std::string msg = "Unable to open part file " + partFilePath;
+			throw std::exception(msg.c_str());
+		}
+
+		const char* data = mappedFile.Data();
+		size_t size = mappedFile.Size();
+		result.bytesRead = size;
+
+		PartFileLayout layout = ScanPartFileLayout(data, size);
+		result.featureCount = layout.features.size();
+		upgraded.reserve(size + size / 8);
+
+		// the upgraded part gets fresh checksums, so damage has to be caught before they would cover it
+		PartFileChecksumCheck integrity(data, size, layout);
+		integrity.CheckFeatures(0, layout.features.size());
+		integrity.Verify();
+		bool checksummed = layout.hasFooter;
+
+		// Whatever sits between features, the header included, goes across untouched
+		size_t copiedUpTo = 0;
+		for (const FeatureSpan& span : layout.features)
+		{
+			upgraded.append(data + copiedUpTo, span.begin - copiedUpTo);
+			size_t featureBegin = upgraded.size();
+			if (VersionUpFeature(data, span, upgraded, result))
+			{
+				++result.upgradedFeatureCount;
+				if (checksummed || span.hasChecksum)
+				{
+					AppendFeatureChecksum(upgraded, featureBegin);
+				}
+			}
+			else
+			{
+				upgraded.append(data + span.begin, span.end - span.begin);
+			}
+			copiedUpTo = span.end;
+		}
+		upgraded.append(data + copiedUpTo, layout.footerBegin - copiedUpTo);
+		if (checksummed)
+		{
+			AppendPartFileChecksum(upgraded, Crc32C(upgraded.data(), upgraded.size()));
+		}
+	}
+
+	// The mapping has to be gone before the rename can replace the file
+	if (result.upgradedFeatureCount != 0)
+	{
+		WriteFileAtomically(partFilePath, upgraded);
+		result.bytesWritten = upgraded.size();
+	}
+
+	return result;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <cstdint>
+#include <map>
+#include <string>
+
+/// <summary>
+/// What VersionUpPartFile did to one part file.
+/// </summary>
+struct PartVersionUpResult
+{
+	size_t featureCount = 0;
+	size_t upgradedFeatureCount = 0;
+	uint64_t bytesRead = 0;
+	uint64_t bytesWritten = 0;
+
+	/// <summary>
+	/// Upgrade path, e.g. "Extrude 2->3", to the number of features that took it.
+	/// </summary>
+	std::map<std::string, size_t> upgradePaths;
+};
+
+/// <summary>
+/// Brings every feature in the text part file at partFilePath up to its latest version and
+/// writes the file back atomically, through a temp file and a rename.  Uses the readers,
+/// version ups and writers registered with the DataObjectReader, so libraries holding
+/// feature types (COOLDEMANDLOADEDLIBRARY for Wire) must be loaded first.
+/// Features already at their latest version are copied as they are, a file with nothing to
+/// upgrade is not rewritten.  Throws std::exception, leaving the file untouched, when a
+/// feature has no reader or no writer for the version it ends up at.
+/// Safe to call for different files from several threads at once.
+/// </summary>
+APPPARTOPS_API PartVersionUpResult VersionUpPartFile(const std::string& partFilePath);
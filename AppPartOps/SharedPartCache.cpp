@@ -0,0 +1,570 @@
+#include "framework.h"
+#include "SharedPartCache.h"
+#include "BinaryPartImage.h"
+#include "BinaryPartWriter.h"
+#include "PartOpsInternal.h"
+#include "PartParseCache.h"
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <boost/interprocess/managed_windows_shared_memory.hpp>
+#include "..\Core\ContentHash.h"
+
+using namespace Application;
+
+namespace bip = boost::interprocess;
+
+// A Windows named segment rather than a file backed one, it cannot outlive the processes using it
+typedef bip::managed_windows_shared_memory SharedSegment;
+
+const char* const SharedPartCache::DefaultSegmentName = "Local\\PartFileSharedPartCache";
+
+static const char* const DirectoryName = "SharedPartCacheDirectory";
+
+// Bump when SharedEntry or SharedDirectory change, processes built before then cannot open the segment
+static const uint32_t DirectoryLayoutVersion = 2;
+static const uint32_t DirectorySlotCount = 4096;
+static const uint32_t HoldersPerEntry = 8;
+static const uint32_t NoSlot = ~0u;
+
+// The processes holding references on an entry, so the references of one that died can be taken back
+struct SharedHolder
+{
+	uint32_t processId;
+	uint32_t references;
+	uint64_t processStartTime; /** Tells the process apart from a later one given the same id. */
+};
+
+// Lives in the segment, so only offsets and plain values, no pointers
+struct SharedEntry
+{
+	uint64_t pathHash;
+	uint64_t contentHash;
+	SharedSegment::handle_t image; /** Offset of the image in the segment, each process maps it at its own address. */
+	uint64_t imageSize;
+	uint64_t lastUsed; /** The directory clock at the last Find or Publish. */
+	uint32_t references; /** Images handed out over the entry, in every process, the sum of the holders'. */
+	uint32_t inUse;
+	SharedHolder holders[HoldersPerEntry];
+};
+
+// Guarded by the named mutex next to the segment, not one inside it, see DirectoryLock
+struct SharedDirectory
+{
+	SharedDirectory() : layoutVersion(DirectoryLayoutVersion), readerVersion(PartParseCache::ReaderVersion), clock(0), entryCount(0), entryBytes(0)
+	{
+		memset(entries, 0, sizeof(entries));
+	}
+
+	uint32_t layoutVersion;
+	uint32_t readerVersion;
+	uint64_t clock;
+	uint32_t entryCount;
+	uint64_t entryBytes;
+	SharedEntry entries[DirectorySlotCount];
+};
+
+struct SharedPartCache::Segment
+{
+	Segment(const std::string& segmentName, uint64_t segmentBytes)
+		: memory(bip::open_or_create, segmentName.c_str(), (std::size_t)segmentBytes), directory(nullptr), directoryMutex(nullptr)
+	{
+		// named after the segment, in the same Local\ or Global\ namespace
+		std::string mutexName = segmentName + ".Directory";
+		directoryMutex = CreateMutexA(nullptr, FALSE, mutexName.c_str());
+		if (directoryMutex == nullptr)
+		{
+			std::string msg = "Unable to create the directory mutex of shared part cache " + segmentName;
+			throw std::exception(msg.c_str());
+		}
+		directory = memory.find_or_construct<SharedDirectory>(DirectoryName)();
+	}
+
+	~Segment()
+	{
+		if (directoryMutex != nullptr)
+		{
+			CloseHandle(directoryMutex);
+		}
+	}
+
+	Segment(const Segment&) = delete;
+	Segment& operator=(const Segment&) = delete;
+
+	SharedSegment memory;
+	SharedDirectory* directory;
+	HANDLE directoryMutex;
+};
+
+static uint64_t ProcessStartTime(HANDLE process)
+{
+	FILETIME creation, exit, kernel, user;
+	if (!GetProcessTimes(process, &creation, &exit, &kernel, &user))
+	{
+		return 0;
+	}
+	return ((uint64_t)creation.dwHighDateTime << 32) | creation.dwLowDateTime;
+}
+
+static uint64_t CurrentProcessStartTime()
+{
+	static const uint64_t startTime = ProcessStartTime(GetCurrentProcess());
+	return startTime;
+}
+
+static bool IsProcessAlive(uint32_t processId, uint64_t processStartTime)
+{
+	HANDLE process = OpenProcess(SYNCHRONIZE | PROCESS_QUERY_LIMITED_INFORMATION, FALSE, processId);
+	if (process == nullptr)
+	{
+		// access denied is a process of another user, it is running
+		return GetLastError() == ERROR_ACCESS_DENIED;
+	}
+	bool alive = WaitForSingleObject(process, 0) == WAIT_TIMEOUT && ProcessStartTime(process) == processStartTime;
+	CloseHandle(process);
+	return alive;
+}
+
+// The directory mutex is held by every function below, up to DirectoryLock
+
+static bool AddHolderReference(SharedEntry& entry)
+{
+	uint32_t processId = GetCurrentProcessId();
+	uint64_t processStartTime = CurrentProcessStartTime();
+	SharedHolder* freeHolder = nullptr;
+	for (SharedHolder& holder : entry.holders)
+	{
+		if (holder.references > 0 && holder.processId == processId && holder.processStartTime == processStartTime)
+		{
+			holder.references++;
+			entry.references++;
+			return true;
+		}
+		if (holder.references == 0 && freeHolder == nullptr)
+		{
+			freeHolder = &holder;
+		}
+	}
+
+	// more processes hold the entry than it has room to track, this one parses the part itself
+	if (freeHolder == nullptr)
+	{
+		return false;
+	}
+	freeHolder->processId = processId;
+	freeHolder->processStartTime = processStartTime;
+	freeHolder->references = 1;
+	entry.references++;
+	return true;
+}
+
+static void ReleaseHolderReference(SharedEntry& entry)
+{
+	uint32_t processId = GetCurrentProcessId();
+	uint64_t processStartTime = CurrentProcessStartTime();
+	for (SharedHolder& holder : entry.holders)
+	{
+		if (holder.references > 0 && holder.processId == processId && holder.processStartTime == processStartTime)
+		{
+			holder.references--;
+			entry.references--;
+			return;
+		}
+	}
+}
+
+// Takes back the references of processes that ended without releasing them, so their entries can be evicted again
+static uint32_t ReclaimDeadHolders(SharedDirectory& directory)
+{
+	uint32_t processId = GetCurrentProcessId();
+	std::map<std::pair<uint32_t, uint64_t>, bool> alive;
+	uint32_t reclaimed = 0;
+	for (SharedEntry& entry : directory.entries)
+	{
+		if (!entry.inUse || entry.references == 0)
+		{
+			continue;
+		}
+
+		uint32_t references = 0;
+		for (SharedHolder& holder : entry.holders)
+		{
+			if (holder.references == 0 || holder.processId == processId)
+			{
+				references += holder.references;
+				continue;
+			}
+
+			std::pair<uint32_t, uint64_t> process(holder.processId, holder.processStartTime);
+			std::map<std::pair<uint32_t, uint64_t>, bool>::iterator found = alive.find(process);
+			if (found == alive.end())
+			{
+				found = alive.emplace(process, IsProcessAlive(holder.processId, holder.processStartTime)).first;
+			}
+			if (found->second)
+			{
+				references += holder.references;
+			}
+			else
+			{
+				reclaimed += holder.references;
+				memset(&holder, 0, sizeof(holder));
+			}
+		}
+		entry.references = references;
+	}
+	return reclaimed;
+}
+
+// A process that died holding the mutex may have stopped between any two stores, so the totals are counted again
+static void RepairDirectory(SharedDirectory& directory)
+{
+	directory.entryCount = 0;
+	directory.entryBytes = 0;
+	for (SharedEntry& entry : directory.entries)
+	{
+		if (entry.inUse)
+		{
+			directory.entryCount++;
+			directory.entryBytes += entry.imageSize;
+		}
+	}
+	ReclaimDeadHolders(directory);
+}
+
+// A named Win32 mutex rather than a boost::interprocess one in the segment, when its holder dies
+// Windows hands it to the next waiter with WAIT_ABANDONED instead of leaving every process stuck
+class DirectoryLock
+{
+public:
+	DirectoryLock(HANDLE mutex, SharedDirectory& directory) : m_mutex(mutex)
+	{
+		DWORD waited = WaitForSingleObject(m_mutex, INFINITE);
+		if (waited == WAIT_ABANDONED)
+		{
+			RepairDirectory(directory);
+		}
+		else if (waited != WAIT_OBJECT_0)
+		{
+			throw std::exception("Unable to lock the shared part cache directory");
+		}
+	}
+
+	~DirectoryLock()
+	{
+		ReleaseMutex(m_mutex);
+	}
+
+	DirectoryLock(const DirectoryLock&) = delete;
+	DirectoryLock& operator=(const DirectoryLock&) = delete;
+
+private:
+	HANDLE m_mutex;
+};
+
+// Holds one reference on an entry for as long as the image over it lives
+class SharedPartCache::Lease
+{
+public:
+	Lease(std::shared_ptr<Segment> segment) : m_segment(std::move(segment)), m_slot(NoSlot)
+	{
+	}
+
+	~Lease()
+	{
+		if (m_slot != NoSlot)
+		{
+			DirectoryLock lock(m_segment->directoryMutex, *m_segment->directory);
+			ReleaseHolderReference(m_segment->directory->entries[m_slot]);
+		}
+	}
+
+	Lease(const Lease&) = delete;
+	Lease& operator=(const Lease&) = delete;
+
+	std::shared_ptr<Segment> m_segment;
+	uint32_t m_slot; /** Set under the directory mutex along with the reference it stands for. */
+};
+
+static uint64_t HashPartPath(const std::string& partFilePath)
+{
+	std::error_code error;
+	std::string path = std::filesystem::absolute(partFilePath, error).lexically_normal().string();
+	if (error)
+	{
+		path = partFilePath;
+	}
+	return HashContent(path.data(), path.size());
+}
+
+static uint32_t FindEntry(SharedDirectory& directory, uint64_t pathHash, uint64_t contentHash)
+{
+	for (uint32_t slot = 0; slot < DirectorySlotCount; slot++)
+	{
+		const SharedEntry& entry = directory.entries[slot];
+		if (entry.inUse && entry.pathHash == pathHash && entry.contentHash == contentHash)
+		{
+			return slot;
+		}
+	}
+	return NoSlot;
+}
+
+static uint32_t FindLeastRecentlyUsed(const SharedDirectory& directory)
+{
+	uint32_t oldest = NoSlot;
+	for (uint32_t slot = 0; slot < DirectorySlotCount; slot++)
+	{
+		const SharedEntry& entry = directory.entries[slot];
+		if (entry.inUse && entry.references == 0 && (oldest == NoSlot || entry.lastUsed < directory.entries[oldest].lastUsed))
+		{
+			oldest = slot;
+		}
+	}
+	return oldest;
+}
+
+static void EvictEntry(SharedSegment& memory, SharedDirectory& directory, uint32_t slot)
+{
+	// unlisted before the image is freed, dying in between leaks the image rather than listing freed memory
+	SharedEntry& entry = directory.entries[slot];
+	SharedSegment::handle_t image = entry.image;
+	directory.entryCount--;
+	directory.entryBytes -= entry.imageSize;
+	memset(&entry, 0, sizeof(entry));
+	memory.deallocate(memory.get_address_from_handle(image));
+}
+
+// FindLeastRecentlyUsed, taking back dead processes' references when every entry is held
+static uint32_t FindEvictable(SharedDirectory& directory)
+{
+	uint32_t oldest = FindLeastRecentlyUsed(directory);
+	if (oldest == NoSlot && ReclaimDeadHolders(directory) > 0)
+	{
+		oldest = FindLeastRecentlyUsed(directory);
+	}
+	return oldest;
+}
+
+
+SharedPartCache& Application::SharedPartCache::GetInstance()
+{
+	static SharedPartCache instance;
+	return instance;
+}
+
+Application::SharedPartCache::SharedPartCache() : m_hits(0), m_misses(0), m_publishes(0), m_evictions(0)
+{
+
+}
+
+void Application::SharedPartCache::Open(const std::string& segmentName, uint64_t segmentBytes)
+{
+	std::shared_ptr<Segment> segment;
+	try
+	{
+		segment = std::make_shared<Segment>(segmentName, segmentBytes);
+	}
+	catch (bip::interprocess_exception& e)
+	{
+		// a segment too small for the directory ends up here too, as bip::bad_alloc
+		std::string msg = "Unable to open shared part cache " + segmentName + ", " + e.what();
+		throw std::exception(msg.c_str());
+	}
+	if (segment->directory->layoutVersion != DirectoryLayoutVersion || segment->directory->readerVersion != PartParseCache::ReaderVersion)
+	{
+		std::string msg = "Shared part cache " + segmentName + " was created by a different version";
+		throw std::exception(msg.c_str());
+	}
+
+	{
+		// processes that crashed while the segment was kept open by others left their references behind
+		DirectoryLock lock(segment->directoryMutex, *segment->directory);
+		ReclaimDeadHolders(*segment->directory);
+	}
+
+	std::lock_guard<std::mutex> lock(m_segmentMutex);
+	m_segment = segment;
+}
+
+void Application::SharedPartCache::Close()
+{
+	std::lock_guard<std::mutex> lock(m_segmentMutex);
+	m_segment.reset();
+}
+
+bool Application::SharedPartCache::IsEnabled() const
+{
+	return GetSegment() != nullptr;
+}
+
+std::shared_ptr<SharedPartCache::Segment> Application::SharedPartCache::GetSegment() const
+{
+	std::lock_guard<std::mutex> lock(m_segmentMutex);
+	return m_segment;
+}
+
+BinaryPartImage* Application::SharedPartCache::Find(const std::string& partFilePath, const char* partData, size_t partSize)
+{
+	std::shared_ptr<Segment> segment = GetSegment();
+	if (segment == nullptr)
+	{
+		return nullptr;
+	}
+
+	uint64_t pathHash = HashPartPath(partFilePath);
+	uint64_t contentHash = HashContent(partData, partSize);
+	std::shared_ptr<Lease> lease = std::make_shared<Lease>(segment);
+	const char* image = nullptr;
+	size_t imageSize = 0;
+	{
+		SharedDirectory& directory = *segment->directory;
+		DirectoryLock lock(segment->directoryMutex, directory);
+		uint32_t slot = FindEntry(directory, pathHash, contentHash);
+		if (slot == NoSlot || !AddHolderReference(directory.entries[slot]))
+		{
+			m_misses++;
+			return nullptr;
+		}
+
+		SharedEntry& entry = directory.entries[slot];
+		entry.lastUsed = ++directory.clock;
+		lease->m_slot = slot;
+		image = (const char*)segment->memory.get_address_from_handle(entry.image);
+		imageSize = (size_t)entry.imageSize;
+	}
+
+	m_hits++;
+	return new BinaryPartImage(image, imageSize, lease);
+}
+
+BinaryPartImage* Application::SharedPartCache::Publish(const std::string& partFilePath, const char* partData, size_t partSize, const std::vector<GuidObject*>& features)
+{
+	std::shared_ptr<Segment> segment = GetSegment();
+	if (segment == nullptr)
+	{
+		return nullptr;
+	}
+
+	BinaryPartWriter writer;
+	for (GuidObject* feature : features)
+	{
+		if (feature != nullptr && !AddCacheRecord(writer, feature))
+		{
+			return nullptr;
+		}
+	}
+	std::vector<char> image = writer.GetImage();
+
+	// one part taking most of the segment would push every other part out
+	if (image.size() > segment->memory.get_size() / 2)
+	{
+		return nullptr;
+	}
+
+	uint64_t pathHash = HashPartPath(partFilePath);
+	uint64_t contentHash = HashContent(partData, partSize);
+	SharedDirectory& directory = *segment->directory;
+	std::shared_ptr<Lease> lease = std::make_shared<Lease>(segment);
+
+	// Room is made and the block taken under the directory mutex, but nothing lists the block yet
+	void* block = nullptr;
+	{
+		DirectoryLock lock(segment->directoryMutex, directory);
+		for (uint32_t slot = 0; slot < DirectorySlotCount; slot++)
+		{
+			SharedEntry& entry = directory.entries[slot];
+			if (entry.inUse && entry.references == 0 && entry.pathHash == pathHash && entry.contentHash != contentHash)
+			{
+				EvictEntry(segment->memory, directory, slot);
+				m_evictions++;
+			}
+		}
+
+		while ((block = segment->memory.allocate(image.size(), std::nothrow)) == nullptr)
+		{
+			uint32_t oldest = FindEvictable(directory);
+			if (oldest == NoSlot)
+			{
+				return nullptr;
+			}
+			EvictEntry(segment->memory, directory, oldest);
+			m_evictions++;
+		}
+	}
+
+	// so the copy holds up no other process, and no process can see the block until it is whole
+	memcpy(block, image.data(), image.size());
+
+	const char* published = nullptr;
+	size_t publishedSize = 0;
+	{
+		DirectoryLock lock(segment->directoryMutex, directory);
+		uint32_t slot = FindEntry(directory, pathHash, contentHash);
+		if (slot != NoSlot)
+		{
+			// another process published the same part while this one copied, use theirs
+			segment->memory.deallocate(block);
+		}
+		else
+		{
+			for (slot = 0; slot < DirectorySlotCount && directory.entries[slot].inUse; slot++)
+			{
+			}
+			if (slot == DirectorySlotCount)
+			{
+				slot = FindEvictable(directory);
+				if (slot == NoSlot)
+				{
+					segment->memory.deallocate(block);
+					return nullptr;
+				}
+				EvictEntry(segment->memory, directory, slot);
+				m_evictions++;
+			}
+
+			SharedEntry& entry = directory.entries[slot];
+			entry.pathHash = pathHash;
+			entry.contentHash = contentHash;
+			entry.image = segment->memory.get_handle_from_address(block);
+			entry.imageSize = image.size();
+			entry.inUse = 1;
+			directory.entryCount++;
+			directory.entryBytes += image.size();
+			m_publishes++;
+		}
+
+		SharedEntry& entry = directory.entries[slot];
+		if (!AddHolderReference(entry))
+		{
+			return nullptr;
+		}
+		entry.lastUsed = ++directory.clock;
+		lease->m_slot = slot;
+		published = (const char*)segment->memory.get_address_from_handle(entry.image);
+		publishedSize = (size_t)entry.imageSize;
+	}
+
+	return new BinaryPartImage(published, publishedSize, lease);
+}
+
+SharedPartCacheStatistics Application::SharedPartCache::GetStatistics() const
+{
+	SharedPartCacheStatistics statistics = { m_hits, m_misses, m_publishes, m_evictions, 0, 0 };
+	std::shared_ptr<Segment> segment = GetSegment();
+	if (segment != nullptr)
+	{
+		DirectoryLock lock(segment->directoryMutex, *segment->directory);
+		statistics.entryCount = segment->directory->entryCount;
+		statistics.entryBytes = segment->directory->entryBytes;
+	}
+	return statistics;
+}
+
+void Application::SharedPartCache::ResetStatistics()
+{
+	m_hits = 0;
+	m_misses = 0;
+	m_publishes = 0;
+	m_evictions = 0;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "AppPartOpsExports.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class GuidObject;
+
+namespace Application
+{
+	class BinaryPartImage;
+
+	struct SharedPartCacheStatistics
+	{
+		uint64_t hits; /** This process's, as are misses, publishes and evictions. */
+		uint64_t misses;
+		uint64_t publishes;
+		uint64_t evictions;
+		uint32_t entryCount; /** Across every process mapping the segment. */
+		uint64_t entryBytes;
+	};
+
+	/// <summary>
+	/// Parsed, already version upped feature sets shared between processes through a
+	/// named shared memory segment, so automation processes on one machine parse a
+	/// reference part once between them.  An entry is a binary part image (.prtb)
+	/// keyed by the part's path and content hash, it is never written once it is
+	/// published and is handed out as a BinaryPartImage read in place.  An entry
+	/// is only listed in the segment's directory once its bytes are copied in, and
+	/// each image handed out holds a reference that keeps its entry from being
+	/// evicted.  When the segment fills, the least recently used entries nobody
+	/// holds are evicted.  The segment goes away with the last process that has
+	/// it open.  Off until Open is called.
+	///
+	/// A process may die while others keep the segment open.  The directory is locked
+	/// with a named Win32 mutex, so the next process to lock it gets WAIT_ABANDONED
+	/// instead of hanging, and recounts the directory first.  Each reference records
+	/// the id and start time of its process.  Open, an abandoned lock and an eviction
+	/// that finds every entry held take back the references of processes that are gone.
+	/// Limits: an entry tracks the references of 8 processes, a ninth gets a miss and
+	/// parses the part itself.  A process dying inside the segment's own allocator, or
+	/// between taking a block and listing it, leaks that block until the segment goes away.
+	/// </summary>
+	class APPPARTOPS_API SharedPartCache
+	{
+	public:
+		static SharedPartCache& GetInstance();
+
+		SharedPartCache(const SharedPartCache&) = delete;
+		SharedPartCache& operator=(const SharedPartCache&) = delete;
+
+		static const char* const DefaultSegmentName;
+		static const uint64_t DefaultSegmentBytes = 256ull * 1024 * 1024;
+
+		/// <summary>
+		/// Opens the segment named segmentName, creating it segmentBytes large if no
+		/// process has it open.  Throws std::exception if it cannot be created or was
+		/// created by a build with another entry layout or PartParseCache::ReaderVersion.
+		/// </summary>
+		void Open(const std::string& segmentName = DefaultSegmentName, uint64_t segmentBytes = DefaultSegmentBytes);
+
+		/// <summary>
+		/// Stops using the segment.  Images already handed out stay valid, the
+		/// segment is unmapped once they are deleted.
+		/// </summary>
+		void Close();
+
+		bool IsEnabled() const;
+
+		/// <summary>
+		/// A view over the entry for this part path and content, nullptr on a miss.
+		/// The caller deletes it, which releases its reference on the entry.
+		/// </summary>
+		BinaryPartImage* Find(const std::string& partFilePath, const char* partData, size_t partSize);
+
+		/// <summary>
+		/// Publishes the entry for this part path and content and returns a view over
+		/// it as Find does.  nullptr when nothing could be published: a feature has no
+		/// cache record, or the image will not fit beside the entries in use.  Older
+		/// content of the same path is evicted first when nobody holds it.
+		/// </summary>
+		BinaryPartImage* Publish(const std::string& partFilePath, const char* partData, size_t partSize, const std::vector<GuidObject*>& features);
+
+		SharedPartCacheStatistics GetStatistics() const;
+		void ResetStatistics();
+
+	private:
+		SharedPartCache();
+
+		struct Segment;
+		class Lease;
+		std::shared_ptr<Segment> GetSegment() const;
+
+		mutable std::mutex m_segmentMutex; /** Guards m_segment, the segment's own entries are guarded in the segment. */
+		std::shared_ptr<Segment> m_segment;
+		std::atomic<uint64_t> m_hits;
+		std::atomic<uint64_t> m_misses;
+		std::atomic<uint64_t> m_publishes;
+		std::atomic<uint64_t> m_evictions;
+	};
+}
@@ -1 +1 @@
-#include "CadObjectBuilder.h"
+#include "CadObjectBuilder.h"
@@ -1,5 +1,5 @@
-#pragma once
-class CadObjectBuilder
-{
-};
-
+#pragma once
+class CadObjectBuilder
+{
+};
+
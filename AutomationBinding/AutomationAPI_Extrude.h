@@ -1,15 +1,15 @@
-#pragma once
-#include "AutomationBindingExports.h"
-#include "AutomationAPI_CADObject.h"
-
-namespace AutomationAPI
-{
-	/// <summary>
-	/// Extrude object
-	/// </summary>
-	class AUTOMATIONBINDING_API Extrude : public CADObject
-	{
-
-
-	};
-}
+#pragma once
+#include "AutomationBindingExports.h"
+#include "AutomationAPI_CADObject.h"
+
+namespace AutomationAPI
+{
+	/// <summary>
+	/// Extrude object
+	/// </summary>
+	class AUTOMATIONBINDING_API Extrude : public CADObject
+	{
+
+
+	};
+}
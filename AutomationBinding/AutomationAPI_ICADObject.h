@@ -1,15 +1,15 @@
-#pragma once
-#include "AutomationBindingExports.h"
-namespace AutomationAPI
-{
-	/// <summary>
-	/// ICADObject comment
-	/// </summary>
-	class AUTOMATIONBINDING_API ICADObject
-	{
-
-		virtual int GetGuid() = 0;
-
-
-	};
+#pragma once
+#include "AutomationBindingExports.h"
+namespace AutomationAPI
+{
+	/// <summary>
+	/// ICADObject comment
+	/// </summary>
+	class AUTOMATIONBINDING_API ICADObject
+	{
+
+		virtual int GetGuid() = 0;
+
+
+	};
 }
\ No newline at end of file
@@ -1,50 +1,79 @@
-#pragma once
-
-#include "AutomationBindingExports.h"
-#include <string>
-
-
-namespace AutomationAPI
-{
-	class Part;
-	/// <summary>
-	/// This represents an Session object which is needed for any automation workflow.
-	/// </summary>
-	class AUTOMATIONBINDING_API Session
-	{
-		public :
-			/// <summary>
-			/// This method should be called first in any automation program.
-			/// </summary>
-			/// This is used as the starting point in any automation workflow.
-			/// <returns>Generates and\or returns the Session object.</returns>
-			static Session* GetSession();
-
-
-			/// <summary>
-			/// Generates the Part File at the path specificed
-			/// </summary>
-			/// To save the part afterward  use [Part.Save()](@ref Part.Save())
-			/// <param name="partFilePath">The path to the file to be created</param>
-			/// <returns>The part created </returns>
-			Part* MakePart(std::string partFilePath);
-
-			/**
-			* <summary>Opens an existing the Part File at the path specificed</summary>
-			* To save the part afterware use [Save Method](@ref Part.Save())
-
-			*/
-			Part* OpenPart(std::string partFilePath);
-
-			virtual ~Session();
-			Session(const Session&) = delete;
-			Session& operator=(const Session&) = delete;
-
-		private:
-			Session() = default;
-
-	};
-
-}
-
-
+#pragma once
+
+#include "AutomationBindingExports.h"
+#include <string>
+
+
+namespace AutomationAPI
+{
+	class Part;
+	/// <summary>
+	/// This represents an Session object which is needed for any automation workflow.
+	/// </summary>
+	class AUTOMATIONBINDING_API Session
+	{
+		public :
+			/// <summary>
+			/// This method should be called first in any automation program.
+			/// </summary>
+			/// This is used as the starting point in any automation workflow.
+			/// <returns>Generates and\or returns the Session object.</returns>
+			static Session* GetSession();
+
+
+			/// <summary>
+			/// Generates the Part File at the path specificed
+			/// </summary>
+			/// To save the part afterward  use [Part.Save()](@ref Part.Save())
+			/// <param name="partFilePath">The path to the file to be created</param>
+			/// <returns>The part created </returns>
+			Part* MakePart(std::string partFilePath);
+
+			/**
+			* <summary>Opens an existing the Part File at the path specificed</summary>
+			* To save the part afterware use [Save Method](@ref Part.Save())
+
+			*/
+			Part* OpenPart(std::string partFilePath);
+
+			/// <summary>
+			/// Turns write-behind saves on or off, off by default.
+			/// </summary>
+			/// When on, [Part.Save()](@ref Part.Save()) queues the save and returns, repeated saves
+			/// of a part are written together shortly after.  Use [Part.Flush()](@ref Part.Flush())
+			/// or SaveBarrier when the saves must be on disk before the script goes on.
+			/// <param name="enabled">Whether saves are queued</param>
+			void SetWriteBehindSaves(bool enabled);
+
+			/// <summary>
+			/// Returns once every save queued so far, of every part, is on disk.
+			/// </summary>
+			void SaveBarrier();
+
+			/// <summary>
+			/// Turns watching for changes by other processes on or off, off by default.
+			/// </summary>
+			/// When on, parts opened afterwards are watched.  A change is applied to the open
+			/// part, only the features whose text changed are read again, the next time
+			/// DispatchChanges is called.
+			/// <param name="watchForChanges">Whether opened parts are watched</param>
+			void SetWatchForChanges(bool watchForChanges);
+
+			/// <summary>
+			/// Applies the changes other processes made to watched parts since the last call.
+			/// </summary>
+			/// <returns>How many changed part files were applied.</returns>
+			int DispatchChanges();
+
+			virtual ~Session();
+			Session(const Session&) = delete;
+			Session& operator=(const Session&) = delete;
+
+		private:
+			Session() = default;
+
+	};
+
+}
+
+
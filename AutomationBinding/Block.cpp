@@ -1 +1 @@
-#include "AutomationAPI_Block.h"
+#include "AutomationAPI_Block.h"
@@ -1,6 +1,6 @@
-#include "AutomationAPI_CADObject.h"
-
-int AutomationAPI::CADObject::GetGuid()
-{
-	return 0;
-}
+#include "AutomationAPI_CADObject.h"
+
+int AutomationAPI::CADObject::GetGuid()
+{
+	return 0;
+}
@@ -1 +1 @@
-#include "AutomationAPI_Extrude.h"
+#include "AutomationAPI_Extrude.h"
@@ -1 +1 @@
-#include "AutomationAPI_IBuilder.h"
+#include "AutomationAPI_IBuilder.h"
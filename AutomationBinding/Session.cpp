@@ -1,45 +1,68 @@
-#include "AutomationAPI_Session.h"
-#include "AutomationAPI_Part.h"
-#include "..\Core\Core.h"
-#include "..\AppPartOps\PartOps.h"
-#include "..\AppPartOps\Journaling_Session.h"
-
-
-AutomationAPI::Session* AutomationAPI::Session::GetSession()
-{
-	static Session instance;
-	bool authorized = true;
-
-	if (!authorized || initializeProduct() != 0)
-	{
-		throw std::exception("Not authorized to get Session, purchase license");
-	}
-
-	return &instance;
-	
-}
-
-AutomationAPI::Part* AutomationAPI::Session::MakePart(std::string partFilePath)
-{
-	Application::PartFile * partFile =  Journaling_Session_MakePart(partFilePath);
-
-	int guid = partFile->GetGuid();
-
-	return AutomationAPI::Part::CreatePart(guid);
-}
-
-AutomationAPI::Part* AutomationAPI::Session::OpenPart(std::string partFilePath)
-{
-	Application::PartFile* partFile = Journaling_Session_OpenPart(partFilePath);
-
-	int guid = partFile->GetGuid();
-
-	return AutomationAPI::Part::CreatePart(guid);
-}
-
-
-AutomationAPI::Session::~Session()
-{
-	shutdownProduct();
-}
-
+#include "AutomationAPI_Session.h"
+#include "AutomationAPI_Part.h"
+#include "..\Core\Core.h"
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\Journaling_Session.h"
+#include "..\AppPartOps\PartSaveQueue.h"
+
+
+AutomationAPI::Session* AutomationAPI::Session::GetSession()
+{
+	static Session instance;
+	bool authorized = true;
+
+	if (!authorized || initializeProduct() != 0)
+	{
+		throw std::exception("Not authorized to get Session, purchase license");
+	}
+
+	return &instance;
+	
+}
+
+AutomationAPI::Part* AutomationAPI::Session::MakePart(std::string partFilePath)
+{
+	Application::PartFile * partFile =  Journaling_Session_MakePart(partFilePath);
+
+	int guid = partFile->GetGuid();
+
+	return AutomationAPI::Part::CreatePart(guid);
+}
+
+AutomationAPI::Part* AutomationAPI::Session::OpenPart(std::string partFilePath)
+{
+	Application::PartFile* partFile = Journaling_Session_OpenPart(partFilePath);
+
+	int guid = partFile->GetGuid();
+
+	return AutomationAPI::Part::CreatePart(guid);
+}
+
+void AutomationAPI::Session::SetWriteBehindSaves(bool enabled)
+{
+	Journaling_Session_SetWriteBehindSaves(enabled);
+}
+
+void AutomationAPI::Session::SaveBarrier()
+{
+	Journaling_Session_SaveBarrier();
+}
+
+void AutomationAPI::Session::SetWatchForChanges(bool watchForChanges)
+{
+	Journaling_Session_SetWatchForChanges(watchForChanges);
+}
+
+int AutomationAPI::Session::DispatchChanges()
+{
+	return Journaling_Session_DispatchChanges();
+}
+
+
+AutomationAPI::Session::~Session()
+{
+	// the queued saves go to their delta logs before the parts are torn down
+	Application::PartSaveQueue::GetInstance().Shutdown();
+	shutdownProduct();
+}
+
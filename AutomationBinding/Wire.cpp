@@ -1 +1 @@
-#include "AutomationAPI_Wire.h"
+#include "AutomationAPI_Wire.h"
@@ -1,15 +1,43 @@
-#include "RoutingFeature.h"
-#include "Wire.h"
-
-
-
-void ProcessRoutingFeature(std::string featureType, std::ifstream& streamObject)
-{
-
-	if (featureType == "Wire")
-	{
-		ReadInWire(streamObject);
-	}
-
-
-}
+#include "RoutingFeature.h"
+#include "Wire.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PerfectHash.h"
+
+
+
+namespace
+{
+	struct RoutingFeatureReaders
+	{
+		void (*streamReader)(std::ifstream& streamObject);
+		void (*viewReader)(PartFileTokenizer& tokenizer);
+	};
+}
+
+// One probe per feature whatever the number of types, add new routing feature types here
+static constexpr PerfectHashEntry<RoutingFeatureReaders> RoutingFeatureReaderEntries[] =
+{
+	{ "Wire", { ReadInWire, ReadInWire } },
+};
+
+static constexpr auto RoutingFeatureReaderMap = MakePerfectHashMap(RoutingFeatureReaderEntries);
+static_assert(RoutingFeatureReaderMap.IsPerfect(), "no perfect hash seed for the routing feature types");
+
+
+void ProcessRoutingFeature(std::string featureType, std::ifstream& streamObject)
+{
+	const RoutingFeatureReaders* readers = RoutingFeatureReaderMap.Find(featureType);
+	if (readers != nullptr)
+	{
+		readers->streamReader(streamObject);
+	}
+}
+
+void ProcessRoutingFeature(std::string_view featureType, PartFileTokenizer& tokenizer)
+{
+	const RoutingFeatureReaders* readers = RoutingFeatureReaderMap.Find(featureType);
+	if (readers != nullptr)
+	{
+		readers->viewReader(tokenizer);
+	}
+}
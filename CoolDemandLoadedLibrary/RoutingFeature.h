@@ -1,15 +1,26 @@
-#pragma once
-
-#include "CoolDemandLoadedLibraryExports.h"
-#include <iostream>
-#include <fstream>
-
-static std::string RoutingFeatureToken = "RoutingFeature:";
-static std::string EndRoutingFeatureToken = "EndRoutingFeature";
-
-
-void ProcessRoutingFeature(std::string featureType, std::ifstream& streamObject);
-
-class COOLDEMANDLOADEDLIBRARY_API RoutingFeature
-{
-};
+#pragma once
+
+#include "CoolDemandLoadedLibraryExports.h"
+#include <iostream>
+#include <fstream>
+#include <string_view>
+#include "..\Core\PartFileTokens.h"
+#include "..\Core\PartFileWritable.h"
+
+
+class PartFileTokenizer;
+
+void ProcessRoutingFeature(std::string featureType, std::ifstream& streamObject);
+void ProcessRoutingFeature(std::string_view featureType, PartFileTokenizer& tokenizer);
+
+class COOLDEMANDLOADEDLIBRARY_API RoutingFeature : public IPartFileWritable
+{
+public:
+	virtual ~RoutingFeature()
+	{
+
+	}
+
+	// Every routing feature type writes itself, RoutingFeature: line through EndRoutingFeature
+	void WriteFeature(std::string& out) override = 0;
+};
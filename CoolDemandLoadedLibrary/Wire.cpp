@@ -1,151 +1,257 @@
-#include "Wire.h"
-#include "WireVersions.h"
-#include <fstream>
-#include "..\Core\StringUtils.h"
-#include "..\DataReader\DataObjectReader.h"
-#include "..\DataReader\\DataReaderRegistrant.h"
-#include "..\Core\GuidObject.h"
-
-
-std::string Wire_VersionToken = "Wire_Version:";
-std::string Wire_DistanceToken = "Wire_Distance:";
-
-
-GuidObject* ReadWireVersion2(std::ifstream& streamObject);
-GuidObject* ReadWireVersion3(std::ifstream& streamObject);
-
-Wire* VersionUpWireVersion2(Wire2 *oldFeature);
-
-static DataReaderRegistrant wire2registrant("Wire2", ReadWireVersion2);
-static DataReaderRegistrant wire3registrant("Wire3", ReadWireVersion3);
-
-
-
-Wire::Wire(std::string distance, int guid)
-	: IWire(guid), m_distance(distance)
-{
-
-}
-std::string Wire::GetVersion()
-{
-	return "3";
-}
-
-void ReadInWire(std::ifstream& streamObject)
-{
-
-	std::cout << "    ProcessWire" << std::endl;
-	std::string line;
-	getline(streamObject, line);
-
-	//IExtrude* extrudeReadIn = nullptr;
-	void* wireReadIn = nullptr;
-
-	std::string version = line.substr(Wire_VersionToken.size(), line.size() - Wire_VersionToken.size());
-	std::cout << "    " << Wire_VersionToken << " " << version << std::endl;
-
-	std::string WireVersionToken = "Wire" + version;
-
-	dataReaderFunction readerFunc = nullptr;
-
-	readerFunc = DataObjectReader::GetInstance().GetReader(WireVersionToken);
-
-	if (readerFunc != nullptr)
-	{
-		wireReadIn = readerFunc(streamObject);
-	}
-
-
-	IWire* wireReadInterface = (IWire*)wireReadIn;
-
-	Wire* retVal = dynamic_cast<Wire*>(wireReadInterface);
-
-	if (dynamic_cast<Wire*>(wireReadInterface) == nullptr)
-	{
-		if (version == "1")
-		{
-
-		}
-		else if (version == "2")
-		{
-			Wire2* wireVersion2 = dynamic_cast<Wire2*>(wireReadInterface);
-			retVal = VersionUpWireVersion2(wireVersion2);
-		}
-		// need to upgrade to latest Version
-		
-	}
-	else
-	{
-		return; // We woudl probably like to return this retVal
-	}
-
-}
-
-GuidObject * ReadWireVersion2(std::ifstream& streamObject)
-{
-	std::string line;
-
-	std::string distance;
-
-
-	bool done = false;
-	while (!done)
-	{
-		getline(streamObject, line);
-		std::cout << line << '\n';
-
-
-
-		if (startsWith(line, EndRoutingFeatureToken))
-		{
-			done = true;
-		}
-
-		else if (startsWith(line, Wire_DistanceToken))
-		{
-			distance = line.substr(Wire_DistanceToken.size(), line.size() - Wire_DistanceToken.size());
-			std::cout << "    " << Wire_DistanceToken << " " << distance << std::endl;
-		}
-
-	}
-	// TODO totally made up guid
-	int guid = 99999;
-
-	// TODO no validation we read in all the right fields 
-
-	return new Wire2(distance, guid);
-
-}
-
-
-GuidObject* ReadWireVersion3(std::ifstream& streamObject)
-{
-
-	throw std::exception("NIY");
-
-	return nullptr;
-
-}
-
-
-Wire* VersionUpWireVersion2(Wire2 * oldFeature)
-{
-	Wire* retval = nullptr;
-
-	//Old Items
-	const std::string distance = oldFeature->GetDistance();
-
-	//New Items
-	std::string isAddition;
-	std::string isSubtraction;
-
-	int guid = oldFeature->GetGuid();
-
-	std::cout << "    VersionUpExtrudeVersion2" << std::endl;
-
-
-	retval = new Wire(distance, guid);
-
-	return retval;
-
-}
+#include "Wire.h"
+#include "WireVersions.h"
+#include <fstream>
+#include <memory>
+#include "..\Core\StringUtils.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\DataReader\DataObjectReader.h"
+#include "..\DataReader\\DataReaderRegistrant.h"
+#include "..\Core\GuidObject.h"
+
+
+GuidObject* ReadWireVersion2(std::ifstream& streamObject);
+GuidObject* ReadWireVersion3(std::ifstream& streamObject);
+GuidObject* ReadWireVersion2View(PartFileTokenizer& tokenizer);
+GuidObject* ReadWireVersion3View(PartFileTokenizer& tokenizer);
+GuidObject* ReadWireVersion2AsLatestView(PartFileTokenizer& tokenizer);
+
+Wire* VersionUpWireVersion2(Wire2 *oldFeature);
+static Wire* VersionUpToLatestWire(std::string_view version, GuidObject* wireReadIn);
+static GuidObject* VersionUpWire2(GuidObject* oldObject);
+static double ParseWireDistance(std::string_view distance);
+static std::string ReadWireFields(std::ifstream& streamObject);
+static std::string_view ReadWireFields(PartFileTokenizer& tokenizer);
+static void WriteWireVersion3(GuidObject* object, std::string& out);
+
+// Routing features carry no guid in the part file, nothing looks a wire up by one
+static const int NoWireGuid = -1;
+
+static DataReaderRegistrant wire2registrant("Wire2", ReadWireVersion2, ReadWireVersion2View, VersionUpWire2,
+	ReadWireVersion2AsLatestView);
+static DataReaderRegistrant wire3registrant("Wire3", ReadWireVersion3, ReadWireVersion3View, WriteWireVersion3);
+
+
+
+Wire::Wire(double distance, int guid)
+	: IWire(guid), m_distance(distance)
+{
+
+}
+std::string Wire::GetVersion()
+{
+	return "3";
+}
+
+void Wire::WriteFeature(std::string& out)
+{
+	out.append(RoutingFeatureToken).append("Wire\n");
+	out.append(Wire_VersionToken).append(GetVersion()).append("\n");
+	appendDouble(out.append(Wire_DistanceToken), m_distance);
+	out.append("\n");
+	out.append(EndRoutingFeatureToken).append("\n");
+}
+
+void ReadInWire(std::ifstream& streamObject)
+{
+
+	std::cout << "    ProcessWire" << std::endl;
+	std::string line;
+	getline(streamObject, line);
+
+	GuidObject* wireReadIn = nullptr;
+
+	std::string version = line.substr(Wire_VersionToken.size(), line.size() - Wire_VersionToken.size());
+	std::cout << "    " << Wire_VersionToken << " " << version << std::endl;
+
+	std::string WireVersionToken = "Wire" + version;
+
+	dataReaderFunction readerFunc = nullptr;
+
+	readerFunc = DataObjectReader::GetInstance().GetReader(WireVersionToken);
+
+	if (readerFunc != nullptr)
+	{
+		wireReadIn = readerFunc(streamObject);
+	}
+
+	// routing features are only traced, nothing keeps the wire
+	delete VersionUpToLatestWire(version, wireReadIn);
+}
+
+void ReadInWire(PartFileTokenizer& tokenizer)
+{
+	std::string_view line;
+	tokenizer.NextLine(line);
+
+	GuidObject* wireReadIn = nullptr;
+
+	std::string_view version = PartFileTokenizer::TokenValue(line, Wire_VersionToken);
+
+	std::string WireVersionToken("Wire");
+	WireVersionToken.append(version);
+
+	DataObjectReader& dataReader = DataObjectReader::GetInstance();
+	dataViewReaderFunction readerFunc = dataReader.GetLatestViewReader(WireVersionToken);
+	if (readerFunc != nullptr)
+	{
+		// already the latest Wire, no Wire2 in between
+		delete readerFunc(tokenizer);
+		return;
+	}
+
+	readerFunc = dataReader.GetViewReader(WireVersionToken);
+
+	if (readerFunc != nullptr)
+	{
+		wireReadIn = readerFunc(tokenizer);
+	}
+
+	// routing features are only traced, nothing keeps the wire
+	delete VersionUpToLatestWire(version, wireReadIn);
+}
+
+static Wire* VersionUpToLatestWire(std::string_view version, GuidObject* wireReadIn)
+{
+	// whatever was read is owned here, only the latest version leaves
+	std::unique_ptr<GuidObject> readIn(wireReadIn);
+
+	Wire* latest = dynamic_cast<Wire*>(wireReadIn);
+	if (latest != nullptr)
+	{
+		readIn.release();
+		return latest;
+	}
+
+	if (version == "2")
+	{
+		Wire2* wireVersion2 = dynamic_cast<Wire2*>(wireReadIn);
+		if (wireVersion2 != nullptr)
+		{
+			return VersionUpWireVersion2(wireVersion2);
+		}
+	}
+	return nullptr;
+}
+
+GuidObject * ReadWireVersion2(std::ifstream& streamObject)
+{
+	return new Wire2(ParseWireDistance(ReadWireFields(streamObject)), NoWireGuid);
+}
+
+
+GuidObject* ReadWireVersion3(std::ifstream& streamObject)
+{
+	return new Wire(ParseWireDistance(ReadWireFields(streamObject)), NoWireGuid);
+}
+
+GuidObject* ReadWireVersion2View(PartFileTokenizer& tokenizer)
+{
+	return new Wire2(ParseWireDistance(ReadWireFields(tokenizer)), NoWireGuid);
+}
+
+// Version 2 text straight into a version 3 Wire, the distance carries over as it is
+GuidObject* ReadWireVersion2AsLatestView(PartFileTokenizer& tokenizer)
+{
+	return new Wire(ParseWireDistance(ReadWireFields(tokenizer)), NoWireGuid);
+}
+
+GuidObject* ReadWireVersion3View(PartFileTokenizer& tokenizer)
+{
+	return new Wire(ParseWireDistance(ReadWireFields(tokenizer)), NoWireGuid);
+}
+
+// Every Wire version so far has the one field, the distance.  The rest of the body is skipped
+static std::string ReadWireFields(std::ifstream& streamObject)
+{
+	std::string line;
+
+	std::string distance;
+
+	// a part cut short ends the wire rather than leave getline failing forever
+	bool done = false;
+	while (!done && getline(streamObject, line))
+	{
+		std::cout << line << '\n';
+
+		if (startsWith(line, EndRoutingFeatureToken))
+		{
+			done = true;
+		}
+
+		else if (startsWith(line, Wire_DistanceToken))
+		{
+			distance = line.substr(Wire_DistanceToken.size(), line.size() - Wire_DistanceToken.size());
+			std::cout << "    " << Wire_DistanceToken << " " << distance << std::endl;
+		}
+
+	}
+	return distance;
+}
+
+static std::string_view ReadWireFields(PartFileTokenizer& tokenizer)
+{
+	std::string_view line;
+
+	std::string_view distance;
+
+	std::string_view value;
+	bool done = false;
+	while (!done && tokenizer.NextLine(line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::EndRoutingFeature:
+			done = true;
+			break;
+		case PartFileKey::Wire_Distance:
+			distance = value;
+			break;
+		default:
+			break;
+		}
+	}
+	return distance;
+}
+
+Wire* VersionUpWireVersion2(Wire2 * oldFeature)
+{
+	Wire* retval = nullptr;
+
+	//Old Items
+	const double distance = oldFeature->GetDistance();
+
+	int guid = oldFeature->GetGuid();
+
+
+	retval = new Wire(distance, guid);
+
+	return retval;
+
+}
+
+static GuidObject* VersionUpWire2(GuidObject* oldObject)
+{
+	Wire2* wireVersion2 = dynamic_cast<Wire2*>(oldObject);
+	if (wireVersion2 == nullptr)
+	{
+		throw std::exception("Wire2 version up given a different feature");
+	}
+	return VersionUpWireVersion2(wireVersion2);
+}
+
+static void WriteWireVersion3(GuidObject* object, std::string& out)
+{
+	Wire* wire = dynamic_cast<Wire*>(object);
+	if (wire == nullptr)
+	{
+		throw std::exception("Wire3 writer given a different feature");
+	}
+	wire->WriteFeature(out);
+}
+
+// A distance that was not given is NaN, text that is not a number throws
+static double ParseWireDistance(std::string_view distance)
+{
+	return parseDoubleField(Wire_DistanceToken, distance);
+}
@@ -1,13 +1,23 @@
-#include "WireVersions.h"
-
-
-Wire2::Wire2(std::string distance, int guid)
-	: IWire(guid), m_distance(distance)
-{
-
-}
-
-std::string Wire2::GetVersion()
-{
-	return "2";
-}
\ No newline at end of file
+#include "WireVersions.h"
+#include "..\Core\StringUtils.h"
+
+
+Wire2::Wire2(double distance, int guid)
+	: IWire(guid), m_distance(distance)
+{
+
+}
+
+std::string Wire2::GetVersion()
+{
+	return "2";
+}
+
+void Wire2::WriteFeature(std::string& out)
+{
+	out.append(RoutingFeatureToken).append("Wire\n");
+	out.append(Wire_VersionToken).append(GetVersion()).append("\n");
+	appendDouble(out.append(Wire_DistanceToken), m_distance);
+	out.append("\n");
+	out.append(EndRoutingFeatureToken).append("\n");
+}
@@ -1,23 +1,26 @@
-#pragma once
-
-#include "Wire.h"
-#include <string>
-
-class Wire2 : public RoutingFeature, public IWire
-{
-public:
-	Wire2(std::string distance, int guid);
-	std::string GetVersion() override;
-
-	const std::string& GetDistance()
-	{
-		return m_distance;
-	};
-
-
-
-private:
-	std::string m_distance;
-
-};
-
+#pragma once
+
+#include "Wire.h"
+#include <string>
+
+class Wire2 : public RoutingFeature, public IWire
+{
+public:
+	Wire2(double distance, int guid);
+	std::string GetVersion() override;
+
+	// Appends the wire as version 2 text, which reads back into the latest version
+	void WriteFeature(std::string& out) override;
+
+	double GetDistance() const
+	{
+		return m_distance;
+	};
+
+
+
+private:
+	double m_distance;
+
+};
+
@@ -0,0 +1,117 @@
+#include "ContentHash.h"
+#include <cstring>
+
+static const uint64_t Prime1 = 11400714785074694791ULL;
+static const uint64_t Prime2 = 14029467366897019727ULL;
+static const uint64_t Prime3 = 1609587929392839161ULL;
+static const uint64_t Prime4 = 9650029242287828579ULL;
+static const uint64_t Prime5 = 2870177450012600261ULL;
+
+static inline uint64_t RotateLeft(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+// unaligned little endian loads, memcpy compiles down to a plain mov
+static inline uint64_t Read64(const unsigned char* bytes)
+{
+	uint64_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+static inline uint32_t Read32(const unsigned char* bytes)
+{
+	uint32_t value;
+	memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+static inline uint64_t Round(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * Prime2;
+	accumulator = RotateLeft(accumulator, 31);
+	return accumulator * Prime1;
+}
+
+static inline uint64_t MergeRound(uint64_t accumulator, uint64_t value)
+{
+	accumulator ^= Round(0, value);
+	return accumulator * Prime1 + Prime4;
+}
+
+uint64_t HashContent(const void* data, size_t size, uint64_t seed)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	const unsigned char* end = bytes + size;
+	uint64_t hash;
+
+	if (size >= 32)
+	{
+		// four independent lanes over 32 byte stripes
+		uint64_t lane1 = seed + Prime1 + Prime2;
+		uint64_t lane2 = seed + Prime2;
+		uint64_t lane3 = seed;
+		uint64_t lane4 = seed - Prime1;
+
+		const unsigned char* stripesEnd = end - 32;
+		do
+		{
+			lane1 = Round(lane1, Read64(bytes));
+			lane2 = Round(lane2, Read64(bytes + 8));
+			lane3 = Round(lane3, Read64(bytes + 16));
+			lane4 = Round(lane4, Read64(bytes + 24));
+			bytes += 32;
+		} while (bytes <= stripesEnd);
+
+		hash = RotateLeft(lane1, 1) + RotateLeft(lane2, 7) + RotateLeft(lane3, 12) + RotateLeft(lane4, 18);
+		hash = MergeRound(hash, lane1);
+		hash = MergeRound(hash, lane2);
+		hash = MergeRound(hash, lane3);
+		hash = MergeRound(hash, lane4);
+	}
+	else
+	{
+		hash = seed + Prime5;
+	}
+
+	hash += (uint64_t)size;
+
+	while (bytes + 8 <= end)
+	{
+		hash ^= Round(0, Read64(bytes));
+		hash = RotateLeft(hash, 27) * Prime1 + Prime4;
+		bytes += 8;
+	}
+	if (bytes + 4 <= end)
+	{
+		hash ^= (uint64_t)Read32(bytes) * Prime1;
+		hash = RotateLeft(hash, 23) * Prime2 + Prime3;
+		bytes += 4;
+	}
+	while (bytes < end)
+	{
+		hash ^= (*bytes) * Prime5;
+		hash = RotateLeft(hash, 11) * Prime1;
+		bytes++;
+	}
+
+	hash ^= hash >> 33;
+	hash *= Prime2;
+	hash ^= hash >> 29;
+	hash *= Prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+
+std::string ContentHashToString(uint64_t hash)
+{
+	static const char HexDigits[] = "0123456789abcdef";
+	std::string text(16, '0');
+	for (int i = 15; i >= 0; i--)
+	{
+		text[i] = HexDigits[hash & 0xF];
+		hash >>= 4;
+	}
+	return text;
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "CoreExports.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+/// <summary>
+/// 64 bit xxHash (XXH64) of size bytes at data.  Not cryptographic, it is
+/// for telling whether part file content changed, at memory bandwidth speed.
+/// </summary>
+CORE_API uint64_t HashContent(const void* data, size_t size, uint64_t seed = 0);
+
+/// <summary>
+/// hash as 16 lower case hex digits, for file names and logs.
+/// </summary>
+CORE_API std::string ContentHashToString(uint64_t hash);
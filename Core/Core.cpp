@@ -1,24 +1,44 @@
-// Core.cpp : Defines the exported functions for the DLL.
-//
-
-#include "framework.h"
-#include "Core.h"
-#include <iostream>
-#include "CoreSession.h"
-
-static CoreSession* m_coreSession = nullptr;
-
-CORE_API int initializeProduct(void)
-{
-	std::cout << "Product Core is Initialized" << std::endl;
-	CoreSession::GetInstance();
-	return 0;
-}
-
-CORE_API int shutdownProduct(void)
-{
-	std::cout << "Product Core is Shutdown" << std::endl;
-	CoreSession::GetInstance().ClearObservers();
-	return 0;
-}
-
+// Core.cpp : Defines the exported functions for the DLL.
+//
+
+#include "framework.h"
+#include "Core.h"
+#include <iostream>
+#include "CoreSession.h"
+#include "PartFileIO.h"
+#include "PartFileWatcher.h"
+#include "ThreadPool.h"
+
+static CoreSession* m_coreSession = nullptr;
+
+CORE_API int initializeProduct(void)
+{
+	std::cout << "Product Core is Initialized" << std::endl;
+	CoreSession::GetInstance();
+	return 0;
+}
+
+CORE_API int shutdownProduct(void)
+{
+	std::cout << "Product Core is Shutdown" << std::endl;
+	CoreSession::GetInstance().ClearObservers();
+	PartFileWatcher::GetInstance().Shutdown();
+	// queued saves and journals land before the process goes.  Shutdown swallows a failed write, it is asked for first
+	int result = 0;
+	for (PartFileIO* backend : { &PartFileIO::GetCompletionPortBackend(), &PartFileIO::GetThreadPoolBackend() })
+	{
+		try
+		{
+			backend->WaitForWrites();
+		}
+		catch (std::exception& e)
+		{
+			std::cerr << "Product Core shutdown: " << e.what() << std::endl;
+			result = 1;
+		}
+		backend->Shutdown();
+	}
+	ThreadPool::GetInstance().Shutdown();
+	return result;
+}
+
@@ -1,7 +1,8 @@
-#include "CoreExports.h"
-
-CORE_API int initializeProduct(void);
-
-CORE_API int shutdownProduct(void);
-
-
+#include "CoreExports.h"
+
+CORE_API int initializeProduct(void);
+
+// Nonzero when a queued write, a save or a journal, could not be written
+CORE_API int shutdownProduct(void);
+
+
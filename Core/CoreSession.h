@@ -1,47 +1,50 @@
-#pragma once
-#include "CoreExports.h"
-#include "ISubject.h"
-#include <list>
-#include <iostream>
-
-class Observer;
-
-class CORE_API CoreSession : ISubject
-{
-	public:
-        static CoreSession& GetInstance();
-
-        CoreSession(CoreSession const&) = delete;
-        void operator=(CoreSession const&) = delete;
-
-
-        ~CoreSession() override;
-
-        /**
-         * The subscription management methods.
-         */
-        void Attach(IObserver* observer) override;
-        void Detach(IObserver* observer) override;
-        void NotifyAll() override;
-        void Notify(IObserver::EventTypes eventType) override;
-        void Notify(IObserver::EventTypes eventType, void* data) override;
-
-        void CreateMessage(IObserver::EventTypes eventType);
-        void CreateMessage(IObserver::EventTypes eventType, void * data);
-        void CreateMessage(std::string message = "Empty");
-        void HowManyObserver();
-
-        void ClearObservers();
-
-        void SetupDefaultObservers();
-
-private:
-    std::list<IObserver*> m_listObserver;
-    std::string m_message;
-    CoreSession();
-    Observer* m_observerForSavePart; 
-    Observer* m_observerForClosePart;
-    Observer* m_observerForOpenPart;
-
-};
-
+#pragma once
+#include "CoreExports.h"
+#include "ISubject.h"
+#include <list>
+#include <mutex>
+#include <iostream>
+
+class Observer;
+
+class CORE_API CoreSession : ISubject
+{
+	public:
+        static CoreSession& GetInstance();
+
+        CoreSession(CoreSession const&) = delete;
+        void operator=(CoreSession const&) = delete;
+
+
+        ~CoreSession() override;
+
+        /**
+         * The subscription management methods.
+         */
+        void Attach(IObserver* observer) override;
+        void Detach(IObserver* observer) override;
+        void NotifyAll() override;
+        void Notify(IObserver::EventTypes eventType) override;
+        void Notify(IObserver::EventTypes eventType, void* data) override;
+
+        void CreateMessage(IObserver::EventTypes eventType);
+        void CreateMessage(IObserver::EventTypes eventType, void * data);
+        void CreateMessage(std::string message = "Empty");
+        void HowManyObserver();
+
+        void ClearObservers();
+
+        void SetupDefaultObservers();
+
+private:
+    std::list<IObserver*> m_listObserver;
+    std::mutex m_observerMutex; /** The PartSaveQueue notifies from its own thread.  Observers are called on a copy of the list with it unlocked, so an observer may Detach from Update. */
+    std::string m_message;
+    CoreSession();
+    Observer* m_observerForSavePart; 
+    Observer* m_observerForClosePart;
+    Observer* m_observerForOpenPart;
+    Observer* m_observerForReloadPart;
+
+};
+
@@ -0,0 +1,176 @@
+#include "Crc32C.h"
+#include <cstring>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#include <nmmintrin.h>
+#endif
+
+// Castagnoli polynomial, bit reflected
+static const uint32_t Polynomial = 0x82F63B78;
+
+namespace
+{
+	struct Crc32CTables
+	{
+		// slicing by 8, table k advances a byte that sits k bytes ahead of the end
+		uint32_t slices[8][256];
+		// x^(2^k) mod P, for shifting a crc past a run of zero bytes
+		uint32_t powersOfX[32];
+
+		Crc32CTables();
+	};
+
+	uint32_t MultiplyModP(uint32_t a, uint32_t b)
+	{
+		uint32_t mask = 1u << 31;
+		uint32_t product = 0;
+		for (;;)
+		{
+			if (a & mask)
+			{
+				product ^= b;
+				if ((a & (mask - 1)) == 0)
+				{
+					break;
+				}
+			}
+			mask >>= 1;
+			b = (b & 1) ? (b >> 1) ^ Polynomial : b >> 1;
+		}
+		return product;
+	}
+
+	Crc32CTables::Crc32CTables()
+	{
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			uint32_t crc = i;
+			for (int bit = 0; bit < 8; bit++)
+			{
+				crc = (crc & 1) ? (crc >> 1) ^ Polynomial : crc >> 1;
+			}
+			slices[0][i] = crc;
+		}
+		for (uint32_t i = 0; i < 256; i++)
+		{
+			for (int k = 1; k < 8; k++)
+			{
+				slices[k][i] = (slices[k - 1][i] >> 8) ^ slices[0][slices[k - 1][i] & 0xFF];
+			}
+		}
+
+		uint32_t power = 1u << 30; // x^1
+		powersOfX[0] = power;
+		for (int k = 1; k < 32; k++)
+		{
+			power = MultiplyModP(power, power);
+			powersOfX[k] = power;
+		}
+	}
+
+	const Crc32CTables& GetTables()
+	{
+		static const Crc32CTables tables;
+		return tables;
+	}
+
+	inline uint32_t Read32(const unsigned char* bytes)
+	{
+		uint32_t value;
+		memcpy(&value, bytes, sizeof(value));
+		return value;
+	}
+
+	uint32_t TableCrc32C(const unsigned char* bytes, size_t size, uint32_t crc)
+	{
+		const Crc32CTables& tables = GetTables();
+		const uint32_t(&slices)[8][256] = tables.slices;
+
+		while (size >= 8)
+		{
+			uint32_t low = Read32(bytes) ^ crc;
+			uint32_t high = Read32(bytes + 4);
+			crc = slices[7][low & 0xFF] ^ slices[6][(low >> 8) & 0xFF] ^ slices[5][(low >> 16) & 0xFF] ^ slices[4][low >> 24]
+				^ slices[3][high & 0xFF] ^ slices[2][(high >> 8) & 0xFF] ^ slices[1][(high >> 16) & 0xFF] ^ slices[0][high >> 24];
+			bytes += 8;
+			size -= 8;
+		}
+		while (size > 0)
+		{
+			crc = (crc >> 8) ^ slices[0][(crc ^ *bytes) & 0xFF];
+			bytes++;
+			size--;
+		}
+		return crc;
+	}
+
+#if defined(_M_X64)
+	bool ProcessorHasSSE42()
+	{
+		int info[4];
+		__cpuid(info, 1);
+		return (info[2] & (1 << 20)) != 0;
+	}
+
+	uint32_t HardwareCrc32C(const unsigned char* bytes, size_t size, uint32_t crc)
+	{
+		uint64_t crc64 = crc;
+		while (size >= 8)
+		{
+			uint64_t value;
+			memcpy(&value, bytes, sizeof(value));
+			crc64 = _mm_crc32_u64(crc64, value);
+			bytes += 8;
+			size -= 8;
+		}
+		crc = (uint32_t)crc64;
+		while (size > 0)
+		{
+			crc = _mm_crc32_u8(crc, *bytes);
+			bytes++;
+			size--;
+		}
+		return crc;
+	}
+#endif
+}
+
+bool Crc32CIsHardwareAccelerated()
+{
+#if defined(_M_X64)
+	static const bool hasSSE42 = ProcessorHasSSE42();
+	return hasSSE42;
+#else
+	return false;
+#endif
+}
+
+uint32_t Crc32C(const void* data, size_t size, uint32_t crc)
+{
+	const unsigned char* bytes = (const unsigned char*)data;
+	crc = ~crc;
+#if defined(_M_X64)
+	if (Crc32CIsHardwareAccelerated())
+	{
+		return ~HardwareCrc32C(bytes, size, crc);
+	}
+#endif
+	return ~TableCrc32C(bytes, size, crc);
+}
+
+uint32_t Crc32CCombine(uint32_t crcA, uint32_t crcB, size_t lengthB)
+{
+	// crcA times x^(8 * lengthB), one table power per set bit of the bit count
+	const Crc32CTables& tables = GetTables();
+	uint32_t shift = 1u << 31; // x^0
+	unsigned k = 3;
+	for (size_t n = lengthB; n != 0; n >>= 1, k++)
+	{
+		if (n & 1)
+		{
+			shift = MultiplyModP(tables.powersOfX[k & 31], shift);
+		}
+	}
+	return MultiplyModP(shift, crcA) ^ crcB;
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include "CoreExports.h"
+#include <cstdint>
+#include <cstddef>
+
+/// <summary>
+/// CRC32C (Castagnoli) of size bytes at data, carried on from crc so a buffer can be
+/// checked in pieces, Crc32C(b, Crc32C(a)) == Crc32C(a + b).  Uses the SSE4.2 crc32
+/// instruction when the processor has it, a slicing by 8 table otherwise, both give
+/// the same value.
+/// </summary>
+CORE_API uint32_t Crc32C(const void* data, size_t size, uint32_t crc = 0);
+
+/// <summary>
+/// The CRC32C of a followed by b, from the CRC32C of each and the length of b, without
+/// touching the bytes.  Lets pieces of a buffer be checked on different threads.
+/// </summary>
+CORE_API uint32_t Crc32CCombine(uint32_t crcA, uint32_t crcB, size_t lengthB);
+
+/// <summary>
+/// True when Crc32C runs on the SSE4.2 instruction rather than the table.
+/// </summary>
+CORE_API bool Crc32CIsHardwareAccelerated();
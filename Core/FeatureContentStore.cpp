@@ -0,0 +1,114 @@
+#include "FeatureContentStore.h"
+#include "ContentHash.h"
+#include <cstring>
+#include <mutex>
+
+// Payloads are a few dozen bytes, they are packed in to chunks rather than allocated one by one
+static const size_t ChunkWords = 8192;
+
+FeatureContentStore& FeatureContentStore::GetInstance()
+{
+	static FeatureContentStore instance;
+
+	return instance;
+}
+
+FeatureContentStore::FeatureContentStore() : m_chunkUsed(ChunkWords)
+{
+
+}
+
+FeatureContentKind FeatureContentStore::GetKind(std::string_view featureType)
+{
+	std::unique_lock<std::shared_mutex> lock(m_mutex);
+	for (size_t kind = 0; kind < m_kinds.size(); kind++)
+	{
+		if (m_kinds[kind].featureType == featureType)
+		{
+			return (FeatureContentKind)kind;
+		}
+	}
+
+	KindCounters& counters = m_kinds.emplace_back();
+	counters.featureType = featureType;
+	counters.references = 0;
+	counters.payloads = 0;
+	counters.payloadBytes = 0;
+	return (FeatureContentKind)(m_kinds.size() - 1);
+}
+
+const void* FeatureContentStore::Intern(FeatureContentKind kind, const void* payload, size_t size)
+{
+	uint64_t hash = HashContent(payload, size, kind);
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		if (kind >= m_kinds.size())
+		{
+			throw std::exception("Unknown feature content kind");
+		}
+		m_kinds[kind].references.fetch_add(1, std::memory_order_relaxed);
+
+		auto range = m_entries.equal_range(hash);
+		for (auto iterator = range.first; iterator != range.second; ++iterator)
+		{
+			const Entry& entry = iterator->second;
+			if (entry.kind == kind && entry.size == size && memcmp(entry.payload, payload, size) == 0)
+			{
+				return entry.payload;
+			}
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+	// another thread may have added it between the two locks
+	auto range = m_entries.equal_range(hash);
+	for (auto iterator = range.first; iterator != range.second; ++iterator)
+	{
+		const Entry& entry = iterator->second;
+		if (entry.kind == kind && entry.size == size && memcmp(entry.payload, payload, size) == 0)
+		{
+			return entry.payload;
+		}
+	}
+
+	const void* stored = StorePayload(payload, size);
+	m_entries.emplace(hash, Entry{ stored, size, kind });
+	m_kinds[kind].payloads++;
+	m_kinds[kind].payloadBytes += size;
+	return stored;
+}
+
+// Called under the unique lock
+const void* FeatureContentStore::StorePayload(const void* payload, size_t size)
+{
+	size_t words = (size + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+	if (ChunkWords - m_chunkUsed < words)
+	{
+		// a payload too big for a chunk gets one of its own, filled up so the next one starts afresh
+		m_chunks.push_back(std::make_unique<uint64_t[]>(words > ChunkWords ? words : ChunkWords));
+		m_chunkUsed = 0;
+	}
+	if (words > ChunkWords)
+	{
+		memcpy(m_chunks.back().get(), payload, size);
+		m_chunkUsed = ChunkWords;
+		return m_chunks.back().get();
+	}
+	uint64_t* stored = m_chunks.back().get() + m_chunkUsed;
+	m_chunkUsed += words;
+	memcpy(stored, payload, size);
+	return stored;
+}
+
+std::vector<FeatureContentStatistics> FeatureContentStore::GetStatistics() const
+{
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	std::vector<FeatureContentStatistics> statistics;
+	for (const KindCounters& counters : m_kinds)
+	{
+		statistics.push_back({ counters.featureType, counters.references.load(std::memory_order_relaxed),
+			counters.payloads, counters.payloadBytes });
+	}
+	return statistics;
+}
@@ -0,0 +1,91 @@
+#pragma once
+#include "CoreExports.h"
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+typedef uint32_t FeatureContentKind;
+
+struct FeatureContentStatistics
+{
+	std::string featureType;
+	uint64_t references; /** Intern calls, one per feature built since the process started. */
+	uint64_t payloads; /** Distinct payloads kept. */
+	uint64_t payloadBytes; /** What the distinct payloads take up. */
+};
+
+/// <summary>
+/// Content addressed store of feature field values.  A feature hands in its canonical
+/// fields and gets back a pointer to the one immutable copy of them, so the thousands
+/// of identical fasteners in a library share a payload and each keeps only its guid and
+/// that pointer.  Payloads are hashed with HashContent and compared byte for byte, so
+/// they must be plain structs with no padding bytes and NaNs made canonical before
+/// they come in.  Like the StringInterner, payloads are kept for the life of the
+/// process.  Safe to use from several threads.
+/// </summary>
+class CORE_API FeatureContentStore
+{
+public:
+	static FeatureContentStore& GetInstance();
+
+	/// <summary>
+	/// The kind featureType's payloads are interned under, the same kind for the same name.
+	/// Payloads of different kinds are never shared.
+	/// </summary>
+	FeatureContentKind GetKind(std::string_view featureType);
+
+	/// <summary>
+	/// The stored copy of the size bytes at payload, added if this kind has no equal one.
+	/// The copy is 8 byte aligned and never moves.
+	/// </summary>
+	const void* Intern(FeatureContentKind kind, const void* payload, size_t size);
+
+	template <typename Payload>
+	const Payload* Intern(FeatureContentKind kind, const Payload& payload)
+	{
+		static_assert(std::is_trivially_copyable<Payload>::value, "Feature payloads are compared as bytes");
+		static_assert(alignof(Payload) <= sizeof(uint64_t), "Feature payloads are stored 8 byte aligned");
+		return static_cast<const Payload*>(Intern(kind, &payload, sizeof(Payload)));
+	}
+
+	/// <summary>
+	/// One entry per kind, in the order the kinds were first asked for.
+	/// </summary>
+	std::vector<FeatureContentStatistics> GetStatistics() const;
+
+	FeatureContentStore(const FeatureContentStore&) = delete;
+	FeatureContentStore& operator=(const FeatureContentStore&) = delete;
+
+private:
+	FeatureContentStore();
+	const void* StorePayload(const void* payload, size_t size);
+
+	struct Entry
+	{
+		const void* payload;
+		size_t size;
+		FeatureContentKind kind;
+	};
+
+	struct KindCounters
+	{
+		std::string featureType;
+		std::atomic<uint64_t> references;
+		uint64_t payloads; /** Under the unique lock. */
+		uint64_t payloadBytes; /** Under the unique lock. */
+	};
+
+	mutable std::shared_mutex m_mutex;
+	std::unordered_multimap<uint64_t, Entry> m_entries; /** By HashContent of the payload, seeded with its kind. */
+	std::deque<KindCounters> m_kinds; /** Indexed by kind, a deque so the atomics never move. */
+	std::vector<std::unique_ptr<uint64_t[]>> m_chunks;
+	size_t m_chunkUsed; /** Words of the last chunk handed out, a full chunk once it cannot take more. */
+};
@@ -0,0 +1,59 @@
+#include "FeatureSerializer.h"
+#include "GuidObject.h"
+#include "PartFileIntegrity.h"
+#include "PartFileWritable.h"
+#include "ThreadPool.h"
+#include <algorithm>
+
+static void SerializeChunk(const std::vector<GuidObject*>& features, size_t begin, size_t end, size_t bytesPerFeature,
+	bool withChecksums, std::string& chunk)
+{
+	chunk.reserve((end - begin) * bytesPerFeature);
+	for (size_t i = begin; i < end; i++)
+	{
+		IPartFileWritable* writable = dynamic_cast<IPartFileWritable*>(features[i]);
+		if (writable == nullptr)
+		{
+			throw std::exception("Feature has no writer, it cannot be saved");
+		}
+		size_t featureBegin = chunk.size();
+		writable->WriteFeature(chunk);
+		if (withChecksums)
+		{
+			AppendFeatureChecksum(chunk, featureBegin);
+		}
+	}
+}
+
+void SerializeFeaturesInParallel(const std::vector<GuidObject*>& features, size_t bytesPerFeature, std::vector<std::string>& chunks,
+	bool withChecksums)
+{
+	size_t chunkCount = (features.size() + SerializeFeaturesPerChunk - 1) / SerializeFeaturesPerChunk;
+	std::vector<std::string> serialized(chunkCount);
+
+	auto serializeChunks = [&](size_t beginChunk, size_t endChunk)
+	{
+		for (size_t chunkIndex = beginChunk; chunkIndex < endChunk; chunkIndex++)
+		{
+			size_t begin = chunkIndex * SerializeFeaturesPerChunk;
+			size_t end = std::min(begin + SerializeFeaturesPerChunk, features.size());
+			SerializeChunk(features, begin, end, bytesPerFeature, withChecksums, serialized[chunkIndex]);
+		}
+	};
+
+	// one chunk is not worth a trip through the pool
+	if (chunkCount <= 1)
+	{
+		serializeChunks(0, chunkCount);
+	}
+	else
+	{
+		ThreadPool::GetInstance().ParallelFor(chunkCount, serializeChunks);
+	}
+
+	// the chunk index is the merge key, they go out in list order
+	for (std::string& chunk : serialized)
+	{
+		chunks.push_back(std::move(chunk));
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include "CoreExports.h"
+#include <string>
+#include <vector>
+
+class GuidObject;
+
+/// <summary>
+/// Features per chunk for SerializeFeaturesInParallel, small enough to spread a
+/// few thousand features over the workers and big enough to amortize a task.
+/// </summary>
+inline constexpr size_t SerializeFeaturesPerChunk = 1024;
+
+/// <summary>
+/// Writes features with IPartFileWritable::WriteFeature into chunks, each holding
+/// SerializeFeaturesPerChunk features in list order, appended to chunks.  Chunks
+/// are filled concurrently on the shared ThreadPool, one buffer reserved per chunk
+/// from bytesPerFeature.  The chunk boundaries only depend on the feature count so
+/// the chunks, read in order, are byte for byte what one thread writing the list
+/// would produce.  withChecksums gives every feature its FeatureChecksum: line, see
+/// PartFileIntegrity.h.  Throws std::exception for an object that is not IPartFileWritable,
+/// chunks is then left as it was.  Do not call from inside a ThreadPool task.
+/// </summary>
+CORE_API void SerializeFeaturesInParallel(const std::vector<GuidObject*>& features, size_t bytesPerFeature,
+	std::vector<std::string>& chunks, bool withChecksums = false);
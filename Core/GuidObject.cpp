@@ -1,35 +1,63 @@
-#include "GuidObject.h"
-#include <map>
-GuidObject::GuidObject(int guid) : m_guid(guid)
-{
-
-}
-
-
-GuidObject::~GuidObject()
-{
-
-}
-
-int GuidObject::GetGuid()
-{
-	return m_guid;
-}
-
-std::map<int, GuidObject*> m_guidToObjectMap ;
-
-GuidObjectManager& GuidObjectManager::GetGuidObjectManager()
-{
-	static GuidObjectManager instance;
-	return instance;
-}
-
-GuidObject* GuidObjectManager::GetObjectFromGUID(int guid)
-{
-	return m_guidToObjectMap[guid];
-}
-
-void GuidObjectManager::SetObjectFromGUID(int guid, GuidObject* objectToStore)
-{
-	m_guidToObjectMap[guid] = objectToStore;
-}
+#include "GuidObject.h"
+#include <map>
+#include <list>
+GuidObject::GuidObject(int guid) : m_guid(guid)
+{
+
+}
+
+
+GuidObject::~GuidObject()
+{
+
+}
+
+int GuidObject::GetGuid()
+{
+	return m_guid;
+}
+
+std::map<int, GuidObject*> m_guidToObjectMap ;
+std::list<ILazyObjectSource*> m_lazyObjectSources;
+
+GuidObjectManager& GuidObjectManager::GetGuidObjectManager()
+{
+	static GuidObjectManager instance;
+	return instance;
+}
+
+GuidObject* GuidObjectManager::GetObjectFromGUID(int guid)
+{
+	std::map<int, GuidObject*>::iterator found = m_guidToObjectMap.find(guid);
+	if (found != m_guidToObjectMap.end() && found->second != nullptr)
+	{
+		return found->second;
+	}
+
+	for (ILazyObjectSource* source : m_lazyObjectSources)
+	{
+		GuidObject* materialized = source->MaterializeObject(guid);
+		if (materialized != nullptr)
+		{
+			m_guidToObjectMap[guid] = materialized;
+			return materialized;
+		}
+	}
+
+	return m_guidToObjectMap[guid];
+}
+
+void GuidObjectManager::SetObjectFromGUID(int guid, GuidObject* objectToStore)
+{
+	m_guidToObjectMap[guid] = objectToStore;
+}
+
+void GuidObjectManager::AddLazyObjectSource(ILazyObjectSource* source)
+{
+	m_lazyObjectSources.push_front(source);
+}
+
+void GuidObjectManager::RemoveLazyObjectSource(ILazyObjectSource* source)
+{
+	m_lazyObjectSources.remove(source);
+}
@@ -1,37 +1,59 @@
-#pragma once
-#include "CoreExports.h"
-
-class CORE_API GuidObject
-{
-	public :
-		GuidObject(int guid);
-		
-
-		int GetGuid();
-
-
-		virtual ~GuidObject();
-		GuidObject() = delete;
-	protected:
-		
-		int m_guid;
-
-};
-
-class CORE_API GuidObjectManager
-{
-	public:
-		static GuidObjectManager& GetGuidObjectManager();
-
-		GuidObject* GetObjectFromGUID(int guid);
-		void SetObjectFromGUID(int guid, GuidObject* objectToStore);
-		GuidObjectManager(const GuidObjectManager&) = delete;
-		GuidObjectManager& operator=(const GuidObjectManager&) = delete;
-
-	private:
-		GuidObjectManager() = default;
-		~GuidObjectManager() = default;
-
-
-};
-
+#pragma once
+#include "CoreExports.h"
+
+class CORE_API GuidObject
+{
+	public :
+		GuidObject(int guid);
+		
+
+		int GetGuid();
+
+
+		virtual ~GuidObject();
+		GuidObject() = delete;
+	protected:
+		
+		int m_guid;
+
+};
+
+/// <summary>
+/// Builds objects on demand for the GuidObjectManager, see AddLazyObjectSource.
+/// </summary>
+class CORE_API ILazyObjectSource
+{
+	public:
+		virtual ~ILazyObjectSource() {}
+
+		/// <summary>
+		/// Builds the object for guid, nullptr if this source does not hold it.
+		/// Called at most once per guid, the manager keeps what comes back.
+		/// </summary>
+		virtual GuidObject* MaterializeObject(int guid) = 0;
+};
+
+class CORE_API GuidObjectManager
+{
+	public:
+		static GuidObjectManager& GetGuidObjectManager();
+
+		GuidObject* GetObjectFromGUID(int guid);
+		void SetObjectFromGUID(int guid, GuidObject* objectToStore);
+
+		/// <summary>
+		/// GetObjectFromGUID asks the sources, newest first, for guids it has no object for.
+		/// The source must be removed before it is deleted.
+		/// </summary>
+		void AddLazyObjectSource(ILazyObjectSource* source);
+		void RemoveLazyObjectSource(ILazyObjectSource* source);
+		GuidObjectManager(const GuidObjectManager&) = delete;
+		GuidObjectManager& operator=(const GuidObjectManager&) = delete;
+
+	private:
+		GuidObjectManager() = default;
+		~GuidObjectManager() = default;
+
+
+};
+
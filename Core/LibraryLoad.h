@@ -1,7 +1,7 @@
-#pragma once
-#include "CoreExports.h"
-#include <windows.h> 
-
-CORE_API HINSTANCE CoreLoadLibrary(const char* libraryName);
-CORE_API void UnloadLibrary(HINSTANCE handle);
-
+#pragma once
+#include "CoreExports.h"
+#include <windows.h> 
+
+CORE_API HINSTANCE CoreLoadLibrary(const char* libraryName);
+CORE_API void UnloadLibrary(HINSTANCE handle);
+
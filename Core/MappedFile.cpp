@@ -0,0 +1,69 @@
+#include "MappedFile.h"
+#include <windows.h>
+
+
+MappedFile::MappedFile(const std::string& filePath)
+	: m_fileHandle(INVALID_HANDLE_VALUE), m_mappingHandle(nullptr), m_data(nullptr), m_size(0), m_isOpen(false)
+{
+	HANDLE fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		return;
+	}
+	m_fileHandle = fileHandle;
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize))
+	{
+		return;
+	}
+
+	m_size = (size_t)fileSize.QuadPart;
+	if (m_size == 0)
+	{
+		// Windows refuses to map an empty file, an empty view is still a valid file
+		m_isOpen = true;
+		return;
+	}
+
+	m_mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_mappingHandle == nullptr)
+	{
+		return;
+	}
+
+	m_data = (const char*)MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+	m_isOpen = (m_data != nullptr);
+}
+
+MappedFile::~MappedFile()
+{
+	if (m_data != nullptr)
+	{
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle != nullptr)
+	{
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle != INVALID_HANDLE_VALUE)
+	{
+		CloseHandle(m_fileHandle);
+	}
+}
+
+bool MappedFile::IsOpen() const
+{
+	return m_isOpen;
+}
+
+const char* MappedFile::Data() const
+{
+	return m_data;
+}
+
+size_t MappedFile::Size() const
+{
+	return m_size;
+}
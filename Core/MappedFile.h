@@ -0,0 +1,31 @@
+#pragma once
+#include "CoreExports.h"
+#include <string>
+#include <cstddef>
+
+/// <summary>
+/// Read only memory mapping of a whole file.  The view stays valid
+/// for the lifetime of the object, so std::string_view tokens handed
+/// out over Data() must not outlive it.
+/// </summary>
+class CORE_API MappedFile
+{
+public:
+	MappedFile(const std::string& filePath);
+	virtual ~MappedFile();
+
+	MappedFile() = delete;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool IsOpen() const;
+	const char* Data() const;
+	size_t Size() const;
+
+private:
+	void* m_fileHandle;
+	void* m_mappingHandle;
+	const char* m_data;
+	size_t m_size;
+	bool m_isOpen;
+};
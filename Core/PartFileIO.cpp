@@ -0,0 +1,516 @@
+#include "PartFileIO.h"
+#include "ThreadPool.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <windows.h>
+
+// One ReadFile or WriteFile, well inside the DWORD a call takes
+static const size_t ChunkBytes = 16 * 1024 * 1024;
+// Files a completion port batch has open at once, the rest wait for a slot
+static const size_t ReadsInFlight = 64;
+static const ULONG CompletionsPerWait = 64;
+
+static std::atomic<PartFileIO*> selectedBackend(nullptr);
+
+static void FailRead(PartFileRead& read)
+{
+	read.data.reset();
+	read.size = 0;
+	read.error = "Unable to read " + read.filePath;
+}
+
+// Opens read.filePath and sizes read.data to it.  INVALID_HANDLE_VALUE, with read.error set, when it cannot
+static HANDLE OpenForRead(PartFileRead& read, DWORD flags)
+{
+	read.data.reset();
+	read.size = 0;
+	read.error.clear();
+
+	HANDLE file = CreateFileA(read.filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		read.error = "Unable to open " + read.filePath;
+		return INVALID_HANDLE_VALUE;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize))
+	{
+		CloseHandle(file);
+		FailRead(read);
+		return INVALID_HANDLE_VALUE;
+	}
+
+	// not value initialized, every byte is about to be read over
+	read.size = (size_t)fileSize.QuadPart;
+	read.data.reset(new char[std::max<size_t>(read.size, 1)]);
+	return file;
+}
+
+static void SetOffset(OVERLAPPED& overlapped, uint64_t offset)
+{
+	overlapped = {};
+	overlapped.Offset = (DWORD)offset;
+	overlapped.OffsetHigh = (DWORD)(offset >> 32);
+}
+
+// The temp file is flushed and closed, it replaces filePath or goes
+static void ReplaceWithTempFile(const std::string& tempPath, const std::string& filePath, bool ok)
+{
+	if (!ok || !MoveFileExA(tempPath.c_str(), filePath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH))
+	{
+		DeleteFileA(tempPath.c_str());
+		throw std::exception("Unable to replace file with its saved version");
+	}
+}
+
+
+/// <summary>
+/// Reads of a batch go out together through one completion port per batch, so a
+/// batch read on another thread never reaps this one's completions.  A slot is a
+/// file being read, its chunks go out one after the other.
+/// </summary>
+class CompletionPortPartFileIO : public PartFileIO
+{
+public:
+	~CompletionPortPartFileIO()
+	{
+		Shutdown();
+	}
+
+	const char* GetName() const override
+	{
+		return "completion port";
+	}
+
+	void ReadFiles(std::vector<PartFileRead>& reads) override;
+	void WriteFileNow(const std::string& filePath, const std::vector<std::string_view>& segments) override;
+
+private:
+	struct ReadSlot
+	{
+		PartFileRead* read;
+		HANDLE file;
+		size_t offset;
+		OVERLAPPED overlapped;
+	};
+
+	static bool IssueNextChunk(ReadSlot& slot);
+};
+
+// False once the slot's file is read or has failed, its handle is closed then
+bool CompletionPortPartFileIO::IssueNextChunk(ReadSlot& slot)
+{
+	if (slot.offset == slot.read->size)
+	{
+		CloseHandle(slot.file);
+		return false;
+	}
+
+	SetOffset(slot.overlapped, slot.offset);
+	DWORD chunk = (DWORD)std::min(ChunkBytes, slot.read->size - slot.offset);
+	// a read done at once still queues its completion, it is reaped with the others
+	if (ReadFile(slot.file, slot.read->data.get() + slot.offset, chunk, nullptr, &slot.overlapped) || GetLastError() == ERROR_IO_PENDING)
+	{
+		return true;
+	}
+	FailRead(*slot.read);
+	CloseHandle(slot.file);
+	return false;
+}
+
+void CompletionPortPartFileIO::ReadFiles(std::vector<PartFileRead>& reads)
+{
+	HANDLE port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 0);
+	if (port == nullptr)
+	{
+		throw std::exception("Unable to create an I/O completion port");
+	}
+
+	std::vector<ReadSlot> slots(std::min(reads.size(), ReadsInFlight));
+	std::vector<size_t> freeSlots;
+	for (size_t slot = slots.size(); slot-- > 0; )
+	{
+		freeSlots.push_back(slot);
+	}
+
+	size_t nextRead = 0;
+	while (nextRead < reads.size() || freeSlots.size() < slots.size())
+	{
+		while (nextRead < reads.size() && !freeSlots.empty())
+		{
+			PartFileRead& read = reads[nextRead++];
+			HANDLE file = OpenForRead(read, FILE_FLAG_OVERLAPPED | FILE_FLAG_SEQUENTIAL_SCAN);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				continue;
+			}
+
+			// the completion key is the slot, a handle closed and its slot reused keeps the same key
+			size_t slotIndex = freeSlots.back();
+			if (CreateIoCompletionPort(file, port, (ULONG_PTR)slotIndex, 0) == nullptr)
+			{
+				FailRead(read);
+				CloseHandle(file);
+				continue;
+			}
+
+			ReadSlot& slot = slots[slotIndex];
+			slot.read = &read;
+			slot.file = file;
+			slot.offset = 0;
+			if (IssueNextChunk(slot))
+			{
+				freeSlots.pop_back();
+			}
+		}
+		if (freeSlots.size() == slots.size())
+		{
+			continue; // nothing in flight, every file opened was empty or failed
+		}
+
+		OVERLAPPED_ENTRY completions[CompletionsPerWait];
+		ULONG completionCount = 0;
+		if (!GetQueuedCompletionStatusEx(port, completions, CompletionsPerWait, &completionCount, INFINITE, FALSE))
+		{
+			// the reads in flight write into reads' buffers, they must be done with before this returns
+			for (ReadSlot& slot : slots)
+			{
+				if (std::find(freeSlots.begin(), freeSlots.end(), (size_t)(&slot - slots.data())) == freeSlots.end())
+				{
+					DWORD bytesRead = 0;
+					CancelIoEx(slot.file, &slot.overlapped);
+					GetOverlappedResult(slot.file, &slot.overlapped, &bytesRead, TRUE);
+					FailRead(*slot.read);
+					CloseHandle(slot.file);
+				}
+			}
+			CloseHandle(port);
+			throw std::exception("Unable to wait on an I/O completion port");
+		}
+
+		for (ULONG i = 0; i < completionCount; i++)
+		{
+			size_t slotIndex = (size_t)completions[i].lpCompletionKey;
+			ReadSlot& slot = slots[slotIndex];
+
+			// the completion does not say whether the read failed, its overlapped does
+			DWORD bytesRead = 0;
+			if (!GetOverlappedResult(slot.file, &slot.overlapped, &bytesRead, FALSE) || bytesRead == 0)
+			{
+				FailRead(*slot.read); // a file that shrank under the read ends up here too
+				CloseHandle(slot.file);
+				freeSlots.push_back(slotIndex);
+				continue;
+			}
+
+			slot.offset += bytesRead;
+			if (!IssueNextChunk(slot))
+			{
+				freeSlots.push_back(slotIndex);
+			}
+		}
+	}
+
+	CloseHandle(port);
+}
+
+void CompletionPortPartFileIO::WriteFileNow(const std::string& filePath, const std::vector<std::string_view>& segments)
+{
+	std::string tempPath = filePath + ".saving";
+
+	HANDLE fileHandle = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw std::exception("Unable to create temp file to save to");
+	}
+
+	size_t chunkCount = 0;
+	uint64_t fileSize = 0;
+	for (std::string_view segment : segments)
+	{
+		chunkCount += (segment.size() + ChunkBytes - 1) / ChunkBytes;
+		fileSize += segment.size();
+	}
+
+	// NTFS runs a write that extends the file synchronously, so the file is sized first and every write lands inside it
+	HANDLE port = CreateIoCompletionPort(fileHandle, nullptr, 0, 0);
+	LARGE_INTEGER endOfFile;
+	endOfFile.QuadPart = (LONGLONG)fileSize;
+	bool ok = port != nullptr && SetFilePointerEx(fileHandle, endOfFile, nullptr, FILE_BEGIN) && SetEndOfFile(fileHandle);
+
+	// every piece of the file is in flight at once, each write's overlapped stays put until it is reaped
+	std::vector<OVERLAPPED> writes(chunkCount);
+	std::vector<DWORD> lengths(chunkCount);
+	size_t issued = 0;
+	uint64_t offset = 0;
+	for (size_t s = 0; ok && s < segments.size(); s++)
+	{
+		for (size_t begin = 0; ok && begin < segments[s].size(); begin += ChunkBytes)
+		{
+			lengths[issued] = (DWORD)std::min(ChunkBytes, segments[s].size() - begin);
+			SetOffset(writes[issued], offset);
+			ok = WriteFile(fileHandle, segments[s].data() + begin, lengths[issued], nullptr, &writes[issued]) || GetLastError() == ERROR_IO_PENDING;
+			if (ok)
+			{
+				offset += lengths[issued];
+				issued++;
+			}
+		}
+	}
+
+	size_t reaped = 0;
+	while (reaped < issued)
+	{
+		OVERLAPPED_ENTRY completions[CompletionsPerWait];
+		ULONG completionCount = 0;
+		if (!GetQueuedCompletionStatusEx(port, completions, CompletionsPerWait, &completionCount, INFINITE, FALSE))
+		{
+			// a finished write returns at once, the rest are cancelled and waited for
+			CancelIoEx(fileHandle, nullptr);
+			for (size_t w = 0; w < issued; w++)
+			{
+				DWORD written = 0;
+				GetOverlappedResult(fileHandle, &writes[w], &written, TRUE);
+			}
+			ok = false;
+			break;
+		}
+
+		for (ULONG i = 0; i < completionCount; i++)
+		{
+			size_t w = completions[i].lpOverlapped - writes.data();
+			DWORD written = 0;
+			ok = GetOverlappedResult(fileHandle, &writes[w], &written, FALSE) && written == lengths[w] && ok;
+		}
+		reaped += completionCount;
+	}
+
+	ok = ok && FlushFileBuffers(fileHandle);
+	CloseHandle(fileHandle);
+	if (port != nullptr)
+	{
+		CloseHandle(port);
+	}
+	ReplaceWithTempFile(tempPath, filePath, ok);
+}
+
+
+/// <summary>
+/// Plain blocking reads, each file whole on one ThreadPool worker.
+/// </summary>
+class ThreadPoolPartFileIO : public PartFileIO
+{
+public:
+	~ThreadPoolPartFileIO()
+	{
+		Shutdown();
+	}
+
+	const char* GetName() const override
+	{
+		return "thread pool";
+	}
+
+	void ReadFiles(std::vector<PartFileRead>& reads) override;
+	void WriteFileNow(const std::string& filePath, const std::vector<std::string_view>& segments) override;
+};
+
+void ThreadPoolPartFileIO::ReadFiles(std::vector<PartFileRead>& reads)
+{
+	ThreadPool::GetInstance().ParallelFor(reads.size(), [&reads](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			PartFileRead& read = reads[i];
+			HANDLE file = OpenForRead(read, FILE_FLAG_SEQUENTIAL_SCAN);
+			if (file == INVALID_HANDLE_VALUE)
+			{
+				continue;
+			}
+
+			for (size_t offset = 0; offset < read.size; )
+			{
+				DWORD bytesRead = 0;
+				if (!ReadFile(file, read.data.get() + offset, (DWORD)std::min(ChunkBytes, read.size - offset), &bytesRead, nullptr) || bytesRead == 0)
+				{
+					FailRead(read);
+					break;
+				}
+				offset += bytesRead;
+			}
+			CloseHandle(file);
+		}
+	});
+}
+
+void ThreadPoolPartFileIO::WriteFileNow(const std::string& filePath, const std::vector<std::string_view>& segments)
+{
+	std::string tempPath = filePath + ".saving";
+
+	HANDLE fileHandle = CreateFileA(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw std::exception("Unable to create temp file to save to");
+	}
+
+	// a gather write by hand, WriteFileGather wants page aligned unbuffered I/O which part text is not
+	bool ok = true;
+	for (std::string_view segment : segments)
+	{
+		for (size_t begin = 0; ok && begin < segment.size(); begin += ChunkBytes)
+		{
+			DWORD length = (DWORD)std::min(ChunkBytes, segment.size() - begin);
+			DWORD written = 0;
+			ok = WriteFile(fileHandle, segment.data() + begin, length, &written, nullptr) && written == length;
+		}
+	}
+	ok = ok && FlushFileBuffers(fileHandle);
+	CloseHandle(fileHandle);
+
+	ReplaceWithTempFile(tempPath, filePath, ok);
+}
+
+
+static bool CanCreateCompletionPort()
+{
+	HANDLE port = CreateIoCompletionPort(INVALID_HANDLE_VALUE, nullptr, 0, 0);
+	if (port == nullptr)
+	{
+		return false;
+	}
+	CloseHandle(port);
+	return true;
+}
+
+PartFileIO& PartFileIO::GetBackend()
+{
+	PartFileIO* backend = selectedBackend.load();
+	if (backend != nullptr)
+	{
+		return *backend;
+	}
+
+	static const bool hasCompletionPorts = CanCreateCompletionPort();
+	return hasCompletionPorts ? GetCompletionPortBackend() : GetThreadPoolBackend();
+}
+
+void PartFileIO::SetBackend(PartFileIO* backend)
+{
+	selectedBackend = backend;
+}
+
+PartFileIO& PartFileIO::GetCompletionPortBackend()
+{
+	static CompletionPortPartFileIO instance;
+	return instance;
+}
+
+PartFileIO& PartFileIO::GetThreadPoolBackend()
+{
+	static ThreadPoolPartFileIO instance;
+	return instance;
+}
+
+PartFileIO::PartFileIO() : m_writesInFlight(0), m_stopping(false)
+{
+
+}
+
+// Each backend calls Shutdown in its own destructor, the writer thread calls WriteFileNow
+PartFileIO::~PartFileIO()
+{
+
+}
+
+std::future<void> PartFileIO::WriteFileAsync(const std::string& filePath, std::vector<std::string> segments)
+{
+	QueuedWrite write;
+	write.filePath = filePath;
+	write.segments = std::move(segments);
+	std::future<void> result = write.done.get_future();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (!m_writer.joinable())
+		{
+			m_stopping = false;
+			m_writer = std::thread(&PartFileIO::WriterLoop, this);
+		}
+		m_writes.push_back(std::move(write));
+		m_writesInFlight++;
+	}
+	m_writeQueued.notify_one();
+	return result;
+}
+
+void PartFileIO::WriterLoop()
+{
+	for (;;)
+	{
+		QueuedWrite write;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_writeQueued.wait(lock, [this]() { return m_stopping || !m_writes.empty(); });
+			if (m_writes.empty())
+			{
+				return; // stopping, and everything queued has landed
+			}
+			write = std::move(m_writes.front());
+			m_writes.pop_front();
+		}
+
+		std::string failure;
+		try
+		{
+			WriteFileNow(write.filePath, std::vector<std::string_view>(write.segments.begin(), write.segments.end()));
+			write.done.set_value();
+		}
+		catch (std::exception& e)
+		{
+			failure = write.filePath + ", " + e.what();
+			write.done.set_exception(std::current_exception());
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!failure.empty() && m_firstFailure.empty())
+			{
+				m_firstFailure = failure;
+			}
+			m_writesInFlight--;
+		}
+		m_writesDone.notify_all();
+	}
+}
+
+void PartFileIO::WaitForWrites()
+{
+	std::string failure;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_writesDone.wait(lock, [this]() { return m_writesInFlight == 0; });
+		failure.swap(m_firstFailure);
+	}
+
+	if (!failure.empty())
+	{
+		std::string msg = "Queued write of " + failure;
+		throw std::exception(msg.c_str());
+	}
+}
+
+void PartFileIO::Shutdown()
+{
+	std::thread writer;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+		writer = std::move(m_writer);
+	}
+	m_writeQueued.notify_all();
+	if (writer.joinable())
+	{
+		writer.join();
+	}
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include "CoreExports.h"
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// One file for PartFileIO::ReadFiles.  The file is read whole into data, which
+/// PartFileTokenizer then reads in place, the bytes are not copied again.
+/// </summary>
+struct PartFileRead
+{
+	std::string filePath;
+	std::unique_ptr<char[]> data;
+	size_t size = 0;
+	std::string error; /** Why the file could not be read, empty when it was. */
+};
+
+/// <summary>
+/// Where part and journal file I/O goes.  GetBackend is the completion port
+/// backend, or the thread pool backend when no completion port can be made.
+///   Completion port: the reads of a batch are all in flight at once, driven
+///     from the calling thread through one I/O completion port and reaped many
+///     completions to a call.  Saves issue every piece of the file at once.
+///   Thread pool: each file is read with plain blocking calls on the ThreadPool.
+/// Both replace files as WriteFileAtomically always has, a temp file flushed and
+/// renamed over the old one.  WriteFileAsync hands a write to the backend's
+/// writer thread and returns at once, writes land in the order they were queued,
+/// so two saves of one file never race.  shutdownProduct waits for them.
+/// </summary>
+class CORE_API PartFileIO
+{
+public:
+	static PartFileIO& GetBackend();
+
+	/// <summary>
+	/// Sends part I/O to backend, nullptr goes back to the default.  backend must
+	/// outlive its use, set it before parts are opened.
+	/// </summary>
+	static void SetBackend(PartFileIO* backend);
+
+	static PartFileIO& GetCompletionPortBackend();
+	static PartFileIO& GetThreadPoolBackend();
+
+	virtual ~PartFileIO();
+
+	PartFileIO(const PartFileIO&) = delete;
+	PartFileIO& operator=(const PartFileIO&) = delete;
+
+	virtual const char* GetName() const = 0;
+
+	/// <summary>
+	/// Reads every file whole and returns once they all are.  A file that cannot be
+	/// read gets its error set and no data, the rest are read regardless.  Do not call
+	/// from inside a ThreadPool task, the thread pool backend uses ParallelFor.
+	/// </summary>
+	virtual void ReadFiles(std::vector<PartFileRead>& reads) = 0;
+
+	/// <summary>
+	/// Replaces filePath with the segments, one after the other, atomically.  Returns
+	/// once the new file is flushed to disk, throws std::exception if it was not.
+	/// </summary>
+	virtual void WriteFileNow(const std::string& filePath, const std::vector<std::string_view>& segments) = 0;
+
+	/// <summary>
+	/// Queues WriteFileNow and returns at once, the segments are the backend's until
+	/// it is done.  The future rethrows the write's failure.
+	/// </summary>
+	std::future<void> WriteFileAsync(const std::string& filePath, std::vector<std::string> segments);
+
+	/// <summary>
+	/// Blocks until every write queued so far has landed.  Throws std::exception for
+	/// the first that failed since the last call, the futures of the others are not needed.
+	/// </summary>
+	void WaitForWrites();
+
+	/// <summary>
+	/// WaitForWrites, less the throwing, and joins the writer thread.  A later
+	/// WriteFileAsync starts it again.
+	/// </summary>
+	void Shutdown();
+
+protected:
+	PartFileIO();
+
+private:
+	struct QueuedWrite
+	{
+		std::string filePath;
+		std::vector<std::string> segments;
+		std::promise<void> done;
+	};
+
+	void WriterLoop();
+
+	std::mutex m_mutex;
+	std::condition_variable m_writeQueued;
+	std::condition_variable m_writesDone;
+	std::deque<QueuedWrite> m_writes;
+	size_t m_writesInFlight; /** Queued plus the one being written. */
+	std::thread m_writer;
+	bool m_stopping;
+	std::string m_firstFailure;
+};
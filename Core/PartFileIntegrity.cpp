@@ -0,0 +1,243 @@
+#include "PartFileIntegrity.h"
+#include "Crc32C.h"
+#include "PartFileKeys.h"
+#include "PartFileTokenizer.h"
+#include "PartFileTokens.h"
+#include "StringUtils.h"
+#include <cstring>
+
+static const char* const TruncatedMessage =
+	"Part file declares Integrity:CRC32C but does not end with its PartFileChecksum: line, it was cut short or added to";
+
+// The Integrity: value from the header lines, empty when there is none
+static std::string_view FindIntegrity(const char* data, size_t size)
+{
+	PartFileTokenizer tokenizer(data, size);
+	std::string_view line;
+	std::string_view value;
+	while (tokenizer.NextLine(line))
+	{
+		switch (LookupPartFileKey(line, value))
+		{
+		case PartFileKey::Integrity:
+			return value;
+		case PartFileKey::Feature:
+		case PartFileKey::RoutingFeature:
+			return std::string_view();
+		default:
+			break;
+		}
+	}
+	return std::string_view();
+}
+
+// The footer is the last line, a file that ends anywhere else has none
+static bool FindFooter(const char* data, size_t size, size_t& footerBegin, uint32_t& checksum)
+{
+	size_t lineEnd = size;
+	if (lineEnd > 0 && data[lineEnd - 1] == '\n')
+	{
+		lineEnd--;
+	}
+	if (lineEnd > 0 && data[lineEnd - 1] == '\r')
+	{
+		lineEnd--;
+	}
+
+	size_t lineBegin = lineEnd;
+	while (lineBegin > 0 && data[lineBegin - 1] != '\n')
+	{
+		lineBegin--;
+	}
+
+	std::string_view line(data + lineBegin, lineEnd - lineBegin);
+	if (!startsWith(line, PartFileChecksumToken))
+	{
+		return false;
+	}
+	footerBegin = lineBegin;
+	return parseHex32(PartFileTokenizer::TokenValue(line, PartFileChecksumToken), checksum);
+}
+
+static void CheckIntegrityScheme(std::string_view integrity)
+{
+	if (!integrity.empty() && integrity != IntegrityCrc32CValue)
+	{
+		std::string msg = "Part file integrity scheme " + std::string(integrity) + " is not known";
+		throw std::exception(msg.c_str());
+	}
+}
+
+static bool FeatureChecksumMatches(const char* data, const FeatureSpan& span)
+{
+	return !span.hasChecksum || Crc32C(data + span.begin, span.checksumBegin - span.begin) == span.checksum;
+}
+
+[[noreturn]] static void ThrowFeatureMismatch(const FeatureSpan& span)
+{
+	std::string msg = "Part file is damaged, the checksum of " + std::string(span.featureType) + " feature "
+		+ std::to_string(span.guid) + " at byte " + std::to_string(span.begin) + " does not match";
+	throw std::exception(msg.c_str());
+}
+
+// The whole part checksum is wrong, name the first feature whose own checksum is wrong too
+[[noreturn]] static void ThrowPartFileMismatch(const char* data, const PartFileLayout& layout)
+{
+	for (const FeatureSpan& span : layout.features)
+	{
+		if (!FeatureChecksumMatches(data, span))
+		{
+			ThrowFeatureMismatch(span);
+		}
+	}
+	throw std::exception("Part file is damaged, its checksum does not match");
+}
+
+void AppendFeatureChecksum(std::string& out, size_t featureBegin)
+{
+	// the End line is the last line written, set it aside while the checksum line goes in
+	size_t endLineBegin = (out.size() < 2) ? std::string::npos : out.rfind('\n', out.size() - 2);
+	endLineBegin = (endLineBegin == std::string::npos) ? featureBegin : endLineBegin + 1;
+	std::string_view endLine = std::string_view(out).substr(endLineBegin);
+	char endLineCopy[EndRoutingFeatureToken.size() + 2];
+	if (endLineBegin <= featureBegin || endLine.size() > sizeof(endLineCopy)
+		|| (!startsWith(endLine, EndFeatureToken) && !startsWith(endLine, EndRoutingFeatureToken)))
+	{
+		throw std::exception("Feature writer did not finish with an End line, it cannot be checksummed");
+	}
+	size_t endLineSize = endLine.size();
+	memcpy(endLineCopy, endLine.data(), endLineSize);
+
+	uint32_t checksum = Crc32C(out.data() + featureBegin, endLineBegin - featureBegin);
+	out.resize(endLineBegin);
+	out.append(FeatureChecksumToken);
+	appendHex32(out, checksum);
+	out.append("\n");
+	out.append(endLineCopy, endLineSize);
+}
+
+void AppendPartFileChecksum(std::string& out, uint32_t checksum)
+{
+	out.append(PartFileChecksumToken);
+	appendHex32(out, checksum);
+	out.append("\n");
+}
+
+void VerifyPartFileIntegrity(const char* data, size_t size)
+{
+	std::string_view integrity = FindIntegrity(data, size);
+	CheckIntegrityScheme(integrity);
+
+	size_t footerBegin = 0;
+	uint32_t checksum = 0;
+	if (!FindFooter(data, size, footerBegin, checksum))
+	{
+		if (!integrity.empty())
+		{
+			throw std::exception(TruncatedMessage);
+		}
+		return;
+	}
+
+	if (Crc32C(data, footerBegin) != checksum)
+	{
+		ThrowPartFileMismatch(data, ScanPartFileLayout(data, size));
+	}
+}
+
+void VerifyPartFileComplete(const PartFileLayout& layout, size_t size)
+{
+	CheckIntegrityScheme(layout.integrity);
+	if (layout.hasFooter ? layout.footerEnd != size : !layout.integrity.empty())
+	{
+		throw std::exception(TruncatedMessage);
+	}
+}
+
+void VerifyFeatureChecksum(const char* data, const FeatureSpan& span)
+{
+	if (!FeatureChecksumMatches(data, span))
+	{
+		ThrowFeatureMismatch(span);
+	}
+}
+
+
+PartFileChecksumCheck::PartFileChecksumCheck(const char* data, size_t size, const PartFileLayout& layout)
+	: m_data(data), m_layout(layout)
+{
+	VerifyPartFileComplete(layout, size);
+	if (layout.hasFooter)
+	{
+		m_rangeChecksums.resize(layout.features.size());
+		m_rangeEnds.resize(layout.features.size(), 0);
+	}
+	else
+	{
+		m_featureMismatch.resize(layout.features.size(), 0);
+	}
+}
+
+void PartFileChecksumCheck::CheckFeatures(size_t begin, size_t end)
+{
+	const std::vector<FeatureSpan>& features = m_layout.features;
+	if (begin >= end)
+	{
+		return;
+	}
+
+	if (m_layout.hasFooter)
+	{
+		// the first range takes the header, the last runs up to the footer, together they cover the part
+		size_t rangeBegin = (begin == 0) ? 0 : features[begin].begin;
+		size_t rangeEnd = (end == features.size()) ? m_layout.footerBegin : features[end].begin;
+		m_rangeChecksums[begin] = Crc32C(m_data + rangeBegin, rangeEnd - rangeBegin);
+		m_rangeEnds[begin] = end;
+		return;
+	}
+
+	for (size_t i = begin; i < end; i++)
+	{
+		m_featureMismatch[i] = !FeatureChecksumMatches(m_data, features[i]);
+	}
+}
+
+void PartFileChecksumCheck::Verify() const
+{
+	const std::vector<FeatureSpan>& features = m_layout.features;
+
+	if (!m_layout.hasFooter)
+	{
+		for (size_t i = 0; i < features.size(); i++)
+		{
+			if (m_featureMismatch[i])
+			{
+				ThrowFeatureMismatch(features[i]);
+			}
+		}
+		return;
+	}
+
+	uint32_t checksum = 0;
+	if (features.empty())
+	{
+		checksum = Crc32C(m_data, m_layout.footerBegin);
+	}
+	for (size_t i = 0; i < features.size(); )
+	{
+		size_t end = m_rangeEnds[i];
+		if (end == 0)
+		{
+			return;
+		}
+		size_t rangeBegin = (i == 0) ? 0 : features[i].begin;
+		size_t rangeEnd = (end == features.size()) ? m_layout.footerBegin : features[end].begin;
+		checksum = Crc32CCombine(checksum, m_rangeChecksums[i], rangeEnd - rangeBegin);
+		i = end;
+	}
+
+	if (checksum != m_layout.fileChecksum)
+	{
+		ThrowPartFileMismatch(m_data, m_layout);
+	}
+}
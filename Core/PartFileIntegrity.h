@@ -0,0 +1,87 @@
+#pragma once
+#include "CoreExports.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "PartFileLayout.h"
+
+// Optional CRC32C checksums of a text part file.  A part written with them says so in its header,
+//
+//   PartFileName:Widget
+//   SchemaVersion:3
+//   Integrity:CRC32C
+//   Feature:Extrude
+//   ...
+//   FeatureChecksum:1a2b3c4d      the Feature: line up to here
+//   EndFeature
+//   PartFileChecksum:5e6f7a8b     everything before this line
+//
+// Readers skip both checksum lines as unknown keys, a part without them opens unchecked.
+
+/// <summary>
+/// out ends with a feature written from featureBegin through its EndFeature or
+/// EndRoutingFeature line, puts the FeatureChecksum: line in before that End line.
+/// </summary>
+CORE_API void AppendFeatureChecksum(std::string& out, size_t featureBegin);
+
+/// <summary>
+/// Appends the PartFileChecksum: line, checksum being the Crc32C of everything before it.
+/// </summary>
+CORE_API void AppendPartFileChecksum(std::string& out, uint32_t checksum);
+
+/// <summary>
+/// Checks a whole part in memory against its checksums on the calling thread.  Only
+/// looks at the header and the last line unless the checksum is wrong.  Throws
+/// std::exception if the part declares Integrity: but lost its footer (a half written
+/// file), or if a checksum does not match, naming the damaged feature when it can.
+/// </summary>
+CORE_API void VerifyPartFileIntegrity(const char* data, size_t size);
+
+/// <summary>
+/// The checks that need no checksumming, a declared footer is there and nothing follows it.
+/// For readers that check features one at a time as they read them.
+/// </summary>
+CORE_API void VerifyPartFileComplete(const PartFileLayout& layout, size_t size);
+
+/// <summary>
+/// Throws std::exception if span has a FeatureChecksum: line that does not match its bytes.
+/// </summary>
+CORE_API void VerifyFeatureChecksum(const char* data, const FeatureSpan& span);
+
+/// <summary>
+/// Checks a part in pieces alongside a reader that splits its features across threads.
+/// CheckFeatures(begin, end) checksums the bytes of those features and whatever sits
+/// between them, so the ranges of a ParallelFor over layout.features cover the whole
+/// part.  Verify combines the pieces with Crc32CCombine, in feature order, against the
+/// footer.  A part without a footer has each feature checked against its own checksum.
+/// </summary>
+class CORE_API PartFileChecksumCheck
+{
+public:
+	/// <summary>
+	/// Throws as VerifyPartFileComplete does.
+	/// </summary>
+	PartFileChecksumCheck(const char* data, size_t size, const PartFileLayout& layout);
+
+	PartFileChecksumCheck(const PartFileChecksumCheck&) = delete;
+	PartFileChecksumCheck& operator=(const PartFileChecksumCheck&) = delete;
+
+	/// <summary>
+	/// Safe to call from several threads at once for ranges that do not overlap.
+	/// </summary>
+	void CheckFeatures(size_t begin, size_t end);
+
+	/// <summary>
+	/// Throws std::exception when a checksum did not match.  Does nothing while a range
+	/// is left unchecked, so after a reader failed it can still say whether the bytes were damaged.
+	/// </summary>
+	void Verify() const;
+
+private:
+	const char* m_data;
+	const PartFileLayout& m_layout;
+	std::vector<uint32_t> m_rangeChecksums; /** At the first feature of each range. */
+	std::vector<size_t> m_rangeEnds; /** At the first feature of each range, 0 until it is checked. */
+	std::vector<char> m_featureMismatch;
+};
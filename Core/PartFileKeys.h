@@ -0,0 +1,116 @@
+#pragma once
+#include <cstdint>
+#include <string_view>
+#include "PartFileTokens.h"
+#include "PerfectHash.h"
+
+/// <summary>
+/// Every key of the text part file format, see PartFileTokens.h for the spelling.
+/// </summary>
+enum class PartFileKey : uint8_t
+{
+	Unknown,
+
+	PartFileName,
+	SchemaVersion,
+	Integrity,
+
+	Feature,
+	EndFeature,
+	RoutingFeature,
+	EndRoutingFeature,
+	FeatureChecksum,
+	PartFileChecksum,
+
+	Extrude_Version,
+	Extrude_Distance,
+	Extrude_TargetFace,
+	Extrude_Vector,
+	Extrude_Boolean,
+	Extrude_IsAddition,
+	Extrude_IsSubtraction,
+	Extrude_Guid,
+
+	Block_Version,
+	Block_Origin,
+	Block_Length,
+	Block_Width,
+	Block_Height,
+	Block_Guid,
+
+	Wire_Version,
+	Wire_Distance,
+
+	DeltaSave,
+	EndDeltaSave,
+	Tombstone,
+};
+
+inline constexpr PerfectHashEntry<PartFileKey> PartFileKeyEntries[] =
+{
+	{ PartFileNameToken, PartFileKey::PartFileName },
+	{ SchemaVersionToken, PartFileKey::SchemaVersion },
+	{ IntegrityToken, PartFileKey::Integrity },
+
+	{ FeatureToken, PartFileKey::Feature },
+	{ EndFeatureToken, PartFileKey::EndFeature },
+	{ RoutingFeatureToken, PartFileKey::RoutingFeature },
+	{ EndRoutingFeatureToken, PartFileKey::EndRoutingFeature },
+	{ FeatureChecksumToken, PartFileKey::FeatureChecksum },
+	{ PartFileChecksumToken, PartFileKey::PartFileChecksum },
+
+	{ Extrude_VersionToken, PartFileKey::Extrude_Version },
+	{ Extrude_DistanceToken, PartFileKey::Extrude_Distance },
+	{ Extrude_TargetFaceToken, PartFileKey::Extrude_TargetFace },
+	{ Extrude_VectorToken, PartFileKey::Extrude_Vector },
+	{ Extrude_BooleanToken, PartFileKey::Extrude_Boolean },
+	{ Extrude_IsAdditionToken, PartFileKey::Extrude_IsAddition },
+	{ Extrude_IsSubtractionToken, PartFileKey::Extrude_IsSubtraction },
+	{ Extrude_GuidToken, PartFileKey::Extrude_Guid },
+
+	{ Block_VersionToken, PartFileKey::Block_Version },
+	{ Block_OriginToken, PartFileKey::Block_Origin },
+	{ Block_LengthToken, PartFileKey::Block_Length },
+	{ Block_WidthToken, PartFileKey::Block_Width },
+	{ Block_HeightToken, PartFileKey::Block_Height },
+	{ Block_GuidToken, PartFileKey::Block_Guid },
+
+	{ Wire_VersionToken, PartFileKey::Wire_Version },
+	{ Wire_DistanceToken, PartFileKey::Wire_Distance },
+
+	{ DeltaSaveToken, PartFileKey::DeltaSave },
+	{ EndDeltaSaveToken, PartFileKey::EndDeltaSave },
+	{ TombstoneToken, PartFileKey::Tombstone },
+};
+
+inline constexpr auto PartFileKeyMap = MakePerfectHashMap(PartFileKeyEntries);
+static_assert(PartFileKeyMap.IsPerfect(), "no perfect hash seed for the part file keys");
+
+/// <summary>
+/// As LookupPartFileKey below, for a line whose key length is already known, keyLength
+/// up to and including the ':' or 0 for a line without one (PartFileLine::keyLength).
+/// </summary>
+inline PartFileKey LookupPartFileKey(std::string_view line, size_t keyLength, std::string_view& value)
+{
+	std::string_view key = (keyLength == 0) ? line : line.substr(0, keyLength);
+
+	const PartFileKey* partFileKey = PartFileKeyMap.Find(key);
+	if (partFileKey == nullptr)
+	{
+		value = std::string_view();
+		return PartFileKey::Unknown;
+	}
+	value = line.substr(key.size());
+	return *partFileKey;
+}
+
+/// <summary>
+/// Splits line in to its key, up to and including the first ':' or the whole line for the
+/// End markers, and what follows it.  Returns which key it is with a single table probe,
+/// PartFileKey::Unknown (value left empty) for anything that is not a part file key.
+/// </summary>
+inline PartFileKey LookupPartFileKey(std::string_view line, std::string_view& value)
+{
+	size_t colon = line.find(':');
+	return LookupPartFileKey(line, (colon == std::string_view::npos) ? 0 : colon + 1, value);
+}
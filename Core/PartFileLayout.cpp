@@ -0,0 +1,122 @@
+#include "PartFileLayout.h"
+#include "PartFileKeys.h"
+#include "PartFileLineScanner.h"
+#include "PartFileTokenizer.h"
+#include "PartFileTokens.h"
+#include "StringUtils.h"
+
+PartFileLayout ScanPartFileLayout(const char* data, size_t size)
+{
+	PartFileLayout layout;
+	PartFileLineScanner scanner(data, size);
+	PartFileLine scannedLine;
+
+	while (scanner.Next(scannedLine))
+	{
+		std::string_view line = scanner.GetLine(scannedLine);
+
+		FeatureSpan span;
+		span.begin = scannedLine.begin;
+
+		std::string_view value;
+		PartFileKey key = LookupPartFileKey(line, scannedLine.keyLength, value);
+		if (key == PartFileKey::Feature || key == PartFileKey::RoutingFeature)
+		{
+			span.featureType = value;
+			span.isRoutingFeature = (key == PartFileKey::RoutingFeature);
+		}
+		else
+		{
+			if (key == PartFileKey::PartFileName)
+			{
+				layout.partFileName = value;
+			}
+			else if (key == PartFileKey::SchemaVersion)
+			{
+				layout.schemaVersion = value;
+			}
+			else if (key == PartFileKey::Integrity)
+			{
+				layout.integrity = value;
+			}
+			else if (key == PartFileKey::PartFileChecksum)
+			{
+				layout.hasFooter = parseHex32(value, layout.fileChecksum);
+				layout.footerBegin = scannedLine.begin;
+				layout.footerEnd = scanner.Offset();
+			}
+			continue;
+		}
+
+		span.bodyBegin = scanner.Offset();
+		span.version = -1;
+		span.guid = -1;
+		span.hasChecksum = false;
+		span.checksumBegin = 0;
+		span.checksum = 0;
+		std::string_view endToken = span.isRoutingFeature ? EndRoutingFeatureToken : EndFeatureToken;
+		while (scanner.Next(scannedLine))
+		{
+			line = scanner.GetLine(scannedLine);
+			if (startsWith(line, endToken))
+			{
+				break;
+			}
+			if (startsWith(line, FeatureChecksumToken))
+			{
+				span.hasChecksum = parseHex32(PartFileTokenizer::TokenValue(line, FeatureChecksumToken), span.checksum);
+				span.checksumBegin = scannedLine.begin;
+				continue;
+			}
+
+			// every feature keys its version and guid as <Type>_Version: and <Type>_Guid:
+			if (startsWith(line, span.featureType))
+			{
+				std::string_view featureKey = line.substr(span.featureType.size());
+				if (startsWith(featureKey, FeatureVersionSuffix))
+				{
+					parseInt(PartFileTokenizer::TokenValue(featureKey, FeatureVersionSuffix), span.version);
+				}
+				else if (startsWith(featureKey, FeatureGuidSuffix))
+				{
+					parseInt(PartFileTokenizer::TokenValue(featureKey, FeatureGuidSuffix), span.guid);
+				}
+			}
+		}
+		span.end = scanner.Offset();
+		layout.features.push_back(span);
+	}
+
+	if (!layout.hasFooter)
+	{
+		layout.footerBegin = size;
+		layout.footerEnd = size;
+	}
+	return layout;
+}
+
+bool SkipFeatureBody(PartFileLineScanner& scanner, std::string_view featureType, bool isRoutingFeature, int& version,
+	size_t completeEnd)
+{
+	version = -1;
+	std::string_view endToken = isRoutingFeature ? EndRoutingFeatureToken : EndFeatureToken;
+	PartFileLine scannedLine;
+	while (scanner.Next(scannedLine))
+	{
+		if (scanner.Offset() > completeEnd)
+		{
+			return false;
+		}
+
+		std::string_view line = scanner.GetLine(scannedLine);
+		if (startsWith(line, endToken))
+		{
+			return true;
+		}
+		if (version < 0 && startsWith(line, featureType) && startsWith(line.substr(featureType.size()), FeatureVersionSuffix))
+		{
+			parseInt(line.substr(featureType.size() + FeatureVersionSuffix.size()), version);
+		}
+	}
+	return false;
+}
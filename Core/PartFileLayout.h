@@ -0,0 +1,55 @@
+#pragma once
+#include "CoreExports.h"
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+class PartFileLineScanner;
+
+/// <summary>
+/// Where one Feature: or RoutingFeature: block sits in a part file buffer.
+/// </summary>
+struct FeatureSpan
+{
+	std::string_view featureType; /** Points into the scanned buffer. */
+	bool isRoutingFeature;
+	size_t begin; /** Offset of the Feature: line. */
+	size_t bodyBegin; /** Offset of the line after the Feature: line. */
+	size_t end; /** Offset just past the EndFeature line, or the buffer size if it is missing. */
+	int version; /** From the <Type>_Version: line, -1 if there is none. */
+	int guid; /** From the <Type>_Guid: line, -1 if there is none. */
+	bool hasChecksum; /** The feature has a FeatureChecksum: line. */
+	size_t checksumBegin; /** Offset of the FeatureChecksum: line, the checksum covers begin up to here. */
+	uint32_t checksum;
+};
+
+/// <summary>
+/// The part file header values and every feature span in file order.
+/// </summary>
+struct PartFileLayout
+{
+	std::string_view partFileName;
+	std::string_view schemaVersion;
+	std::string_view integrity; /** Empty when the header has no Integrity: line. */
+	std::vector<FeatureSpan> features;
+	bool hasFooter = false; /** There is a PartFileChecksum: line, it covers the buffer up to footerBegin. */
+	size_t footerBegin = 0; /** The buffer size when there is no footer. */
+	size_t footerEnd = 0; /** Offset just past the footer line, anything from here on is not covered. */
+	uint32_t fileChecksum = 0;
+};
+
+/// <summary>
+/// Boundary scan of a text part file held in memory.  Only looks for the
+/// framing lines and each feature's version and guid, the other values are
+/// left for a reader that gets the span on its own PartFileTokenizer.
+/// </summary>
+CORE_API PartFileLayout ScanPartFileLayout(const char* data, size_t size);
+
+/// <summary>
+/// Steps scanner over a feature body, from the line after its Feature: or RoutingFeature:
+/// line through its End line, and picks up its <Type>_Version: value on the way, -1 if
+/// there is none.  Nothing else in the block is looked at.  Lines past completeEnd have
+/// only partly arrived and end the scan.  Returns false when there was no End line.
+/// </summary>
+CORE_API bool SkipFeatureBody(PartFileLineScanner& scanner, std::string_view featureType, bool isRoutingFeature, int& version,
+	size_t completeEnd = SIZE_MAX);
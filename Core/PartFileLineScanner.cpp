@@ -0,0 +1,250 @@
+#include "PartFileLineScanner.h"
+#include <cstring>
+#include <exception>
+#include <string>
+
+#if defined(_M_X64)
+#include <intrin.h>
+#include <immintrin.h>
+#define PARTFILESCANNER_X64 1
+#endif
+
+typedef size_t (*ScanKernel)(const char* data, size_t size, PartFileScanState& state, PartFileLine* lines, size_t maxLines);
+
+static inline void EmitLine(const char* data, PartFileScanState& state, size_t lineEnd, PartFileLine* lines, size_t& count)
+{
+	size_t length = lineEnd - state.lineBegin;
+
+	// part files are written on Windows, drop the \r of \r\n
+	if (length > 0 && data[lineEnd - 1] == '\r')
+	{
+		length--;
+	}
+	lines[count++] = { state.lineBegin, (uint32_t)length, state.keyLength };
+	state.lineBegin = lineEnd + 1;
+	state.keyLength = 0;
+}
+
+// memchr for the line end, then for a ':' inside the line if it has no key yet
+static size_t ScanScalar(const char* data, size_t size, PartFileScanState& state, PartFileLine* lines, size_t maxLines)
+{
+	size_t count = 0;
+	while (count < maxLines && state.offset < size)
+	{
+		const char* newline = (const char*)memchr(data + state.offset, '\n', size - state.offset);
+		size_t lineEnd = (newline != nullptr) ? (size_t)(newline - data) : size;
+
+		if (state.keyLength == 0)
+		{
+			const char* colon = (const char*)memchr(data + state.offset, ':', lineEnd - state.offset);
+			if (colon != nullptr)
+			{
+				state.keyLength = (uint32_t)(colon - data - state.lineBegin + 1);
+			}
+		}
+
+		if (newline == nullptr)
+		{
+			// the last line has no \n, Refill hands it out once the kernel is done
+			state.offset = size;
+			break;
+		}
+		EmitLine(data, state, lineEnd, lines, count);
+		state.offset = lineEnd + 1;
+	}
+	return count;
+}
+
+#if defined(PARTFILESCANNER_X64)
+
+// Walks the \n and ':' bits of one block in byte order
+static inline void ScanBlockMasks(const char* data, PartFileScanState& state, uint32_t newlineMask, uint32_t colonMask,
+	PartFileLine* lines, size_t& count)
+{
+	uint32_t mask = newlineMask | colonMask;
+	while (mask != 0)
+	{
+		unsigned long bit = 0;
+		_BitScanForward(&bit, mask);
+		size_t position = state.offset + bit;
+
+		if (newlineMask & (1u << bit))
+		{
+			EmitLine(data, state, position, lines, count);
+		}
+		else if (state.keyLength == 0)
+		{
+			state.keyLength = (uint32_t)(position - state.lineBegin + 1);
+		}
+		mask &= mask - 1;
+	}
+}
+
+static size_t ScanSSE2(const char* data, size_t size, PartFileScanState& state, PartFileLine* lines, size_t maxLines)
+{
+	const size_t BlockBytes = 16;
+	const __m128i newlines = _mm_set1_epi8('\n');
+	const __m128i colons = _mm_set1_epi8(':');
+
+	size_t count = 0;
+	while (state.offset + BlockBytes <= size)
+	{
+		// a block can end at most BlockBytes lines
+		if (count + BlockBytes > maxLines)
+		{
+			return count;
+		}
+
+		__m128i block = _mm_loadu_si128((const __m128i*)(data + state.offset));
+		uint32_t newlineMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, newlines));
+		uint32_t colonMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, colons));
+		if ((newlineMask | colonMask) != 0)
+		{
+			ScanBlockMasks(data, state, newlineMask, colonMask, lines, count);
+		}
+		state.offset += BlockBytes;
+	}
+
+	return count + ScanScalar(data, size, state, lines + count, maxLines - count);
+}
+
+static size_t ScanAVX2(const char* data, size_t size, PartFileScanState& state, PartFileLine* lines, size_t maxLines)
+{
+	const size_t BlockBytes = 32;
+	const __m256i newlines = _mm256_set1_epi8('\n');
+	const __m256i colons = _mm256_set1_epi8(':');
+
+	size_t count = 0;
+	while (state.offset + BlockBytes <= size)
+	{
+		if (count + BlockBytes > maxLines)
+		{
+			_mm256_zeroupper();
+			return count;
+		}
+
+		__m256i block = _mm256_loadu_si256((const __m256i*)(data + state.offset));
+		uint32_t newlineMask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, newlines));
+		uint32_t colonMask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, colons));
+		if ((newlineMask | colonMask) != 0)
+		{
+			ScanBlockMasks(data, state, newlineMask, colonMask, lines, count);
+		}
+		state.offset += BlockBytes;
+	}
+	_mm256_zeroupper();
+
+	return count + ScanScalar(data, size, state, lines + count, maxLines - count);
+}
+
+static bool ProcessorHasAVX2()
+{
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+	{
+		return false;
+	}
+
+	// AVX needs the OS to save the ymm registers as well as the processor to have it
+	__cpuid(info, 1);
+	bool osSavesState = (info[2] & (1 << 27)) != 0;
+	bool hasAVX = (info[2] & (1 << 28)) != 0;
+	if (!osSavesState || !hasAVX || (_xgetbv(0) & 6) != 6)
+	{
+		return false;
+	}
+
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+}
+
+#endif
+
+static ScanKernel GetKernel(PartFileScannerKind kind)
+{
+	switch (kind)
+	{
+#if defined(PARTFILESCANNER_X64)
+	case PartFileScannerKind::SSE2:
+		return ScanSSE2;
+	case PartFileScannerKind::AVX2:
+		return ScanAVX2;
+#endif
+	default:
+		return ScanScalar;
+	}
+}
+
+
+PartFileLineScanner::PartFileLineScanner(const char* data, size_t size)
+	: PartFileLineScanner(data, size, GetBestKind())
+{
+
+}
+
+PartFileLineScanner::PartFileLineScanner(const char* data, size_t size, PartFileScannerKind kind)
+	: m_data(data), m_size(size), m_kind(kind), m_state{ 0, 0, 0 }, m_index(0), m_count(0)
+{
+	if (!IsSupported(kind))
+	{
+		std::string msg = std::string(GetKindName(kind)) + " part file scanner is not supported on this processor";
+		throw std::exception(msg.c_str());
+	}
+}
+
+bool PartFileLineScanner::Refill()
+{
+	m_index = 0;
+	m_count = GetKernel(m_kind)(m_data, m_size, m_state, m_lines, BatchLines);
+
+	if (m_count < BatchLines && m_state.offset >= m_size && m_state.lineBegin < m_size)
+	{
+		EmitLine(m_data, m_state, m_size, m_lines, m_count);
+		m_state.lineBegin = m_size;
+	}
+	return m_count != 0;
+}
+
+PartFileScannerKind PartFileLineScanner::GetBestKind()
+{
+	static const PartFileScannerKind bestKind =
+		IsSupported(PartFileScannerKind::AVX2) ? PartFileScannerKind::AVX2 :
+		IsSupported(PartFileScannerKind::SSE2) ? PartFileScannerKind::SSE2 :
+		PartFileScannerKind::Scalar;
+
+	return bestKind;
+}
+
+bool PartFileLineScanner::IsSupported(PartFileScannerKind kind)
+{
+	switch (kind)
+	{
+	case PartFileScannerKind::Scalar:
+		return true;
+#if defined(PARTFILESCANNER_X64)
+	case PartFileScannerKind::SSE2:
+		return true;
+	case PartFileScannerKind::AVX2:
+	{
+		static const bool hasAVX2 = ProcessorHasAVX2();
+		return hasAVX2;
+	}
+#endif
+	default:
+		return false;
+	}
+}
+
+const char* PartFileLineScanner::GetKindName(PartFileScannerKind kind)
+{
+	switch (kind)
+	{
+	case PartFileScannerKind::SSE2:
+		return "SSE2";
+	case PartFileScannerKind::AVX2:
+		return "AVX2";
+	default:
+		return "Scalar";
+	}
+}
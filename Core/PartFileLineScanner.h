@@ -0,0 +1,110 @@
+#pragma once
+#include "CoreExports.h"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/// <summary>
+/// One line of a part file buffer as found by the PartFileLineScanner.
+/// </summary>
+struct PartFileLine
+{
+	size_t begin; /** Offset of the first byte of the line. */
+	uint32_t length; /** Without the \n or \r\n. */
+	uint32_t keyLength; /** Up to and including the first ':', 0 when the line has none. */
+};
+
+enum class PartFileScannerKind
+{
+	Scalar,
+	SSE2,
+	AVX2,
+};
+
+/// <summary>
+/// Where a scan kernel stopped, kept between batches.  Only the kernels use it.
+/// </summary>
+struct PartFileScanState
+{
+	size_t offset; /** Next byte the kernel looks at. */
+	size_t lineBegin; /** Start of the line being scanned. */
+	uint32_t keyLength; /** Of the line being scanned so far, 0 until its first ':'. */
+};
+
+/// <summary>
+/// Finds the line ends and the first ':' of every line of a part file buffer in one pass,
+/// 16 or 32 bytes at a time with SSE2 or AVX2 where the processor has it and a byte at a
+/// time otherwise.  The kernel is picked once at runtime, see GetBestKind.  Lines are
+/// scanned a batch at a time in to the scanner, so memory does not grow with the file.
+/// Line splitting matches PartFileTokenizer, a trailing line without \n is still a line.
+/// </summary>
+class CORE_API PartFileLineScanner
+{
+public:
+	PartFileLineScanner(const char* data, size_t size);
+
+	/// <summary>
+	/// Uses the given kernel, for benchmarks and tests.  Throws std::exception if this
+	/// processor does not support it.
+	/// </summary>
+	PartFileLineScanner(const char* data, size_t size, PartFileScannerKind kind);
+
+	PartFileLineScanner() = delete;
+	PartFileLineScanner(const PartFileLineScanner&) = delete;
+	PartFileLineScanner& operator=(const PartFileLineScanner&) = delete;
+
+	/// <summary>
+	/// Hands out the next line, returns false once the buffer is exhausted.
+	/// </summary>
+	bool Next(PartFileLine& line)
+	{
+		if (m_index == m_count && !Refill())
+		{
+			return false;
+		}
+		line = m_lines[m_index++];
+		return true;
+	}
+
+	/// <summary>
+	/// Byte offset of the next line to be handed out, like PartFileTokenizer::Offset.
+	/// </summary>
+	size_t Offset() const
+	{
+		return (m_index < m_count) ? m_lines[m_index].begin : m_state.lineBegin;
+	}
+
+	std::string_view GetLine(const PartFileLine& line) const
+	{
+		return std::string_view(m_data + line.begin, line.length);
+	}
+
+	PartFileScannerKind GetKind() const
+	{
+		return m_kind;
+	}
+
+	/// <summary>
+	/// The fastest kernel this processor and OS support.
+	/// </summary>
+	static PartFileScannerKind GetBestKind();
+	static bool IsSupported(PartFileScannerKind kind);
+	static const char* GetKindName(PartFileScannerKind kind);
+
+	/// <summary>
+	/// Lines per batch, at least the widest kernel's block (32 bytes, so 32 lines) past
+	/// the point where a kernel stops filling.
+	/// </summary>
+	static constexpr size_t BatchLines = 512;
+
+private:
+	bool Refill();
+
+	const char* m_data;
+	size_t m_size;
+	PartFileScannerKind m_kind;
+	PartFileScanState m_state;
+	size_t m_index;
+	size_t m_count;
+	PartFileLine m_lines[BatchLines];
+};
@@ -0,0 +1,77 @@
+#pragma once
+#include "CoreExports.h"
+#include <string_view>
+#include <cstring>
+
+/// <summary>
+/// Walks a part file held in memory (normally a MappedFile) line by line.
+/// Lines are handed out as std::string_view into the buffer with the
+/// line ending stripped, nothing is copied or allocated.
+/// </summary>
+class CORE_API PartFileTokenizer
+{
+public:
+	PartFileTokenizer(const char* data, size_t size) : m_data(data), m_size(size), m_offset(0)
+	{
+
+	}
+	PartFileTokenizer() = delete;
+
+	/// <summary>
+	/// Reads the next line, returns false once the buffer is exhausted.
+	/// </summary>
+	bool NextLine(std::string_view& line)
+	{
+		if (m_offset >= m_size)
+		{
+			line = std::string_view();
+			return false;
+		}
+
+		const char* start = m_data + m_offset;
+		size_t remaining = m_size - m_offset;
+		const char* end = (const char*)memchr(start, '\n', remaining);
+		size_t length = (end != nullptr) ? (size_t)(end - start) : remaining;
+
+		m_offset += (end != nullptr) ? length + 1 : length;
+
+		// part files are written on Windows, drop the \r of \r\n
+		if (length > 0 && start[length - 1] == '\r')
+		{
+			length--;
+		}
+		line = std::string_view(start, length);
+		return true;
+	}
+
+	bool AtEnd() const
+	{
+		return m_offset >= m_size;
+	}
+
+	/// <summary>
+	/// Byte offset of the next line to be read.
+	/// </summary>
+	size_t Offset() const
+	{
+		return m_offset;
+	}
+
+	void Seek(size_t offset)
+	{
+		m_offset = (offset < m_size) ? offset : m_size;
+	}
+
+	/// <summary>
+	/// Returns what follows token on the line, the caller has already checked startsWith.
+	/// </summary>
+	static std::string_view TokenValue(std::string_view line, std::string_view token)
+	{
+		return line.substr(token.size());
+	}
+
+private:
+	const char* m_data;
+	size_t m_size;
+	size_t m_offset;
+};
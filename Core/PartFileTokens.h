@@ -0,0 +1,54 @@
+#pragma once
+#include <string_view>
+
+// Every key of the text part file format lives here, readers, writers and
+// the tools all spell the format through these so they cannot drift apart.
+
+// Part header
+inline constexpr std::string_view PartFileNameToken = "PartFileName:";
+inline constexpr std::string_view SchemaVersionToken = "SchemaVersion:";
+inline constexpr std::string_view IntegrityToken = "Integrity:";
+
+// Feature blocks
+inline constexpr std::string_view FeatureToken = "Feature:";
+inline constexpr std::string_view EndFeatureToken = "EndFeature";
+inline constexpr std::string_view RoutingFeatureToken = "RoutingFeature:";
+inline constexpr std::string_view EndRoutingFeatureToken = "EndRoutingFeature";
+
+// Integrity checksums, see PartFileIntegrity.h.  A part whose header says Integrity:CRC32C
+// ends with a PartFileChecksum: line, each feature may carry a FeatureChecksum: line
+// just before its End line
+inline constexpr std::string_view IntegrityCrc32CValue = "CRC32C";
+inline constexpr std::string_view FeatureChecksumToken = "FeatureChecksum:";
+inline constexpr std::string_view PartFileChecksumToken = "PartFileChecksum:";
+
+// Keys common to every feature type, spelled <Type>_Version: and <Type>_Guid:
+inline constexpr std::string_view FeatureVersionSuffix = "_Version:";
+inline constexpr std::string_view FeatureGuidSuffix = "_Guid:";
+
+// Extrude
+inline constexpr std::string_view Extrude_VersionToken = "Extrude_Version:";
+inline constexpr std::string_view Extrude_DistanceToken = "Extrude_Distance:";
+inline constexpr std::string_view Extrude_TargetFaceToken = "Extrude_TargetFace:";
+inline constexpr std::string_view Extrude_VectorToken = "Extrude_Vector:";
+inline constexpr std::string_view Extrude_BooleanToken = "Extrude_Boolean:";
+inline constexpr std::string_view Extrude_IsAdditionToken = "Extrude_IsAddition:";
+inline constexpr std::string_view Extrude_IsSubtractionToken = "Extrude_IsSubtraction:";
+inline constexpr std::string_view Extrude_GuidToken = "Extrude_Guid:";
+
+// Block
+inline constexpr std::string_view Block_VersionToken = "Block_Version:";
+inline constexpr std::string_view Block_OriginToken = "Block_Origin:";
+inline constexpr std::string_view Block_LengthToken = "Block_Length:";
+inline constexpr std::string_view Block_WidthToken = "Block_Width:";
+inline constexpr std::string_view Block_HeightToken = "Block_Height:";
+inline constexpr std::string_view Block_GuidToken = "Block_Guid:";
+
+// Wire
+inline constexpr std::string_view Wire_VersionToken = "Wire_Version:";
+inline constexpr std::string_view Wire_DistanceToken = "Wire_Distance:";
+
+// Delta log next to a part, see PartDeltaLog
+inline constexpr std::string_view DeltaSaveToken = "DeltaSave:";
+inline constexpr std::string_view EndDeltaSaveToken = "EndDeltaSave";
+inline constexpr std::string_view TombstoneToken = "Tombstone:";
@@ -0,0 +1,300 @@
+#include "PartFileWatcher.h"
+#include <algorithm>
+#include <cwctype>
+#include <filesystem>
+#include <thread>
+#include <vector>
+#include <windows.h>
+
+static const DWORD NotifyFilter = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE;
+static const DWORD NotifyBufferBytes = 64 * 1024;
+
+struct PartFileWatcher::WatchedDirectory
+{
+	std::wstring path;
+	HANDLE handle;
+	HANDLE changeEvent;
+	HANDLE stopEvent;
+	OVERLAPPED overlapped;
+	std::vector<DWORD> buffer; /** DWORD aligned, as ReadDirectoryChangesW needs. */
+	std::thread thread;
+};
+
+static std::wstring ToLower(std::wstring text)
+{
+	std::transform(text.begin(), text.end(), text.begin(), [](wchar_t c) { return (wchar_t)std::towlower(c); });
+	return text;
+}
+
+
+PartFileWatcher& PartFileWatcher::GetInstance()
+{
+	static PartFileWatcher instance;
+	return instance;
+}
+
+PartFileWatcher::PartFileWatcher() : m_nextWatchId(NoWatch + 1), m_settleTime(250)
+{
+
+}
+
+PartFileWatcher::~PartFileWatcher()
+{
+	Shutdown();
+}
+
+bool PartFileWatcher::IssueRead(WatchedDirectory* directory)
+{
+	ResetEvent(directory->changeEvent);
+	directory->overlapped = {};
+	directory->overlapped.hEvent = directory->changeEvent;
+	return ReadDirectoryChangesW(directory->handle, directory->buffer.data(), NotifyBufferBytes, FALSE, NotifyFilter,
+		nullptr, &directory->overlapped, nullptr) != FALSE;
+}
+
+uint64_t PartFileWatcher::Watch(const std::string& filePath, ChangeCallback onChanged)
+{
+	std::filesystem::path path = std::filesystem::absolute(filePath).lexically_normal();
+	std::wstring directoryPath = path.parent_path().wstring();
+	std::wstring directoryKey = ToLower(directoryPath);
+
+	std::lock_guard<std::mutex> lock(m_mutex);
+	WatchedDirectory*& directory = m_directories[directoryKey];
+	if (directory == nullptr)
+	{
+		HANDLE handle = CreateFileW(directoryPath.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+		if (handle == INVALID_HANDLE_VALUE)
+		{
+			m_directories.erase(directoryKey);
+			std::string msg = "Unable to watch the directory of " + filePath;
+			throw std::exception(msg.c_str());
+		}
+
+		WatchedDirectory* created = new WatchedDirectory();
+		created->path = directoryPath;
+		created->handle = handle;
+		created->changeEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		created->stopEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+		created->buffer.resize(NotifyBufferBytes / sizeof(DWORD));
+
+		// the first read is issued before Watch returns, so no change after it is missed
+		if (created->changeEvent == nullptr || created->stopEvent == nullptr || !IssueRead(created))
+		{
+			m_directories.erase(directoryKey);
+			CloseHandle(created->changeEvent);
+			CloseHandle(created->stopEvent);
+			CloseHandle(handle);
+			delete created;
+			std::string msg = "Unable to watch the directory of " + filePath;
+			throw std::exception(msg.c_str());
+		}
+		created->thread = std::thread(&PartFileWatcher::DirectoryLoop, this, created);
+		directory = created;
+	}
+
+	uint64_t watchId = m_nextWatchId++;
+	WatchedFile& file = m_files[watchId];
+	file.filePath = filePath;
+	file.fileName = ToLower(path.filename().wstring());
+	file.directory = directory;
+	file.onChanged = std::move(onChanged);
+	file.pending = false;
+	return watchId;
+}
+
+void PartFileWatcher::Unwatch(uint64_t watchId)
+{
+	WatchedDirectory* unused = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::map<uint64_t, WatchedFile>::iterator found = m_files.find(watchId);
+		if (found == m_files.end())
+		{
+			return;
+		}
+		WatchedDirectory* directory = found->second.directory;
+		m_files.erase(found);
+
+		bool stillWatched = std::any_of(m_files.begin(), m_files.end(),
+			[directory](const std::pair<const uint64_t, WatchedFile>& file) { return file.second.directory == directory; });
+		if (!stillWatched)
+		{
+			m_directories.erase(ToLower(directory->path));
+			unused = directory;
+		}
+	}
+
+	// the directory thread takes m_mutex, it is joined without it
+	if (unused != nullptr)
+	{
+		StopDirectory(unused);
+	}
+}
+
+void PartFileWatcher::StopDirectory(WatchedDirectory* directory)
+{
+	SetEvent(directory->stopEvent);
+	directory->thread.join();
+	CloseHandle(directory->handle);
+	CloseHandle(directory->changeEvent);
+	CloseHandle(directory->stopEvent);
+	delete directory;
+}
+
+void PartFileWatcher::Shutdown()
+{
+	std::vector<WatchedDirectory*> directories;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		for (const std::pair<const std::wstring, WatchedDirectory*>& directory : m_directories)
+		{
+			directories.push_back(directory.second);
+		}
+		m_directories.clear();
+		m_files.clear();
+	}
+
+	for (WatchedDirectory* directory : directories)
+	{
+		StopDirectory(directory);
+	}
+}
+
+void PartFileWatcher::SetSettleMilliseconds(uint32_t settleMilliseconds)
+{
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_settleTime = std::chrono::milliseconds(settleMilliseconds);
+}
+
+void PartFileWatcher::DirectoryLoop(WatchedDirectory* directory)
+{
+	HANDLE events[2] = { directory->changeEvent, directory->stopEvent };
+	for (;;)
+	{
+		DWORD signalled = WaitForMultipleObjects(2, events, FALSE, INFINITE);
+		DWORD bytesReturned = 0;
+		if (signalled != WAIT_OBJECT_0)
+		{
+			// the read must be done with before its buffer goes
+			CancelIoEx(directory->handle, &directory->overlapped);
+			GetOverlappedResult(directory->handle, &directory->overlapped, &bytesReturned, TRUE);
+			return;
+		}
+		if (!GetOverlappedResult(directory->handle, &directory->overlapped, &bytesReturned, FALSE))
+		{
+			return; // the directory was deleted or the volume went away
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			std::vector<std::wstring> changedNames;
+			const char* record = (const char*)directory->buffer.data();
+			for (DWORD offset = 0; bytesReturned != 0; )
+			{
+				const FILE_NOTIFY_INFORMATION* information = (const FILE_NOTIFY_INFORMATION*)(record + offset);
+				// a tool saving through a temp file renames it over the watched one
+				if (information->Action != FILE_ACTION_REMOVED && information->Action != FILE_ACTION_RENAMED_OLD_NAME)
+				{
+					changedNames.push_back(ToLower(std::wstring(information->FileName, information->FileNameLength / sizeof(WCHAR))));
+				}
+				if (information->NextEntryOffset == 0)
+				{
+					break;
+				}
+				offset += information->NextEntryOffset;
+			}
+
+			for (std::pair<const uint64_t, WatchedFile>& file : m_files)
+			{
+				// no bytes means the buffer overflowed and the names are lost, every file may have changed
+				if (file.second.directory == directory && (bytesReturned == 0 ||
+					std::find(changedNames.begin(), changedNames.end(), file.second.fileName) != changedNames.end()))
+				{
+					file.second.pending = true;
+					file.second.lastChange = now;
+				}
+			}
+		}
+		m_fileChanged.notify_all();
+
+		if (!IssueRead(directory))
+		{
+			return;
+		}
+	}
+}
+
+size_t PartFileWatcher::DispatchChanges()
+{
+	struct ReadyFile
+	{
+		uint64_t watchId;
+		std::string filePath;
+		ChangeCallback onChanged;
+	};
+
+	std::vector<ReadyFile> ready;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		for (std::pair<const uint64_t, WatchedFile>& file : m_files)
+		{
+			if (file.second.pending && now - file.second.lastChange >= m_settleTime)
+			{
+				file.second.pending = false;
+				ready.push_back({ file.first, file.second.filePath, file.second.onChanged });
+			}
+		}
+	}
+
+	// without the lock, a callback may Watch or Unwatch
+	size_t dispatched = 0;
+	for (ReadyFile& file : ready)
+	{
+		if (file.onChanged(file.filePath))
+		{
+			dispatched++;
+			continue;
+		}
+
+		std::lock_guard<std::mutex> lock(m_mutex);
+		std::map<uint64_t, WatchedFile>::iterator found = m_files.find(file.watchId);
+		if (found != m_files.end())
+		{
+			found->second.pending = true;
+			found->second.lastChange = std::chrono::steady_clock::now();
+		}
+	}
+	return dispatched;
+}
+
+size_t PartFileWatcher::WaitAndDispatchChanges(uint32_t timeoutMilliseconds)
+{
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMilliseconds);
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		for (;;)
+		{
+			std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+			std::chrono::steady_clock::time_point wakeAt = deadline;
+			bool settled = false;
+			for (const std::pair<const uint64_t, WatchedFile>& file : m_files)
+			{
+				if (file.second.pending)
+				{
+					std::chrono::steady_clock::time_point settlesAt = file.second.lastChange + m_settleTime;
+					settled = settled || settlesAt <= now;
+					wakeAt = std::min(wakeAt, settlesAt);
+				}
+			}
+			if (settled || now >= deadline)
+			{
+				break;
+			}
+			m_fileChanged.wait_until(lock, wakeAt);
+		}
+	}
+	return DispatchChanges();
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include "CoreExports.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+
+/// <summary>
+/// Tells the session when files it has open are changed by other processes.
+/// Each watched directory has a thread waiting on ReadDirectoryChangesW, which
+/// only notes which files changed.  The callbacks run on the thread that calls
+/// DispatchChanges, so they may touch what that thread owns, such as the
+/// features in the GuidObjectManager.  A file is dispatched once it has gone
+/// the settle time without another change, so a tool writing it in pieces
+/// causes one callback.  shutdownProduct stops the threads.
+/// </summary>
+class CORE_API PartFileWatcher
+{
+public:
+	static PartFileWatcher& GetInstance();
+
+	PartFileWatcher(const PartFileWatcher&) = delete;
+	PartFileWatcher& operator=(const PartFileWatcher&) = delete;
+
+	/// <summary>
+	/// Called with the watched path.  Returns false when the file could not be
+	/// read yet, it is then dispatched again after another settle time.
+	/// </summary>
+	typedef std::function<bool(const std::string& filePath)> ChangeCallback;
+
+	static const uint64_t NoWatch = 0;
+
+	/// <summary>
+	/// Starts watching filePath, which need not exist yet.  A file may be watched
+	/// more than once, each watch is dispatched on its own.  Throws std::exception
+	/// if its directory cannot be watched.
+	/// </summary>
+	uint64_t Watch(const std::string& filePath, ChangeCallback onChanged);
+
+	/// <summary>
+	/// Stops the watch, its callback is not called again once this returns unless
+	/// DispatchChanges is running it on another thread.
+	/// </summary>
+	void Unwatch(uint64_t watchId);
+
+	/// <summary>
+	/// How long a file must go unchanged before it is dispatched, 250 ms by default.
+	/// </summary>
+	void SetSettleMilliseconds(uint32_t settleMilliseconds);
+
+	/// <summary>
+	/// Runs the callbacks of the files that have settled, returns how many ran.
+	/// </summary>
+	size_t DispatchChanges();
+
+	/// <summary>
+	/// Waits up to timeoutMilliseconds for a changed file to settle, then DispatchChanges.
+	/// </summary>
+	size_t WaitAndDispatchChanges(uint32_t timeoutMilliseconds);
+
+	/// <summary>
+	/// Drops every watch and joins the directory threads.
+	/// </summary>
+	void Shutdown();
+
+private:
+	PartFileWatcher();
+	~PartFileWatcher();
+
+	struct WatchedDirectory;
+	struct WatchedFile
+	{
+		std::string filePath;
+		std::wstring fileName; /** Lower case, as compared with the names ReadDirectoryChangesW reports. */
+		WatchedDirectory* directory;
+		ChangeCallback onChanged;
+		bool pending;
+		std::chrono::steady_clock::time_point lastChange;
+	};
+
+	static bool IssueRead(WatchedDirectory* directory);
+	void DirectoryLoop(WatchedDirectory* directory);
+	void StopDirectory(WatchedDirectory* directory);
+
+	std::mutex m_mutex;
+	std::condition_variable m_fileChanged;
+	std::map<uint64_t, WatchedFile> m_files;
+	std::map<std::wstring, WatchedDirectory*> m_directories; /** By lower case directory path. */
+	uint64_t m_nextWatchId;
+	std::chrono::milliseconds m_settleTime;
+};
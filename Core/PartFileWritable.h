@@ -0,0 +1,19 @@
+#pragma once
+#include "CoreExports.h"
+#include <string>
+
+/// <summary>
+/// Anything that can be saved into a part file.  Features and routing features live in
+/// different libraries, this lets the part writers save both without knowing either.
+/// </summary>
+class CORE_API IPartFileWritable
+{
+	public:
+		virtual ~IPartFileWritable() {}
+
+		/// <summary>
+		/// Appends the object to out in the latest text format, its Feature: or
+		/// RoutingFeature: line through the matching end line.
+		/// </summary>
+		virtual void WriteFeature(std::string& out) = 0;
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+template <typename Value>
+struct PerfectHashEntry
+{
+	std::string_view key;
+	Value value;
+};
+
+/// <summary>
+/// A fixed set of string keys with a seed, found at compile time, under which every key
+/// hashes to its own slot.  Find is one hash and one string compare however many keys
+/// there are, so readers can look a line's key up instead of walking a startsWith chain.
+/// Build one through MakePerfectHashMap and static_assert IsPerfect, a key set no seed
+/// separates (a duplicate key, or too many keys for SlotCount) then fails the build.
+/// </summary>
+template <typename Value, size_t EntryCount, size_t SlotCount = 256>
+class PerfectHashMap
+{
+	static_assert((SlotCount & (SlotCount - 1)) == 0, "SlotCount must be a power of two");
+	static_assert(EntryCount < 255, "slots hold the entry index in a byte");
+
+public:
+	constexpr PerfectHashMap(const PerfectHashEntry<Value>(&entries)[EntryCount])
+	{
+		for (size_t i = 0; i < EntryCount; ++i)
+		{
+			m_entries[i] = entries[i];
+		}
+
+		for (uint32_t seed = 0; seed < MaxSeedTries; ++seed)
+		{
+			if (TryBuildSlots(seed))
+			{
+				m_seed = seed;
+				m_isPerfect = true;
+				return;
+			}
+		}
+	}
+
+	constexpr bool IsPerfect() const
+	{
+		return m_isPerfect;
+	}
+
+	/// <summary>
+	/// The value stored for key, nullptr if key is not one of the entries.
+	/// </summary>
+	constexpr const Value* Find(std::string_view key) const
+	{
+		uint8_t slot = m_slots[Hash(key, m_seed) & (SlotCount - 1)];
+		if (slot == 0 || m_entries[slot - 1].key != key)
+		{
+			return nullptr;
+		}
+		return &m_entries[slot - 1].value;
+	}
+
+	/// <summary>
+	/// FNV-1a with the seed folded in to the offset basis.
+	/// </summary>
+	static constexpr uint32_t Hash(std::string_view key, uint32_t seed)
+	{
+		uint32_t hash = 2166136261u ^ (seed * 2654435761u);
+		for (char c : key)
+		{
+			hash ^= (uint8_t)c;
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+private:
+	static constexpr uint32_t MaxSeedTries = 4096;
+
+	constexpr bool TryBuildSlots(uint32_t seed)
+	{
+		for (size_t slot = 0; slot < SlotCount; ++slot)
+		{
+			m_slots[slot] = 0;
+		}
+		for (size_t i = 0; i < EntryCount; ++i)
+		{
+			size_t slot = Hash(m_entries[i].key, seed) & (SlotCount - 1);
+			if (m_slots[slot] != 0)
+			{
+				return false;
+			}
+			m_slots[slot] = (uint8_t)(i + 1);
+		}
+		return true;
+	}
+
+	PerfectHashEntry<Value> m_entries[EntryCount] = {};
+	uint8_t m_slots[SlotCount] = {}; /** Entry index plus one, 0 for an empty slot. */
+	uint32_t m_seed = 0;
+	bool m_isPerfect = false;
+};
+
+template <typename Value, size_t EntryCount>
+constexpr PerfectHashMap<Value, EntryCount> MakePerfectHashMap(const PerfectHashEntry<Value>(&entries)[EntryCount])
+{
+	return PerfectHashMap<Value, EntryCount>(entries);
+}
@@ -0,0 +1,57 @@
+#include "StringInterner.h"
+#include <mutex>
+
+StringInterner& StringInterner::GetInstance()
+{
+	static StringInterner instance;
+
+	return instance;
+}
+
+StringInterner::StringInterner()
+{
+	m_strings.emplace_back();
+	m_ids.emplace(std::string_view(m_strings.back()), EmptyId);
+}
+
+InternedStringId StringInterner::Intern(std::string_view text)
+{
+	{
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		auto iterator = m_ids.find(text);
+		if (iterator != m_ids.end())
+		{
+			return iterator->second;
+		}
+	}
+
+	std::unique_lock<std::shared_mutex> lock(m_mutex);
+
+	// another thread may have added it between the two locks
+	auto iterator = m_ids.find(text);
+	if (iterator != m_ids.end())
+	{
+		return iterator->second;
+	}
+
+	InternedStringId id = (InternedStringId)m_strings.size();
+	m_strings.emplace_back(text);
+	m_ids.emplace(std::string_view(m_strings.back()), id);
+	return id;
+}
+
+std::string_view StringInterner::GetString(InternedStringId id) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	if (id >= m_strings.size())
+	{
+		throw std::exception("Unknown interned string id");
+	}
+	return m_strings[id];
+}
+
+size_t StringInterner::GetCount() const
+{
+	std::shared_lock<std::shared_mutex> lock(m_mutex);
+	return m_strings.size();
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "CoreExports.h"
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+typedef uint32_t InternedStringId;
+
+/// <summary>
+/// Hands out one small id per distinct string, so features can hold face and vector
+/// references as four bytes and compare them without touching the text.  Strings are
+/// kept for the life of the process, it is meant for the small vocabulary of reference
+/// names a part set uses, not for free text.  Safe to use from several threads.
+/// </summary>
+class CORE_API StringInterner
+{
+public:
+	static StringInterner& GetInstance();
+
+	/// <summary>
+	/// The empty string is always interned as EmptyId.
+	/// </summary>
+	static constexpr InternedStringId EmptyId = 0;
+
+	InternedStringId Intern(std::string_view text);
+
+	/// <summary>
+	/// The text id was interned from, the view stays valid for the life of the process.
+	/// Throws std::exception for an id this interner never handed out.
+	/// </summary>
+	std::string_view GetString(InternedStringId id) const;
+
+	size_t GetCount() const;
+
+	StringInterner(const StringInterner&) = delete;
+	StringInterner& operator=(const StringInterner&) = delete;
+
+private:
+	StringInterner();
+
+	mutable std::shared_mutex m_mutex;
+	std::deque<std::string> m_strings; /** Indexed by id, a deque so growing it never moves a string. */
+	std::unordered_map<std::string_view, InternedStringId> m_ids; /** Views in to m_strings. */
+};
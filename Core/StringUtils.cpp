@@ -1,17 +1,192 @@
-
-#include "StringUtils.h"
-
-
-/*
- * Case Sensitive Implementation of startsWith()
- * It checks if the string 'mainStr' starts with given string 'toMatch'
- * https://thispointer.com/c-check-if-a-string-starts-with-an-another-given-string/
- */
-bool startsWith(std::string mainStr, std::string toMatch)
-{
-	// std::string::find returns 0 if toMatch is found at starting
-	if (mainStr.find(toMatch) == 0)
-		return true;
-	else
-		return false;
-}
+
+#include "StringUtils.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+
+
+/*
+ * Case Sensitive Implementation of startsWith()
+ * It checks if the string 'mainStr' starts with given string 'toMatch'
+ * https://thispointer.com/c-check-if-a-string-starts-with-an-another-given-string/
+ */
+bool startsWith(std::string_view mainStr, std::string_view toMatch)
+{
+	// Only compare the prefix, no copies and no scanning past it
+	if (mainStr.size() >= toMatch.size() && mainStr.compare(0, toMatch.size(), toMatch) == 0)
+		return true;
+	else
+		return false;
+}
+
+/*
+ * Parses a whole string_view as a base 10 int without allocating,
+ * returns false if anything but digits (and a leading '-') is present.
+ */
+bool parseInt(std::string_view text, int& value)
+{
+	const char* first = text.data();
+	const char* last = text.data() + text.size();
+	std::from_chars_result result = std::from_chars(first, last, value);
+	return result.ec == std::errc() && result.ptr == last;
+}
+
+/*
+ * Parses a whole string_view as a double without allocating or looking at the locale,
+ * returns false and leaves value alone if anything else is present.
+ */
+bool parseDouble(std::string_view text, double& value)
+{
+	const char* first = text.data();
+	const char* last = text.data() + text.size();
+	double parsed = 0.0;
+	std::from_chars_result result = std::from_chars(first, last, parsed);
+	if (result.ec != std::errc() || result.ptr != last)
+	{
+		return false;
+	}
+	value = parsed;
+	return true;
+}
+
+/*
+ * Parses a whole string_view as base 16, no 0x prefix, without allocating.
+ */
+bool parseHex32(std::string_view text, uint32_t& value)
+{
+	const char* first = text.data();
+	const char* last = text.data() + text.size();
+	std::from_chars_result result = std::from_chars(first, last, value, 16);
+	return result.ec == std::errc() && result.ptr == last;
+}
+
+void appendHex32(std::string& out, uint32_t value)
+{
+	static const char HexDigits[] = "0123456789abcdef";
+	char buffer[8];
+	for (int i = 7; i >= 0; i--)
+	{
+		buffer[i] = HexDigits[value & 0xF];
+		value >>= 4;
+	}
+	out.append(buffer, sizeof(buffer));
+}
+
+/*
+ * Parses count comma separated doubles straight from the text, no splitting into
+ * substrings and no allocation.  Blank around the commas is not allowed, the
+ * same as every other part file value.
+ */
+bool parseDoubleList(std::string_view text, double* values, size_t count)
+{
+	const char* first = text.data();
+	const char* last = text.data() + text.size();
+	for (size_t i = 0; i < count; i++)
+	{
+		std::from_chars_result result = std::from_chars(first, last, values[i]);
+		if (result.ec != std::errc())
+		{
+			return false;
+		}
+		first = result.ptr;
+		if (i + 1 < count)
+		{
+			if (first == last || *first != ',')
+			{
+				return false;
+			}
+			++first;
+		}
+	}
+	return count != 0 && first == last;
+}
+
+void appendDouble(std::string& out, double value)
+{
+	if (std::isnan(value))
+	{
+		return;
+	}
+
+	char buffer[32];
+	std::to_chars_result result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+	out.append(buffer, result.ptr);
+}
+
+void appendDoubleList(std::string& out, const double* values, size_t count)
+{
+	if (std::all_of(values, values + count, [](double value) { return std::isnan(value); }))
+	{
+		return;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (i != 0)
+		{
+			out.push_back(',');
+		}
+		appendDouble(out, values[i]);
+	}
+}
+
+bool parseBool(std::string_view text, bool& value)
+{
+	if (text == "True")
+	{
+		value = true;
+		return true;
+	}
+	if (text == "False")
+	{
+		value = false;
+		return true;
+	}
+	return false;
+}
+
+std::string_view boolToString(bool value)
+{
+	return value ? "True" : "False";
+}
+
+static void ThrowMalformedField(std::string_view fieldToken, std::string_view text, const char* expected)
+{
+	std::string msg = std::string(fieldToken) + std::string(text) + " is not " + expected;
+	throw std::exception(msg.c_str());
+}
+
+double parseDoubleField(std::string_view fieldToken, std::string_view text)
+{
+	double value = std::numeric_limits<double>::quiet_NaN();
+	if (!text.empty() && !parseDouble(text, value))
+	{
+		ThrowMalformedField(fieldToken, text, "a number");
+	}
+	return value;
+}
+
+void parseDoubleListField(std::string_view fieldToken, std::string_view text, double* values, size_t count)
+{
+	if (text.empty())
+	{
+		std::fill(values, values + count, std::numeric_limits<double>::quiet_NaN());
+		return;
+	}
+	if (!parseDoubleList(text, values, count))
+	{
+		std::string expected = std::to_string(count) + " comma separated numbers";
+		ThrowMalformedField(fieldToken, text, expected.c_str());
+	}
+}
+
+bool parseBoolField(std::string_view fieldToken, std::string_view text)
+{
+	bool value = false;
+	if (!text.empty() && !parseBool(text, value))
+	{
+		ThrowMalformedField(fieldToken, text, "True or False");
+	}
+	return value;
+}
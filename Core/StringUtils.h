@@ -1,6 +1,34 @@
-#pragma once
-
-#include <string>
-#include "CoreExports.h"
-
-CORE_API bool startsWith(std::string mainStr, std::string toMatch);
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "CoreExports.h"
+
+CORE_API bool startsWith(std::string_view mainStr, std::string_view toMatch);
+
+CORE_API bool parseInt(std::string_view text, int& value);
+
+CORE_API bool parseDouble(std::string_view text, double& value);
+
+// Checksums are written as 8 lower case hex digits
+CORE_API bool parseHex32(std::string_view text, uint32_t& value);
+CORE_API void appendHex32(std::string& out, uint32_t value);
+
+// Exactly count comma separated doubles, as in 0,0,0.  On false values may be partly written
+CORE_API bool parseDoubleList(std::string_view text, double* values, size_t count);
+
+// Shortest text that reads back as the same double, NaN (a field that was never given) appends nothing,
+// as does a list of nothing but NaN
+CORE_API void appendDouble(std::string& out, double value);
+CORE_API void appendDoubleList(std::string& out, const double* values, size_t count);
+
+// Part files spell booleans True and False
+CORE_API bool parseBool(std::string_view text, bool& value);
+CORE_API std::string_view boolToString(bool value);
+
+// Feature field values.  Empty text is a field that was never given, NaN or false, and writes back empty.
+// Any other text that does not parse throws std::exception naming the field, rather than being saved back empty
+CORE_API double parseDoubleField(std::string_view fieldToken, std::string_view text);
+CORE_API void parseDoubleListField(std::string_view fieldToken, std::string_view text, double* values, size_t count);
+CORE_API bool parseBoolField(std::string_view fieldToken, std::string_view text);
@@ -0,0 +1,112 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+// Enough ranges per worker that one slow range does not leave the others idle
+static const size_t RangesPerThread = 4;
+
+ThreadPool& ThreadPool::GetInstance()
+{
+	static ThreadPool instance;
+	return instance;
+}
+
+ThreadPool::ThreadPool(size_t threadCount) : m_threadCount(threadCount), m_stopping(false)
+{
+	if (m_threadCount == 0)
+	{
+		m_threadCount = std::max<size_t>(1, std::thread::hardware_concurrency());
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	Shutdown();
+}
+
+void ThreadPool::StartWorkers()
+{
+	m_stopping = false;
+	for (size_t i = 0; i < m_threadCount; i++)
+	{
+		m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+	}
+}
+
+std::future<void> ThreadPool::Submit(std::function<void()> task)
+{
+	std::packaged_task<void()> packagedTask(std::move(task));
+	std::future<void> result = packagedTask.get_future();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_workers.empty())
+		{
+			StartWorkers();
+		}
+		m_tasks.push(std::move(packagedTask));
+	}
+	m_taskAvailable.notify_one();
+	return result;
+}
+
+void ThreadPool::ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	size_t rangeCount = std::min(count, m_threadCount * RangesPerThread);
+	size_t rangeSize = (count + rangeCount - 1) / rangeCount;
+
+	std::vector<std::future<void>> ranges;
+	for (size_t begin = 0; begin < count; begin += rangeSize)
+	{
+		size_t end = std::min(count, begin + rangeSize);
+		ranges.push_back(Submit([&body, begin, end]() { body(begin, end); }));
+	}
+
+	// wait for every range before rethrowing, body is referenced by the ones still queued
+	for (std::future<void>& range : ranges)
+	{
+		range.wait();
+	}
+	for (std::future<void>& range : ranges)
+	{
+		range.get();
+	}
+}
+
+void ThreadPool::Shutdown()
+{
+	std::vector<std::thread> workers;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stopping = true;
+		workers.swap(m_workers);
+	}
+	m_taskAvailable.notify_all();
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+}
+
+void ThreadPool::WorkerLoop()
+{
+	while (true)
+	{
+		std::packaged_task<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_taskAvailable.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty())
+			{
+				return;
+			}
+			task = std::move(m_tasks.front());
+			m_tasks.pop();
+		}
+		task();
+	}
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include "CoreExports.h"
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <functional>
+
+/// <summary>
+/// Fixed set of worker threads fed from one queue.  Workers start on the
+/// first Submit and are joined by Shutdown, shutdownProduct does that for
+/// the shared instance so no thread outlives the Core dll.
+/// </summary>
+class CORE_API ThreadPool
+{
+public:
+	static ThreadPool& GetInstance();
+
+	/// <summary>
+	/// threadCount of 0 uses one worker per hardware thread.
+	/// </summary>
+	explicit ThreadPool(size_t threadCount = 0);
+	virtual ~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/// <summary>
+	/// Queues task, the future rethrows anything the task threw.
+	/// </summary>
+	std::future<void> Submit(std::function<void()> task);
+
+	/// <summary>
+	/// Splits [0, count) into contiguous ranges and runs body(begin, end) on the
+	/// workers, returning once all ranges are done.  The first exception in range
+	/// order is rethrown.  Do not call from inside a pool task, the caller blocks.
+	/// </summary>
+	void ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& body);
+
+	size_t GetThreadCount() const
+	{
+		return m_threadCount;
+	}
+
+	/// <summary>
+	/// Finishes the queued tasks and joins the workers, a later Submit starts them again.
+	/// </summary>
+	void Shutdown();
+
+private:
+	void StartWorkers();
+	void WorkerLoop();
+
+	size_t m_threadCount;
+	std::vector<std::thread> m_workers;
+	std::queue<std::packaged_task<void()>> m_tasks;
+	std::mutex m_mutex;
+	std::condition_variable m_taskAvailable;
+	bool m_stopping;
+};
@@ -1,5 +1,5 @@
-//
-// pch.cpp
-//
-
-#include "pch.h"
+//
+// pch.cpp
+//
+
+#include "pch.h"
@@ -1,7 +1,7 @@
-//
-// pch.h
-//
-
-#pragma once
-
-#include "gtest/gtest.h"
+//
+// pch.h
+//
+
+#pragma once
+
+#include "gtest/gtest.h"
@@ -1,24 +1,1101 @@
-#include "pch.h"
-#include "..\Core\StringUtils.h"
-
-TEST(StringUtilsTests, startsWithNegativeTest)
-{
-
-	std::string a = "aaaabbbb";
-	std::string prefix = "bbbb";
-	bool val = startsWith(a, prefix);
-
-
-	EXPECT_FALSE(val);
-	 
-}
-
-TEST(StringUtilsTests, startsWithPostiveTest)
-{
-	std::string a = "aaaabbbb";
-	std::string prefix = "aaaa";
-	bool val = startsWith(a, prefix);
-
-	EXPECT_TRUE(val);
-
-}
+#include "pch.h"
+#include "..\Core\StringUtils.h"
+#include "..\Core\ThreadPool.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\GuidObject.h"
+#include "..\Core\ContentHash.h"
+#include "..\Core\PartFileKeys.h"
+#include "..\Core\StringInterner.h"
+#include "..\Core\PartFileLineScanner.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileWritable.h"
+#include "..\Core\FeatureSerializer.h"
+#include "..\Core\Crc32C.h"
+#include "..\Core\PartFileIntegrity.h"
+#include "..\Core\FeatureContentStore.h"
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\PartFileWriter.h"
+#include "..\AppPartOps\PartDeltaLog.h"
+#include "..\AppPartOps\LazyFeatureIndex.h"
+#include "..\AppPartOps\PartSaveQueue.h"
+#include "..\AppPartOps\DelMeBadPattern.h"
+#include "..\AppPartOps\BinaryPartFormat.h"
+#include "..\AppPartOps\BinaryPartImage.h"
+#include "..\AppPartOps\PartFileConverter.h"
+#include "..\AppPartOps\PartCatalog.h"
+#include "..\AppPartOps\PartArchive.h"
+#include "..\Core\Observer.h"
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+
+TEST(StringUtilsTests, startsWithNegativeTest)
+{
+
+	std::string a = "aaaabbbb";
+	std::string prefix = "bbbb";
+	bool val = startsWith(a, prefix);
+
+
+	EXPECT_FALSE(val);
+	 
+}
+
+TEST(StringUtilsTests, startsWithPostiveTest)
+{
+	std::string a = "aaaabbbb";
+	std::string prefix = "aaaa";
+	bool val = startsWith(a, prefix);
+
+	EXPECT_TRUE(val);
+
+}
+
+TEST(ThreadPoolTests, parallelForVisitsEveryIndexOnceTest)
+{
+	ThreadPool pool(4);
+	std::vector<int> visits(1000, 0);
+
+	pool.ParallelFor(visits.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			visits[i]++;
+		}
+	});
+
+	EXPECT_EQ(std::count(visits.begin(), visits.end(), 1), 1000);
+}
+
+TEST(PartFileLayoutTests, scanFindsFeatureSpansInFileOrderTest)
+{
+	std::string part =
+		"PartFileName:Sample\r\n"
+		"SchemaVersion:1\r\n"
+		"Feature:Extrude\r\n"
+		"Extrude_Version:2\r\n"
+		"EndFeature\r\n"
+		"RoutingFeature:Wire\r\n"
+		"Wire_Version:2\r\n"
+		"EndRoutingFeature\r\n";
+
+	PartFileLayout layout = ScanPartFileLayout(part.data(), part.size());
+
+	EXPECT_EQ(layout.partFileName, "Sample");
+	EXPECT_EQ(layout.schemaVersion, "1");
+	ASSERT_EQ(layout.features.size(), 2u);
+	EXPECT_EQ(layout.features[0].featureType, "Extrude");
+	EXPECT_FALSE(layout.features[0].isRoutingFeature);
+	EXPECT_EQ(part.substr(layout.features[0].bodyBegin, layout.features[0].end - layout.features[0].bodyBegin), "Extrude_Version:2\r\nEndFeature\r\n");
+	EXPECT_EQ(layout.features[1].featureType, "Wire");
+	EXPECT_TRUE(layout.features[1].isRoutingFeature);
+	EXPECT_EQ(layout.features[1].end, part.size());
+}
+
+class CountingLazySource : public ILazyObjectSource
+{
+public:
+	GuidObject* MaterializeObject(int guid) override
+	{
+		m_calls++;
+		return (guid == 777001) ? new GuidObject(guid) : nullptr;
+	}
+	int m_calls = 0;
+};
+
+TEST(GuidObjectManagerTests, lazySourceMaterializesOnFirstLookupTest)
+{
+	CountingLazySource source;
+	GuidObjectManager& manager = GuidObjectManager::GetGuidObjectManager();
+	manager.AddLazyObjectSource(&source);
+
+	GuidObject* first = manager.GetObjectFromGUID(777001);
+	GuidObject* second = manager.GetObjectFromGUID(777001);
+	manager.RemoveLazyObjectSource(&source);
+
+	ASSERT_NE(first, nullptr);
+	EXPECT_EQ(first, second);
+	EXPECT_EQ(first->GetGuid(), 777001);
+	EXPECT_EQ(source.m_calls, 1);
+}
+
+TEST(ContentHashTests, matchesReferenceXXH64Test)
+{
+	EXPECT_EQ(HashContent("", 0), 0xEF46DB3751D8E999ull);
+	EXPECT_EQ(HashContent("abc", 3), 0x44BC2CF5AD770999ull);
+	EXPECT_EQ(ContentHashToString(0x44BC2CF5AD770999ull), "44bc2cf5ad770999");
+}
+
+TEST(PartFileKeysTests, lookupFindsEveryKeyAndRejectsOthersTest)
+{
+	std::string_view value;
+	for (const PerfectHashEntry<PartFileKey>& entry : PartFileKeyEntries)
+	{
+		std::string line(entry.key);
+		line.append("42");
+		PartFileKey expected = (entry.key.back() == ':') ? entry.value : PartFileKey::Unknown;
+		EXPECT_EQ(LookupPartFileKey(line, value), expected) << line;
+		EXPECT_EQ(LookupPartFileKey(entry.key, value), entry.value) << entry.key;
+	}
+
+	EXPECT_EQ(LookupPartFileKey("Extrude_Boolean:Intersect:Face1", value), PartFileKey::Extrude_Boolean);
+	EXPECT_EQ(value, "Intersect:Face1");
+	EXPECT_EQ(LookupPartFileKey("Extrude_Colour:Red", value), PartFileKey::Unknown);
+	EXPECT_EQ(LookupPartFileKey("", value), PartFileKey::Unknown);
+}
+
+TEST(StringInternerTests, sameTextGetsSameIdTest)
+{
+	StringInterner& interner = StringInterner::GetInstance();
+
+	InternedStringId face = interner.Intern("StringInternerTests_Face1");
+	InternedStringId vector = interner.Intern("StringInternerTests_Vector1");
+
+	EXPECT_NE(face, vector);
+	EXPECT_EQ(interner.Intern(std::string("StringInternerTests_Face1")), face);
+	EXPECT_EQ(interner.GetString(vector), "StringInternerTests_Vector1");
+	EXPECT_EQ(interner.Intern(""), StringInterner::EmptyId);
+}
+
+TEST(StringUtilsTests, doubleRoundTripsThroughShortestTextTest)
+{
+	double value = 0.0;
+	EXPECT_TRUE(parseDouble("2.75", value));
+	EXPECT_EQ(value, 2.75);
+	EXPECT_FALSE(parseDouble("2.75mm", value));
+
+	std::string text;
+	appendDouble(text, 0.1);
+	EXPECT_EQ(text, "0.1");
+
+	text.clear();
+	appendDouble(text, std::nan(""));
+	EXPECT_TRUE(text.empty());
+}
+
+TEST(StringUtilsTests, doubleListParsesExactlyCountValuesTest)
+{
+	double origin[3] = { 0.0, 0.0, 0.0 };
+	EXPECT_TRUE(parseDoubleList("1,-2.5,1e3", origin, 3));
+	EXPECT_EQ(origin[0], 1.0);
+	EXPECT_EQ(origin[1], -2.5);
+	EXPECT_EQ(origin[2], 1000.0);
+
+	EXPECT_FALSE(parseDoubleList("1,2", origin, 3));
+	EXPECT_FALSE(parseDoubleList("1,2,3,4", origin, 3));
+	EXPECT_FALSE(parseDoubleList("1, 2,3", origin, 3));
+
+	// a failed parse may have written some values, read them in again
+	EXPECT_TRUE(parseDoubleList("1,-2.5,1e3", origin, 3));
+	std::string text;
+	appendDoubleList(text, origin, 3);
+	EXPECT_EQ(text, "1,-2.5,1000");
+
+	// an origin that was never given writes back as it was read, empty
+	double unset[3];
+	parseDoubleListField(Block_OriginToken, "", unset, 3);
+	text.clear();
+	appendDoubleList(text, unset, 3);
+	EXPECT_TRUE(text.empty());
+}
+
+TEST(StringUtilsTests, malformedFieldThrowsRatherThanSavingBackEmptyTest)
+{
+	EXPECT_EQ(parseDoubleField(Block_LengthToken, "12.5"), 12.5);
+	EXPECT_TRUE(std::isnan(parseDoubleField(Block_LengthToken, "")));
+	EXPECT_THROW(parseDoubleField(Block_LengthToken, "12.5mm"), std::exception);
+
+	double origin[3];
+	EXPECT_THROW(parseDoubleListField(Block_OriginToken, "1,2", origin, 3), std::exception);
+
+	EXPECT_TRUE(parseBoolField(Extrude_IsAdditionToken, "True"));
+	EXPECT_FALSE(parseBoolField(Extrude_IsAdditionToken, ""));
+	EXPECT_THROW(parseBoolField(Extrude_IsAdditionToken, "Yes"), std::exception);
+}
+
+TEST(PartFileLineScannerTests, everyKernelSplitsLinesLikeTheTokenizerTest)
+{
+	// long enough to cross several SIMD blocks, with a \r\n, an empty line and no trailing \n
+	std::string part = "PartFileName:Scanner\r\nFeature:Extrude\nExtrude_Boolean:Intersect:Face1\n\nno key on this line\n";
+	for (int i = 0; i < 40; i++)
+	{
+		part += "Extrude_Distance:" + std::to_string(i) + "\n";
+	}
+	part += "EndFeature";
+
+	for (PartFileScannerKind kind : { PartFileScannerKind::Scalar, PartFileScannerKind::SSE2, PartFileScannerKind::AVX2 })
+	{
+		if (!PartFileLineScanner::IsSupported(kind))
+		{
+			continue;
+		}
+
+		PartFileLineScanner scanner(part.data(), part.size(), kind);
+		PartFileTokenizer tokenizer(part.data(), part.size());
+		PartFileLine scannedLine;
+		std::string_view line;
+		while (tokenizer.NextLine(line))
+		{
+			ASSERT_TRUE(scanner.Next(scannedLine)) << PartFileLineScanner::GetKindName(kind);
+			EXPECT_EQ(scanner.GetLine(scannedLine), line);
+			size_t colon = line.find(':');
+			EXPECT_EQ(scannedLine.keyLength, (colon == std::string_view::npos) ? 0 : colon + 1);
+			EXPECT_EQ(scanner.Offset(), tokenizer.Offset());
+		}
+		EXPECT_FALSE(scanner.Next(scannedLine));
+	}
+}
+
+namespace
+{
+	// Writes a different amount of text per guid so chunks end at uneven offsets
+	class TestWritableFeature : public GuidObject, public IPartFileWritable
+	{
+	public:
+		TestWritableFeature(int guid) : GuidObject(guid)
+		{
+		}
+
+		void WriteFeature(std::string& out) override
+		{
+			out.append("Feature:Test\nTest_Guid:").append(std::to_string(m_guid)).append("\n");
+			out.append(m_guid % 7, 'x').append("\nEndFeature\n");
+		}
+	};
+}
+
+TEST(FeatureSerializerTests, parallelChunksMatchSerialWriteTest)
+{
+	std::vector<std::unique_ptr<TestWritableFeature>> owned;
+	std::vector<GuidObject*> features;
+	for (int guid = 1; guid <= (int)(SerializeFeaturesPerChunk * 5 + 17); guid++)
+	{
+		owned.push_back(std::make_unique<TestWritableFeature>(guid));
+		features.push_back(owned.back().get());
+	}
+
+	std::string serial;
+	for (const std::unique_ptr<TestWritableFeature>& feature : owned)
+	{
+		feature->WriteFeature(serial);
+	}
+
+	std::vector<std::string> chunks;
+	SerializeFeaturesInParallel(features, 32, chunks);
+
+	std::string gathered;
+	for (const std::string& chunk : chunks)
+	{
+		gathered.append(chunk);
+	}
+	EXPECT_EQ(chunks.size(), 6u);
+	EXPECT_EQ(gathered, serial);
+
+	// the writer checksums each chunk on its own thread and chains their CRCs into the footer
+	Application::PartFileWriter serialWriter;
+	serialWriter.AddHeader("Checked", "12");
+	for (GuidObject* feature : features)
+	{
+		serialWriter.AddFeature(feature);
+	}
+	serialWriter.AddChecksumFooter();
+
+	Application::PartFileWriter parallelWriter;
+	parallelWriter.AddHeader("Checked", "12");
+	parallelWriter.AddFeatures(features);
+	parallelWriter.AddChecksumFooter();
+
+	EXPECT_GT(parallelWriter.GetSegments().size(), 1u);
+	const std::string& serialPart = serialWriter.GetText();
+	const std::string& parallelPart = parallelWriter.GetText();
+	EXPECT_EQ(parallelPart, serialPart);
+	EXPECT_NO_THROW(VerifyPartFileIntegrity(parallelPart.data(), parallelPart.size()));
+	PartFileLayout layout = ScanPartFileLayout(parallelPart.data(), parallelPart.size());
+	EXPECT_TRUE(layout.hasFooter);
+	ASSERT_EQ(layout.features.size(), features.size());
+	EXPECT_TRUE(layout.features.back().hasChecksum);
+}
+
+TEST(Crc32CTests, knownValueAndCombineTest)
+{
+	std::string text = "123456789";
+	EXPECT_EQ(Crc32C(text.data(), text.size()), 0xE3069283u);
+
+	std::string part;
+	for (int i = 0; i < 1000; i++)
+	{
+		part.append("Extrude_Distance:").append(std::to_string(i)).append("\n");
+	}
+	uint32_t whole = Crc32C(part.data(), part.size());
+	for (size_t split : { (size_t)0, (size_t)1, (size_t)13, part.size() / 2, part.size() })
+	{
+		uint32_t head = Crc32C(part.data(), split);
+		uint32_t tail = Crc32C(part.data() + split, part.size() - split);
+		EXPECT_EQ(Crc32C(part.data() + split, part.size() - split, head), whole);
+		EXPECT_EQ(Crc32CCombine(head, tail, part.size() - split), whole);
+	}
+}
+
+TEST(PartFileIntegrityTests, damageAndTruncationAreCaughtTest)
+{
+	std::string part = "PartFileName:Checked\nSchemaVersion:12\nIntegrity:CRC32C\n";
+	for (int guid = 1; guid <= 40; guid++)
+	{
+		size_t featureBegin = part.size();
+		TestWritableFeature(guid).WriteFeature(part);
+		AppendFeatureChecksum(part, featureBegin);
+	}
+	AppendPartFileChecksum(part, Crc32C(part.data(), part.size()));
+
+	EXPECT_NO_THROW(VerifyPartFileIntegrity(part.data(), part.size()));
+	PartFileLayout layout = ScanPartFileLayout(part.data(), part.size());
+	ASSERT_EQ(layout.features.size(), 40u);
+	EXPECT_TRUE(layout.features[0].hasChecksum);
+	{
+		// ranges as a ParallelFor would hand them out
+		PartFileChecksumCheck check(part.data(), part.size(), layout);
+		check.CheckFeatures(0, 13);
+		check.CheckFeatures(13, 40);
+		EXPECT_NO_THROW(check.Verify());
+	}
+
+	std::string damaged = part;
+	damaged[damaged.find("Test_Guid:17") + 10] = '9';
+	EXPECT_THROW(VerifyPartFileIntegrity(damaged.data(), damaged.size()), std::exception);
+	PartFileLayout damagedLayout = ScanPartFileLayout(damaged.data(), damaged.size());
+	EXPECT_THROW(VerifyFeatureChecksum(damaged.data(), damagedLayout.features[16]), std::exception);
+	EXPECT_NO_THROW(VerifyFeatureChecksum(damaged.data(), damagedLayout.features[15]));
+
+	std::string truncated = part.substr(0, part.size() / 2);
+	EXPECT_THROW(VerifyPartFileIntegrity(truncated.data(), truncated.size()), std::exception);
+	PartFileLayout truncatedLayout = ScanPartFileLayout(truncated.data(), truncated.size());
+	EXPECT_THROW(PartFileChecksumCheck(truncated.data(), truncated.size(), truncatedLayout), std::exception);
+}
+
+TEST(FeatureContentStoreTests, equalPayloadsAreSharedPerKindTest)
+{
+	struct TestPayload
+	{
+		double value;
+		uint32_t id;
+		uint32_t flags;
+	};
+
+	FeatureContentStore& store = FeatureContentStore::GetInstance();
+	FeatureContentKind kind = store.GetKind("StoreTestA");
+	FeatureContentKind otherKind = store.GetKind("StoreTestB");
+	EXPECT_EQ(store.GetKind("StoreTestA"), kind);
+	EXPECT_NE(otherKind, kind);
+
+	TestPayload payload = { 2.5, 7, 1 };
+	const TestPayload* first = store.Intern(kind, payload);
+	TestPayload copy = payload;
+	EXPECT_EQ(store.Intern(kind, copy), first);
+	EXPECT_NE(first, &payload);
+	EXPECT_EQ(first->id, 7u);
+
+	copy.flags = 0;
+	EXPECT_NE(store.Intern(kind, copy), first);
+	EXPECT_NE(store.Intern(otherKind, payload), first);
+
+	// interned from several threads at once, every equal payload still lands on one copy
+	std::vector<const TestPayload*> shared(1000, nullptr);
+	ThreadPool::GetInstance().ParallelFor(shared.size(), [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			TestPayload threadPayload = { (double)(i % 10), 99, 0 };
+			shared[i] = store.Intern(kind, threadPayload);
+		}
+	});
+	for (size_t i = 10; i < shared.size(); i++)
+	{
+		EXPECT_EQ(shared[i], shared[i % 10]);
+	}
+
+	for (const FeatureContentStatistics& statistics : store.GetStatistics())
+	{
+		if (statistics.featureType == "StoreTestA")
+		{
+			EXPECT_EQ(statistics.references, 1003u);
+			EXPECT_EQ(statistics.payloads, 12u);
+			EXPECT_EQ(statistics.payloadBytes, 12u * sizeof(TestPayload));
+		}
+	}
+}
+
+namespace
+{
+	// A folder under the temp path for the part file tests, removed with everything in it
+	class TemporaryPartFolder
+	{
+	public:
+		TemporaryPartFolder(const std::string& name)
+		{
+			m_folder = std::filesystem::temp_directory_path() / ("CoreUnitTest_" + name);
+			std::filesystem::remove_all(m_folder);
+			std::filesystem::create_directories(m_folder);
+		}
+
+		~TemporaryPartFolder()
+		{
+			std::error_code error;
+			std::filesystem::remove_all(m_folder, error);
+		}
+
+		std::string GetPath(const std::string& fileName) const
+		{
+			return (m_folder / fileName).string();
+		}
+
+	private:
+		std::filesystem::path m_folder;
+	};
+
+	std::string ReadWholeFile(const std::string& filePath)
+	{
+		std::ifstream file(filePath, std::ios::binary);
+		std::stringstream content;
+		content << file.rdbuf();
+		return content.str();
+	}
+
+	void WriteWholeFile(const std::string& filePath, const std::string& content)
+	{
+		std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+		file << content;
+	}
+
+	void AppendWholeFile(const std::string& filePath, const std::string& content)
+	{
+		std::ofstream file(filePath, std::ios::binary | std::ios::app);
+		file << content;
+	}
+
+	std::string TestFeatureText(int guid, const std::string& body)
+	{
+		return "Feature:Test\nTest_Guid:" + std::to_string(guid) + "\n" + body + "\nEndFeature\n";
+	}
+
+	// Body of the last feature with this guid, empty when there is none
+	std::string FindTestFeatureBody(const std::string& part, int guid)
+	{
+		PartFileLayout layout = ScanPartFileLayout(part.data(), part.size());
+		std::string body;
+		for (const FeatureSpan& feature : layout.features)
+		{
+			if (feature.guid == guid)
+			{
+				std::string text = part.substr(feature.bodyBegin, feature.end - feature.bodyBegin);
+				size_t bodyBegin = text.find('\n') + 1;
+				body = text.substr(bodyBegin, text.rfind("\nEndFeature") - bodyBegin);
+			}
+		}
+		return body;
+	}
+
+	const std::string DeltaTestHeader = "PartFileName:DeltaTest\nSchemaVersion:12\n";
+}
+
+TEST(PartDeltaLogTests, appendedSavesAndTombstonesFoldByGuidTest)
+{
+	TemporaryPartFolder folder("DeltaAppend");
+	std::string partFilePath = folder.GetPath("part.prt");
+	WriteWholeFile(partFilePath, DeltaTestHeader + TestFeatureText(1, "one") + TestFeatureText(2, "two") + TestFeatureText(3, "three"));
+	EXPECT_FALSE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+
+	{
+		Application::PartDeltaLog deltaLog(partFilePath);
+		deltaLog.AppendSave(TestFeatureText(2, "two changed") + TestFeatureText(4, "four"), { 3 });
+		deltaLog.AppendSave(TestFeatureText(4, "four changed"), {});
+	}
+	EXPECT_TRUE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+
+	std::string deltaLog = ReadWholeFile(Application::PartDeltaLog::GetDeltaLogPath(partFilePath));
+	EXPECT_NE(deltaLog.find("Tombstone:3\n"), std::string::npos);
+	EXPECT_NE(deltaLog.rfind("EndDeltaSave\n"), deltaLog.find("EndDeltaSave\n"));
+
+	std::string folded;
+	ASSERT_TRUE(Application::PartDeltaLog::ReadFolded(partFilePath, folded));
+	EXPECT_EQ(FindTestFeatureBody(folded, 1), "one");
+	EXPECT_EQ(FindTestFeatureBody(folded, 2), "two changed");
+	EXPECT_EQ(FindTestFeatureBody(folded, 3), "");
+	EXPECT_EQ(FindTestFeatureBody(folded, 4), "four changed");
+	EXPECT_EQ(ScanPartFileLayout(folded.data(), folded.size()).features.size(), 3u);
+
+	// reading it folded leaves both files alone
+	EXPECT_TRUE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+	EXPECT_EQ(FindTestFeatureBody(ReadWholeFile(partFilePath), 3), "three");
+}
+
+TEST(PartDeltaLogTests, batchWithoutEndDeltaSaveIsIgnoredTest)
+{
+	TemporaryPartFolder folder("DeltaTorn");
+	std::string partFilePath = folder.GetPath("part.prt");
+	WriteWholeFile(partFilePath, DeltaTestHeader + TestFeatureText(1, "one") + TestFeatureText(2, "two"));
+
+	{
+		Application::PartDeltaLog deltaLog(partFilePath);
+		deltaLog.AppendSave(TestFeatureText(1, "one changed"), {});
+	}
+	// a save cut short part way through its batch
+	AppendWholeFile(Application::PartDeltaLog::GetDeltaLogPath(partFilePath), "DeltaSave:9\n" + TestFeatureText(2, "torn") + "Tombstone:1\n");
+
+	std::string folded;
+	ASSERT_TRUE(Application::PartDeltaLog::ReadFolded(partFilePath, folded));
+	EXPECT_EQ(FindTestFeatureBody(folded, 1), "one changed");
+	EXPECT_EQ(FindTestFeatureBody(folded, 2), "two");
+
+	Application::PartDeltaLog(partFilePath).Compact();
+	std::string part = ReadWholeFile(partFilePath);
+	EXPECT_EQ(FindTestFeatureBody(part, 1), "one changed");
+	EXPECT_EQ(FindTestFeatureBody(part, 2), "two");
+}
+
+TEST(PartDeltaLogTests, compactionFoldsTheLogAndLaterSavesReplayOnTopTest)
+{
+	TemporaryPartFolder folder("DeltaCompact");
+	std::string partFilePath = folder.GetPath("part.prt");
+	WriteWholeFile(partFilePath, DeltaTestHeader + TestFeatureText(1, "one") + TestFeatureText(2, "two"));
+
+	Application::PartDeltaLog deltaLog(partFilePath);
+	deltaLog.AppendSave(TestFeatureText(3, "three"), { 1 });
+	std::string folded;
+	ASSERT_TRUE(Application::PartDeltaLog::ReadFolded(partFilePath, folded));
+
+	deltaLog.Compact();
+	EXPECT_FALSE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+	std::string part = ReadWholeFile(partFilePath);
+	EXPECT_EQ(part, folded);
+	EXPECT_EQ(FindTestFeatureBody(part, 1), "");
+	EXPECT_EQ(FindTestFeatureBody(part, 3), "three");
+
+	// saves after a compaction land in a fresh log and fold over the compacted part
+	deltaLog.AppendSave(TestFeatureText(2, "two changed") + TestFeatureText(1, "one again"), { 3 });
+	EXPECT_TRUE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+	deltaLog.Compact();
+	EXPECT_FALSE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+	part = ReadWholeFile(partFilePath);
+	EXPECT_EQ(FindTestFeatureBody(part, 1), "one again");
+	EXPECT_EQ(FindTestFeatureBody(part, 2), "two changed");
+	EXPECT_EQ(FindTestFeatureBody(part, 3), "");
+
+	// nothing logged, nothing to do
+	EXPECT_NO_THROW(deltaLog.Compact());
+	EXPECT_EQ(ReadWholeFile(partFilePath), part);
+}
+
+TEST(PartDeltaLogTests, openFoldsTheLogIntoThePartTest)
+{
+	TemporaryPartFolder folder("DeltaOpen");
+	std::string partFilePath = folder.GetPath("part.prt");
+	WriteWholeFile(partFilePath, DeltaTestHeader + TestFeatureText(880001, "one") + TestFeatureText(880002, "two"));
+	{
+		Application::PartDeltaLog deltaLog(partFilePath);
+		deltaLog.AppendSave(TestFeatureText(880002, "two changed") + TestFeatureText(880003, "three"), { 880001 });
+	}
+
+	Application::PartFile* partFile = Application::PartFile::OpenPartFile(partFilePath, Application::PartFileReadMode::Lazy);
+	EXPECT_FALSE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+
+	const Application::LazyFeatureIndex* lazyIndex = partFile->GetLazyIndex();
+	ASSERT_NE(lazyIndex, nullptr);
+	const size_t noFeature = Application::LazyFeatureIndex::NoFeature;
+	EXPECT_EQ(lazyIndex->GetFeatureCount(), 2u);
+	EXPECT_EQ(lazyIndex->FindFeatureIndex(880001), noFeature);
+	size_t changed = lazyIndex->FindFeatureIndex(880002);
+	ASSERT_NE(changed, noFeature);
+	EXPECT_EQ(std::string(lazyIndex->GetFeatureText(changed)), TestFeatureText(880002, "two changed"));
+	EXPECT_NE(lazyIndex->FindFeatureIndex(880003), noFeature);
+	delete partFile;
+}
+
+namespace
+{
+	// Counts the SavePart messages and checks, as each one arrives, that the saved record is already in the delta log
+	class SaveNotificationObserver : public Observer
+	{
+	public:
+		SaveNotificationObserver(const std::string& expectedRecord) : Observer(CoreSession::GetInstance(), Observer::SavePart), m_expectedRecord(expectedRecord)
+		{
+		}
+
+		~SaveNotificationObserver() override
+		{
+			RemoveMeFromTheList();
+		}
+
+		void Update(const std::string& message_from_subject, void* data) override
+		{
+			PartSaveNotifierData* partSaveNotifierData = static_cast<PartSaveNotifierData*>((PartOpsNotifierData*)data);
+			std::string deltaLog = ReadWholeFile(Application::PartDeltaLog::GetDeltaLogPath(partSaveNotifierData->partName));
+
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_notifications++;
+			m_coalescedSaves += partSaveNotifierData->coalescedSaves;
+			if (deltaLog.find(m_expectedRecord) == std::string::npos)
+			{
+				m_notifiedBeforeWrite++;
+			}
+		}
+
+		size_t GetNotifications()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_notifications;
+		}
+		size_t GetCoalescedSaves()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_coalescedSaves;
+		}
+		size_t GetNotifiedBeforeWrite()
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			return m_notifiedBeforeWrite;
+		}
+
+	private:
+		std::mutex m_mutex;
+		std::string m_expectedRecord;
+		size_t m_notifications = 0;
+		size_t m_coalescedSaves = 0;
+		size_t m_notifiedBeforeWrite = 0;
+	};
+
+	std::vector<std::string> TestFeatureRecords(const std::string& text)
+	{
+		std::vector<std::string> featureRecords;
+		featureRecords.push_back(text);
+		return featureRecords;
+	}
+}
+
+TEST(PartSaveQueueTests, savesWithinTheWindowCoalesceIntoOneBatchTest)
+{
+	TemporaryPartFolder folder("SaveQueueCoalesce");
+	std::string partFilePath = folder.GetPath("part.prt");
+	WriteWholeFile(partFilePath, DeltaTestHeader + TestFeatureText(1, "one") + TestFeatureText(2, "two"));
+
+	Application::PartSaveQueue& saveQueue = Application::PartSaveQueue::GetInstance();
+	saveQueue.SetEnabled(true);
+	// long enough that only the Flush writes
+	saveQueue.SetCoalesceMilliseconds(60000);
+	saveQueue.ResetStatistics();
+	SaveNotificationObserver observer(TestFeatureText(3, "three"));
+
+	std::shared_ptr<Application::PartDeltaLog> deltaLog = std::make_shared<Application::PartDeltaLog>(partFilePath);
+	saveQueue.QueueSave(partFilePath, 880101, deltaLog, TestFeatureRecords(TestFeatureText(1, "one changed")), { 1 }, {});
+	saveQueue.QueueSave(partFilePath, 880101, deltaLog, TestFeatureRecords(TestFeatureText(1, "one again") + TestFeatureText(3, "three")), { 1, 3 }, {});
+	saveQueue.QueueSave(partFilePath, 880101, deltaLog, {}, {}, { 2 });
+
+	EXPECT_TRUE(saveQueue.HasQueuedSaves(partFilePath));
+	EXPECT_FALSE(Application::PartDeltaLog::HasPendingDeltas(partFilePath));
+	EXPECT_EQ(observer.GetNotifications(), 0u);
+
+	saveQueue.Flush(partFilePath);
+	EXPECT_FALSE(saveQueue.HasQueuedSaves(partFilePath));
+	EXPECT_EQ(observer.GetNotifications(), 1u);
+	EXPECT_EQ(observer.GetCoalescedSaves(), 3u);
+	EXPECT_EQ(observer.GetNotifiedBeforeWrite(), 0u);
+
+	// the three saves are one batch, the last save of guid 1 wins
+	std::string log = ReadWholeFile(Application::PartDeltaLog::GetDeltaLogPath(partFilePath));
+	EXPECT_EQ(log.find("DeltaSave:"), log.rfind("DeltaSave:"));
+	EXPECT_EQ(log.find("one changed"), std::string::npos);
+	std::string folded;
+	ASSERT_TRUE(Application::PartDeltaLog::ReadFolded(partFilePath, folded));
+	EXPECT_EQ(FindTestFeatureBody(folded, 1), "one again");
+	EXPECT_EQ(FindTestFeatureBody(folded, 2), "");
+	EXPECT_EQ(FindTestFeatureBody(folded, 3), "three");
+
+	Application::PartSaveQueueStatistics statistics = saveQueue.GetStatistics();
+	EXPECT_EQ(statistics.queuedSaves, 3u);
+	EXPECT_EQ(statistics.writtenBatches, 1u);
+	EXPECT_EQ(statistics.failedBatches, 0u);
+
+	saveQueue.SetEnabled(false);
+	saveQueue.Shutdown();
+	saveQueue.SetCoalesceMilliseconds(100);
+	saveQueue.ResetStatistics();
+}
+
+TEST(PartSaveQueueTests, barrierAndTheFlusherNotifyOnceTheBatchIsOnDiskTest)
+{
+	TemporaryPartFolder folder("SaveQueueBarrier");
+	std::string firstPartFilePath = folder.GetPath("first.prt");
+	std::string secondPartFilePath = folder.GetPath("second.prt");
+	WriteWholeFile(firstPartFilePath, DeltaTestHeader + TestFeatureText(1, "one"));
+	WriteWholeFile(secondPartFilePath, DeltaTestHeader + TestFeatureText(1, "one"));
+
+	Application::PartSaveQueue& saveQueue = Application::PartSaveQueue::GetInstance();
+	saveQueue.SetEnabled(true);
+	saveQueue.SetCoalesceMilliseconds(60000);
+	saveQueue.ResetStatistics();
+	SaveNotificationObserver observer(TestFeatureText(4, "four"));
+
+	std::shared_ptr<Application::PartDeltaLog> firstDeltaLog = std::make_shared<Application::PartDeltaLog>(firstPartFilePath);
+	std::shared_ptr<Application::PartDeltaLog> secondDeltaLog = std::make_shared<Application::PartDeltaLog>(secondPartFilePath);
+	saveQueue.QueueSave(firstPartFilePath, 880201, firstDeltaLog, TestFeatureRecords(TestFeatureText(4, "four")), { 4 }, {});
+	saveQueue.QueueSave(secondPartFilePath, 880202, secondDeltaLog, TestFeatureRecords(TestFeatureText(4, "four")), { 4 }, {});
+	saveQueue.QueueSave(secondPartFilePath, 880202, secondDeltaLog, {}, {}, { 1 });
+
+	saveQueue.Barrier();
+	EXPECT_FALSE(saveQueue.HasQueuedSaves(firstPartFilePath));
+	EXPECT_FALSE(saveQueue.HasQueuedSaves(secondPartFilePath));
+	EXPECT_TRUE(Application::PartDeltaLog::HasPendingDeltas(firstPartFilePath));
+	EXPECT_TRUE(Application::PartDeltaLog::HasPendingDeltas(secondPartFilePath));
+	EXPECT_EQ(observer.GetNotifications(), 2u);
+	EXPECT_EQ(observer.GetCoalescedSaves(), 3u);
+	EXPECT_EQ(observer.GetNotifiedBeforeWrite(), 0u);
+	EXPECT_EQ(saveQueue.GetStatistics().writtenBatches, 2u);
+
+	// left to the flusher, the save is written once its window has gone by
+	saveQueue.SetCoalesceMilliseconds(20);
+	saveQueue.QueueSave(firstPartFilePath, 880201, firstDeltaLog, TestFeatureRecords(TestFeatureText(4, "four")), { 4 }, {});
+	std::chrono::steady_clock::time_point giveUpAt = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	while (observer.GetNotifications() < 3 && std::chrono::steady_clock::now() < giveUpAt)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+	}
+	EXPECT_EQ(observer.GetNotifications(), 3u);
+	EXPECT_FALSE(saveQueue.HasQueuedSaves(firstPartFilePath));
+	EXPECT_EQ(observer.GetNotifiedBeforeWrite(), 0u);
+	std::string log = ReadWholeFile(Application::PartDeltaLog::GetDeltaLogPath(firstPartFilePath));
+	EXPECT_NE(log.find("DeltaSave:"), log.rfind("DeltaSave:"));
+
+	saveQueue.SetEnabled(false);
+	saveQueue.Shutdown();
+	saveQueue.SetCoalesceMilliseconds(100);
+	saveQueue.ResetStatistics();
+}
+
+namespace
+{
+	// In the order ConvertBinaryPartToText writes the fields, so the round trip gives the text back as it was
+	const std::string BinaryTestPart =
+		"PartFileName:BinaryTest\n"
+		"SchemaVersion:12\n"
+		"Feature:Extrude\n"
+		"Extrude_Version:3\n"
+		"Extrude_Distance:5\n"
+		"Extrude_TargetFace:Face1\n"
+		"Extrude_Vector:Vector1\n"
+		"Extrude_Boolean:Intersect\n"
+		"Extrude_IsAddition:True\n"
+		"Extrude_IsSubtraction:False\n"
+		"Extrude_Guid:880301\n"
+		"EndFeature\n"
+		"Feature:Block\n"
+		"Block_Version:10\n"
+		"Block_Origin:0,0,0\n"
+		"Block_Length:100\n"
+		"Block_Width:50\n"
+		"Block_Height:25\n"
+		"Block_Guid:880302\n"
+		"EndFeature\n"
+		"RoutingFeature:Wire\n"
+		"Wire_Version:2\n"
+		"Wire_Distance:7\n"
+		"EndRoutingFeature\n"
+		"Feature:Extrude\n"
+		"Extrude_Version:3\n"
+		"Extrude_Distance:5\n"
+		"Extrude_TargetFace:Face1\n"
+		"Extrude_Vector:Vector1\n"
+		"Extrude_Boolean:Intersect\n"
+		"Extrude_IsAddition:True\n"
+		"Extrude_IsSubtraction:False\n"
+		"Extrude_Guid:880303\n"
+		"EndFeature\n";
+
+	template <typename Value>
+	std::string WithHeaderValue(std::string binaryPart, size_t offset, Value value)
+	{
+		memcpy(&binaryPart[offset], &value, sizeof(value));
+		return binaryPart;
+	}
+}
+
+TEST(BinaryPartTests, textAndBinaryRoundTripTest)
+{
+	TemporaryPartFolder folder("BinaryRoundTrip");
+	std::string textPartPath = folder.GetPath("part.prt");
+	std::string binaryPartPath = folder.GetPath("part.prtb");
+	std::string backToTextPath = folder.GetPath("back.prt");
+	std::string backToBinaryPath = folder.GetPath("back.prtb");
+	WriteWholeFile(textPartPath, BinaryTestPart);
+
+	ConvertPartFile(textPartPath, binaryPartPath);
+	EXPECT_FALSE(Application::BinaryPartImage::IsBinaryPartFile(textPartPath));
+	ASSERT_TRUE(Application::BinaryPartImage::IsBinaryPartFile(binaryPartPath));
+	{
+		Application::BinaryPartImage image(binaryPartPath);
+		EXPECT_EQ(image.GetPartFileName(), "BinaryTest");
+		EXPECT_EQ(image.GetSchemaVersion(), 12);
+		EXPECT_EQ(image.GetFeatureCount(), 4u);
+		EXPECT_EQ(image.FindFeatureIndex(880302), 1u);
+		EXPECT_TRUE(image.FindFeatureIndex(880304) == Application::BinaryPartImage::NoFeature);
+		// equal features share one record
+		EXPECT_EQ(image.GetHeader().extrudeCount, 1u);
+
+		std::string blockText;
+		AppendBinaryFeatureAsText(blockText, image, 1);
+		EXPECT_EQ(blockText, BinaryTestPart.substr(BinaryTestPart.find("Feature:Block"), BinaryTestPart.find("RoutingFeature:Wire") - BinaryTestPart.find("Feature:Block")));
+	}
+
+	ConvertPartFile(binaryPartPath, backToTextPath);
+	EXPECT_EQ(ReadWholeFile(backToTextPath), BinaryTestPart);
+	ConvertPartFile(backToTextPath, backToBinaryPath);
+	EXPECT_EQ(ReadWholeFile(backToBinaryPath), ReadWholeFile(binaryPartPath));
+}
+
+TEST(BinaryPartTests, truncatedOrCorruptBinaryPartIsRejectedTest)
+{
+	TemporaryPartFolder folder("BinaryCorrupt");
+	std::string textPartPath = folder.GetPath("part.prt");
+	std::string binaryPartPath = folder.GetPath("part.prtb");
+	WriteWholeFile(textPartPath, BinaryTestPart);
+	ConvertTextPartToBinary(textPartPath, binaryPartPath);
+	std::string binaryPart = ReadWholeFile(binaryPartPath);
+	ASSERT_GT(binaryPart.size(), sizeof(Application::BinaryPart::Header));
+
+	std::string damagedPath = folder.GetPath("damaged.prtb");
+	std::string convertedPath = folder.GetPath("converted.prt");
+	std::vector<std::string> damagedParts =
+	{
+		binaryPart.substr(0, binaryPart.size() - 8),
+		binaryPart.substr(0, sizeof(Application::BinaryPart::Header) - 1),
+		WithHeaderValue(binaryPart, offsetof(Application::BinaryPart::Header, fileSize), (uint64_t)binaryPart.size() * 2),
+		WithHeaderValue(binaryPart, offsetof(Application::BinaryPart::Header, formatVersion), (uint32_t)0xFFFF),
+		WithHeaderValue(binaryPart, offsetof(Application::BinaryPart::Header, tocOffset), (uint64_t)binaryPart.size() + 64),
+		WithHeaderValue(binaryPart, offsetof(Application::BinaryPart::Header, stringTableSize), (uint64_t)binaryPart.size()),
+		WithHeaderValue(binaryPart, offsetof(Application::BinaryPart::Header, featureCount), (uint32_t)0)
+	};
+	for (size_t i = 0; i < damagedParts.size(); i++)
+	{
+		WriteWholeFile(damagedPath, damagedParts[i]);
+		EXPECT_TRUE(Application::BinaryPartImage::IsBinaryPartFile(damagedPath)) << i;
+		EXPECT_THROW(Application::BinaryPartImage image(damagedPath), std::exception) << i;
+		EXPECT_THROW(ConvertBinaryPartToText(damagedPath, convertedPath), std::exception) << i;
+		EXPECT_FALSE(std::filesystem::exists(convertedPath)) << i;
+	}
+
+	// without the magic number it is not taken for a binary part at all
+	std::string notBinary = binaryPart;
+	notBinary[0] = 'X';
+	WriteWholeFile(damagedPath, notBinary);
+	EXPECT_FALSE(Application::BinaryPartImage::IsBinaryPartFile(damagedPath));
+	EXPECT_THROW(Application::BinaryPartImage image(damagedPath), std::exception);
+
+	// the intact file still reads
+	EXPECT_NO_THROW(Application::BinaryPartImage image(binaryPartPath));
+}
+
+namespace
+{
+	std::string CatalogTestPart(int features, int version)
+	{
+		std::string part = "PartFileName:CatalogTest\nSchemaVersion:12\n";
+		for (int guid = 1; guid <= features; guid++)
+		{
+			part.append(TestFeatureText(guid, "Test_Version:" + std::to_string(version)));
+		}
+		return part;
+	}
+
+	const Application::PartCatalogEntry* FindCatalogEntry(const Application::PartCatalog& catalog, const std::string& relativePath)
+	{
+		std::vector<const Application::PartCatalogEntry*> entries = catalog.FindParts([&](const Application::PartCatalogEntry& entry)
+		{
+			return entry.relativePath == relativePath;
+		});
+		return entries.empty() ? nullptr : entries.front();
+	}
+}
+
+TEST(PartCatalogTests, refreshProbesOnlyChangedPartsTest)
+{
+	TemporaryPartFolder folder("CatalogRefresh");
+	std::string rootDirectory = folder.GetPath("parts");
+	std::filesystem::create_directories(std::filesystem::path(rootDirectory) / "sub");
+	std::string indexPath = folder.GetPath("catalog.idx");
+	for (int i = 0; i < 5; i++)
+	{
+		WriteWholeFile((std::filesystem::path(rootDirectory) / ((i % 2) ? "sub" : "") / ("part" + std::to_string(i) + ".prt")).string(), CatalogTestPart(i + 1, 1));
+	}
+
+	Application::PartCatalog catalog(rootDirectory, indexPath);
+	Application::PartCatalogRefreshResult result = catalog.Refresh();
+	EXPECT_EQ(result.partCount, 5u);
+	EXPECT_EQ(result.probedCount, 5u);
+	EXPECT_EQ(result.failedCount, 0u);
+	const Application::PartCatalogEntry* entry = FindCatalogEntry(catalog, "sub/part3.prt");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(entry->featureCount, 4u);
+	EXPECT_EQ(entry->schemaVersion, 12);
+
+	result = catalog.Refresh();
+	EXPECT_EQ(result.partCount, 5u);
+	EXPECT_EQ(result.probedCount, 0u);
+
+	// a part rewritten and a part that gained a delta log are probed again, nothing else is
+	std::string changedPartPath = (std::filesystem::path(rootDirectory) / "part2.prt").string();
+	WriteWholeFile(changedPartPath, CatalogTestPart(6, 2));
+	std::string savedPartPath = (std::filesystem::path(rootDirectory) / "part4.prt").string();
+	Application::PartDeltaLog(savedPartPath).AppendSave(TestFeatureText(9, "Test_Version:1"), {});
+	result = catalog.Refresh();
+	EXPECT_EQ(result.probedCount, 2u);
+	entry = FindCatalogEntry(catalog, "part2.prt");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(entry->featureCount, 6u);
+	entry = FindCatalogEntry(catalog, "part4.prt");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_TRUE(entry->hasPendingDeltas);
+	EXPECT_NE(entry->deltaLogSize, 0u);
+
+	// appending to the log changes its stamp though the part is untouched
+	Application::PartDeltaLog(savedPartPath).AppendSave(TestFeatureText(10, "Test_Version:1"), {});
+	result = catalog.Refresh();
+	EXPECT_EQ(result.probedCount, 1u);
+
+	std::filesystem::remove((std::filesystem::path(rootDirectory) / "sub" / "part1.prt"));
+	result = catalog.Refresh();
+	EXPECT_EQ(result.partCount, 4u);
+	EXPECT_EQ(result.probedCount, 0u);
+	EXPECT_EQ(result.removedCount, 1u);
+	EXPECT_EQ(FindCatalogEntry(catalog, "sub/part1.prt"), nullptr);
+	EXPECT_EQ(catalog.FindPartsWithFeatureVersion("Test", 2).size(), 1u);
+}
+
+TEST(PartCatalogTests, reloadedIndexKeepsItsEntriesTest)
+{
+	TemporaryPartFolder folder("CatalogReload");
+	std::string rootDirectory = folder.GetPath("parts");
+	std::filesystem::create_directories(rootDirectory);
+	std::string indexPath = folder.GetPath("catalog.idx");
+	for (int i = 0; i < 4; i++)
+	{
+		WriteWholeFile((std::filesystem::path(rootDirectory) / ("part" + std::to_string(i) + ".prt")).string(), CatalogTestPart(i + 1, i));
+	}
+	{
+		Application::PartCatalog catalog(rootDirectory, indexPath);
+		EXPECT_EQ(catalog.Refresh().probedCount, 4u);
+	}
+
+	Application::PartCatalog reloaded(rootDirectory, indexPath);
+	ASSERT_EQ(reloaded.GetEntries().size(), 4u);
+	EXPECT_EQ(reloaded.FindPartsWithFeatureVersion("Test", 3).size(), 1u);
+	const Application::PartCatalogEntry* entry = FindCatalogEntry(reloaded, "part2.prt");
+	ASSERT_NE(entry, nullptr);
+	EXPECT_EQ(entry->featureCount, 3u);
+	ASSERT_EQ(entry->featureVersions.size(), 1u);
+	EXPECT_EQ(reloaded.GetFeatureTypeName(entry->featureVersions[0].featureType), "Test");
+	EXPECT_EQ(entry->featureVersions[0].version, 2);
+
+	Application::PartCatalogRefreshResult result = reloaded.Refresh();
+	EXPECT_EQ(result.partCount, 4u);
+	EXPECT_EQ(result.probedCount, 0u);
+
+	// an index it cannot read is rebuilt rather than trusted
+	WriteWholeFile(indexPath, "not an index");
+	Application::PartCatalog rebuilt(rootDirectory, indexPath);
+	EXPECT_TRUE(rebuilt.GetEntries().empty());
+	EXPECT_EQ(rebuilt.Refresh().probedCount, 4u);
+}
+
+TEST(PartArchiveTests, packedPartsReadBackByNameTest)
+{
+	TemporaryPartFolder folder("ArchivePack");
+	std::string alphaPath = folder.GetPath("alpha.prt");
+	std::string betaPath = folder.GetPath("beta.prt");
+	std::string gammaPath = folder.GetPath("gamma.prt");
+	std::string archivePath = folder.GetPath("parts.prtpak");
+	WriteWholeFile(alphaPath, DeltaTestHeader + TestFeatureText(880401, "alpha"));
+	WriteWholeFile(betaPath, DeltaTestHeader + TestFeatureText(880402, "beta"));
+	WriteWholeFile(gammaPath, DeltaTestHeader + TestFeatureText(880403, "gamma") + TestFeatureText(880404, "gamma"));
+	Application::PartDeltaLog(betaPath).AppendSave(TestFeatureText(880402, "beta changed"), {});
+
+	Application::PartArchive::Pack({ gammaPath, alphaPath, betaPath }, archivePath);
+	// the log was folded into the part as it was packed
+	EXPECT_FALSE(Application::PartDeltaLog::HasPendingDeltas(betaPath));
+	{
+		Application::PartArchive archive(archivePath);
+		ASSERT_EQ(archive.GetPartCount(), 3u);
+		std::vector<std::string> partNames;
+		for (uint32_t i = 0; i < archive.GetPartCount(); i++)
+		{
+			partNames.push_back(std::string(archive.GetPartName(i)));
+			EXPECT_EQ(archive.GetPart(i), archive.GetPart(archive.GetPartName(i)));
+		}
+		std::sort(partNames.begin(), partNames.end());
+		EXPECT_EQ(partNames, std::vector<std::string>({ "alpha", "beta", "gamma" }));
+
+		EXPECT_EQ(std::string(archive.GetPart("alpha")), ReadWholeFile(alphaPath));
+		EXPECT_EQ(FindTestFeatureBody(std::string(archive.GetPart("beta")), 880402), "beta changed");
+		EXPECT_EQ(std::string(archive.GetPart("gamma")), ReadWholeFile(gammaPath));
+		EXPECT_THROW(archive.GetPart("delta"), std::exception);
+	}
+
+	// names must be unique and only text parts are packed
+	std::filesystem::create_directories(folder.GetPath("other"));
+	std::string otherAlphaPath = folder.GetPath("other/alpha.prt");
+	WriteWholeFile(otherAlphaPath, DeltaTestHeader + TestFeatureText(880405, "other alpha"));
+	std::string otherArchivePath = folder.GetPath("other.prtpak");
+	EXPECT_THROW(Application::PartArchive::Pack({ alphaPath, otherAlphaPath }, otherArchivePath), std::exception);
+	EXPECT_THROW(Application::PartArchive::Pack({ alphaPath, folder.GetPath("missing.prt") }, otherArchivePath), std::exception);
+	EXPECT_FALSE(std::filesystem::exists(otherArchivePath));
+
+	std::string notArchivePath = folder.GetPath("notArchive.prtpak");
+	WriteWholeFile(notArchivePath, ReadWholeFile(alphaPath));
+	EXPECT_THROW(Application::PartArchive archive(notArchivePath), std::exception);
+	std::string truncatedArchivePath = folder.GetPath("truncated.prtpak");
+	std::string archiveBytes = ReadWholeFile(archivePath);
+	WriteWholeFile(truncatedArchivePath, archiveBytes.substr(0, archiveBytes.size() - 10));
+	EXPECT_THROW(Application::PartArchive archive(truncatedArchivePath), std::exception);
+}
+
+TEST(PartArchiveTests, archivedPartOpensByPathTest)
+{
+	TemporaryPartFolder folder("ArchiveOpen");
+	std::string alphaPath = folder.GetPath("alpha.prt");
+	std::string betaPath = folder.GetPath("beta.prt");
+	std::string archivePath = folder.GetPath("parts.prtpak");
+	WriteWholeFile(alphaPath, DeltaTestHeader + TestFeatureText(880501, "alpha"));
+	WriteWholeFile(betaPath, DeltaTestHeader + TestFeatureText(880502, "beta") + TestFeatureText(880503, "beta"));
+	Application::PartArchive::Pack({ alphaPath, betaPath }, archivePath);
+
+	std::string splitArchivePath;
+	std::string partName;
+	ASSERT_TRUE(Application::PartArchive::SplitArchivedPartPath(archivePath + "#beta", splitArchivePath, partName));
+	EXPECT_EQ(splitArchivePath, archivePath);
+	EXPECT_EQ(partName, "beta");
+	EXPECT_TRUE(Application::PartArchive::IsArchivedPartPath(archivePath + "#beta"));
+	EXPECT_FALSE(Application::PartArchive::IsArchivedPartPath(betaPath));
+	EXPECT_FALSE(Application::PartArchive::IsArchivedPartPath(archivePath));
+
+	Application::PartFile* partFile = Application::PartFile::OpenPartFile(archivePath + "#beta", Application::PartFileReadMode::Lazy);
+	const Application::LazyFeatureIndex* lazyIndex = partFile->GetLazyIndex();
+	ASSERT_NE(lazyIndex, nullptr);
+	const size_t noFeature = Application::LazyFeatureIndex::NoFeature;
+	EXPECT_EQ(lazyIndex->GetFeatureCount(), 2u);
+	size_t feature = lazyIndex->FindFeatureIndex(880503);
+	ASSERT_NE(feature, noFeature);
+	EXPECT_EQ(std::string(lazyIndex->GetFeatureText(feature)), TestFeatureText(880503, "beta"));
+	EXPECT_EQ(lazyIndex->FindFeatureIndex(880501), noFeature);
+	// the archive is read only
+	EXPECT_THROW(partFile->SavePart(Application::PartSaveMode::Full), std::exception);
+	delete partFile;
+
+	EXPECT_THROW(Application::PartFile::OpenPartFile(archivePath + "#gamma", Application::PartFileReadMode::Lazy), std::exception);
+	Application::PartArchive::CloseArchives();
+}
@@ -1,41 +1,138 @@
-#include "DataObjectReader.h"
-
-DataObjectReader& DataObjectReader::GetInstance()
-{
-    static DataObjectReader instance;
-
-    return instance;
-}
-
-
-DataObjectReader::DataObjectReader()
-{
-
-}
-
-
-void DataObjectReader::AddReader(std::string name, dataReaderFunction func)
-{
-
-    std::cout << "Adding Reader for " << name << std::endl;
-
-    m_mapOfReaderFunctions[name] = func;
-}
-void DataObjectReader::RemoveReader(std::string name)
-{
-    std::cout << "Removing Reader for " << name << std::endl;
-    m_mapOfReaderFunctions.erase(name);
-}
-dataReaderFunction DataObjectReader::GetReader(std::string name)
-{
-    try
-    {
-        std::cout << "Getting Reader for " << name << std::endl;
-        return m_mapOfReaderFunctions[name];
-    }
-    catch (std::exception e)
-    {
-        std::string msg = "No reader registered for " + name;
-        throw std::exception(msg.c_str());
-    }
-}
\ No newline at end of file
+#include "DataObjectReader.h"
+
+DataObjectReader& DataObjectReader::GetInstance()
+{
+    static DataObjectReader instance;
+
+    return instance;
+}
+
+
+DataObjectReader::DataObjectReader()
+{
+
+}
+
+
+void DataObjectReader::AddReader(std::string name, dataReaderFunction func)
+{
+
+    std::cout << "Adding Reader for " << name << std::endl;
+
+    m_mapOfReaderFunctions[name] = func;
+}
+void DataObjectReader::RemoveReader(std::string name)
+{
+    std::cout << "Removing Reader for " << name << std::endl;
+    m_mapOfReaderFunctions.erase(name);
+}
+dataReaderFunction DataObjectReader::GetReader(std::string name)
+{
+    try
+    {
+        std::cout << "Getting Reader for " << name << std::endl;
+        return m_mapOfReaderFunctions[name];
+    }
+    catch (std::exception e)
+    {
+        std::string msg = "No reader registered for " + name;
+        throw std::exception(msg.c_str());
+    }
+}
+
+
+void DataObjectReader::AddViewReader(std::string name, dataViewReaderFunction func)
+{
+    std::cout << "Adding View Reader for " << name << std::endl;
+
+    m_mapOfViewReaderFunctions[name] = func;
+}
+
+void DataObjectReader::RemoveViewReader(std::string name)
+{
+    std::cout << "Removing View Reader for " << name << std::endl;
+    m_mapOfViewReaderFunctions.erase(name);
+}
+
+// Called once per feature on the mapped path, so no logging and no insertion on a miss
+dataViewReaderFunction DataObjectReader::GetViewReader(const std::string& name)
+{
+    auto iterator = m_mapOfViewReaderFunctions.find(name);
+    if (iterator == m_mapOfViewReaderFunctions.end())
+    {
+        return nullptr;
+    }
+    return iterator->second;
+}
+
+
+void DataObjectReader::AddVersionUp(std::string name, dataVersionUpFunction func)
+{
+    std::cout << "Adding Version Up for " << name << std::endl;
+
+    m_mapOfVersionUpFunctions[name] = func;
+}
+
+void DataObjectReader::RemoveVersionUp(std::string name)
+{
+    std::cout << "Removing Version Up for " << name << std::endl;
+    m_mapOfVersionUpFunctions.erase(name);
+}
+
+dataVersionUpFunction DataObjectReader::GetVersionUp(const std::string& name)
+{
+    auto iterator = m_mapOfVersionUpFunctions.find(name);
+    if (iterator == m_mapOfVersionUpFunctions.end())
+    {
+        return nullptr;
+    }
+    return iterator->second;
+}
+
+
+void DataObjectReader::AddLatestViewReader(std::string name, dataViewReaderFunction func)
+{
+    std::cout << "Adding Latest View Reader for " << name << std::endl;
+
+    m_mapOfLatestViewReaderFunctions[name] = func;
+}
+
+void DataObjectReader::RemoveLatestViewReader(std::string name)
+{
+    std::cout << "Removing Latest View Reader for " << name << std::endl;
+    m_mapOfLatestViewReaderFunctions.erase(name);
+}
+
+dataViewReaderFunction DataObjectReader::GetLatestViewReader(const std::string& name)
+{
+    auto iterator = m_mapOfLatestViewReaderFunctions.find(name);
+    if (iterator == m_mapOfLatestViewReaderFunctions.end())
+    {
+        return nullptr;
+    }
+    return iterator->second;
+}
+
+
+void DataObjectReader::AddWriter(std::string name, dataWriterFunction func)
+{
+    std::cout << "Adding Writer for " << name << std::endl;
+
+    m_mapOfWriterFunctions[name] = func;
+}
+
+void DataObjectReader::RemoveWriter(std::string name)
+{
+    std::cout << "Removing Writer for " << name << std::endl;
+    m_mapOfWriterFunctions.erase(name);
+}
+
+dataWriterFunction DataObjectReader::GetWriter(const std::string& name)
+{
+    auto iterator = m_mapOfWriterFunctions.find(name);
+    if (iterator == m_mapOfWriterFunctions.end())
+    {
+        return nullptr;
+    }
+    return iterator->second;
+}
@@ -1,27 +1,51 @@
-#pragma once
-#include "DataReaderExports.h"
-#include <string>
-#include "dataReaderFunctionType.h"
-
-
-class DATAREADER_API DataObjectReader
-{
-public:
-
-    static DataObjectReader& GetInstance();
-
-    DataObjectReader(DataObjectReader const&) = delete;
-    void operator=(DataObjectReader const&) = delete;
-
-    void AddReader(std::string, dataReaderFunction func );
-    void RemoveReader(std::string);
-    dataReaderFunction GetReader(std::string);
-
-private:
-    DataObjectReader();
-
-    std::map<std::string, dataReaderFunction> m_mapOfReaderFunctions;
-
-
-};
-
+#pragma once
+#include "DataReaderExports.h"
+#include <string>
+#include "dataReaderFunctionType.h"
+
+
+class DATAREADER_API DataObjectReader
+{
+public:
+
+    static DataObjectReader& GetInstance();
+
+    DataObjectReader(DataObjectReader const&) = delete;
+    void operator=(DataObjectReader const&) = delete;
+
+    void AddReader(std::string, dataReaderFunction func );
+    void RemoveReader(std::string);
+    dataReaderFunction GetReader(std::string);
+
+    void AddViewReader(std::string, dataViewReaderFunction func);
+    void RemoveViewReader(std::string);
+    dataViewReaderFunction GetViewReader(const std::string&);
+
+    // Keyed like the readers, "Extrude2" is the step from version 2 to 3
+    void AddVersionUp(std::string, dataVersionUpFunction func);
+    void RemoveVersionUp(std::string);
+    dataVersionUpFunction GetVersionUp(const std::string&);
+
+    // Keyed like the readers, "Extrude2" reads version 2 text straight into the latest version,
+    // applying the version up rules field by field so no old version object is made
+    void AddLatestViewReader(std::string, dataViewReaderFunction func);
+    void RemoveLatestViewReader(std::string);
+    dataViewReaderFunction GetLatestViewReader(const std::string&);
+
+    // Only the latest version of a feature has a writer
+    void AddWriter(std::string, dataWriterFunction func);
+    void RemoveWriter(std::string);
+    dataWriterFunction GetWriter(const std::string&);
+
+private:
+    DataObjectReader();
+
+    std::map<std::string, dataReaderFunction> m_mapOfReaderFunctions;
+    std::map<std::string, dataViewReaderFunction> m_mapOfViewReaderFunctions;
+    std::map<std::string, dataVersionUpFunction> m_mapOfVersionUpFunctions;
+    std::map<std::string, dataViewReaderFunction> m_mapOfLatestViewReaderFunctions;
+    std::map<std::string, dataWriterFunction> m_mapOfWriterFunctions;
+
+
+};
+
@@ -1,21 +1,90 @@
-#include "DataReaderRegistrant.h"
-#include "DataObjectReader.h"
-
-
-
-
-DataReaderRegistrant::DataReaderRegistrant(std::string registrantName, dataReaderFunction func)
-{
-	DataObjectReader::GetInstance().AddReader(registrantName, func);
-	m_registrantName = registrantName;
-}
-
-
-DataReaderRegistrant::~DataReaderRegistrant()
-{
-	DataObjectReader::GetInstance().RemoveReader(m_registrantName);
-}
-
-
-
-
+#include "DataReaderRegistrant.h"
+#include "DataObjectReader.h"
+
+
+
+
+DataReaderRegistrant::DataReaderRegistrant(std::string registrantName, dataReaderFunction func)
+{
+	DataObjectReader::GetInstance().AddReader(registrantName, func);
+	m_registrantName = registrantName;
+	m_hasViewReader = false;
+	m_hasVersionUp = false;
+	m_hasLatestViewReader = false;
+	m_hasWriter = false;
+}
+
+DataReaderRegistrant::DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc)
+{
+	DataObjectReader::GetInstance().AddReader(registrantName, func);
+	DataObjectReader::GetInstance().AddViewReader(registrantName, viewFunc);
+	m_registrantName = registrantName;
+	m_hasViewReader = true;
+	m_hasVersionUp = false;
+	m_hasLatestViewReader = false;
+	m_hasWriter = false;
+}
+
+DataReaderRegistrant::DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc, dataVersionUpFunction versionUpFunc)
+{
+	DataObjectReader::GetInstance().AddReader(registrantName, func);
+	DataObjectReader::GetInstance().AddViewReader(registrantName, viewFunc);
+	DataObjectReader::GetInstance().AddVersionUp(registrantName, versionUpFunc);
+	m_registrantName = registrantName;
+	m_hasViewReader = true;
+	m_hasVersionUp = true;
+	m_hasLatestViewReader = false;
+	m_hasWriter = false;
+}
+
+DataReaderRegistrant::DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc, dataVersionUpFunction versionUpFunc,
+	dataViewReaderFunction latestViewFunc)
+{
+	DataObjectReader::GetInstance().AddReader(registrantName, func);
+	DataObjectReader::GetInstance().AddViewReader(registrantName, viewFunc);
+	DataObjectReader::GetInstance().AddVersionUp(registrantName, versionUpFunc);
+	DataObjectReader::GetInstance().AddLatestViewReader(registrantName, latestViewFunc);
+	m_registrantName = registrantName;
+	m_hasViewReader = true;
+	m_hasVersionUp = true;
+	m_hasLatestViewReader = true;
+	m_hasWriter = false;
+}
+
+DataReaderRegistrant::DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc, dataWriterFunction writerFunc)
+{
+	DataObjectReader::GetInstance().AddReader(registrantName, func);
+	DataObjectReader::GetInstance().AddViewReader(registrantName, viewFunc);
+	DataObjectReader::GetInstance().AddWriter(registrantName, writerFunc);
+	m_registrantName = registrantName;
+	m_hasViewReader = true;
+	m_hasVersionUp = false;
+	m_hasLatestViewReader = false;
+	m_hasWriter = true;
+}
+
+
+DataReaderRegistrant::~DataReaderRegistrant()
+{
+	DataObjectReader::GetInstance().RemoveReader(m_registrantName);
+	if (m_hasViewReader)
+	{
+		DataObjectReader::GetInstance().RemoveViewReader(m_registrantName);
+	}
+	if (m_hasVersionUp)
+	{
+		DataObjectReader::GetInstance().RemoveVersionUp(m_registrantName);
+	}
+	if (m_hasLatestViewReader)
+	{
+		DataObjectReader::GetInstance().RemoveLatestViewReader(m_registrantName);
+	}
+	if (m_hasWriter)
+	{
+		DataObjectReader::GetInstance().RemoveWriter(m_registrantName);
+	}
+}
+
+
+
+
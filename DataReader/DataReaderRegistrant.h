@@ -1,19 +1,31 @@
-#pragma once
-#include "DataReaderExports.h"
-#include "dataReaderFunctionType.h"
-#include <string>
-
-
-
-class DATAREADER_API DataReaderRegistrant
-{
-public:
-
-	DataReaderRegistrant(std::string registrantName, dataReaderFunction func);
-
-	virtual ~DataReaderRegistrant();
-
-
-private:
-	std::string m_registrantName;
-};
+#pragma once
+#include "DataReaderExports.h"
+#include "dataReaderFunctionType.h"
+#include <string>
+
+
+
+class DATAREADER_API DataReaderRegistrant
+{
+public:
+
+	DataReaderRegistrant(std::string registrantName, dataReaderFunction func);
+	DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc);
+	// An older version, registers the step up to the next version alongside its readers
+	DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc, dataVersionUpFunction versionUpFunc);
+	// As above, plus a view reader that reads this version straight into the latest one
+	DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc, dataVersionUpFunction versionUpFunc,
+		dataViewReaderFunction latestViewFunc);
+	// The latest version, registers its writer alongside its readers
+	DataReaderRegistrant(std::string registrantName, dataReaderFunction func, dataViewReaderFunction viewFunc, dataWriterFunction writerFunc);
+
+	virtual ~DataReaderRegistrant();
+
+
+private:
+	std::string m_registrantName;
+	bool m_hasViewReader;
+	bool m_hasVersionUp;
+	bool m_hasLatestViewReader;
+	bool m_hasWriter;
+};
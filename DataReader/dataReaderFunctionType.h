@@ -1,7 +1,17 @@
-#pragma once
-#include <iostream>
-#include <map>
-#include <string>
-#include "..\Core\GuidObject.h"
-
-typedef GuidObject* (*dataReaderFunction)(std::ifstream& streamObject);
\ No newline at end of file
+#pragma once
+#include <iostream>
+#include <map>
+#include <string>
+#include "..\Core\GuidObject.h"
+#include "..\Core\PartFileTokenizer.h"
+
+typedef GuidObject* (*dataReaderFunction)(std::ifstream& streamObject);
+
+// Reader over a memory mapped part file, lines come in as std::string_view
+typedef GuidObject* (*dataViewReaderFunction)(PartFileTokenizer& tokenizer);
+
+// Takes a feature one version up, returns a new object and leaves oldObject to the caller
+typedef GuidObject* (*dataVersionUpFunction)(GuidObject* oldObject);
+
+// Appends a feature in its text format, Feature: line through EndFeature
+typedef void (*dataWriterFunction)(GuidObject* object, std::string& out);
@@ -1,13 +1,13 @@
-// The following ifdef block is the standard way of creating macros which make exporting
-// from a DLL simpler. All files within this DLL are compiled with the FEATUREOPSUI_EXPORTS
-// symbol defined on the command line. This symbol should not be defined on any project
-// that uses this DLL. This way any other project whose source files include this file see
-// FEATUREOPSUI_API functions as being imported from a DLL, whereas this DLL sees symbols
-// defined with this macro as being exported.
-#ifdef FEATUREOPSUI_EXPORTS
-#define FEATUREOPSUI_API __declspec(dllexport)
-#else
-#define FEATUREOPSUI_API __declspec(dllimport)
-#endif
-
-
+// The following ifdef block is the standard way of creating macros which make exporting
+// from a DLL simpler. All files within this DLL are compiled with the FEATUREOPSUI_EXPORTS
+// symbol defined on the command line. This symbol should not be defined on any project
+// that uses this DLL. This way any other project whose source files include this file see
+// FEATUREOPSUI_API functions as being imported from a DLL, whereas this DLL sees symbols
+// defined with this macro as being exported.
+#ifdef FEATUREOPSUI_EXPORTS
+#define FEATUREOPSUI_API __declspec(dllexport)
+#else
+#define FEATUREOPSUI_API __declspec(dllimport)
+#endif
+
+
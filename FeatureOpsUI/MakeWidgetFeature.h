@@ -1,12 +1,12 @@
-#pragma once
-
-#include "FeatureOpsUIExports.h"
-namespace Application
-{
-	class PartFile;
-}
-
-
-FEATUREOPSUI_API void AddWidgetFeatureToPartUI(Application::PartFile* partFile, bool option1, int values);
-
-
+#pragma once
+
+#include "FeatureOpsUIExports.h"
+namespace Application
+{
+	class PartFile;
+}
+
+
+FEATUREOPSUI_API void AddWidgetFeatureToPartUI(Application::PartFile* partFile, bool option1, int values);
+
+
@@ -1,91 +1,89 @@
-#include "JournalFile.h"
-#include "JournalingTypes.h"
-#include <fstream>
-
-using namespace Journal;
-
-JournalFile::JournalFile(std::string fileName, JournalingLanguage jnlLang)
-	: m_journalFileName(fileName), m_jnlLang(jnlLang), m_journalContents(), m_file(new std::ofstream(fileName))
-{
-	 
-}
-
-void JournalFile::WriteJournalFile()
-{
-	ProFormaStart();
-	*m_file << m_journalContents.str() << std::endl;
-	ProFormEnd();
-	m_file->close();
-}
-
-JournalFile::~JournalFile()
-{
-    if (m_file != nullptr)
-    {
-        m_file->close();
-    }
-	delete m_file;
-}
-
-void JournalFile::NewLine()
-{
-    m_journalContents << std::endl;
-}
-
-void JournalFile::WriteToFile(std::string& contentToWrite)
-{
-    m_journalContents << contentToWrite;
-}
-
-void JournalFile::ProFormEnd()
-{
-    if (m_jnlLang == JournalingLanguage::CPP)
-    {
-        ProFormEndCPP();
-    }
-    else
-    {
-        ProFormEndJava();
-    }
-}
-
-void JournalFile::ProFormEndCPP()
-{
-    *m_file << "}" << std::endl;
-}
-void JournalFile::ProFormEndJava()
-{
-    *m_file << "NIY END" << std::endl;
-}
-
-void JournalFile::ProFormaStart()
-{
-    if (m_jnlLang == JournalingLanguage::CPP)
-    {
-        ProFormaStartCPP();
-    }
-    else
-    {
-        ProFormaStartJava();
-    }
-}
-
-void JournalFile::ProFormaStartCPP()
-{
-    //Write out include Files
-    *m_file << "#include <iostream>" << std::endl;
-    *m_file << "#include \"..\\AutomationBinding\\AutomationAPI_Session.h\"" << std::endl;
-    *m_file << "#include \"..\\AutomationBinding\\AutomationAPI_Part.h\"" << std::endl;
-
-    *m_file << preProForma.str() << std::endl;
-
-    *m_file << "int main()" << std::endl;
-    *m_file << "{" << std::endl;
-    *m_file << "    std::cout << \"Hello World!\\n\";" << std::endl;
-    *m_file << "    AutomationAPI::Session* mySession = AutomationAPI::Session::GetSession();" << std::endl;
-}
-
-void JournalFile::ProFormaStartJava()
-{
-    *m_file << "NIY Java" << std::endl;
-}
+#include "JournalFile.h"
+#include "JournalingTypes.h"
+#include "..\Core\PartFileIO.h"
+
+using namespace Journal;
+
+JournalFile::JournalFile(std::string fileName, JournalingLanguage jnlLang)
+	: m_journalFileName(fileName), m_jnlLang(jnlLang), m_journalContents()
+{
+	 
+}
+
+void JournalFile::WriteJournalFile()
+{
+	std::stringstream journalText;
+	ProFormaStart(journalText);
+	journalText << m_journalContents.str() << std::endl;
+	ProFormEnd(journalText);
+
+	// the future is not needed, the backend keeps the first failure for WaitForWrites
+	PartFileIO::GetBackend().WriteFileAsync(m_journalFileName, { journalText.str() });
+}
+
+JournalFile::~JournalFile()
+{
+}
+
+void JournalFile::NewLine()
+{
+    m_journalContents << std::endl;
+}
+
+void JournalFile::WriteToFile(std::string& contentToWrite)
+{
+    m_journalContents << contentToWrite;
+}
+
+void JournalFile::ProFormEnd(std::ostream& out)
+{
+    if (m_jnlLang == JournalingLanguage::CPP)
+    {
+        ProFormEndCPP(out);
+    }
+    else
+    {
+        ProFormEndJava(out);
+    }
+}
+
+void JournalFile::ProFormEndCPP(std::ostream& out)
+{
+    out << "}" << std::endl;
+}
+void JournalFile::ProFormEndJava(std::ostream& out)
+{
+    out << "NIY END" << std::endl;
+}
+
+void JournalFile::ProFormaStart(std::ostream& out)
+{
+    if (m_jnlLang == JournalingLanguage::CPP)
+    {
+        ProFormaStartCPP(out);
+    }
+    else
+    {
+        ProFormaStartJava(out);
+    }
+}
+
+void JournalFile::ProFormaStartCPP(std::ostream& out)
+{
+    //Write out include Files
+    out << "#include <iostream>" << std::endl;
+    out << "#include \"..\\AutomationBinding\\AutomationAPI_Session.h\"" << std::endl;
+    out << "#include \"..\\AutomationBinding\\AutomationAPI_Part.h\"" << std::endl;
+
+    out << preProForma.str() << std::endl;
+
+    out << "int main()" << std::endl;
+    out << "{" << std::endl;
+    out << "    std::cout << \"Hello World!\\n\";" << std::endl;
+    out << "    AutomationAPI::Session* mySession = AutomationAPI::Session::GetSession();" << std::endl;
+}
+
+void JournalFile::ProFormaStartJava(std::ostream& out)
+{
+    out << "NIY Java" << std::endl;
+}
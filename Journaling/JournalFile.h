@@ -1,33 +1,36 @@
-#pragma once
-#include <sstream>
-#include "JournalingTypes.h"
-namespace Journal
-{
-	class JournalFile
-	{
-	public:
-		JournalFile(std::string fileName, JournalingLanguage jnlLang);
-
-		virtual ~JournalFile();
-
-		void WriteJournalFile();
-
-		void WriteToFile(std::string& lineToWrite);
-		void NewLine();
-
-	private:
-		void ProFormaStart();
-		void ProFormaStartCPP();
-		void ProFormaStartJava();
-		void ProFormEnd();
-		void ProFormEndCPP();
-		void ProFormEndJava();
-
-		std::stringstream m_journalContents;
-		std::string m_journalFileName;
-		std::ofstream* m_file;
-		std::stringstream preProForma; // Include files for example
-		JournalingLanguage m_jnlLang;
-	};
-}
-
+#pragma once
+#include <sstream>
+#include "JournalingTypes.h"
+namespace Journal
+{
+	class JournalFile
+	{
+	public:
+		JournalFile(std::string fileName, JournalingLanguage jnlLang);
+
+		virtual ~JournalFile();
+
+		/// <summary>
+		/// Queues the journal to be written on the PartFileIO writer and returns at once.
+		/// A failed write is reported by PartFileIO::WaitForWrites, shutdownProduct calls it.
+		/// </summary>
+		void WriteJournalFile();
+
+		void WriteToFile(std::string& lineToWrite);
+		void NewLine();
+
+	private:
+		void ProFormaStart(std::ostream& out);
+		void ProFormaStartCPP(std::ostream& out);
+		void ProFormaStartJava(std::ostream& out);
+		void ProFormEnd(std::ostream& out);
+		void ProFormEndCPP(std::ostream& out);
+		void ProFormEndJava(std::ostream& out);
+
+		std::stringstream m_journalContents;
+		std::string m_journalFileName;
+		std::stringstream preProForma; // Include files for example
+		JournalingLanguage m_jnlLang;
+	};
+}
+
@@ -1,14 +1,14 @@
-#pragma once
-
-enum class CannedGlobals
-{
-	NOT_CANNED,
-	SESSION
-	
-};
-
-enum class JournalingLanguage
-{
-	CPP,
-	Java
-};
+#pragma once
+
+enum class CannedGlobals
+{
+	NOT_CANNED,
+	SESSION
+	
+};
+
+enum class JournalingLanguage
+{
+	CPP,
+	Java
+};
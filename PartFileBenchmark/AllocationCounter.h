@@ -0,0 +1,8 @@
+#pragma once
+#include <cstddef>
+
+/// <summary>
+/// Number of operator new calls made from this executable so far.
+/// Allocations made inside the product dlls are not seen here.
+/// </summary>
+size_t AllocationCount();
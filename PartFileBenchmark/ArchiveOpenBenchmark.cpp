@@ -0,0 +1,83 @@
+#include "ArchiveOpenBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <filesystem>
+#include <iostream>
+#include <vector>
+#include "..\AppPartOps\PartArchive.h"
+#include "..\AppPartOps\PartOps.h"
+
+static const int Repetitions = 3;
+
+int RunArchiveOpenBenchmark(const std::string& samplePartPath, size_t partCount)
+{
+	std::string looseDirectory = samplePartPath + ".loose";
+	std::string archivePath = samplePartPath + ".prtpak";
+
+	std::cout << "Archive open benchmark, " << partCount << " copies of " << samplePartPath << std::endl;
+	std::filesystem::remove_all(looseDirectory);
+	std::filesystem::create_directories(looseDirectory);
+
+	std::vector<std::string> loosePaths;
+	std::vector<std::string> archivedPaths;
+	std::string firstPartPath = (std::filesystem::path(looseDirectory) / "Part0.prt").string();
+	size_t partBytes = ScaleSamplePart(samplePartPath, firstPartPath, 1);
+	for (size_t i = 0; i < partCount; i++)
+	{
+		std::string partName = "Part" + std::to_string(i);
+		std::string partPath = (std::filesystem::path(looseDirectory) / (partName + ".prt")).string();
+		if (i != 0)
+		{
+			std::filesystem::copy_file(firstPartPath, partPath, std::filesystem::copy_options::overwrite_existing);
+		}
+		loosePaths.push_back(partPath);
+		archivedPaths.push_back(archivePath + "#" + partName);
+	}
+	size_t bytes = partBytes * partCount;
+
+	double packSeconds = BestOf(1, [&]() { Application::PartArchive::Pack(loosePaths, archivePath); });
+	std::cout << "    " << bytes << " bytes of parts, archive " << FileSizeInBytes(archivePath) << " bytes" << std::endl;
+	PrintResult("pack", packSeconds, bytes);
+
+	std::cout << "OpenPartFile of every part (console output discarded)" << std::endl;
+	double looseMappedSeconds = 0.0;
+	double archivedMappedSeconds = 0.0;
+	double looseLazySeconds = 0.0;
+	double archivedLazySeconds = 0.0;
+	{
+		ScopedSilenceCout silence;
+		looseMappedSeconds = BestOf(Repetitions, [&]() {
+			for (const std::string& partPath : loosePaths)
+			{
+				Application::PartFile::OpenPartFile(partPath, Application::PartFileReadMode::Mapped);
+			} });
+		archivedMappedSeconds = BestOf(Repetitions, [&]() {
+			// mapping the archive is part of the cost, once per run
+			Application::PartArchive::CloseArchives();
+			for (const std::string& partPath : archivedPaths)
+			{
+				Application::PartFile::OpenPartFile(partPath, Application::PartFileReadMode::Mapped);
+			} });
+		looseLazySeconds = BestOf(Repetitions, [&]() {
+			for (const std::string& partPath : loosePaths)
+			{
+				Application::PartFile::OpenPartFile(partPath, Application::PartFileReadMode::Lazy)->ClosePart();
+			} });
+		archivedLazySeconds = BestOf(Repetitions, [&]() {
+			Application::PartArchive::CloseArchives();
+			for (const std::string& partPath : archivedPaths)
+			{
+				Application::PartFile::OpenPartFile(partPath, Application::PartFileReadMode::Lazy)->ClosePart();
+			} });
+	}
+	PrintResult("loose .prt, Mapped", looseMappedSeconds, bytes);
+	PrintResult(".prtpak, Mapped", archivedMappedSeconds, bytes);
+	PrintResult("loose .prt, Lazy", looseLazySeconds, bytes);
+	PrintResult(".prtpak, Lazy", archivedLazySeconds, bytes);
+	std::cout << "    speedup mapped " << looseMappedSeconds / archivedMappedSeconds << "x, lazy "
+		<< looseLazySeconds / archivedLazySeconds << "x" << std::endl;
+
+	Application::PartArchive::CloseArchives();
+	std::filesystem::remove_all(looseDirectory);
+	std::filesystem::remove(archivePath);
+	return 0;
+}
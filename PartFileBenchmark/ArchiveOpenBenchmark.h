@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// Writes partCount copies of the sample part as loose .prt files and packs them into
+/// a part archive, then times OpenPartFile on every part, loose and from the archive,
+/// with the mapped and the lazy reader.
+/// </summary>
+int RunArchiveOpenBenchmark(const std::string& samplePartPath, size_t partCount);
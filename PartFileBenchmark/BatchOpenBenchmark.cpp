@@ -0,0 +1,86 @@
+#include "BatchOpenBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include "..\AppPartOps\PartOps.h"
+#include "..\Core\PartFileIO.h"
+
+static const int Repetitions = 3;
+
+int RunBatchOpenBenchmark(const std::string& samplePartPath, size_t partCount)
+{
+	std::string looseDirectory = samplePartPath + ".batch";
+
+	std::cout << "Batch open benchmark, " << partCount << " copies of " << samplePartPath << std::endl;
+	std::filesystem::remove_all(looseDirectory);
+	std::filesystem::create_directories(looseDirectory);
+
+	std::vector<std::string> partPaths;
+	std::string firstPartPath = (std::filesystem::path(looseDirectory) / "Part0.prt").string();
+	size_t partBytes = ScaleSamplePart(samplePartPath, firstPartPath, 1);
+	for (size_t i = 0; i < partCount; i++)
+	{
+		std::string partPath = (std::filesystem::path(looseDirectory) / ("Part" + std::to_string(i) + ".prt")).string();
+		if (i != 0)
+		{
+			std::filesystem::copy_file(firstPartPath, partPath, std::filesystem::copy_options::overwrite_existing);
+		}
+		partPaths.push_back(partPath);
+	}
+	size_t bytes = partBytes * partCount;
+	std::cout << "    " << bytes << " bytes of parts" << std::endl;
+
+	PartFileIO& completionPort = PartFileIO::GetCompletionPortBackend();
+	PartFileIO& threadPool = PartFileIO::GetThreadPoolBackend();
+
+	std::cout << "Opening every part Mapped (console output discarded)" << std::endl;
+	double oneByOneSeconds = 0.0;
+	double threadPoolSeconds = 0.0;
+	double completionPortSeconds = 0.0;
+	{
+		ScopedSilenceCout silence;
+		oneByOneSeconds = BestOf(Repetitions, [&]() {
+			for (const std::string& partPath : partPaths)
+			{
+				Application::PartFile::OpenPartFile(partPath, Application::PartFileReadMode::Mapped);
+			} });
+		PartFileIO::SetBackend(&threadPool);
+		threadPoolSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFiles(partPaths, Application::PartFileReadMode::Mapped); });
+		PartFileIO::SetBackend(&completionPort);
+		completionPortSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFiles(partPaths, Application::PartFileReadMode::Mapped); });
+		PartFileIO::SetBackend(nullptr);
+	}
+	PrintResult("OpenPartFile one by one, mapped", oneByOneSeconds, bytes);
+	PrintResult("OpenPartFiles, thread pool backend", threadPoolSeconds, bytes);
+	PrintResult("OpenPartFiles, completion port backend", completionPortSeconds, bytes);
+
+	std::ifstream firstPart(firstPartPath, std::ios::binary);
+	std::string partText((std::istreambuf_iterator<char>(firstPart)), std::istreambuf_iterator<char>());
+	firstPart.close();
+
+	std::cout << "Writing every part back" << std::endl;
+	double writeNowSeconds = BestOf(Repetitions, [&]() {
+		for (const std::string& partPath : partPaths)
+		{
+			completionPort.WriteFileNow(partPath, { partText });
+		} });
+	double queueSeconds = 0.0;
+	double landedSeconds = BestOf(Repetitions, [&]() {
+		queueSeconds = BestOf(1, [&]() {
+			for (const std::string& partPath : partPaths)
+			{
+				completionPort.WriteFileAsync(partPath, { partText });
+			} });
+		completionPort.WaitForWrites(); });
+	PrintResult("WriteFileNow one by one", writeNowSeconds, bytes);
+	PrintResult("WriteFileAsync, caller blocked", queueSeconds, bytes);
+	PrintResult("WriteFileAsync, until landed", landedSeconds, bytes);
+
+	std::filesystem::remove_all(looseDirectory);
+	return 0;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// Opening partCount loose copies of the sample part one OpenPartFile at a time vs
+/// OpenPartFiles on each PartFileIO backend, then writing them back one at a time
+/// vs queued on the backend's writer.
+/// </summary>
+int RunBatchOpenBenchmark(const std::string& samplePartPath, size_t partCount);
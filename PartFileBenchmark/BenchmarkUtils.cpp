@@ -0,0 +1,81 @@
+#include "BenchmarkUtils.h"
+#include <fstream>
+#include <vector>
+#include <iomanip>
+#include "..\Core\StringUtils.h"
+
+
+size_t ScaleSamplePart(const std::string& samplePartPath, const std::string& scaledPartPath, size_t scale)
+{
+	std::ifstream sample(samplePartPath);
+	if (!sample.is_open())
+	{
+		throw std::exception(("Unable to open sample part " + samplePartPath).c_str());
+	}
+
+	std::vector<std::string> header;
+	std::vector<std::string> features;
+	std::string line;
+	while (getline(sample, line))
+	{
+		if (features.empty() && !startsWith(line, "Feature:") && !startsWith(line, "RoutingFeature:"))
+		{
+			header.push_back(line);
+		}
+		else
+		{
+			features.push_back(line);
+		}
+	}
+
+	// Written as binary with \r\n so the result matches a part saved on Windows
+	std::ofstream scaled(scaledPartPath, std::ios::binary | std::ios::trunc);
+	for (const std::string& headerLine : header)
+	{
+		scaled << headerLine << "\r\n";
+	}
+
+	int guid = 1;
+	for (size_t copy = 0; copy < scale; copy++)
+	{
+		for (const std::string& featureLine : features)
+		{
+			size_t guidPos = featureLine.find("_Guid:");
+			if (guidPos != std::string::npos)
+			{
+				scaled << featureLine.substr(0, guidPos + 6) << guid++ << "\r\n";
+			}
+			else
+			{
+				scaled << featureLine << "\r\n";
+			}
+		}
+	}
+	scaled.close();
+
+	return FileSizeInBytes(scaledPartPath);
+}
+
+size_t FileSizeInBytes(const std::string& filePath)
+{
+	std::ifstream file(filePath, std::ios::binary | std::ios::ate);
+	return file.is_open() ? (size_t)file.tellg() : 0;
+}
+
+ScopedSilenceCout::ScopedSilenceCout()
+{
+	m_previousBuffer = std::cout.rdbuf(&m_nullBuffer);
+}
+
+ScopedSilenceCout::~ScopedSilenceCout()
+{
+	std::cout.rdbuf(m_previousBuffer);
+}
+
+void PrintResult(const std::string& label, double seconds, size_t bytes)
+{
+	double megabytes = bytes / (1024.0 * 1024.0);
+	std::cout << "    " << std::left << std::setw(28) << label
+		<< std::right << std::fixed << std::setprecision(3) << std::setw(10) << seconds << " s"
+		<< std::setw(12) << std::setprecision(1) << (megabytes / seconds) << " MB/s" << std::endl;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <chrono>
+#include <iostream>
+
+/// <summary>
+/// Writes a copy of samplePartPath with its features repeated scale times.
+/// Every *_Guid: line gets a fresh value so the copies stay distinct.
+/// Returns the number of bytes written.
+/// </summary>
+size_t ScaleSamplePart(const std::string& samplePartPath, const std::string& scaledPartPath, size_t scale);
+
+size_t FileSizeInBytes(const std::string& filePath);
+
+/// <summary>
+/// The readers and observers print as they go, swallow std::cout while
+/// timing so we measure parsing rather than the console.
+/// </summary>
+class ScopedSilenceCout
+{
+public:
+	ScopedSilenceCout();
+	~ScopedSilenceCout();
+
+private:
+	class NullBuffer : public std::streambuf
+	{
+	protected:
+		int overflow(int c) override
+		{
+			return c;
+		}
+	};
+
+	NullBuffer m_nullBuffer;
+	std::streambuf* m_previousBuffer;
+};
+
+/// <summary>
+/// Runs func repetitions times and returns the fastest run in seconds.
+/// </summary>
+template <typename Func>
+double BestOf(int repetitions, Func func)
+{
+	double best = 0.0;
+	for (int i = 0; i < repetitions; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+		func();
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+		if (i == 0 || elapsed.count() < best)
+		{
+			best = elapsed.count();
+		}
+	}
+	return best;
+}
+
+void PrintResult(const std::string& label, double seconds, size_t bytes);
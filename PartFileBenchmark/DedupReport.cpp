@@ -0,0 +1,150 @@
+#include "DedupReport.h"
+#include "BenchmarkUtils.h"
+#include <cstdio>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+#include "..\Core\FeatureContentStore.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\AppLibrary\Block.h"
+#include "..\AppLibrary\Extrude.h"
+#include "..\AppPartOps\PartFileConverter.h"
+
+static double Ratio(uint64_t total, uint64_t unique)
+{
+	return (unique == 0) ? 0.0 : (double)total / unique;
+}
+
+static double Megabytes(uint64_t bytes)
+{
+	return bytes / (1024.0 * 1024.0);
+}
+
+// The shared payload behind a feature, nullptr for the types that do not share one
+static const void* GetSharedPayload(GuidObject* feature)
+{
+	Application::Block* block = dynamic_cast<Application::Block*>(feature);
+	if (block != nullptr)
+	{
+		return block->GetFields();
+	}
+	Application::Extrude* extrude = dynamic_cast<Application::Extrude*>(feature);
+	if (extrude != nullptr)
+	{
+		return extrude->GetFields();
+	}
+	return nullptr;
+}
+
+int RunDedupReport(const std::string& archiveDirectory)
+{
+	std::cout << "Feature dedup report, " << archiveDirectory << std::endl;
+
+	FeatureContentStore& store = FeatureContentStore::GetInstance();
+	std::vector<FeatureContentStatistics> before = store.GetStatistics();
+
+	std::vector<GuidObject*> session;
+	std::unordered_set<const void*> seenPayloads;
+	size_t partCount = 0;
+	size_t failedCount = 0;
+	uint64_t featureCount = 0;
+	uint64_t featureTextBytes = 0;
+	uint64_t uniqueFeatureTextBytes = 0;
+	uint64_t convertedTextBytes = 0;
+	uint64_t binaryBytes = 0;
+	std::string binaryPartPath = (std::filesystem::temp_directory_path() / "DedupReport.prtb").string();
+	{
+		ScopedSilenceCout silence;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(archiveDirectory,
+			std::filesystem::directory_options::skip_permission_denied))
+		{
+			if (!entry.is_regular_file() || entry.path().extension() != ".prt")
+			{
+				continue;
+			}
+
+			std::string partPath = entry.path().string();
+			try
+			{
+				MappedFile mappedFile(partPath);
+				if (!mappedFile.IsOpen())
+				{
+					failedCount++;
+					continue;
+				}
+
+				PartFileLayout layout = ScanPartFileLayout(mappedFile.Data(), mappedFile.Size());
+				for (const FeatureSpan& span : layout.features)
+				{
+					GuidObject* feature = nullptr;
+					if (!span.isRoutingFeature)
+					{
+						PartFileTokenizer tokenizer(mappedFile.Data() + span.bodyBegin, span.end - span.bodyBegin);
+						feature = ProcessFeature(span.featureType, tokenizer);
+					}
+					if (feature != nullptr)
+					{
+						session.push_back(feature);
+					}
+
+					// the first feature with a payload keeps its text, the copies after it would only need a reference
+					const void* payload = GetSharedPayload(feature);
+					if (payload == nullptr || seenPayloads.insert(payload).second)
+					{
+						uniqueFeatureTextBytes += span.end - span.begin;
+					}
+					featureTextBytes += span.end - span.begin;
+					featureCount++;
+				}
+				partCount++;
+
+				ConvertTextPartToBinary(partPath, binaryPartPath);
+				convertedTextBytes += mappedFile.Size();
+				binaryBytes += FileSizeInBytes(binaryPartPath);
+			}
+			catch (std::exception&)
+			{
+				failedCount++;
+			}
+		}
+	}
+	std::remove(binaryPartPath.c_str());
+
+	std::cout << "    " << partCount << " parts, " << featureCount << " features, " << failedCount << " parts could not be read" << std::endl;
+	std::cout << std::fixed << std::setprecision(1);
+
+	uint64_t unsharedBytes = 0;
+	uint64_t sharedBytes = 0;
+	std::vector<FeatureContentStatistics> after = store.GetStatistics();
+	for (size_t kind = 0; kind < after.size(); kind++)
+	{
+		// the store counts since the process started, only what this report read is shown
+		uint64_t references = after[kind].references - ((kind < before.size()) ? before[kind].references : 0);
+		uint64_t payloads = after[kind].payloads - ((kind < before.size()) ? before[kind].payloads : 0);
+		uint64_t payloadSize = (after[kind].payloads == 0) ? 0 : after[kind].payloadBytes / after[kind].payloads;
+		unsharedBytes += references * payloadSize;
+		sharedBytes += payloads * payloadSize + references * sizeof(void*);
+
+		std::cout << "    " << std::left << std::setw(10) << after[kind].featureType << std::right
+			<< std::setw(12) << references << " features" << std::setw(10) << payloads << " payloads"
+			<< std::setw(10) << Ratio(references, payloads) << "x" << std::endl;
+	}
+
+	std::cout << "    fields in memory          " << Megabytes(unsharedBytes) << " MB unshared, "
+		<< Megabytes(sharedBytes) << " MB shared with a pointer each" << std::endl;
+	std::cout << "    feature text on disk      " << Megabytes(featureTextBytes) << " MB, "
+		<< Megabytes(uniqueFeatureTextBytes) << " MB of distinct content, "
+		<< Ratio(featureTextBytes, uniqueFeatureTextBytes) << "x" << std::endl;
+	std::cout << "    as binary parts (.prtb)   " << Megabytes(convertedTextBytes) << " MB of text, "
+		<< Megabytes(binaryBytes) << " MB with shared records, " << Ratio(convertedTextBytes, binaryBytes) << "x" << std::endl;
+
+	for (GuidObject* feature : session)
+	{
+		delete feature;
+	}
+	return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// Reads every text part (.prt) under archiveDirectory into memory, the way a session
+/// holding them all would, and reports how far the FeatureContentStore shares their
+/// Block and Extrude payloads: payloads per feature type, bytes held with and without
+/// sharing, and how much of the archive's feature text is repeated content.  Also
+/// converts each part to a binary part (.prtb), which stores equal records once.
+/// </summary>
+int RunDedupReport(const std::string& archiveDirectory);
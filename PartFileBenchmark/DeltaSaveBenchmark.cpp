@@ -0,0 +1,73 @@
+#include "DeltaSaveBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <cstdio>
+#include <vector>
+#include <iostream>
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\PartDeltaLog.h"
+#include "..\AppLibrary\Extrude.h"
+
+static const int Repetitions = 3;
+
+// Scaled guids start at 1, these sit well past them
+static const int FirstEditGuid = 900000000;
+
+static void MarkEdits(Application::PartFile* partFile, std::vector<Application::Extrude*>& edits, size_t editCount)
+{
+	for (size_t i = 0; i < editCount; i++)
+	{
+		if (i == edits.size())
+		{
+			edits.push_back(Application::Extrude::FromText("2", "Face1", "Vector1", "True", "False", FirstEditGuid + (int)i));
+		}
+		partFile->AddFeature(edits[i]);
+	}
+}
+
+int RunDeltaSaveBenchmark(const std::string& samplePartPath, size_t scale)
+{
+	std::string scaledPartPath = samplePartPath + ".scaled.prt";
+	std::string deltaLogPath = Application::PartDeltaLog::GetDeltaLogPath(scaledPartPath);
+
+	std::cout << "Delta save benchmark, " << samplePartPath << " scaled " << scale << "x" << std::endl;
+	size_t bytes = ScaleSamplePart(samplePartPath, scaledPartPath, scale);
+	std::remove(deltaLogPath.c_str());
+	std::cout << "    " << bytes << " bytes" << std::endl;
+
+	std::vector<size_t> editCounts = { 1, 100, 10000 };
+	std::vector<double> deltaSeconds;
+	double fullSeconds = 0.0;
+	std::vector<Application::Extrude*> edits;
+	{
+		ScopedSilenceCout silence;
+		Application::PartFile* partFile = Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Lazy);
+		// keep compaction out of the delta timings
+		partFile->SetCompactionRatio(1000.0);
+
+		for (size_t editCount : editCounts)
+		{
+			deltaSeconds.push_back(BestOf(Repetitions, [&]() {
+				MarkEdits(partFile, edits, editCount);
+				partFile->SavePart(Application::PartSaveMode::Delta); }));
+		}
+
+		fullSeconds = BestOf(Repetitions, [&]() {
+			MarkEdits(partFile, edits, 1);
+			partFile->SavePart(Application::PartSaveMode::Full); });
+		delete partFile;
+	}
+
+	for (size_t i = 0; i < editCounts.size(); i++)
+	{
+		std::cout << "    PartSaveMode::Delta " << editCounts[i] << " features " << deltaSeconds[i] * 1000.0 << " ms" << std::endl;
+	}
+	std::cout << "    PartSaveMode::Full 1 feature " << fullSeconds * 1000.0 << " ms" << std::endl;
+
+	for (Application::Extrude* edit : edits)
+	{
+		delete edit;
+	}
+	std::remove(deltaLogPath.c_str());
+	std::remove(scaledPartPath.c_str());
+	return 0;
+}
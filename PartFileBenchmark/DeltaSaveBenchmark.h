@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// SavePart latency against edit size on the scaled sample part, delta
+/// appends of a few features against a full save that compacts the part.
+/// </summary>
+int RunDeltaSaveBenchmark(const std::string& samplePartPath, size_t scale);
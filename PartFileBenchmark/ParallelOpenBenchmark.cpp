@@ -0,0 +1,48 @@
+#include "ParallelOpenBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <cstdio>
+#include <iostream>
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileLayout.h"
+#include "..\Core\ThreadPool.h"
+#include "..\AppPartOps\PartOps.h"
+
+static const int Repetitions = 3;
+
+int RunParallelOpenBenchmark(const std::string& samplePartPath, size_t scale)
+{
+	std::string scaledPartPath = samplePartPath + ".scaled.prt";
+
+	std::cout << "Parallel open benchmark, " << samplePartPath << " scaled " << scale << "x, "
+		<< ThreadPool::GetInstance().GetThreadCount() << " threads" << std::endl;
+	size_t bytes = ScaleSamplePart(samplePartPath, scaledPartPath, scale);
+
+	size_t featureCount = 0;
+	double scanSeconds = BestOf(Repetitions, [&]() {
+		MappedFile mappedFile(scaledPartPath);
+		featureCount = ScanPartFileLayout(mappedFile.Data(), mappedFile.Size()).features.size(); });
+	std::cout << "    " << bytes << " bytes, " << featureCount << " features" << std::endl;
+	PrintResult("boundary scan", scanSeconds, bytes);
+
+	std::cout << "OpenPartFile (console output discarded)" << std::endl;
+	double mappedOpenSeconds = 0.0;
+	double parallelOpenSeconds = 0.0;
+	double lazyOpenSeconds = 0.0;
+	{
+		ScopedSilenceCout silence;
+		mappedOpenSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Mapped); });
+		parallelOpenSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Parallel); });
+		lazyOpenSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Lazy)->ClosePart(); });
+	}
+	PrintResult("PartFileReadMode::Mapped", mappedOpenSeconds, bytes);
+	PrintResult("PartFileReadMode::Parallel", parallelOpenSeconds, bytes);
+	PrintResult("PartFileReadMode::Lazy", lazyOpenSeconds, bytes);
+	std::cout << "    speedup parallel " << mappedOpenSeconds / parallelOpenSeconds << "x, lazy "
+		<< mappedOpenSeconds / lazyOpenSeconds << "x" << std::endl;
+
+	std::remove(scaledPartPath.c_str());
+	return 0;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// Times the boundary scan on its own, then OpenPartFile with the sequential
+/// mapped reader against the parallel and lazy readers on the scaled sample part.
+/// </summary>
+int RunParallelOpenBenchmark(const std::string& samplePartPath, size_t scale);
@@ -0,0 +1,49 @@
+#include "ParseCacheBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <cstdio>
+#include <iostream>
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\PartParseCache.h"
+
+static const int Repetitions = 3;
+
+int RunParseCacheBenchmark(const std::string& samplePartPath, size_t scale)
+{
+	std::string scaledPartPath = samplePartPath + ".scaled.prt";
+	std::string cacheDirectory = samplePartPath + ".parsecache";
+
+	std::cout << "Parse cache benchmark, " << samplePartPath << " scaled " << scale << "x" << std::endl;
+	size_t bytes = ScaleSamplePart(samplePartPath, scaledPartPath, scale);
+	std::cout << "    " << bytes << " bytes" << std::endl;
+
+	Application::PartParseCache& cache = Application::PartParseCache::GetInstance();
+	double uncachedSeconds = 0.0;
+	double coldSeconds = 0.0;
+	double warmSeconds = 0.0;
+	{
+		ScopedSilenceCout silence;
+		uncachedSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Mapped); });
+
+		cache.SetCacheDirectory(cacheDirectory);
+		cache.ResetStatistics();
+		coldSeconds = BestOf(Repetitions, [&]() {
+			cache.Clear();
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Mapped); });
+		warmSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Mapped); });
+	}
+	PrintResult("no cache", uncachedSeconds, bytes);
+	PrintResult("cold cache (parse + store)", coldSeconds, bytes);
+	PrintResult("warm cache (load)", warmSeconds, bytes);
+
+	Application::PartParseCacheStatistics statistics = cache.GetStatistics();
+	std::cout << "    hits " << statistics.hits << ", misses " << statistics.misses << ", stores " << statistics.stores
+		<< ", evictions " << statistics.evictions << std::endl;
+	std::cout << "    speedup warm " << uncachedSeconds / warmSeconds << "x" << std::endl;
+
+	cache.Clear();
+	cache.SetCacheDirectory("");
+	std::remove(scaledPartPath.c_str());
+	return 0;
+}
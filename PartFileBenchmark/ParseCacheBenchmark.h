@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// OpenPartFile on the scaled sample part without the parse cache, on a
+/// cold cache (parse and store) and on a warm cache (load only).
+/// </summary>
+int RunParseCacheBenchmark(const std::string& samplePartPath, size_t scale);
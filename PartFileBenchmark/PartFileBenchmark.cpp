@@ -0,0 +1,116 @@
+// PartFileBenchmark.cpp : Timings for the part file readers and writers.
+//
+
+#include <iostream>
+#include <string>
+#include "..\Core\Core.h"
+#include "..\Core\CoreUtils.h"
+#include "TokenizerBenchmark.h"
+#include "ParallelOpenBenchmark.h"
+#include "DeltaSaveBenchmark.h"
+#include "ParseCacheBenchmark.h"
+#include "ScannerBenchmark.h"
+#include "SaveBenchmark.h"
+#include "DedupReport.h"
+#include "ArchiveOpenBenchmark.h"
+#include "SharedCacheBenchmark.h"
+#include "BatchOpenBenchmark.h"
+#include "WriteBehindBenchmark.h"
+#include "..\AppPartOps\PartSaveQueue.h"
+
+static void Usage()
+{
+	std::cout << "Usage: PartFileBenchmark <benchmark> [samplePart] [scale]" << std::endl;
+	std::cout << "    tokenizer    ifstream reader vs memory mapped tokenizer" << std::endl;
+	std::cout << "    parallel     sequential mapped open vs thread pool open vs lazy open" << std::endl;
+	std::cout << "    deltasave    SavePart delta appends by edit size vs a full compacting save" << std::endl;
+	std::cout << "    parsecache   mapped open without, cold and warm parse cache" << std::endl;
+	std::cout << "    scanner      GB/s finding lines and keys, getline vs tokenizer vs SIMD scanner" << std::endl;
+	std::cout << "    save         full saves of 10^3 features up to scale features, serial and parallel PartFileWriter vs ofstream, and verifying the checksums" << std::endl;
+	std::cout << "    archive      opening scale loose parts (10000 by default) vs the same parts packed in a .prtpak archive" << std::endl;
+	std::cout << "    sharedcache  parallel open vs cold and warm shared memory part cache" << std::endl;
+	std::cout << "    batchopen    opening scale loose parts (10000 by default) one by one vs batched on each I/O backend, and queued writes" << std::endl;
+	std::cout << "    writebehind  scale saves (1000 by default) of a few parts, each written by SavePart vs queued and coalesced" << std::endl;
+	std::cout << "    dedup        shared Block and Extrude payloads across every part under samplePart, a directory" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		Usage();
+		return 1;
+	}
+
+	std::string benchmark = argv[1];
+	std::string samplePartPath = (argc > 2) ? argv[2] : BasePath() + "\\SampleVersionUp.prt";
+	size_t scale = (argc > 3) ? std::stoul(argv[3]) : 100000;
+
+	initializeProduct();
+
+	int retVal = 0;
+	try
+	{
+		if (benchmark == "tokenizer")
+		{
+			retVal = RunTokenizerBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "parallel")
+		{
+			retVal = RunParallelOpenBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "deltasave")
+		{
+			retVal = RunDeltaSaveBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "parsecache")
+		{
+			retVal = RunParseCacheBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "scanner")
+		{
+			retVal = RunScannerBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "save")
+		{
+			retVal = RunSaveBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "archive")
+		{
+			retVal = RunArchiveOpenBenchmark(samplePartPath, (argc > 3) ? scale : 10000);
+		}
+		else if (benchmark == "sharedcache")
+		{
+			retVal = RunSharedCacheBenchmark(samplePartPath, scale);
+		}
+		else if (benchmark == "batchopen")
+		{
+			retVal = RunBatchOpenBenchmark(samplePartPath, (argc > 3) ? scale : 10000);
+		}
+		else if (benchmark == "writebehind")
+		{
+			retVal = RunWriteBehindBenchmark(samplePartPath, (argc > 3) ? scale : 1000);
+		}
+		else if (benchmark == "dedup")
+		{
+			retVal = RunDedupReport((argc > 2) ? argv[2] : BasePath());
+		}
+		else
+		{
+			Usage();
+			retVal = 1;
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::cout << "Benchmark failed: " << e.what() << std::endl;
+		retVal = 1;
+	}
+
+	Application::PartSaveQueue::GetInstance().Shutdown();
+	if (shutdownProduct() != 0)
+	{
+		retVal = 1;
+	}
+	return retVal;
+}
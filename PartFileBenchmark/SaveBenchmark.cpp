@@ -0,0 +1,115 @@
+#include "SaveBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <cstdio>
+#include <fstream>
+#include <vector>
+#include <iostream>
+#include "..\AppPartOps\PartFileWriter.h"
+#include "..\AppLibrary\Block.h"
+#include "..\AppLibrary\Extrude.h"
+#include "..\Core\Crc32C.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileIntegrity.h"
+
+static const int Repetitions = 3;
+
+// Half extrudes and half blocks, Wire saves through the same IPartFileWritable call but lives in the demand loaded library
+static std::vector<GuidObject*> MakeFeatures(size_t featureCount)
+{
+	std::vector<GuidObject*> features;
+	features.reserve(featureCount);
+	for (size_t i = 0; i < featureCount; i++)
+	{
+		int guid = (int)i + 1;
+		if (i % 2 == 0)
+		{
+			features.push_back(Application::Extrude::FromText("12.5", "Face1", "Vector1", "True", "False", guid));
+		}
+		else
+		{
+			features.push_back(Application::Block::FromText("0,0,0", "100", "50.25", "10", guid));
+		}
+	}
+	return features;
+}
+
+static size_t SaveWithPartFileWriter(const std::vector<GuidObject*>& features, const std::string& savePath, size_t& growCount)
+{
+	Application::PartFileWriter writer(64 + features.size() * Application::PartFileWriter::TypicalFeatureBytes);
+	writer.AddHeader("SaveBenchmark", "12");
+	for (GuidObject* feature : features)
+	{
+		writer.AddFeature(feature);
+	}
+	writer.AddChecksumFooter();
+	writer.Write(savePath);
+	growCount = writer.GetGrowCount();
+	return writer.GetSize();
+}
+
+static size_t SaveWithParallelPartFileWriter(const std::vector<GuidObject*>& features, const std::string& savePath)
+{
+	Application::PartFileWriter writer(64);
+	writer.AddHeader("SaveBenchmark", "12");
+	writer.AddFeatures(features);
+	writer.AddChecksumFooter();
+	writer.Write(savePath);
+	return writer.GetSize();
+}
+
+static size_t SaveWithOfstream(const std::vector<GuidObject*>& features, const std::string& savePath)
+{
+	size_t bytes = 0;
+	std::ofstream partFile(savePath, std::ios::binary | std::ios::trunc);
+	partFile << "PartFileName:SaveBenchmark\nSchemaVersion:12\n";
+	for (GuidObject* feature : features)
+	{
+		std::string featureText;
+		dynamic_cast<IPartFileWritable*>(feature)->WriteFeature(featureText);
+		partFile << featureText;
+		bytes += featureText.size();
+	}
+	partFile.flush();
+	return bytes;
+}
+
+int RunSaveBenchmark(const std::string& samplePartPath, size_t maxFeatureCount)
+{
+	std::string savePath = samplePartPath + ".save.prt";
+
+	std::cout << "Save benchmark, up to " << maxFeatureCount << " features" << std::endl;
+
+	for (size_t featureCount = 1000; featureCount <= maxFeatureCount; featureCount *= 10)
+	{
+		std::vector<GuidObject*> features = MakeFeatures(featureCount);
+
+		size_t bytes = 0;
+		size_t growCount = 0;
+		double writerSeconds = BestOf(Repetitions, [&]() { bytes = SaveWithPartFileWriter(features, savePath, growCount); });
+		double parallelSeconds = BestOf(Repetitions, [&]() { SaveWithParallelPartFileWriter(features, savePath); });
+
+		// what every open of the saved part pays for its checksums
+		double verifySeconds = 0;
+		{
+			MappedFile savedPart(savePath);
+			verifySeconds = BestOf(Repetitions, [&]() { VerifyPartFileIntegrity(savedPart.Data(), savedPart.Size()); });
+		}
+		double ofstreamSeconds = BestOf(Repetitions, [&]() { SaveWithOfstream(features, savePath); });
+
+		std::cout << "    " << featureCount << " features, " << bytes << " bytes, buffer grew " << growCount << " times" << std::endl;
+		PrintResult("PartFileWriter (atomic)", writerSeconds, bytes);
+		PrintResult("PartFileWriter parallel", parallelSeconds, bytes);
+		PrintResult(Crc32CIsHardwareAccelerated() ? "verify checksums (SSE4.2)" : "verify checksums (table)", verifySeconds, bytes);
+		PrintResult("string per feature + ofstream", ofstreamSeconds, bytes);
+		std::cout << "    " << (featureCount / writerSeconds) << " features/s, "
+			<< (featureCount / parallelSeconds) << " features/s parallel" << std::endl;
+
+		for (GuidObject* feature : features)
+		{
+			delete feature;
+		}
+	}
+
+	std::remove(savePath.c_str());
+	return 0;
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// Full saves of in-memory parts of 10^3 features up to maxFeatureCount (10^6 gives
+/// the whole range), through the PartFileWriter one feature at a time and on the
+/// ThreadPool, and through a per feature string and std::ofstream, the way parts
+/// used to be written.
+/// </summary>
+int RunSaveBenchmark(const std::string& samplePartPath, size_t maxFeatureCount);
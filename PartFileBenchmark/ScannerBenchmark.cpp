@@ -0,0 +1,109 @@
+#include "ScannerBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <fstream>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\Core\PartFileLineScanner.h"
+
+static const int Repetitions = 5;
+
+// Every loop sums the key lengths so none of them can be optimized away and all must agree
+static size_t GetlineKeyLoop(const std::string& partPath)
+{
+	size_t keyBytes = 0;
+	std::string line;
+	std::ifstream partFile(partPath);
+	while (getline(partFile, line))
+	{
+		size_t colon = line.find(':');
+		if (colon != std::string::npos)
+		{
+			keyBytes += colon + 1;
+		}
+	}
+	return keyBytes;
+}
+
+static size_t TokenizerKeyLoop(const MappedFile& mappedFile)
+{
+	size_t keyBytes = 0;
+	std::string_view line;
+	PartFileTokenizer tokenizer(mappedFile.Data(), mappedFile.Size());
+	while (tokenizer.NextLine(line))
+	{
+		size_t colon = line.find(':');
+		if (colon != std::string_view::npos)
+		{
+			keyBytes += colon + 1;
+		}
+	}
+	return keyBytes;
+}
+
+static size_t ScannerKeyLoop(const MappedFile& mappedFile, PartFileScannerKind kind)
+{
+	size_t keyBytes = 0;
+	PartFileLine line;
+	PartFileLineScanner scanner(mappedFile.Data(), mappedFile.Size(), kind);
+	while (scanner.Next(line))
+	{
+		keyBytes += line.keyLength;
+	}
+	return keyBytes;
+}
+
+static void PrintGigabytesPerSecond(const std::string& label, double seconds, size_t bytes)
+{
+	std::cout << "    " << std::left << std::setw(28) << label
+		<< std::right << std::fixed << std::setprecision(4) << std::setw(10) << seconds << " s"
+		<< std::setw(10) << std::setprecision(2) << (bytes / seconds / 1.0e9) << " GB/s" << std::endl;
+}
+
+int RunScannerBenchmark(const std::string& samplePartPath, size_t scale)
+{
+	std::string scaledPartPath = samplePartPath + ".scaled.prt";
+
+	std::cout << "Scanner benchmark, " << samplePartPath << " scaled " << scale << "x" << std::endl;
+	size_t bytes = ScaleSamplePart(samplePartPath, scaledPartPath, scale);
+	std::cout << "    " << bytes << " bytes, best scanner "
+		<< PartFileLineScanner::GetKindName(PartFileLineScanner::GetBestKind()) << std::endl;
+
+	size_t expectedKeyBytes = GetlineKeyLoop(scaledPartPath);
+	double getlineSeconds = BestOf(Repetitions, [&]() { GetlineKeyLoop(scaledPartPath); });
+	PrintGigabytesPerSecond("ifstream + getline", getlineSeconds, bytes);
+
+	int retVal = 0;
+	{
+		// mapped once and touched by the first pass, the rest measure the scan and not the disk
+		MappedFile mappedFile(scaledPartPath);
+		TokenizerKeyLoop(mappedFile);
+
+		double tokenizerSeconds = BestOf(Repetitions, [&]() { TokenizerKeyLoop(mappedFile); });
+		PrintGigabytesPerSecond("PartFileTokenizer", tokenizerSeconds, bytes);
+
+		for (PartFileScannerKind kind : { PartFileScannerKind::Scalar, PartFileScannerKind::SSE2, PartFileScannerKind::AVX2 })
+		{
+			std::string label = std::string("PartFileLineScanner ") + PartFileLineScanner::GetKindName(kind);
+			if (!PartFileLineScanner::IsSupported(kind))
+			{
+				std::cout << "    " << label << " not supported on this processor" << std::endl;
+				continue;
+			}
+
+			if (ScannerKeyLoop(mappedFile, kind) != expectedKeyBytes)
+			{
+				std::cout << "    " << label << " disagrees with getline" << std::endl;
+				retVal = 1;
+			}
+			double scannerSeconds = BestOf(Repetitions, [&]() { ScannerKeyLoop(mappedFile, kind); });
+			PrintGigabytesPerSecond(label, scannerSeconds, bytes);
+			std::cout << "        " << std::setprecision(1) << getlineSeconds / scannerSeconds << "x getline" << std::endl;
+		}
+	}
+
+	std::remove(scaledPartPath.c_str());
+	return retVal;
+}
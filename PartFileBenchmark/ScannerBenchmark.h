@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// GB/s of finding every line and key separator in SampleVersionUp.prt scaled up by
+/// scale: the getline loop, the tokenizer, and each PartFileLineScanner kernel.
+/// </summary>
+int RunScannerBenchmark(const std::string& samplePartPath, size_t scale);
@@ -0,0 +1,50 @@
+#include "SharedCacheBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <cstdio>
+#include <iostream>
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\SharedPartCache.h"
+
+static const int Repetitions = 3;
+
+int RunSharedCacheBenchmark(const std::string& samplePartPath, size_t scale)
+{
+	std::string scaledPartPath = samplePartPath + ".scaled.prt";
+
+	std::cout << "Shared part cache benchmark, " << samplePartPath << " scaled " << scale << "x" << std::endl;
+	size_t bytes = ScaleSamplePart(samplePartPath, scaledPartPath, scale);
+	std::cout << "    " << bytes << " bytes" << std::endl;
+
+	// a segment of its own, so other processes' entries do not turn the cold runs warm
+	std::string segmentName = std::string(Application::SharedPartCache::DefaultSegmentName) + ".Benchmark";
+	Application::SharedPartCache& cache = Application::SharedPartCache::GetInstance();
+	double parallelSeconds = 0.0;
+	double coldSeconds = 0.0;
+	double warmSeconds = 0.0;
+	{
+		ScopedSilenceCout silence;
+		parallelSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Parallel); });
+
+		coldSeconds = BestOf(Repetitions, [&]() {
+			// closing the only mapping drops the segment and its entries
+			cache.Close();
+			cache.Open(segmentName);
+			delete Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Shared); });
+		cache.ResetStatistics();
+		warmSeconds = BestOf(Repetitions, [&]() {
+			delete Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Shared); });
+	}
+	PrintResult("parallel, no cache", parallelSeconds, bytes);
+	PrintResult("cold shared cache (parse + publish)", coldSeconds, bytes);
+	PrintResult("warm shared cache (view)", warmSeconds, bytes);
+
+	Application::SharedPartCacheStatistics statistics = cache.GetStatistics();
+	std::cout << "    warm hits " << statistics.hits << ", misses " << statistics.misses << ", entries " << statistics.entryCount
+		<< " holding " << statistics.entryBytes << " bytes" << std::endl;
+	std::cout << "    speedup warm " << parallelSeconds / warmSeconds << "x" << std::endl;
+
+	cache.Close();
+	std::remove(scaledPartPath.c_str());
+	return 0;
+}
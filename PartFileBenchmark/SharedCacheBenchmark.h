@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// OpenPartFile on the scaled sample part with the parallel reader, then with the
+/// shared part cache cold (parse and publish) and warm (a view over the entry, as
+/// every process after the first would get).
+/// </summary>
+int RunSharedCacheBenchmark(const std::string& samplePartPath, size_t scale);
@@ -0,0 +1,102 @@
+#include "TokenizerBenchmark.h"
+#include "BenchmarkUtils.h"
+#include "AllocationCounter.h"
+#include <fstream>
+#include <cstdio>
+#include <iostream>
+#include "..\Core\StringUtils.h"
+#include "..\Core\MappedFile.h"
+#include "..\Core\PartFileTokenizer.h"
+#include "..\AppPartOps\PartOps.h"
+
+static const int Repetitions = 3;
+
+// Roughly what every reader does per line today, a getline and a substr of the value
+static size_t StreamLineLoop(const std::string& partPath)
+{
+	size_t valueBytes = 0;
+	std::string line;
+	std::ifstream partFile(partPath);
+	while (getline(partFile, line))
+	{
+		size_t colon = line.find(':');
+		if (colon != std::string::npos)
+		{
+			std::string value = line.substr(colon + 1, line.size() - colon - 1);
+			valueBytes += value.size();
+		}
+	}
+	return valueBytes;
+}
+
+static size_t MappedLineLoop(const std::string& partPath)
+{
+	size_t valueBytes = 0;
+	std::string_view line;
+	MappedFile mappedFile(partPath);
+	PartFileTokenizer tokenizer(mappedFile.Data(), mappedFile.Size());
+	while (tokenizer.NextLine(line))
+	{
+		size_t colon = line.find(':');
+		if (colon != std::string_view::npos)
+		{
+			std::string_view value = line.substr(colon + 1);
+			valueBytes += value.size();
+		}
+	}
+	return valueBytes;
+}
+
+static size_t CountLines(const std::string& partPath)
+{
+	size_t lines = 0;
+	std::string_view line;
+	MappedFile mappedFile(partPath);
+	PartFileTokenizer tokenizer(mappedFile.Data(), mappedFile.Size());
+	while (tokenizer.NextLine(line))
+	{
+		lines++;
+	}
+	return lines;
+}
+
+int RunTokenizerBenchmark(const std::string& samplePartPath, size_t scale)
+{
+	std::string scaledPartPath = samplePartPath + ".scaled.prt";
+
+	std::cout << "Tokenizer benchmark, " << samplePartPath << " scaled " << scale << "x" << std::endl;
+	size_t bytes = ScaleSamplePart(samplePartPath, scaledPartPath, scale);
+	size_t lines = CountLines(scaledPartPath);
+	std::cout << "    " << bytes << " bytes, " << lines << " lines" << std::endl;
+
+	std::cout << "Line loop (getline + value)" << std::endl;
+	size_t allocationsBefore = AllocationCount();
+	double streamLoopSeconds = BestOf(Repetitions, [&]() { StreamLineLoop(scaledPartPath); });
+	size_t streamAllocations = (AllocationCount() - allocationsBefore) / Repetitions;
+	PrintResult("ifstream + getline", streamLoopSeconds, bytes);
+
+	allocationsBefore = AllocationCount();
+	double mappedLoopSeconds = BestOf(Repetitions, [&]() { MappedLineLoop(scaledPartPath); });
+	size_t mappedAllocations = (AllocationCount() - allocationsBefore) / Repetitions;
+	PrintResult("MappedFile + tokenizer", mappedLoopSeconds, bytes);
+
+	std::cout << "    allocations per line: ifstream " << (double)streamAllocations / lines
+		<< ", mapped " << (double)mappedAllocations / lines << std::endl;
+
+	std::cout << "OpenPartFile (console output discarded)" << std::endl;
+	double streamOpenSeconds = 0.0;
+	double mappedOpenSeconds = 0.0;
+	{
+		ScopedSilenceCout silence;
+		streamOpenSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Stream); });
+		mappedOpenSeconds = BestOf(Repetitions, [&]() {
+			Application::PartFile::OpenPartFile(scaledPartPath, Application::PartFileReadMode::Mapped); });
+	}
+	PrintResult("PartFileReadMode::Stream", streamOpenSeconds, bytes);
+	PrintResult("PartFileReadMode::Mapped", mappedOpenSeconds, bytes);
+	std::cout << "    speedup " << streamOpenSeconds / mappedOpenSeconds << "x" << std::endl;
+
+	std::remove(scaledPartPath.c_str());
+	return 0;
+}
@@ -0,0 +1,8 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// Compares the std::ifstream/getline reader against the memory mapped
+/// tokenizer on SampleVersionUp.prt scaled up by scale.
+/// </summary>
+int RunTokenizerBenchmark(const std::string& samplePartPath, size_t scale);
@@ -0,0 +1,92 @@
+#include "WriteBehindBenchmark.h"
+#include "BenchmarkUtils.h"
+#include <filesystem>
+#include <iostream>
+#include <vector>
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\PartDeltaLog.h"
+#include "..\AppPartOps\PartSaveQueue.h"
+#include "..\AppLibrary\Extrude.h"
+
+static const size_t PartCount = 8;
+
+// Scaled guids start at 1, these sit well past them
+static const int FirstEditGuid = 900000000;
+
+static double SaveEveryEdit(std::vector<Application::PartFile*>& partFiles, std::vector<Application::Extrude*>& edits, size_t saveCount)
+{
+	return BestOf(1, [&]() {
+		for (size_t i = 0; i < saveCount; i++)
+		{
+			Application::PartFile* partFile = partFiles[i % partFiles.size()];
+			partFile->AddFeature(edits[i % edits.size()]);
+			partFile->SavePart(Application::PartSaveMode::Delta);
+		}
+		Application::PartSaveQueue::GetInstance().Barrier(); });
+}
+
+int RunWriteBehindBenchmark(const std::string& samplePartPath, size_t saveCount)
+{
+	std::string looseDirectory = samplePartPath + ".writebehind";
+
+	std::cout << "Write-behind benchmark, " << saveCount << " saves over " << PartCount << " copies of " << samplePartPath << std::endl;
+	std::filesystem::remove_all(looseDirectory);
+	std::filesystem::create_directories(looseDirectory);
+
+	std::vector<std::string> partPaths;
+	for (size_t i = 0; i < PartCount; i++)
+	{
+		std::string partPath = (std::filesystem::path(looseDirectory) / ("Part" + std::to_string(i) + ".prt")).string();
+		ScaleSamplePart(samplePartPath, partPath, 1);
+		partPaths.push_back(partPath);
+	}
+
+	// each part edits its own features, a save of one never replaces another's
+	std::vector<Application::Extrude*> edits;
+	for (size_t i = 0; i < PartCount * 4; i++)
+	{
+		edits.push_back(Application::Extrude::FromText("2", "Face1", "Vector1", "True", "False", FirstEditGuid + (int)i));
+	}
+
+	Application::PartSaveQueue& saveQueue = Application::PartSaveQueue::GetInstance();
+	double writeThroughSeconds = 0.0;
+	double writeBehindSeconds = 0.0;
+	Application::PartSaveQueueStatistics statistics;
+	{
+		ScopedSilenceCout silence;
+		std::vector<Application::PartFile*> partFiles;
+		for (const std::string& partPath : partPaths)
+		{
+			Application::PartFile* partFile = Application::PartFile::OpenPartFile(partPath, Application::PartFileReadMode::Lazy);
+			// keep compaction out of the timings
+			partFile->SetCompactionRatio(1000.0);
+			partFiles.push_back(partFile);
+		}
+
+		saveQueue.SetEnabled(false);
+		writeThroughSeconds = SaveEveryEdit(partFiles, edits, saveCount);
+
+		saveQueue.SetEnabled(true);
+		saveQueue.ResetStatistics();
+		writeBehindSeconds = SaveEveryEdit(partFiles, edits, saveCount);
+		statistics = saveQueue.GetStatistics();
+		saveQueue.SetEnabled(false);
+
+		for (Application::PartFile* partFile : partFiles)
+		{
+			delete partFile;
+		}
+	}
+
+	std::cout << "    SavePart writing each save " << writeThroughSeconds * 1000.0 << " ms" << std::endl;
+	std::cout << "    SavePart queued, then Barrier " << writeBehindSeconds * 1000.0 << " ms" << std::endl;
+	std::cout << "    " << statistics.queuedSaves << " saves written as " << statistics.writtenBatches << " delta log batches in "
+		<< statistics.writeRounds << " rounds, " << statistics.failedBatches << " failed" << std::endl;
+
+	for (Application::Extrude* edit : edits)
+	{
+		delete edit;
+	}
+	std::filesystem::remove_all(looseDirectory);
+	return 0;
+}
@@ -0,0 +1,9 @@
+#pragma once
+#include <string>
+
+/// <summary>
+/// A script saving after every edit: saveCount Delta saves spread over a few
+/// copies of the sample part, each SavePart writing before it returns vs queued
+/// in the PartSaveQueue and written behind, with a Barrier at the end.
+/// </summary>
+int RunWriteBehindBenchmark(const std::string& samplePartPath, size_t saveCount);
@@ -0,0 +1,427 @@
+// PartFileTools.cpp : Command line utilities for part files.
+//
+
+#include <iostream>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "..\AppPartOps\PartArchive.h"
+#include "..\AppPartOps\PartCatalog.h"
+#include "..\AppPartOps\PartDiff.h"
+#include "..\AppPartOps\PartFileConverter.h"
+#include "..\AppPartOps\PartFileProbe.h"
+#include "..\AppPartOps\PartFileStream.h"
+#include "..\AppPartOps\PartVersionUp.h"
+#include "..\AppPartOps\PartOps.h"
+#include "..\AppPartOps\DelMeBadPattern.h"
+#include "..\Core\LibraryLoad.h"
+#include "..\Core\CoreSession.h"
+#include "..\Core\Observer.h"
+#include "..\Core\PartFileWatcher.h"
+#include "..\Core\ThreadPool.h"
+
+static void Usage()
+{
+	std::cout << "Usage: PartFileTools <command> <arguments>" << std::endl;
+	std::cout << "    convert <source> <target>    text part to binary part (.prtb) or back, picked from the source format" << std::endl;
+	std::cout << "    versionup <directory> [threads]    upgrade every feature of every .prt under directory to its latest version" << std::endl;
+	std::cout << "    probe <part>    header, feature counts and feature versions without opening the part" << std::endl;
+	std::cout << "    stream <part|-> [budgetMB]    one pass over a part, or stdin for -, counting features by type and version" << std::endl;
+	std::cout << "    catalog <directory> <index> [feature <type> <version> | schema-below <version>]    refresh the part catalog of directory, then query it" << std::endl;
+	std::cout << "    pack <directory> <archive.prtpak>    pack every .prt under directory into one archive, open a part of it as <archive.prtpak>#<name>" << std::endl;
+	std::cout << "    diff <oldPart> <newPart>    features added, removed and changed by guid, version ups are not changes" << std::endl;
+	std::cout << "    watch <part>    open the part and reload the features other tools change in it, until Ctrl+C" << std::endl;
+}
+
+static int RunConvert(int argc, char** argv)
+{
+	if (argc != 4)
+	{
+		Usage();
+		return 1;
+	}
+
+	ConvertPartFile(argv[2], argv[3]);
+	std::cout << "Converted " << argv[2] << " to " << argv[3] << std::endl;
+	return 0;
+}
+
+static std::vector<std::string> FindPartFiles(const std::string& directory)
+{
+	std::vector<std::string> partFiles;
+	for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+	{
+		if (entry.is_regular_file() && entry.path().extension() == ".prt")
+		{
+			partFiles.push_back(entry.path().string());
+		}
+	}
+	return partFiles;
+}
+
+static int RunVersionUp(int argc, char** argv)
+{
+	if (argc != 3 && argc != 4)
+	{
+		Usage();
+		return 1;
+	}
+
+	size_t threadCount = argc == 4 ? (size_t)std::stoul(argv[3]) : 0;
+
+	// Wire and the other routing features register their readers and writers when this loads
+	HINSTANCE routingLibrary = CoreLoadLibrary("COOLDEMANDLOADEDLIBRARY.dll");
+	if (routingLibrary == nullptr)
+	{
+		std::cout << "COOLDEMANDLOADEDLIBRARY.dll not loaded, routing features will be left as they are" << std::endl;
+	}
+
+	std::vector<std::string> partFiles = FindPartFiles(argv[2]);
+	std::vector<PartVersionUpResult> results(partFiles.size());
+	std::vector<std::string> errors(partFiles.size());
+
+	// the view readers the workers use do not trace, the report is all that goes to std::cout
+	auto start = std::chrono::steady_clock::now();
+	{
+		ThreadPool threadPool(threadCount);
+		threadCount = threadPool.GetThreadCount();
+		threadPool.ParallelFor(partFiles.size(), [&](size_t begin, size_t end)
+			{
+				for (size_t fileIndex = begin; fileIndex < end; ++fileIndex)
+				{
+					try
+					{
+						results[fileIndex] = VersionUpPartFile(partFiles[fileIndex]);
+					}
+					catch (std::exception& e)
+					{
+						errors[fileIndex] = e.what();
+					}
+				}
+			});
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	size_t upgradedParts = 0;
+	size_t failedParts = 0;
+	size_t upgradedFeatures = 0;
+	uint64_t bytesRead = 0;
+	std::map<std::string, size_t> upgradePaths;
+	for (size_t fileIndex = 0; fileIndex < partFiles.size(); ++fileIndex)
+	{
+		if (!errors[fileIndex].empty())
+		{
+			std::cout << "    failed " << partFiles[fileIndex] << ": " << errors[fileIndex] << std::endl;
+			++failedParts;
+			continue;
+		}
+
+		const PartVersionUpResult& result = results[fileIndex];
+		bytesRead += result.bytesRead;
+		upgradedFeatures += result.upgradedFeatureCount;
+		if (result.upgradedFeatureCount != 0)
+		{
+			++upgradedParts;
+		}
+		for (const auto& path : result.upgradePaths)
+		{
+			upgradePaths[path.first] += path.second;
+		}
+	}
+
+	double megabytes = bytesRead / (1024.0 * 1024.0);
+	std::cout << "Version up of " << partFiles.size() << " parts on " << threadCount << " threads in " << seconds << " s" << std::endl;
+	std::cout << "    upgraded " << upgradedParts << ", already latest " << (partFiles.size() - upgradedParts - failedParts)
+		<< ", failed " << failedParts << std::endl;
+	std::cout << "    " << (seconds > 0 ? partFiles.size() / seconds : 0) << " parts/s, "
+		<< (seconds > 0 ? megabytes / seconds : 0) << " MB/s" << std::endl;
+	std::cout << "    " << upgradedFeatures << " features upgraded" << std::endl;
+	for (const auto& path : upgradePaths)
+	{
+		std::cout << "        " << path.first << ": " << path.second << std::endl;
+	}
+
+	if (routingLibrary != nullptr)
+	{
+		UnloadLibrary(routingLibrary);
+	}
+
+	return failedParts == 0 ? 0 : 1;
+}
+
+static int RunProbe(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		Usage();
+		return 1;
+	}
+
+	PartFileProbe probe = ProbePartFile(argv[2]);
+
+	std::cout << "Part " << probe.partFileName << ", schema " << probe.schemaVersion
+		<< (probe.isBinary ? ", binary" : ", text") << (probe.hasPendingDeltas ? ", pending delta saves" : "") << std::endl;
+	std::cout << "    " << probe.featureCount << " features, " << probe.routingFeatureCount << " routing features" << std::endl;
+	for (const auto& featureType : probe.featureVersions)
+	{
+		for (const auto& version : featureType.second)
+		{
+			std::cout << "        " << featureType.first << " version " << version.first << ": " << version.second << std::endl;
+		}
+	}
+	return 0;
+}
+
+static int RunStream(int argc, char** argv)
+{
+	if (argc != 3 && argc != 4)
+	{
+		Usage();
+		return 1;
+	}
+
+	std::string partFilePath = argv[2];
+	size_t memoryBudget = (argc == 4) ? (size_t)std::stoul(argv[3]) * 1024 * 1024 : DefaultStreamMemoryBudget;
+
+	HINSTANCE routingLibrary = CoreLoadLibrary("COOLDEMANDLOADEDLIBRARY.dll");
+
+	std::map<std::string, size_t> featureCounts;
+	StreamedFeatureVisitor countFeature = [&](const StreamedFeature& streamedFeature)
+	{
+		std::string key(streamedFeature.featureType);
+		key.append(" ").append(std::to_string(streamedFeature.fileVersion));
+		if (streamedFeature.version != streamedFeature.fileVersion)
+		{
+			key.append("->").append(std::to_string(streamedFeature.version));
+		}
+		++featureCounts[key];
+		return true;
+	};
+
+	auto start = std::chrono::steady_clock::now();
+	PartStreamResult result = (partFilePath == "-")
+		? StreamPartFile(std::cin, countFeature, memoryBudget)
+		: StreamPartFile(partFilePath, countFeature, memoryBudget);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Part " << result.partFileName << ", schema " << result.schemaVersion << std::endl;
+	std::cout << "    " << result.featureCount << " features, " << result.unreadFeatureCount << " with no reader" << std::endl;
+	for (const auto& count : featureCounts)
+	{
+		std::cout << "        " << count.first << ": " << count.second << std::endl;
+	}
+	std::cout << "    " << result.bytesRead << " bytes in " << seconds << " s, peak buffer " << result.peakBufferBytes << " bytes" << std::endl;
+
+	if (routingLibrary != nullptr)
+	{
+		UnloadLibrary(routingLibrary);
+	}
+	return 0;
+}
+
+static int RunCatalog(int argc, char** argv)
+{
+	if (argc < 4)
+	{
+		Usage();
+		return 1;
+	}
+
+	std::string query = (argc > 4) ? argv[4] : "";
+	if (!((query.empty() && argc == 4) || (query == "feature" && argc == 7) || (query == "schema-below" && argc == 6)))
+	{
+		Usage();
+		return 1;
+	}
+
+	Application::PartCatalog catalog(argv[2], argv[3]);
+	Application::PartCatalogRefreshResult refresh = catalog.Refresh();
+
+	std::cout << "Catalog of " << refresh.partCount << " parts refreshed in " << refresh.seconds << " s" << std::endl;
+	std::cout << "    probed " << refresh.probedCount << ", removed " << refresh.removedCount
+		<< ", failed " << refresh.failedCount << std::endl;
+
+	if (query.empty())
+	{
+		return 0;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<const Application::PartCatalogEntry*> parts = (query == "feature")
+		? catalog.FindPartsWithFeatureVersion(argv[5], std::stoi(argv[6]))
+		: catalog.FindPartsWithSchemaBelow(std::stoi(argv[5]));
+	double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	for (const Application::PartCatalogEntry* part : parts)
+	{
+		std::cout << "        " << part->relativePath << " (" << part->partFileName << ", schema " << part->schemaVersion << ")" << std::endl;
+	}
+	std::cout << "    " << parts.size() << " parts match, query took " << milliseconds << " ms" << std::endl;
+	return 0;
+}
+
+static int RunPack(int argc, char** argv)
+{
+	if (argc != 4)
+	{
+		Usage();
+		return 1;
+	}
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::string> partFiles = FindPartFiles(argv[2]);
+	Application::PartArchive::Pack(partFiles, argv[3]);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Packed " << partFiles.size() << " parts into " << argv[3] << " in " << seconds << " s, "
+		<< std::filesystem::file_size(argv[3]) << " bytes" << std::endl;
+	return 0;
+}
+
+static int RunDiff(int argc, char** argv)
+{
+	if (argc != 4)
+	{
+		Usage();
+		return 1;
+	}
+
+	// the lazy indexes read features with the view readers, nothing traces to std::cout
+	PartDiffResult result = DiffPartFiles(argv[2], argv[3]);
+
+	for (const PartFeatureDifference& difference : result.differences)
+	{
+		const char* change = (difference.change == PartFeatureChange::Added) ? "added  "
+			: (difference.change == PartFeatureChange::Removed) ? "removed" : "changed";
+		std::cout << "    " << change << " " << difference.featureType << " " << difference.guid << std::endl;
+	}
+	std::cout << "Diff of " << argv[2] << " and " << argv[3] << " in " << result.seconds << " s" << std::endl;
+	std::cout << "    " << result.differences.size() << " differences, " << result.unchangedCount << " unchanged ("
+		<< result.rewrittenCount << " rewritten only), " << result.readFeatureCount << " features read" << std::endl;
+
+	// like diff, 1 when the parts differ
+	return result.differences.empty() ? 0 : 1;
+}
+
+// Keeps what the calls in its scope trace to std::cout out of the report.  Swapping the buffer races any other
+// thread writing to std::cout, so only around calls that run on the calling thread with no workers
+class QuietConsole
+{
+public:
+	QuietConsole() : m_console(std::cout.rdbuf(nullptr))
+	{
+	}
+
+	~QuietConsole()
+	{
+		std::cout.rdbuf(m_console);
+		std::cout.clear();
+	}
+
+	QuietConsole(const QuietConsole&) = delete;
+	QuietConsole& operator=(const QuietConsole&) = delete;
+
+private:
+	std::streambuf* m_console;
+};
+
+// Prints what each reload of the watched part changed
+class ReloadReporter : public Observer
+{
+public:
+	ReloadReporter() : Observer(CoreSession::GetInstance(), Observer::ReloadPart)
+	{
+	}
+
+	void Update(const std::string& message_from_subject, void* data) override
+	{
+		const PartReloadNotifierData* reload = static_cast<const PartReloadNotifierData*>((PartOpsNotifierData*)data);
+		std::cout << "Reloaded " << reload->partName << ", " << reload->changedGuids.size() << " changed, "
+			<< reload->addedGuids.size() << " added, " << reload->removedGuids.size() << " removed" << std::endl;
+	}
+};
+
+static int RunWatch(int argc, char** argv)
+{
+	if (argc != 3)
+	{
+		Usage();
+		return 1;
+	}
+
+	Application::PartFile::SetWatchForChanges(true);
+	{
+		// opening traces the part and its observers, a Mapped open reads it on this thread alone
+		QuietConsole quiet;
+		Application::PartFile::OpenPartFile(argv[2], Application::PartFileReadMode::Mapped);
+	}
+
+	ReloadReporter reporter;
+	std::cout << "Watching " << argv[2] << ", Ctrl+C to stop" << std::endl;
+	for (;;)
+	{
+		PartFileWatcher::GetInstance().WaitAndDispatchChanges(1000);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+	{
+		Usage();
+		return 1;
+	}
+
+	std::string command = argv[1];
+
+	int retVal = 0;
+	try
+	{
+		if (command == "convert")
+		{
+			retVal = RunConvert(argc, argv);
+		}
+		else if (command == "versionup")
+		{
+			retVal = RunVersionUp(argc, argv);
+		}
+		else if (command == "probe")
+		{
+			retVal = RunProbe(argc, argv);
+		}
+		else if (command == "stream")
+		{
+			retVal = RunStream(argc, argv);
+		}
+		else if (command == "catalog")
+		{
+			retVal = RunCatalog(argc, argv);
+		}
+		else if (command == "pack")
+		{
+			retVal = RunPack(argc, argv);
+		}
+		else if (command == "diff")
+		{
+			retVal = RunDiff(argc, argv);
+		}
+		else if (command == "watch")
+		{
+			retVal = RunWatch(argc, argv);
+		}
+		else
+		{
+			Usage();
+			retVal = 1;
+		}
+	}
+	catch (std::exception& e)
+	{
+		std::cout << command << " failed: " << e.what() << std::endl;
+		retVal = 1;
+	}
+
+	return retVal;
+}